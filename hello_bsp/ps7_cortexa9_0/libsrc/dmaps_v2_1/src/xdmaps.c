@@ -67,6 +67,8 @@
 *			   the IARCC compiler around PDBG, it is better to remove it.
 *			   Users can always use xil_printfs if they want to debug.
 * 2.01 kpc    08/23/14   Fixed the IAR compiler reported errors
+* 2.1  ag     10/18/26   Skip the cache maintenance of buffers and programs
+*			   in coherent regions, see xil_coherent.h.
 * </pre>
 *
 *****************************************************************************/
@@ -79,6 +81,7 @@
 #include "xdmaps.h"
 #include "xil_io.h"
 #include "xil_cache.h"
+#include "xil_coherent.h"
 
 #include "xil_printf.h"
 
@@ -1311,7 +1314,9 @@ static int XDmaPs_BuildDmaProg(unsigned Channel, XDmaPs_Cmd *Cmd,
 
 	DmaProgBytes = DmaProgBuf - DmaProgStart;
 
-	Xil_DCacheFlushRange((u32)DmaProgStart, DmaProgBytes);
+	if (Xil_IsCoherent((INTPTR)DmaProgStart, DmaProgBytes) == 0U) {
+		Xil_DCacheFlushRange((u32)DmaProgStart, DmaProgBytes);
+	}
 
 	return DmaProgBytes;
 
@@ -1502,10 +1507,12 @@ int XDmaPs_Start(XDmaPs *InstPtr, unsigned int Channel,
 
 		InstPtr->Chans[Channel].DmaCmdToHw = Cmd;
 
-		if (Cmd->ChanCtrl.SrcInc) {
+		if (Cmd->ChanCtrl.SrcInc &&
+		    (Xil_IsCoherent(Cmd->BD.SrcAddr, Cmd->BD.Length) == 0U)) {
 			Xil_DCacheFlushRange(Cmd->BD.SrcAddr, Cmd->BD.Length);
 		}
-		if (Cmd->ChanCtrl.DstInc) {
+		if (Cmd->ChanCtrl.DstInc &&
+		    (Xil_IsCoherent(Cmd->BD.DstAddr, Cmd->BD.Length) == 0U)) {
 			Xil_DCacheInvalidateRange(Cmd->BD.DstAddr,
 					Cmd->BD.Length);
 		}
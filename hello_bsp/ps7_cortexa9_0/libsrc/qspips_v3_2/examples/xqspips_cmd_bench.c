@@ -0,0 +1,227 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_cmd_bench.c
+*
+* Measures the rate of short polled transfers with XQspiPs_PolledTransfer()
+* and with a command template and XQspiPs_CmdPolledTransfer(). Status
+* register reads (2 bytes), ID reads (4 bytes) and 16 byte fast reads are
+* issued back to back; the transfers per second, the CPU cycles per transfer
+* (PMU cycle counter) and the speedup are printed. The received bytes of the
+* two paths are compared.
+*
+* The clock prescaler is set to 2 so the bus time is small and the software
+* overhead dominates, as it does for status polling at full clock.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xqspips.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define QSPI_DEVICE_ID		XPAR_XQSPIPS_0_DEVICE_ID
+
+#define BENCH_TRANSFERS		20000
+#define FAST_READ_BYTES		(4 + 1 + 16)	/* Cmd, address, dummy, data */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int QspiCmdBench(void);
+static int BenchCommand(const char *Name, u8 OpCode, unsigned ByteCount);
+
+/************************** Variable Definitions *****************************/
+
+static XQspiPs QspiInstance;
+
+/*
+ * Word aligned, the transfer functions access the buffers in words
+ */
+static u8 SendBuf[FAST_READ_BYTES + 3] __attribute__ ((aligned(4)));
+static u8 RecvBuf[FAST_READ_BYTES + 3] __attribute__ ((aligned(4)));
+static u8 RefBuf[FAST_READ_BYTES + 3] __attribute__ ((aligned(4)));
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return QspiCmdBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Sets up the controller in I/O mode and runs the commands.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int QspiCmdBench(void)
+{
+	XQspiPs_Config *QspiConfig;
+	int Status;
+
+	QspiConfig = XQspiPs_LookupConfig(QSPI_DEVICE_ID);
+	if (QspiConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XQspiPs_CfgInitialize(&QspiInstance, QspiConfig,
+				       QspiConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XQspiPs_SetOptions(&QspiInstance, XQSPIPS_MANUAL_START_OPTION |
+			   XQSPIPS_FORCE_SSELECT_OPTION |
+			   XQSPIPS_HOLD_B_DRIVE_OPTION);
+	XQspiPs_SetClkPrescaler(&QspiInstance, XQSPIPS_CLK_PRESCALE_2);
+	XQspiPs_SetSlaveSelect(&QspiInstance);
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("\r\nShort polled transfers\r\n");
+	xil_printf("command      bytes  lookup/s  template/s  "
+		   "cycles  cycles  speedup\r\n");
+
+	Status = BenchCommand("RDSR1     ", XQSPIPS_FLASH_OPCODE_RDSR1, 2);
+	Status |= BenchCommand("RDID      ", XQSPIPS_FLASH_OPCODE_RDID, 4);
+	Status |= BenchCommand("FAST_READ ", XQSPIPS_FLASH_OPCODE_FAST_READ,
+			       FAST_READ_BYTES);
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Issues one command BENCH_TRANSFERS times through each path and prints a
+* result row.
+*
+* @param	Name is the printed name of the command.
+* @param	OpCode is the instruction.
+* @param	ByteCount is the number of bytes of each transfer.
+*
+* @return	XST_SUCCESS if both paths received the same data, otherwise
+*		XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int BenchCommand(const char *Name, u8 OpCode, unsigned ByteCount)
+{
+	XQspiPs_CmdTemplate Cmd;
+	XTime Start;
+	XTime End;
+	u32 CycleStart;
+	u32 LookupCycles;
+	u32 TemplateCycles;
+	u32 LookupRate;
+	u32 TemplateRate;
+	u32 Index;
+
+	memset(SendBuf, 0, sizeof(SendBuf));
+	SendBuf[0] = OpCode;
+
+	/* Lookup on every call */
+	XTime_GetTime(&Start);
+	CycleStart = Xpm_GetCycleCounter();
+	for (Index = 0; Index < BENCH_TRANSFERS; Index++) {
+		XQspiPs_PolledTransfer(&QspiInstance, SendBuf, RefBuf,
+				       ByteCount);
+	}
+	LookupCycles = (Xpm_GetCycleCounter() - CycleStart) / BENCH_TRANSFERS;
+	XTime_GetTime(&End);
+	LookupRate = (u32)((BENCH_TRANSFERS * (u64)COUNTS_PER_SECOND) /
+			   (End - Start));
+
+	/* Template prepared once */
+	XQspiPs_CmdPrepare(&QspiInstance, &Cmd, OpCode, ByteCount);
+	XTime_GetTime(&Start);
+	CycleStart = Xpm_GetCycleCounter();
+	for (Index = 0; Index < BENCH_TRANSFERS; Index++) {
+		XQspiPs_CmdPolledTransfer(&QspiInstance, &Cmd, SendBuf,
+					  RecvBuf);
+	}
+	TemplateCycles = (Xpm_GetCycleCounter() - CycleStart) /
+			 BENCH_TRANSFERS;
+	XTime_GetTime(&End);
+	TemplateRate = (u32)((BENCH_TRANSFERS * (u64)COUNTS_PER_SECOND) /
+			     (End - Start));
+
+	xil_printf("%s  %5d  %8d  %10d  %6d  %6d  %4d.%02d\r\n", Name,
+		   ByteCount, LookupRate, TemplateRate, LookupCycles,
+		   TemplateCycles, TemplateRate / LookupRate,
+		   ((TemplateRate % LookupRate) * 100) / LookupRate);
+
+	/* Both paths must have received the same bytes */
+	if (memcmp(RecvBuf, RefBuf, ByteCount) != 0) {
+		xil_printf("%s: received data differs\r\n", Name);
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
@@ -0,0 +1,264 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_dual_bench.c
+*
+* Measures the read throughput gained from a dual parallel QSPI connection.
+* On a board with two parallel flash devices the same amount of data is
+* read once using only the lower device and once striped across both, in
+* linear mode (CPU copy from the linear window) and in I/O mode through the
+* flash device layer (XQspiPs_FlashRead()). The throughput of each pass and
+* the parallel/single ratio are printed; the ratio should approach 2.00.
+*
+* The flash contents do not matter. The benchmark is skipped when the QSPI
+* instance is not configured for dual parallel mode.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xqspips.h"
+#include "xqspips_flash.h"
+#include "xil_printf.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define QSPI_DEVICE_ID		XPAR_XQSPIPS_0_DEVICE_ID
+
+#define LINEAR_BENCH_SIZE	(4 * 1024 * 1024)
+#define IO_BENCH_SIZE		(512 * 1024)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int QspiDualBench(void);
+static u32 LinearRate(u32 LqspiCr);
+static u32 IoRate(u8 ConnectionMode);
+static u32 KBps(u32 Bytes, XTime Ticks);
+static void PrintRow(const char *Name, u32 Single, u32 Parallel);
+
+/************************** Variable Definitions *****************************/
+
+static XQspiPs QspiInstance;
+static XQspiPs_Flash FlashInstance;
+
+static u8 Buffer[LINEAR_BENCH_SIZE] __attribute__ ((aligned(32)));
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return QspiDualBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the linear and I/O mode passes and prints the results.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int QspiDualBench(void)
+{
+	XQspiPs_Config *QspiConfig;
+	u32 Single;
+	u32 Parallel;
+	int Status;
+
+	QspiConfig = XQspiPs_LookupConfig(QSPI_DEVICE_ID);
+	if (QspiConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XQspiPs_CfgInitialize(&QspiInstance, QspiConfig,
+				       QspiConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	if (QspiConfig->ConnectionMode != XQSPIPS_CONNECTION_MODE_PARALLEL) {
+		xil_printf("QSPI is not in dual parallel mode, skipped\r\n");
+		return XST_SUCCESS;
+	}
+
+	XQspiPs_SetClkPrescaler(&QspiInstance, XQSPIPS_CLK_PRESCALE_4);
+
+	xil_printf("\r\nQSPI read throughput, KB/s\r\n");
+	xil_printf("path            single  parallel  ratio\r\n");
+
+	/* Linear mode, quad output fast read */
+	XQspiPs_SetOptions(&QspiInstance, XQSPIPS_LQSPI_MODE_OPTION |
+			   XQSPIPS_HOLD_B_DRIVE_OPTION);
+	Single = LinearRate(XQSPIPS_LQSPI_CR_RST_STATE);
+	Parallel = LinearRate(XQSPIPS_LQSPI_CR_RST_STATE |
+			      XQSPIPS_LQSPI_CR_TWO_MEM_MASK |
+			      XQSPIPS_LQSPI_CR_SEP_BUS_MASK);
+	PrintRow("linear", Single, Parallel);
+
+	/* I/O mode through the flash layer, single bit fast read */
+	XQspiPs_SetLqspiConfigReg(&QspiInstance, 0);
+	XQspiPs_SetOptions(&QspiInstance, XQSPIPS_MANUAL_START_OPTION |
+			   XQSPIPS_FORCE_SSELECT_OPTION |
+			   XQSPIPS_HOLD_B_DRIVE_OPTION);
+	XQspiPs_SetSlaveSelect(&QspiInstance);
+	Single = IoRate(XQSPIPS_CONNECTION_MODE_SINGLE);
+	Parallel = IoRate(XQSPIPS_CONNECTION_MODE_PARALLEL);
+	PrintRow("io", Single, Parallel);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads LINEAR_BENCH_SIZE bytes from the linear window with the given linear
+* configuration.
+*
+* @param	LqspiCr is the linear configuration register value.
+*
+* @return	The throughput in KB/s.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 LinearRate(u32 LqspiCr)
+{
+	XTime Start;
+	XTime End;
+
+	XQspiPs_SetLqspiConfigReg(&QspiInstance, LqspiCr);
+
+	XTime_GetTime(&Start);
+	(void)XQspiPs_LqspiRead(&QspiInstance, Buffer, 0, LINEAR_BENCH_SIZE);
+	XTime_GetTime(&End);
+
+	return KBps(LINEAR_BENCH_SIZE, End - Start);
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads IO_BENCH_SIZE bytes through the flash layer with the given
+* connection mode.
+*
+* @param	ConnectionMode is the connection mode to use.
+*
+* @return	The throughput in KB/s.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 IoRate(u8 ConnectionMode)
+{
+	XTime Start;
+	XTime End;
+
+	QspiInstance.Config.ConnectionMode = ConnectionMode;
+	(void)XQspiPs_FlashInitialize(&FlashInstance, &QspiInstance);
+
+	XTime_GetTime(&Start);
+	(void)XQspiPs_FlashRead(&FlashInstance, 0, Buffer, IO_BENCH_SIZE);
+	XTime_GetTime(&End);
+
+	return KBps(IO_BENCH_SIZE, End - Start);
+}
+
+/*****************************************************************************/
+/**
+*
+* Converts a byte count and global timer ticks to KB/s.
+*
+* @param	Bytes is the number of bytes transferred.
+* @param	Ticks is the elapsed global timer ticks.
+*
+* @return	The throughput in KB/s.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 KBps(u32 Bytes, XTime Ticks)
+{
+	return (u32)(((u64)Bytes * COUNTS_PER_SECOND) / (Ticks * 1024));
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints one result row with the parallel/single ratio.
+*
+* @param	Name is the row label.
+* @param	Single is the single device throughput in KB/s.
+* @param	Parallel is the dual parallel throughput in KB/s.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void PrintRow(const char *Name, u32 Single, u32 Parallel)
+{
+	u32 Ratio = (Single != 0) ? (Parallel * 100) / Single : 0;
+
+	xil_printf("%-12s %8d  %8d  %d.%02d\r\n", Name, Single, Parallel,
+		   Ratio / 100, Ratio % 100);
+}
@@ -0,0 +1,446 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_lqdma_bench.c
+*
+* Compares linear QSPI reads done by the CPU (XQspiPs_LqspiRead()) with the
+* DMA backed XQspiPs_LqspiReadAsync() path.
+*
+* Two scenarios are measured with the global timer:
+*	- A single BENCH_SIZE read. The throughput and the share of CPU time
+*	  the transfer used are reported. For the DMA path the CPU share is
+*	  derived from an idle loop that runs while the read is in progress
+*	  and is calibrated before the measurement.
+*	- A sequential load in BENCH_RECORD_SIZE records, each of which is
+*	  checksummed after it arrives, with and without read-ahead. This
+*	  shows how much of the flash time read-ahead hides behind the
+*	  processing of the previous record.
+*
+* The DMA results are checked against the CPU copy. The flash must hold at
+* least BENCH_SIZE bytes; the contents do not matter.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xqspips.h"
+#include "xqspips_lqdma.h"
+#include "xdmaps.h"
+#include "xscugic.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define QSPI_DEVICE_ID		XPAR_XQSPIPS_0_DEVICE_ID
+#define DMA_DEVICE_ID		XPAR_XDMAPS_1_DEVICE_ID
+#define INTC_DEVICE_ID		XPAR_SCUGIC_SINGLE_DEVICE_ID
+#define DMA_FAULT_INTR		XPAR_XDMAPS_0_FAULT_INTR
+#define DMA_DONE_INTR_0		XPAR_XDMAPS_0_DONE_INTR_0
+#define DMA_CHANNEL		0
+
+#define BENCH_SIZE		(4 * 1024 * 1024)
+#define BENCH_RECORD_SIZE	(64 * 1024)
+#define BENCH_CAL_LOOPS		4000000
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int LqspiDmaBench(void);
+static int SetupInterruptSystem(XScuGic *GicPtr, XDmaPs *DmaPtr);
+static u32 IdleSpin(volatile u32 *BusyPtr, u32 Limit);
+static u32 Checksum(const u8 *BufPtr, u32 ByteCount);
+static XTime LoadRecords(int UseDma);
+static void PrintRate(const char *Name, u32 Bytes, XTime Ticks, u32 CpuPct);
+
+/************************** Variable Definitions *****************************/
+
+static XQspiPs QspiInstance;
+static XDmaPs DmaInstance;
+static XScuGic GicInstance;
+static XQspiPs_LqspiDma LqDma;
+
+static u8 RefBuffer[BENCH_SIZE] __attribute__ ((aligned(32)));
+static u8 DmaBuffer[BENCH_SIZE] __attribute__ ((aligned(32)));
+static u8 StageBuffer[BENCH_RECORD_SIZE] __attribute__ ((aligned(32)));
+
+static volatile u32 Sink;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	int Status;
+
+	Status = LqspiDmaBench();
+	if (Status != XST_SUCCESS) {
+		xil_printf("LQSPI DMA benchmark failed\r\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Sets up QSPI in linear mode and the DMA controller, then runs and prints
+* both scenarios.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int LqspiDmaBench(void)
+{
+	XQspiPs_Config *QspiConfig;
+	XDmaPs_Config *DmaConfig;
+	XTime Start;
+	XTime End;
+	XTime CalTicks;
+	XTime Ticks;
+	XTime Idle;
+	u32 IdleLoops;
+	u32 Busy = 1;
+	int Status;
+
+	QspiConfig = XQspiPs_LookupConfig(QSPI_DEVICE_ID);
+	if (QspiConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XQspiPs_CfgInitialize(&QspiInstance, QspiConfig,
+				       QspiConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XQspiPs_SetOptions(&QspiInstance, XQSPIPS_LQSPI_MODE_OPTION |
+			   XQSPIPS_HOLD_B_DRIVE_OPTION);
+	XQspiPs_SetClkPrescaler(&QspiInstance, XQSPIPS_CLK_PRESCALE_4);
+	XQspiPs_SetLqspiConfigReg(&QspiInstance, XQSPIPS_LQSPI_CR_RST_STATE);
+
+	DmaConfig = XDmaPs_LookupConfig(DMA_DEVICE_ID);
+	if (DmaConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XDmaPs_CfgInitialize(&DmaInstance, DmaConfig,
+				      DmaConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = SetupInterruptSystem(&GicInstance, &DmaInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = XQspiPs_LqspiDmaInitialize(&LqDma, &QspiInstance,
+					    &DmaInstance, DMA_CHANNEL);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("\r\nLinear QSPI read, %d KB\r\n", BENCH_SIZE / 1024);
+	xil_printf("path              MB/s     CPU %%\r\n");
+
+	/* CPU copy, the core is busy for the whole transfer */
+	XTime_GetTime(&Start);
+	Status = XQspiPs_LqspiRead(&QspiInstance, RefBuffer, 0, BENCH_SIZE);
+	XTime_GetTime(&End);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	PrintRate("memcpy", BENCH_SIZE, End - Start, 100);
+
+	/* Calibrate the idle loop used to measure the DMA CPU share */
+	XTime_GetTime(&Start);
+	(void)IdleSpin(&Busy, BENCH_CAL_LOOPS);
+	XTime_GetTime(&End);
+	CalTicks = End - Start;
+
+	XTime_GetTime(&Start);
+	Status = XQspiPs_LqspiReadAsync(&LqDma, DmaBuffer, 0, BENCH_SIZE);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	IdleLoops = IdleSpin(&LqDma.IsBusy, 0xFFFFFFFF);
+	XTime_GetTime(&End);
+	if (XQspiPs_LqspiDmaWait(&LqDma) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Ticks = End - Start;
+	Idle = ((XTime)IdleLoops * CalTicks) / BENCH_CAL_LOOPS;
+	if (Idle > Ticks) {
+		Idle = Ticks;
+	}
+	PrintRate("dma", BENCH_SIZE, Ticks,
+		  (u32)(((Ticks - Idle) * 100) / Ticks));
+
+	if (memcmp(RefBuffer, DmaBuffer, BENCH_SIZE) != 0) {
+		xil_printf("DMA data mismatch\r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("\r\nSequential load, %d KB records + checksum\r\n",
+		   BENCH_RECORD_SIZE / 1024);
+	xil_printf("path              MB/s\r\n");
+
+	PrintRate("memcpy", BENCH_SIZE, LoadRecords(FALSE), 0);
+
+	(void)XQspiPs_LqspiDmaSetReadAhead(&LqDma, NULL, 0);
+	PrintRate("dma", BENCH_SIZE, LoadRecords(TRUE), 0);
+
+	(void)XQspiPs_LqspiDmaSetReadAhead(&LqDma, StageBuffer,
+					   sizeof(StageBuffer));
+	PrintRate("dma+read-ahead", BENCH_SIZE, LoadRecords(TRUE), 0);
+	xil_printf("  %d KB served from staging\r\n", LqDma.StageHits / 1024);
+
+	if (memcmp(RefBuffer, DmaBuffer, BENCH_SIZE) != 0) {
+		xil_printf("DMA data mismatch\r\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Loads BENCH_SIZE bytes record by record and checksums each record after
+* it has arrived.
+*
+* @param	UseDma selects XQspiPs_LqspiReadAsync() instead of
+*		XQspiPs_LqspiRead().
+*
+* @return	The elapsed global timer ticks.
+*
+* @note		None
+*
+******************************************************************************/
+static XTime LoadRecords(int UseDma)
+{
+	XTime Start;
+	XTime End;
+	u32 Offset;
+	u32 Sum = 0;
+
+	XTime_GetTime(&Start);
+	for (Offset = 0; Offset < BENCH_SIZE; Offset += BENCH_RECORD_SIZE) {
+		if (UseDma) {
+			(void)XQspiPs_LqspiReadAsync(&LqDma,
+						     &DmaBuffer[Offset],
+						     Offset,
+						     BENCH_RECORD_SIZE);
+			(void)XQspiPs_LqspiDmaWait(&LqDma);
+			Sum += Checksum(&DmaBuffer[Offset], BENCH_RECORD_SIZE);
+		} else {
+			(void)XQspiPs_LqspiRead(&QspiInstance,
+						&RefBuffer[Offset], Offset,
+						BENCH_RECORD_SIZE);
+			Sum += Checksum(&RefBuffer[Offset], BENCH_RECORD_SIZE);
+		}
+	}
+	XTime_GetTime(&End);
+
+	Sink = Sum;
+
+	return End - Start;
+}
+
+/*****************************************************************************/
+/**
+*
+* Stands in for the processing of a record.
+*
+* @param	BufPtr is the record.
+* @param	ByteCount is the size of the record.
+*
+* @return	The Fletcher style checksum of the record.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 Checksum(const u8 *BufPtr, u32 ByteCount)
+{
+	u32 A = 1;
+	u32 B = 0;
+	u32 Index;
+
+	for (Index = 0; Index < ByteCount; Index++) {
+		A = (A + BufPtr[Index]) % 65521;
+		B = (B + A) % 65521;
+	}
+
+	return (B << 16) | A;
+}
+
+/*****************************************************************************/
+/**
+*
+* Counts loop iterations while *BusyPtr is set. The same loop is used for
+* calibration and measurement so the iteration cost matches.
+*
+* @param	BusyPtr points to the flag to watch.
+* @param	Limit is the maximum number of iterations.
+*
+* @return	The number of iterations run.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 IdleSpin(volatile u32 *BusyPtr, u32 Limit)
+{
+	u32 Count = 0;
+
+	while ((*BusyPtr != 0) && (Count != Limit)) {
+		Count++;
+	}
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints one result row.
+*
+* @param	Name is the row label.
+* @param	Bytes is the number of bytes transferred.
+* @param	Ticks is the elapsed global timer ticks.
+* @param	CpuPct is the CPU share in percent, 0 to omit it.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void PrintRate(const char *Name, u32 Bytes, XTime Ticks, u32 CpuPct)
+{
+	u32 KBps;
+
+	KBps = (u32)(((u64)Bytes * COUNTS_PER_SECOND) / (Ticks * 1000));
+
+	if (CpuPct != 0) {
+		xil_printf("%-16s %4d.%03d  %3d\r\n", Name, KBps / 1000,
+			   KBps % 1000, CpuPct);
+	} else {
+		xil_printf("%-16s %4d.%03d\r\n", Name, KBps / 1000,
+			   KBps % 1000);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Connects the DMA done and fault interrupts to the GIC and enables
+* interrupts.
+*
+* @param	GicPtr is a pointer to the GIC instance.
+* @param	DmaPtr is a pointer to the DMA instance.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int SetupInterruptSystem(XScuGic *GicPtr, XDmaPs *DmaPtr)
+{
+	XScuGic_Config *GicConfig;
+	int Status;
+
+	Xil_ExceptionInit();
+
+	GicConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (GicConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(GicPtr, GicConfig,
+				       GicConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_IRQ_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			GicPtr);
+
+	Status = XScuGic_Connect(GicPtr, DMA_FAULT_INTR,
+				 (Xil_InterruptHandler)XDmaPs_FaultISR,
+				 DmaPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_Connect(GicPtr, DMA_DONE_INTR_0,
+				 (Xil_InterruptHandler)XDmaPs_DoneISR_0,
+				 DmaPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XScuGic_Enable(GicPtr, DMA_FAULT_INTR);
+	XScuGic_Enable(GicPtr, DMA_DONE_INTR_0);
+
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
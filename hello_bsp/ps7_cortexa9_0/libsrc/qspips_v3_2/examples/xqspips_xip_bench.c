@@ -0,0 +1,281 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_xip_bench.c
+*
+* Measures what execute in place from the linear QSPI window saves at boot
+* and what it costs at run time.
+*
+* - Boot copy saved: the .xip_text section (__xip_start to __xip_end) is read
+*   from the linear window into DDR, which is the copy the boot loader would
+*   otherwise make before jumping to the application.
+* - Execution penalty: the same CRC32 routine is built once into DDR and once
+*   into the .xip.text section. Both are timed with the PMU cycle counter cold
+*   (L1 and L2 cleaned and invalidated before the call) and warm (second call),
+*   with and without continuous read mode.
+*
+* The application has to be linked with the lscript.ld .xip_text section and
+* the flash programmed with the image written by tools/xip_split.sh. This
+* code runs from DDR, which XQspiPs_XipInit() requires.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xqspips.h"
+#include "xil_cache.h"
+#include "xil_cache_l.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xtime_l.h"
+#include <string.h>
+
+/************************** Constant Definitions *****************************/
+
+#define QSPI_BASEADDR		XPAR_XQSPIPS_0_BASEADDR
+#define QSPI_CONNECTION_MODE	XPAR_XQSPIPS_0_QSPI_MODE
+
+#define CRC_DATA_SIZE		4096
+#define CRC_POLY		0xEDB88320U
+
+/**************************** Type Definitions *******************************/
+
+typedef u32 (*CrcFunc)(const u8 *Data, u32 Len);
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * One body, two placements, so the only difference between the functions
+ * is where the instructions are fetched from
+ */
+#define CRC32_BODY						\
+	u32 Crc = 0xFFFFFFFFU;					\
+	u32 Index;						\
+	u32 Bit;						\
+								\
+	for (Index = 0; Index < Len; Index++) {			\
+		Crc ^= Data[Index];				\
+		for (Bit = 0; Bit < 8; Bit++) {			\
+			Crc = (Crc >> 1) ^			\
+			      (CRC_POLY & (0U - (Crc & 1U)));	\
+		}						\
+	}							\
+	return ~Crc;
+
+/************************** Function Prototypes ******************************/
+
+int QspiXipBench(void);
+static u32 Crc32Ddr(const u8 *Data, u32 Len) __attribute__ ((noinline));
+static u32 Crc32Xip(const u8 *Data, u32 Len) __attribute__ ((noinline))
+	XQSPIPS_XIP_TEXT;
+static void TimeCrc(CrcFunc Func, u32 *Cold, u32 *Warm, u32 *Crc);
+
+/************************** Variable Definitions *****************************/
+
+extern u8 __xip_start[];
+extern u8 __xip_end[];
+
+static u8 CopyBuffer[4 * 1024 * 1024] __attribute__ ((aligned(32)));
+static u8 CrcData[CRC_DATA_SIZE] __attribute__ ((aligned(32)));
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return QspiXipBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the boot copy and execution passes and prints the results.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int QspiXipBench(void)
+{
+	u32 XipSize = (u32)(__xip_end - __xip_start);
+	XTime Start;
+	XTime End;
+	u32 Index;
+	u32 DdrCold, DdrWarm, DdrCrc;
+	u32 XipCold, XipWarm, XipCrc;
+	u32 Continuous;
+
+	if (XipSize == 0 || XipSize > sizeof(CopyBuffer)) {
+		xil_printf("XIP section size %d not supported\r\n", XipSize);
+		return XST_FAILURE;
+	}
+
+	for (Index = 0; Index < CRC_DATA_SIZE; Index++) {
+		CrcData[Index] = (u8)(Index * 7 + 3);
+	}
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("XIP section: %d bytes at 0x%08x\r\n\r\n", XipSize,
+		   (u32)__xip_start);
+	xil_printf("Mode        Boot copy(us)  DDR cold  DDR warm  "
+		   "XIP cold  XIP warm  (cycles)\r\n");
+
+	for (Continuous = 0; Continuous < 2; Continuous++) {
+		XQspiPs_XipInit(QSPI_BASEADDR, QSPI_CONNECTION_MODE,
+				Continuous);
+
+		/*
+		 * The copy the boot loader no longer has to make; start cold
+		 * so the data comes from flash and not from the caches
+		 */
+		Xil_DCacheFlush();
+		XTime_GetTime(&Start);
+		memcpy(CopyBuffer, __xip_start, XipSize);
+		XTime_GetTime(&End);
+
+		TimeCrc(Crc32Ddr, &DdrCold, &DdrWarm, &DdrCrc);
+		TimeCrc(Crc32Xip, &XipCold, &XipWarm, &XipCrc);
+
+		if (DdrCrc != XipCrc) {
+			xil_printf("CRC mismatch 0x%08x 0x%08x\r\n",
+				   DdrCrc, XipCrc);
+			return XST_FAILURE;
+		}
+
+		xil_printf("%s  %13d  %8d  %8d  %8d  %8d\r\n",
+			   Continuous ? "continuous" : "quad I/O  ",
+			   (u32)(((End - Start) * 1000000) /
+				 COUNTS_PER_SECOND),
+			   DdrCold, DdrWarm, XipCold, XipWarm);
+	}
+
+	xil_printf("\r\nCold penalty: %d cycles per call, warm penalty: "
+		   "%d cycles per call\r\n",
+		   (s32)(XipCold - DdrCold), (s32)(XipWarm - DdrWarm));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Times one CRC routine cold and warm.
+*
+* @param	Func is the routine to call.
+* @param	Cold returns the cycles of the first call after the caches
+*		have been cleaned and invalidated.
+* @param	Warm returns the cycles of the next call.
+* @param	Crc returns the result, for checking the two placements.
+*
+* @return	None.
+*
+* @note		None
+*
+******************************************************************************/
+static void TimeCrc(CrcFunc Func, u32 *Cold, u32 *Warm, u32 *Crc)
+{
+	u32 Start;
+
+	/* L1 D and L2 clean/invalidate, then L1 I invalidate */
+	Xil_DCacheFlush();
+	Xil_L1ICacheInvalidate();
+
+	Start = Xpm_GetCycleCounter();
+	*Crc = Func(CrcData, CRC_DATA_SIZE);
+	*Cold = Xpm_GetCycleCounter() - Start;
+
+	Start = Xpm_GetCycleCounter();
+	(void)Func(CrcData, CRC_DATA_SIZE);
+	*Warm = Xpm_GetCycleCounter() - Start;
+}
+
+/*****************************************************************************/
+/**
+*
+* CRC32 executed from DDR.
+*
+* @param	Data is the data to checksum.
+* @param	Len is the number of bytes.
+*
+* @return	The CRC32 of the data.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 Crc32Ddr(const u8 *Data, u32 Len)
+{
+	CRC32_BODY
+}
+
+/*****************************************************************************/
+/**
+*
+* CRC32 executed in place from the linear QSPI window.
+*
+* @param	Data is the data to checksum.
+* @param	Len is the number of bytes.
+*
+* @return	The CRC32 of the data.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 Crc32Xip(const u8 *Data, u32 Len)
+{
+	CRC32_BODY
+}
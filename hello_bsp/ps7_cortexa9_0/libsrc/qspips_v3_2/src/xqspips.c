@@ -130,6 +130,8 @@ typedef struct {
 
 /************************** Function Prototypes ******************************/
 static void XQspiPs_GetReadData(XQspiPs *InstancePtr, u32 Data, u8 Size);
+static void XQspiPs_DecodeInst(u8 Instruction, unsigned ByteCount,
+			       XQspiPs_CmdTemplate *CmdPtr);
 static void StubStatusHandler(void *CallBackRef, u32 StatusEvent,
 				unsigned ByteCount);
 
@@ -415,25 +417,65 @@ void XQspiPs_Abort(XQspiPs *InstancePtr)
 ******************************************************************************/
 int XQspiPs_Transfer(XQspiPs *InstancePtr, u8 *SendBufPtr, u8 *RecvBufPtr,
 			unsigned ByteCount)
+{
+	XQspiPs_CmdTemplate Cmd;
+
+	/*
+	 * The RecvBufPtr argument can be null
+	 */
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(SendBufPtr != NULL);
+	Xil_AssertNonvoid(ByteCount > 0);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	/*
+	 * The first byte with every chip-select assertion is always
+	 * expected to be an instruction for flash interface mode
+	 */
+	XQspiPs_DecodeInst(*SendBufPtr, ByteCount, &Cmd);
+
+	return XQspiPs_CmdTransfer(InstancePtr, &Cmd, SendBufPtr, RecvBufPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Transfers data on the QSPI bus like XQspiPs_Transfer(), using a command
+* template prepared with XQspiPs_CmdPrepare() instead of looking up the
+* instruction format.
+*
+* @param	InstancePtr is a pointer to the XQspiPs instance.
+* @param	CmdPtr is the command template. It is only read by this call,
+*		which copies what the interrupt handler needs into the
+*		instance, so it may go out of scope once the call returns.
+* @param	SendBufPtr is a pointer to the data to send, starting with the
+*		instruction of the template. CmdPtr->ByteCount bytes are sent.
+* @param	RecvBufPtr is a pointer to a buffer for received data, or NULL.
+*
+* @return
+*		- XST_SUCCESS if the buffers are successfully handed off to the
+*		  device for transfer.
+*		- XST_DEVICE_BUSY indicates that a data transfer is already in
+*		  progress.
+*
+* @note		This function is not thread-safe.
+*
+******************************************************************************/
+int XQspiPs_CmdTransfer(XQspiPs *InstancePtr, XQspiPs_CmdTemplate *CmdPtr,
+			 u8 *SendBufPtr, u8 *RecvBufPtr)
 {
 	u32 StatusReg;
 	u32 ConfigReg;
-	u8 Instruction;
 	u32 Data;
-	unsigned int Index;
 	u8 TransCount = 0;
-	XQspiPsInstFormat *CurrInst;
-	XQspiPsInstFormat NewInst[2];
-	u8 SwitchFlag  = 0;
-
-	CurrInst = &NewInst[0];
 
 	/*
 	 * The RecvBufPtr argument can be null
 	 */
 	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(CmdPtr != NULL);
 	Xil_AssertNonvoid(SendBufPtr != NULL);
-	Xil_AssertNonvoid(ByteCount > 0);
+	Xil_AssertNonvoid(*SendBufPtr == CmdPtr->OpCode);
 	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
 
 	/*
@@ -455,20 +497,8 @@ int XQspiPs_Transfer(XQspiPs *InstancePtr, u8 *SendBufPtr, u8 *RecvBufPtr,
 	InstancePtr->SendBufferPtr = SendBufPtr;
 	InstancePtr->RecvBufferPtr = RecvBufPtr;
 
-	InstancePtr->RequestedBytes = ByteCount;
-	InstancePtr->RemainingBytes = ByteCount;
-
-	/*
-	 * The first byte with every chip-select assertion is always
-	 * expected to be an instruction for flash interface mode
-	 */
-	Instruction = *InstancePtr->SendBufferPtr;
-
-	for (Index = 0 ; Index < ARRAY_SIZE(FlashInst); Index++) {
-		if (Instruction == FlashInst[Index].OpCode) {
-			break;
-		}
-	}
+	InstancePtr->RequestedBytes = CmdPtr->ByteCount;
+	InstancePtr->RemainingBytes = CmdPtr->ByteCount;
 
 	/*
 	 * Set the RX FIFO threshold
@@ -500,70 +530,11 @@ int XQspiPs_Transfer(XQspiPs *InstancePtr, u8 *SendBufPtr, u8 *RecvBufPtr,
 	XQspiPs_WriteReg(InstancePtr->Config.BaseAddress, XQSPIPS_SR_OFFSET,
 			XQSPIPS_IXR_WR_TO_CLR_MASK);
 
-	if (Index < ARRAY_SIZE(FlashInst)) {
-		CurrInst = &FlashInst[Index];
-		/*
-		 * Check for WRSR instruction which has different size for
-		 * Spansion (3 bytes) and Micron (2 bytes)
-		 */
-		if( (CurrInst->OpCode == XQSPIPS_FLASH_OPCODE_WRSR) &&
-			(ByteCount == 3) ) {
-			CurrInst->InstSize = 3;
-			CurrInst->TxOffset = XQSPIPS_TXD_11_OFFSET;
-		}
-	}
-
-	/*
-	 * If instruction not present in table
-	 */
-	if (Index == ARRAY_SIZE(FlashInst)) {
-		/*
-		 * Assign current instruction, size and TXD register to be used
-		 * The InstSize mentioned in case of instructions greater than
-		 * 4 bytes is not the actual size, but is indicative of
-		 * the TXD register used.
-		 * The remaining bytes of the instruction will be transmitted
-		 * through TXD0 below.
-		 */
-		switch(ByteCount%4)
-		{
-			case XQSPIPS_SIZE_ONE:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_ONE;
-				CurrInst->TxOffset = XQSPIPS_TXD_01_OFFSET;
-				if(ByteCount > 4) {
-					SwitchFlag = 1;
-				}
-				break;
-			case XQSPIPS_SIZE_TWO:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_TWO;
-				CurrInst->TxOffset = XQSPIPS_TXD_10_OFFSET;
-				if(ByteCount > 4) {
-					SwitchFlag = 1;
-				}
-				break;
-			case XQSPIPS_SIZE_THREE:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_THREE;
-				CurrInst->TxOffset = XQSPIPS_TXD_11_OFFSET;
-				if(ByteCount > 4) {
-					SwitchFlag = 1;
-				}
-				break;
-			default:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_FOUR;
-				CurrInst->TxOffset = XQSPIPS_TXD_00_OFFSET;
-				break;
-		}
-	}
-
 	/*
 	 * If the instruction size in not 4 bytes then the data received needs
 	 * to be shifted
 	 */
-	if( CurrInst->InstSize != 4 ) {
+	if( CmdPtr->InstSize != 4 ) {
 		InstancePtr->ShiftReadData = 1;
 	} else {
 		InstancePtr->ShiftReadData = 0;
@@ -571,23 +542,22 @@ int XQspiPs_Transfer(XQspiPs *InstancePtr, u8 *SendBufPtr, u8 *RecvBufPtr,
 
 	/* Get the complete command (flash inst + address/data) */
 	Data = *((u32 *)InstancePtr->SendBufferPtr);
-	InstancePtr->SendBufferPtr += CurrInst->InstSize;
-	InstancePtr->RemainingBytes -= CurrInst->InstSize;
+	InstancePtr->SendBufferPtr += CmdPtr->InstSize;
+	InstancePtr->RemainingBytes -= CmdPtr->InstSize;
 	if (InstancePtr->RemainingBytes < 0) {
 		InstancePtr->RemainingBytes = 0;
 	}
 
 	/* Write the command to the FIFO */
 	XQspiPs_WriteReg(InstancePtr->Config.BaseAddress,
-			 CurrInst->TxOffset, Data);
+			 CmdPtr->TxOffset, Data);
 	TransCount++;
 
 	/*
 	 * If switching from TXD1/2/3 to TXD0, then start transfer and
 	 * check for FIFO empty
 	 */
-	if(SwitchFlag == 1) {
-		SwitchFlag = 0;
+	if(CmdPtr->SwitchFlag == 1) {
 		/*
 		 * If, in Manual Start mode, start the transfer.
 		 */
@@ -711,14 +681,11 @@ int XQspiPs_PolledTransfer(XQspiPs *InstancePtr, u8 *SendBufPtr,
 	u8 Instruction;
 	u32 Data;
 	u8 TransCount;
-	unsigned int Index;
-	XQspiPsInstFormat *CurrInst;
-	XQspiPsInstFormat NewInst[2];
-	u8 SwitchFlag  = 0;
+	XQspiPs_CmdTemplate Cmd;
+	XQspiPs_CmdTemplate *CurrInst = &Cmd;
 	u8 IsManualStart = FALSE;
 	u32 RxCount = 0;
 
-	CurrInst = &NewInst[0];
 	/*
 	 * The RecvBufPtr argument can be NULL.
 	 */
@@ -754,12 +721,7 @@ int XQspiPs_PolledTransfer(XQspiPs *InstancePtr, u8 *SendBufPtr,
 	 * expected to be an instruction for flash interface mode
 	 */
 	Instruction = *InstancePtr->SendBufferPtr;
-
-	for (Index = 0 ; Index < ARRAY_SIZE(FlashInst); Index++) {
-		if (Instruction == FlashInst[Index].OpCode) {
-			break;
-		}
-	}
+	XQspiPs_DecodeInst(Instruction, ByteCount, CurrInst);
 
 	/*
 	 * Set the RX FIFO threshold
@@ -785,65 +747,6 @@ int XQspiPs_PolledTransfer(XQspiPs *InstancePtr, u8 *SendBufPtr,
 	 */
 	XQspiPs_Enable(InstancePtr);
 
-	if (Index < ARRAY_SIZE(FlashInst)) {
-
-		CurrInst = &FlashInst[Index];
-		/*
-		 * Check for WRSR instruction which has different size for
-		 * Spansion (3 bytes) and Micron (2 bytes)
-		 */
-		if( (CurrInst->OpCode == XQSPIPS_FLASH_OPCODE_WRSR) &&
-			(ByteCount == 3) ) {
-			CurrInst->InstSize = 3;
-			CurrInst->TxOffset = XQSPIPS_TXD_11_OFFSET;
-		}
-	}
-
-	/*
-	 * If instruction not present in table
-	 */
-	if (Index == ARRAY_SIZE(FlashInst)) {
-		/*
-		 * Assign current instruction, size and TXD register to be used.
-		 * The InstSize mentioned in case of instructions greater than 4 bytes
-		 * is not the actual size, but is indicative of the TXD register used.
-		 * The remaining bytes of the instruction will be transmitted
-		 * through TXD0 below.
-		 */
-		switch(ByteCount%4)
-		{
-			case XQSPIPS_SIZE_ONE:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_ONE;
-				CurrInst->TxOffset = XQSPIPS_TXD_01_OFFSET;
-				if(ByteCount > 4) {
-					SwitchFlag = 1;
-				}
-				break;
-			case XQSPIPS_SIZE_TWO:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_TWO;
-				CurrInst->TxOffset = XQSPIPS_TXD_10_OFFSET;
-				if(ByteCount > 4) {
-					SwitchFlag = 1;
-				}
-				break;
-			case XQSPIPS_SIZE_THREE:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_THREE;
-				CurrInst->TxOffset = XQSPIPS_TXD_11_OFFSET;
-				if(ByteCount > 4) {
-					SwitchFlag = 1;
-				}
-				break;
-			default:
-				CurrInst->OpCode = Instruction;
-				CurrInst->InstSize = XQSPIPS_SIZE_FOUR;
-				CurrInst->TxOffset = XQSPIPS_TXD_00_OFFSET;
-				break;
-		}
-	}
-
 	/*
 	 * If the instruction size in not 4 bytes then the data received needs
 	 * to be shifted
@@ -871,8 +774,7 @@ int XQspiPs_PolledTransfer(XQspiPs *InstancePtr, u8 *SendBufPtr,
 	 * If switching from TXD1/2/3 to TXD0, then start transfer and
 	 * check for FIFO empty
 	 */
-	if(SwitchFlag == 1) {
-		SwitchFlag = 0;
+	if(CurrInst->SwitchFlag == 1) {
 		/*
 		 * If, in Manual Start mode, start the transfer.
 		 */
@@ -1045,6 +947,188 @@ int XQspiPs_PolledTransfer(XQspiPs *InstancePtr, u8 *SendBufPtr,
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+*
+* Prepares a command template for repeated transfers of one instruction with
+* a fixed length. The instruction format is decoded and the Configuration
+* register values for the slave select and manual start are computed once,
+* so XQspiPs_CmdTransfer() and XQspiPs_CmdPolledTransfer() skip the
+* instruction lookup and the read-modify-write of the Configuration
+* register.
+*
+* @param	InstancePtr is a pointer to the XQspiPs instance.
+* @param	CmdPtr is the template to prepare.
+* @param	OpCode is the flash instruction.
+* @param	ByteCount is the number of bytes of each transfer, including
+*		instruction, address and dummy bytes.
+*
+* @return	XST_SUCCESS.
+*
+* @note		The template captures the options, clock prescaler and slave
+*		select. Prepare it again after XQspiPs_SetOptions(),
+*		XQspiPs_SetClkPrescaler() or XQspiPs_SetSlaveSelect().
+*
+******************************************************************************/
+int XQspiPs_CmdPrepare(XQspiPs *InstancePtr, XQspiPs_CmdTemplate *CmdPtr,
+			u8 OpCode, unsigned ByteCount)
+{
+	u32 ConfigReg;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(CmdPtr != NULL);
+	Xil_AssertNonvoid(ByteCount > 0);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	XQspiPs_DecodeInst(OpCode, ByteCount, CmdPtr);
+
+	CmdPtr->ManualCs = XQspiPs_IsManualChipSelect(InstancePtr);
+	CmdPtr->ManualStart = XQspiPs_IsManualStart(InstancePtr);
+
+	ConfigReg = XQspiPs_ReadReg(InstancePtr->Config.BaseAddress,
+				    XQSPIPS_CR_OFFSET);
+	if (CmdPtr->ManualCs) {
+		CmdPtr->CrAssert = ConfigReg & ~XQSPIPS_CR_SSCTRL_MASK;
+		CmdPtr->CrIdle = ConfigReg | XQSPIPS_CR_SSCTRL_MASK;
+	} else {
+		CmdPtr->CrAssert = ConfigReg;
+		CmdPtr->CrIdle = ConfigReg;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Transfers data on the QSPI bus in polled mode using a command template.
+* This is a fast path for short commands such as status register reads:
+* the whole transfer is written to the TX FIFO at once, the RX FIFO
+* threshold is set to the number of entries so a single status poll detects
+* the end of the transfer, and the Configuration register is written with
+* the values of the template without reading it back.
+*
+* @param	InstancePtr is a pointer to the XQspiPs instance.
+* @param	CmdPtr is the command template, with a ByteCount of at most
+*		XQSPIPS_CMD_MAX_BYTES.
+* @param	SendBufPtr is a pointer to the data to send, starting with the
+*		instruction of the template. CmdPtr->ByteCount bytes are sent.
+* @param	RecvBufPtr is a pointer to a buffer for received data, or NULL.
+*
+* @return
+*		- XST_SUCCESS if the transfer completed.
+*		- XST_DEVICE_BUSY indicates that a data transfer is already in
+*		  progress.
+*
+* @note		This function is not thread-safe. The RX FIFO threshold is
+*		left at the size of the transfer; XQspiPs_Transfer() and
+*		XQspiPs_PolledTransfer() program their own.
+*
+******************************************************************************/
+int XQspiPs_CmdPolledTransfer(XQspiPs *InstancePtr,
+			       XQspiPs_CmdTemplate *CmdPtr,
+			       u8 *SendBufPtr, u8 *RecvBufPtr)
+{
+	u32 BaseAddress;
+	u32 StatusReg;
+	u32 Data;
+	u32 Count;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(CmdPtr != NULL);
+	Xil_AssertNonvoid(CmdPtr->ByteCount <= XQSPIPS_CMD_MAX_BYTES);
+	Xil_AssertNonvoid(SendBufPtr != NULL);
+	Xil_AssertNonvoid(*SendBufPtr == CmdPtr->OpCode);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if (InstancePtr->IsBusy) {
+		return XST_DEVICE_BUSY;
+	}
+	InstancePtr->IsBusy = TRUE;
+
+	BaseAddress = InstancePtr->Config.BaseAddress;
+	InstancePtr->RecvBufferPtr = RecvBufPtr;
+	InstancePtr->RequestedBytes = CmdPtr->ByteCount;
+	InstancePtr->ShiftReadData = (CmdPtr->InstSize != 4) ? 1 : 0;
+
+	/*
+	 * The RX FIFO reaches the threshold when the last entry of the
+	 * transfer has been received
+	 */
+	XQspiPs_WriteReg(BaseAddress, XQSPIPS_RXWR_OFFSET, CmdPtr->Words);
+
+	if (CmdPtr->ManualCs) {
+		XQspiPs_WriteReg(BaseAddress, XQSPIPS_CR_OFFSET,
+				 CmdPtr->CrAssert);
+	}
+	XQspiPs_Enable(InstancePtr);
+
+	XQspiPs_WriteReg(BaseAddress, CmdPtr->TxOffset,
+			 *((u32 *)SendBufPtr));
+	SendBufPtr += CmdPtr->InstSize;
+
+	/*
+	 * The bytes of TXD1/2/3 have to leave the FIFO before TXD0 is used
+	 */
+	if (CmdPtr->SwitchFlag) {
+		if (CmdPtr->ManualStart) {
+			XQspiPs_WriteReg(BaseAddress, XQSPIPS_CR_OFFSET,
+					 CmdPtr->CrAssert |
+					 XQSPIPS_CR_MANSTRT_MASK);
+		}
+		do {
+			StatusReg = XQspiPs_ReadReg(BaseAddress,
+						    XQSPIPS_SR_OFFSET);
+		} while ((StatusReg & XQSPIPS_IXR_TXOW_MASK) == 0);
+	}
+
+	for (Count = 1; Count < CmdPtr->Words; Count++) {
+		XQspiPs_WriteReg(BaseAddress, XQSPIPS_TXD_00_OFFSET,
+				 *((u32 *)SendBufPtr));
+		SendBufPtr += 4;
+	}
+
+	if (CmdPtr->ManualStart) {
+		XQspiPs_WriteReg(BaseAddress, XQSPIPS_CR_OFFSET,
+				 CmdPtr->CrAssert | XQSPIPS_CR_MANSTRT_MASK);
+	}
+
+	do {
+		StatusReg = XQspiPs_ReadReg(BaseAddress, XQSPIPS_SR_OFFSET);
+	} while ((StatusReg & XQSPIPS_IXR_RXNEMPTY_MASK) == 0);
+
+	/*
+	 * Drain every entry, keeping the bytes the same way
+	 * XQspiPs_PolledTransfer() does
+	 */
+	for (Count = 0; Count < CmdPtr->Words; Count++) {
+		Data = XQspiPs_ReadReg(BaseAddress, XQSPIPS_RXD_OFFSET);
+		if ((InstancePtr->RequestedBytes <= 0) ||
+		    (InstancePtr->RecvBufferPtr == NULL)) {
+			continue;
+		}
+		if (InstancePtr->RequestedBytes < 4) {
+			XQspiPs_GetReadData(InstancePtr, Data,
+					    InstancePtr->RequestedBytes);
+		} else {
+			*((u32 *)InstancePtr->RecvBufferPtr) = Data;
+			InstancePtr->RecvBufferPtr += 4;
+			InstancePtr->RequestedBytes -= 4;
+		}
+	}
+	InstancePtr->RequestedBytes = 0;
+
+	if (CmdPtr->ManualCs) {
+		XQspiPs_WriteReg(BaseAddress, XQSPIPS_CR_OFFSET,
+				 CmdPtr->CrIdle);
+	}
+
+	InstancePtr->IsBusy = FALSE;
+	XQspiPs_Disable(InstancePtr);
+
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1499,6 +1583,89 @@ void XQspiPs_InterruptHandler(void *InstancePtr)
 }
 
 
+/*****************************************************************************/
+/**
+*
+* Decodes the format of an instruction: the size of the first FIFO entry and
+* the TXD register it is written to. Instructions that are not in the
+* instruction table are sized from the byte count.
+*
+* @param	Instruction is the flash instruction.
+* @param	ByteCount is the number of bytes of the transfer.
+* @param	CmdPtr is the template receiving the format.
+*
+* @return	None.
+*
+* @note		The WRSR size override for Spansion devices applies to this
+*		transfer only and does not modify the instruction table.
+*
+******************************************************************************/
+static void XQspiPs_DecodeInst(u8 Instruction, unsigned ByteCount,
+			       XQspiPs_CmdTemplate *CmdPtr)
+{
+	unsigned int Index;
+
+	CmdPtr->OpCode = Instruction;
+	CmdPtr->ByteCount = ByteCount;
+	CmdPtr->SwitchFlag = 0;
+
+	for (Index = 0 ; Index < ARRAY_SIZE(FlashInst); Index++) {
+		if (Instruction == FlashInst[Index].OpCode) {
+			break;
+		}
+	}
+
+	if (Index < ARRAY_SIZE(FlashInst)) {
+		CmdPtr->InstSize = FlashInst[Index].InstSize;
+		CmdPtr->TxOffset = FlashInst[Index].TxOffset;
+		/*
+		 * Check for WRSR instruction which has different size for
+		 * Spansion (3 bytes) and Micron (2 bytes)
+		 */
+		if ((Instruction == XQSPIPS_FLASH_OPCODE_WRSR) &&
+		    (ByteCount == 3)) {
+			CmdPtr->InstSize = 3;
+			CmdPtr->TxOffset = XQSPIPS_TXD_11_OFFSET;
+		}
+	} else {
+		/*
+		 * Assign size and TXD register to be used. The InstSize
+		 * mentioned in case of instructions greater than 4 bytes is
+		 * not the actual size, but is indicative of the TXD register
+		 * used. The remaining bytes of the instruction will be
+		 * transmitted through TXD0.
+		 */
+		switch (ByteCount % 4) {
+		case XQSPIPS_SIZE_ONE:
+			CmdPtr->InstSize = XQSPIPS_SIZE_ONE;
+			CmdPtr->TxOffset = XQSPIPS_TXD_01_OFFSET;
+			break;
+		case XQSPIPS_SIZE_TWO:
+			CmdPtr->InstSize = XQSPIPS_SIZE_TWO;
+			CmdPtr->TxOffset = XQSPIPS_TXD_10_OFFSET;
+			break;
+		case XQSPIPS_SIZE_THREE:
+			CmdPtr->InstSize = XQSPIPS_SIZE_THREE;
+			CmdPtr->TxOffset = XQSPIPS_TXD_11_OFFSET;
+			break;
+		default:
+			CmdPtr->InstSize = XQSPIPS_SIZE_FOUR;
+			CmdPtr->TxOffset = XQSPIPS_TXD_00_OFFSET;
+			break;
+		}
+		if ((CmdPtr->InstSize != XQSPIPS_SIZE_FOUR) &&
+		    (ByteCount > 4)) {
+			CmdPtr->SwitchFlag = 1;
+		}
+	}
+
+	/* The first entry plus the remaining bytes in whole words */
+	CmdPtr->Words = 1;
+	if (ByteCount > CmdPtr->InstSize) {
+		CmdPtr->Words += (ByteCount - CmdPtr->InstSize + 3) / 4;
+	}
+}
+
 /*****************************************************************************/
 /**
 *
@@ -271,6 +271,21 @@
 * 3.2	sk	02/05/15 Add SLCR reset in abort function as a workaround because
 * 					 controller does not update FIFO status flags as expected
 * 					 when thresholds are used.
+* 3.2   ag  10/18/26 Added DMA backed asynchronous linear reads with
+*                    optional read-ahead, see xqspips_lqdma.h.
+*                    Added flash device layer with queued interrupt driven
+*                    program/erase, timer driven status polling and erase
+*                    suspend for reads, see xqspips_flash.h.
+*                    Added XQspiPs_SetConnectionMode()/XQspiPs_SelectPage()
+*                    and dual parallel/stacked support in the flash layer
+*                    and linear DMA reads.
+*                    Added XQspiPs_XipInit() and the XIP section macros for
+*                    execute in place from the linear window.
+*                    Added the log structured record store, see
+*                    xqspips_log.h.
+*                    Added command templates, XQspiPs_CmdPrepare(),
+*                    XQspiPs_CmdTransfer() and XQspiPs_CmdPolledTransfer(),
+*                    which skip the instruction lookup of each transfer.
 *
 * </pre>
 *
@@ -447,6 +462,17 @@ extern "C" {
 
 /*@}*/
 
+/** @name Command template
+ *
+ * Largest transfer of XQspiPs_CmdPolledTransfer(), which must fit the
+ * FIFOs. The instruction word counts as one FIFO entry.
+ *
+ * @{
+ */
+#define XQSPIPS_CMD_MAX_BYTES	((XQSPIPS_FIFO_DEPTH - 1) * 4)
+
+/*@}*/
+
 /** @name FIFO threshold value
  *
  * This is the Rx FIFO threshold (in words) that was found to be most
@@ -513,6 +539,26 @@ typedef struct {
 				   */
 } XQspiPs;
 
+/**
+ * A pre-decoded command, prepared once with XQspiPs_CmdPrepare() and used
+ * for any number of transfers of the same instruction and length. It holds
+ * the instruction format that XQspiPs_Transfer() otherwise looks up for
+ * every call, and the Configuration register values for asserting the
+ * slave select and starting the transfer.
+ */
+typedef struct {
+	u8 OpCode;		/**< Instruction */
+	u8 InstSize;		/**< Bytes written through TxOffset */
+	u8 TxOffset;		/**< TXD register of the first word */
+	u8 SwitchFlag;		/**< First word must be sent alone */
+	unsigned ByteCount;	/**< Bytes of every transfer */
+	u32 Words;		/**< FIFO entries of the transfer */
+	u32 ManualCs;		/**< Slave select under manual control */
+	u32 ManualStart;	/**< Manual start mode */
+	u32 CrAssert;		/**< Configuration, slave select asserted */
+	u32 CrIdle;		/**< Configuration, slave select released */
+} XQspiPs_CmdTemplate;
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /****************************************************************************/
@@ -754,6 +800,13 @@ int XQspiPs_Transfer(XQspiPs *InstancePtr, u8 *SendBufPtr, u8 *RecvBufPtr,
 		      unsigned ByteCount);
 int XQspiPs_PolledTransfer(XQspiPs *InstancePtr, u8 *SendBufPtr,
 			    u8 *RecvBufPtr, unsigned ByteCount);
+int XQspiPs_CmdPrepare(XQspiPs *InstancePtr, XQspiPs_CmdTemplate *CmdPtr,
+			u8 OpCode, unsigned ByteCount);
+int XQspiPs_CmdTransfer(XQspiPs *InstancePtr, XQspiPs_CmdTemplate *CmdPtr,
+			 u8 *SendBufPtr, u8 *RecvBufPtr);
+int XQspiPs_CmdPolledTransfer(XQspiPs *InstancePtr,
+			       XQspiPs_CmdTemplate *CmdPtr,
+			       u8 *SendBufPtr, u8 *RecvBufPtr);
 int XQspiPs_LqspiRead(XQspiPs *InstancePtr, u8 *RecvBufPtr,
 			u32 Address, unsigned ByteCount);
 
@@ -781,6 +834,9 @@ int XQspiPs_SetDelays(XQspiPs *InstancePtr, u8 DelayNss, u8 DelayBtwn,
 			 u8 DelayAfter, u8 DelayInit);
 void XQspiPs_GetDelays(XQspiPs *InstancePtr, u8 *DelayNss, u8 *DelayBtwn,
 			 u8 *DelayAfter, u8 *DelayInit);
+
+void XQspiPs_SetConnectionMode(XQspiPs *InstancePtr);
+void XQspiPs_SelectPage(XQspiPs *InstancePtr, u32 Upper);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,716 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_flash.c
+* @addtogroup qspips_v3_2
+* @{
+*
+* Contains the flash device layer of the XQspiPs driver. See
+* xqspips_flash.h for an overview.
+*
+* An operation moves through the states below. Transfers are started from
+* XQspiPs_FlashStep() only while no read holds the bus; a transfer that
+* completes while a read is waiting just advances the state, and the read
+* restarts the sequence when it releases the bus.
+*
+*	IDLE -> WREN_SENT -> CMD_PENDING -> CMD_SENT -> BUSY <-> POLL_SENT
+*	                                                          |
+*	IDLE <----------------------- completion <----------------'
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+*                    Added dual parallel and dual stacked connections.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xqspips_flash.h"
+#include "xil_exception.h"
+
+/************************** Constant Definitions *****************************/
+
+/*
+ * States of the operation at the tail of the queue
+ */
+#define XQSPIPS_FLASH_STATE_IDLE	0	/* No operation running */
+#define XQSPIPS_FLASH_STATE_WREN_SENT	1	/* Write enable in flight */
+#define XQSPIPS_FLASH_STATE_CMD_PENDING	2	/* Program/erase to be sent */
+#define XQSPIPS_FLASH_STATE_CMD_SENT	3	/* Program/erase in flight */
+#define XQSPIPS_FLASH_STATE_BUSY	4	/* Device busy, tick polls */
+#define XQSPIPS_FLASH_STATE_POLL_SENT	5	/* Status read in flight */
+
+#define XQSPIPS_FLASH_DEF_PROGRAM_TICKS	1	/* Default program poll interval */
+#define XQSPIPS_FLASH_DEF_ERASE_TICKS	10	/* Default erase poll interval */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+static void XQspiPs_FlashStep(XQspiPs_Flash *FlashPtr);
+static void XQspiPs_FlashComplete(XQspiPs_Flash *FlashPtr, int Status);
+static void XQspiPs_FlashQspiDone(void *CallBackRef, u32 StatusEvent,
+				  unsigned ByteCount);
+static int XQspiPs_FlashWaitReady(XQspiPs_Flash *FlashPtr);
+static u32 XQspiPs_FlashMapAddress(XQspiPs_Flash *FlashPtr, u32 Address);
+static u32 XQspiPs_FlashIsBusy(XQspiPs_Flash *FlashPtr, u8 *StatusPtr);
+static void StubFlashHandler(void *CallBackRef, XQspiPs_FlashOp *OpPtr,
+			     int Status);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* Initializes the flash device layer and installs its status handler on the
+* QSPI instance. The dual memory bits of the controller are programmed from
+* the ConnectionMode of the QSPI instance.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	QspiPtr is a pointer to an initialized XQspiPs instance in I/O
+*		mode.
+*
+* @return	XST_SUCCESS.
+*
+* @note		The status poll intervals default to 1 tick for page
+*		program and 10 ticks for erase.
+*
+******************************************************************************/
+int XQspiPs_FlashInitialize(XQspiPs_Flash *FlashPtr, XQspiPs *QspiPtr)
+{
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(QspiPtr != NULL);
+	Xil_AssertNonvoid(QspiPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	memset(FlashPtr, 0, sizeof(XQspiPs_Flash));
+
+	FlashPtr->QspiPtr = QspiPtr;
+	FlashPtr->ConnectionMode = QspiPtr->Config.ConnectionMode;
+	FlashPtr->PageSize = (FlashPtr->ConnectionMode ==
+			      XQSPIPS_CONNECTION_MODE_PARALLEL) ?
+			     XQSPIPS_FLASH_MAX_PAGE_SIZE :
+			     XQSPIPS_FLASH_PAGE_SIZE;
+	FlashPtr->DeviceSize = XQSPIPS_FLASH_DEF_DEVICE_SIZE;
+	FlashPtr->State = XQSPIPS_FLASH_STATE_IDLE;
+	FlashPtr->ProgramPollTicks = XQSPIPS_FLASH_DEF_PROGRAM_TICKS;
+	FlashPtr->ErasePollTicks = XQSPIPS_FLASH_DEF_ERASE_TICKS;
+	FlashPtr->Handler = StubFlashHandler;
+
+	XQspiPs_SetConnectionMode(QspiPtr);
+	XQspiPs_SetStatusHandler(QspiPtr, FlashPtr, XQspiPs_FlashQspiDone);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the callback invoked when a queued operation completes.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	FuncPtr is the pointer to the callback function.
+* @param	CallBackRef is the upper layer callback reference passed back
+*		when the callback function is invoked.
+*
+* @return	None.
+*
+* @note		The callback may submit further operations.
+*
+******************************************************************************/
+void XQspiPs_FlashSetHandler(XQspiPs_Flash *FlashPtr,
+			     XQspiPs_FlashHandler FuncPtr, void *CallBackRef)
+{
+	Xil_AssertVoid(FlashPtr != NULL);
+	Xil_AssertVoid(FuncPtr != NULL);
+
+	FlashPtr->Handler = FuncPtr;
+	FlashPtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets how many calls of XQspiPs_FlashTick() pass between two status reads
+* while a page program or an erase is running. The intervals should be
+* chosen from the tick period and the typical program and erase times of
+* the device, e.g. a 100 us tick with 5 for page program and 100 for a
+* 64 KB sector erase.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	ProgramTicks is the poll interval while programming.
+* @param	EraseTicks is the poll interval while erasing.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XQspiPs_FlashSetPollInterval(XQspiPs_Flash *FlashPtr,
+				  u32 ProgramTicks, u32 EraseTicks)
+{
+	Xil_AssertVoid(FlashPtr != NULL);
+	Xil_AssertVoid(ProgramTicks > 0);
+	Xil_AssertVoid(EraseTicks > 0);
+
+	FlashPtr->ProgramPollTicks = ProgramTicks;
+	FlashPtr->ErasePollTicks = EraseTicks;
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the size of one flash device. In dual stacked mode addresses from
+* DeviceSize upwards go to the upper device.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	DeviceSize is the size of one device in bytes.
+*
+* @return	None.
+*
+* @note		Only used in dual stacked mode. Must not be called while
+*		operations are queued.
+*
+******************************************************************************/
+void XQspiPs_FlashSetDeviceSize(XQspiPs_Flash *FlashPtr, u32 DeviceSize)
+{
+	Xil_AssertVoid(FlashPtr != NULL);
+	Xil_AssertVoid(DeviceSize > 0);
+
+	FlashPtr->DeviceSize = DeviceSize;
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues a page program or erase operation. The operation is started right
+* away if the queue was empty.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	OpPtr is the operation, which is copied into the queue. The
+*		data it points to is not, see XQspiPs_FlashOp.
+*
+* @return
+*		- XST_SUCCESS if the operation was queued.
+*		- XST_DEVICE_BUSY if the queue is full.
+*
+* @note		None.
+*
+******************************************************************************/
+int XQspiPs_FlashSubmit(XQspiPs_Flash *FlashPtr, XQspiPs_FlashOp *OpPtr)
+{
+	u32 CpsrVal;
+	int Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(OpPtr != NULL);
+	Xil_AssertNonvoid(OpPtr->Type <= XQSPIPS_FLASH_OP_ERASE_4K);
+	Xil_AssertNonvoid((OpPtr->Type != XQSPIPS_FLASH_OP_PROGRAM) ||
+		((OpPtr->BufPtr != NULL) && (OpPtr->ByteCount > 0) &&
+		 ((OpPtr->Address % FlashPtr->PageSize) +
+		  OpPtr->ByteCount <= FlashPtr->PageSize)));
+	Xil_AssertNonvoid((FlashPtr->ConnectionMode !=
+			   XQSPIPS_CONNECTION_MODE_PARALLEL) ||
+		(OpPtr->Type != XQSPIPS_FLASH_OP_PROGRAM) ||
+		(((OpPtr->Address | OpPtr->ByteCount) & 1) == 0));
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+
+	if ((FlashPtr->Head - FlashPtr->Tail) >= XQSPIPS_FLASH_QUEUE_LEN) {
+		Status = XST_DEVICE_BUSY;
+	} else {
+		FlashPtr->Queue[FlashPtr->Head &
+				(XQSPIPS_FLASH_QUEUE_LEN - 1)] = *OpPtr;
+		FlashPtr->Head++;
+
+		if (FlashPtr->State == XQSPIPS_FLASH_STATE_IDLE) {
+			XQspiPs_FlashStep(FlashPtr);
+		}
+	}
+
+	mtcpsr(CpsrVal);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads from flash with polled transfers while background operations are
+* held off. A running erase is suspended for the duration of the read and
+* a running page program is allowed to finish first.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	Address is the flash address to read from.
+* @param	BufPtr is the buffer the data is read to.
+* @param	ByteCount is the number of bytes to read.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if a transfer failed.
+*
+* @note		Must be called from task context, not from an interrupt
+*		handler.
+*
+******************************************************************************/
+int XQspiPs_FlashRead(XQspiPs_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+		      unsigned ByteCount)
+{
+	XQspiPs_FlashOp *OpPtr;
+	u32 CpsrVal;
+	u32 Suspended = FALSE;
+	u32 DevAddress;
+	unsigned Chunk;
+	int Status = XST_SUCCESS;
+
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+	Xil_AssertNonvoid((FlashPtr->ConnectionMode !=
+			   XQSPIPS_CONNECTION_MODE_PARALLEL) ||
+			  (((Address | ByteCount) & 1) == 0));
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+	FlashPtr->Hold = TRUE;
+	mtcpsr(CpsrVal);
+
+	/*
+	 * A command or status read already in flight is only a few bytes
+	 * long; once it is done nothing else is started until the hold is
+	 * released.
+	 */
+	while (FlashPtr->QspiPtr->IsBusy) {
+		/* Wait for the transfer to finish */
+	}
+
+	OpPtr = &FlashPtr->Queue[FlashPtr->Tail & (XQSPIPS_FLASH_QUEUE_LEN - 1)];
+
+	if (FlashPtr->State == XQSPIPS_FLASH_STATE_BUSY) {
+		/* The device of the running operation is still selected */
+		if (OpPtr->Type != XQSPIPS_FLASH_OP_PROGRAM) {
+			FlashPtr->CmdBuf[0] = XQSPIPS_FLASH_OPCODE_ERASE_SUS;
+			Status = XQspiPs_PolledTransfer(FlashPtr->QspiPtr,
+							FlashPtr->CmdBuf,
+							NULL, 1);
+			Suspended = (Status == XST_SUCCESS);
+			FlashPtr->Suspends++;
+		}
+		if (Status == XST_SUCCESS) {
+			Status = XQspiPs_FlashWaitReady(FlashPtr);
+		}
+	}
+
+	while ((Status == XST_SUCCESS) && (ByteCount > 0)) {
+		Chunk = (ByteCount > XQSPIPS_FLASH_READ_CHUNK) ?
+			XQSPIPS_FLASH_READ_CHUNK : ByteCount;
+
+		/* A chunk must not span the two stacked devices */
+		if ((FlashPtr->ConnectionMode ==
+		     XQSPIPS_CONNECTION_MODE_STACKED) &&
+		    (Address < FlashPtr->DeviceSize) &&
+		    (Chunk > (FlashPtr->DeviceSize - Address))) {
+			Chunk = FlashPtr->DeviceSize - Address;
+		}
+
+		DevAddress = XQspiPs_FlashMapAddress(FlashPtr, Address);
+		FlashPtr->ReadBuf[0] = XQSPIPS_FLASH_OPCODE_FAST_READ;
+		FlashPtr->ReadBuf[1] = (u8)(DevAddress >> 16);
+		FlashPtr->ReadBuf[2] = (u8)(DevAddress >> 8);
+		FlashPtr->ReadBuf[3] = (u8)DevAddress;
+
+		Status = XQspiPs_PolledTransfer(FlashPtr->QspiPtr,
+				FlashPtr->ReadBuf, FlashPtr->ReadBuf,
+				XQSPIPS_FLASH_CMD_SIZE +
+				XQSPIPS_FLASH_DUMMY_SIZE + Chunk);
+
+		memcpy(BufPtr, &FlashPtr->ReadBuf[XQSPIPS_FLASH_CMD_SIZE +
+			XQSPIPS_FLASH_DUMMY_SIZE], Chunk);
+
+		BufPtr += Chunk;
+		Address += Chunk;
+		ByteCount -= Chunk;
+	}
+
+	/* Give the device back to the queued operation */
+	if (FlashPtr->Head != FlashPtr->Tail) {
+		(void)XQspiPs_FlashMapAddress(FlashPtr, OpPtr->Address);
+	}
+
+	if (Suspended) {
+		FlashPtr->CmdBuf[0] = XQSPIPS_FLASH_OPCODE_ERASE_RES;
+		if (XQspiPs_PolledTransfer(FlashPtr->QspiPtr, FlashPtr->CmdBuf,
+					   NULL, 1) != XST_SUCCESS) {
+			Status = XST_FAILURE;
+		}
+	}
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+	FlashPtr->Hold = FALSE;
+	XQspiPs_FlashStep(FlashPtr);
+	mtcpsr(CpsrVal);
+
+	return (Status == XST_SUCCESS) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Drives the status polling of a running program or erase operation. The
+* application calls this function from a periodic timer interrupt; every
+* poll interval ticks a status register read is started, and the operation
+* completes from the QSPI interrupt once the device is no longer busy.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+*
+* @return	None.
+*
+* @note		The timer interrupt must not preempt the QSPI interrupt or
+*		vice versa.
+*
+******************************************************************************/
+void XQspiPs_FlashTick(XQspiPs_Flash *FlashPtr)
+{
+	Xil_AssertVoid(FlashPtr != NULL);
+
+	if ((FlashPtr->State != XQSPIPS_FLASH_STATE_BUSY) || FlashPtr->Hold) {
+		return;
+	}
+
+	if (FlashPtr->PollTicks > 1) {
+		FlashPtr->PollTicks--;
+		return;
+	}
+
+	FlashPtr->State = XQSPIPS_FLASH_STATE_POLL_SENT;
+	FlashPtr->StatusBuf[0] = XQSPIPS_FLASH_OPCODE_RDSR1;
+	FlashPtr->Polls++;
+
+	/* In dual parallel mode a status byte is returned per device */
+	if (XQspiPs_Transfer(FlashPtr->QspiPtr, FlashPtr->StatusBuf,
+			     FlashPtr->StatusBuf,
+			     (FlashPtr->ConnectionMode ==
+			      XQSPIPS_CONNECTION_MODE_PARALLEL) ? 3 : 2) !=
+			XST_SUCCESS) {
+		/* Try again on the next tick */
+		FlashPtr->State = XQSPIPS_FLASH_STATE_BUSY;
+		FlashPtr->PollTicks = 1;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Starts the next transfer the current state asks for, unless a read holds
+* the bus. Called with interrupts masked or from interrupt context.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_FlashStep(XQspiPs_Flash *FlashPtr)
+{
+	XQspiPs_FlashOp *OpPtr;
+	unsigned Count = XQSPIPS_FLASH_CMD_SIZE;
+	u32 DevAddress;
+	int Status;
+
+	if (FlashPtr->Hold) {
+		return;
+	}
+
+	OpPtr = &FlashPtr->Queue[FlashPtr->Tail & (XQSPIPS_FLASH_QUEUE_LEN - 1)];
+
+	switch (FlashPtr->State) {
+	case XQSPIPS_FLASH_STATE_IDLE:
+		if (FlashPtr->Head == FlashPtr->Tail) {
+			return;
+		}
+		/* Select the device the write enable is meant for */
+		(void)XQspiPs_FlashMapAddress(FlashPtr, OpPtr->Address);
+		FlashPtr->CmdBuf[0] = XQSPIPS_FLASH_OPCODE_WREN;
+		FlashPtr->State = XQSPIPS_FLASH_STATE_WREN_SENT;
+		Status = XQspiPs_Transfer(FlashPtr->QspiPtr, FlashPtr->CmdBuf,
+					  NULL, 1);
+		break;
+
+	case XQSPIPS_FLASH_STATE_CMD_PENDING:
+		DevAddress = XQspiPs_FlashMapAddress(FlashPtr, OpPtr->Address);
+		if (OpPtr->Type == XQSPIPS_FLASH_OP_PROGRAM) {
+			FlashPtr->CmdBuf[0] = XQSPIPS_FLASH_OPCODE_PP;
+			memcpy(&FlashPtr->CmdBuf[XQSPIPS_FLASH_CMD_SIZE],
+			       OpPtr->BufPtr, OpPtr->ByteCount);
+			Count += OpPtr->ByteCount;
+		} else if (OpPtr->Type == XQSPIPS_FLASH_OP_ERASE_SECTOR) {
+			FlashPtr->CmdBuf[0] = XQSPIPS_FLASH_OPCODE_SE;
+		} else {
+			FlashPtr->CmdBuf[0] = XQSPIPS_FLASH_OPCODE_BE_4K;
+		}
+		FlashPtr->CmdBuf[1] = (u8)(DevAddress >> 16);
+		FlashPtr->CmdBuf[2] = (u8)(DevAddress >> 8);
+		FlashPtr->CmdBuf[3] = (u8)DevAddress;
+
+		FlashPtr->State = XQSPIPS_FLASH_STATE_CMD_SENT;
+		Status = XQspiPs_Transfer(FlashPtr->QspiPtr, FlashPtr->CmdBuf,
+					  NULL, Count);
+		break;
+
+	default:
+		/* A transfer is in flight or the tick polls the status */
+		return;
+	}
+
+	if (Status != XST_SUCCESS) {
+		XQspiPs_FlashComplete(FlashPtr, XST_FAILURE);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Removes the current operation from the queue, reports it and starts the
+* next one.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	Status is the result of the operation.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_FlashComplete(XQspiPs_Flash *FlashPtr, int Status)
+{
+	XQspiPs_FlashOp Op;
+
+	Op = FlashPtr->Queue[FlashPtr->Tail & (XQSPIPS_FLASH_QUEUE_LEN - 1)];
+	FlashPtr->Tail++;
+	FlashPtr->State = XQSPIPS_FLASH_STATE_IDLE;
+
+	FlashPtr->Handler(FlashPtr->CallBackRef, &Op, Status);
+
+	XQspiPs_FlashStep(FlashPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* QSPI status handler of the flash layer. Advances the current operation
+* when one of its transfers completes.
+*
+* @param	CallBackRef is the XQspiPs_Flash instance.
+* @param	StatusEvent is the QSPI status event.
+* @param	ByteCount is the number of bytes transferred.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_FlashQspiDone(void *CallBackRef, u32 StatusEvent,
+				  unsigned ByteCount)
+{
+	XQspiPs_Flash *FlashPtr = (XQspiPs_Flash *)CallBackRef;
+	XQspiPs_FlashOp *OpPtr;
+
+	(void)ByteCount;
+
+	OpPtr = &FlashPtr->Queue[FlashPtr->Tail & (XQSPIPS_FLASH_QUEUE_LEN - 1)];
+
+	switch (FlashPtr->State) {
+	case XQSPIPS_FLASH_STATE_WREN_SENT:
+		if (StatusEvent != XST_SPI_TRANSFER_DONE) {
+			XQspiPs_FlashComplete(FlashPtr, XST_FAILURE);
+			return;
+		}
+		FlashPtr->State = XQSPIPS_FLASH_STATE_CMD_PENDING;
+		break;
+
+	case XQSPIPS_FLASH_STATE_CMD_SENT:
+		if (StatusEvent != XST_SPI_TRANSFER_DONE) {
+			XQspiPs_FlashComplete(FlashPtr, XST_FAILURE);
+			return;
+		}
+		FlashPtr->State = XQSPIPS_FLASH_STATE_BUSY;
+		FlashPtr->PollTicks =
+			(OpPtr->Type == XQSPIPS_FLASH_OP_PROGRAM) ?
+			FlashPtr->ProgramPollTicks : FlashPtr->ErasePollTicks;
+		break;
+
+	case XQSPIPS_FLASH_STATE_POLL_SENT:
+		if ((StatusEvent == XST_SPI_TRANSFER_DONE) &&
+		    !XQspiPs_FlashIsBusy(FlashPtr, FlashPtr->StatusBuf)) {
+			XQspiPs_FlashComplete(FlashPtr, XST_SUCCESS);
+			return;
+		}
+		FlashPtr->State = XQSPIPS_FLASH_STATE_BUSY;
+		FlashPtr->PollTicks =
+			(OpPtr->Type == XQSPIPS_FLASH_OP_PROGRAM) ?
+			FlashPtr->ProgramPollTicks : FlashPtr->ErasePollTicks;
+		break;
+
+	default:
+		/* Not a transfer of the flash layer */
+		return;
+	}
+
+	XQspiPs_FlashStep(FlashPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Polls the status register with polled transfers until the device is no
+* longer busy. Used by XQspiPs_FlashRead() while it holds the bus.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+*
+* @return	XST_SUCCESS if the device is ready, XST_FAILURE if a transfer
+*		failed.
+*
+* @note		None.
+*
+******************************************************************************/
+static int XQspiPs_FlashWaitReady(XQspiPs_Flash *FlashPtr)
+{
+	u8 Status[3];
+	unsigned Count;
+
+	Count = (FlashPtr->ConnectionMode == XQSPIPS_CONNECTION_MODE_PARALLEL) ?
+		3 : 2;
+
+	do {
+		Status[0] = XQSPIPS_FLASH_OPCODE_RDSR1;
+		if (XQspiPs_PolledTransfer(FlashPtr->QspiPtr, Status, Status,
+					   Count) != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	} while (XQspiPs_FlashIsBusy(FlashPtr, Status));
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks the write-in-progress bit of a status register read. In dual
+* parallel mode the device is busy while either of the two is busy.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	StatusPtr is the receive buffer of the RDSR transfer.
+*
+* @return	TRUE if a program or erase is in progress, FALSE otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XQspiPs_FlashIsBusy(XQspiPs_Flash *FlashPtr, u8 *StatusPtr)
+{
+	u8 Status = StatusPtr[1];
+
+	if (FlashPtr->ConnectionMode == XQSPIPS_CONNECTION_MODE_PARALLEL) {
+		Status |= StatusPtr[2];
+	}
+
+	return (Status & XQSPIPS_FLASH_SR_WIP_MASK) ? TRUE : FALSE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Translates a flash address as seen by the user into the address sent to
+* the device. In dual parallel mode each device holds every other byte, so
+* the address is halved. In dual stacked mode the device holding the
+* address is selected and the address made relative to it.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+* @param	Address is the flash address.
+*
+* @return	The address to send with the command.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XQspiPs_FlashMapAddress(XQspiPs_Flash *FlashPtr, u32 Address)
+{
+	u32 DevAddress = Address;
+
+	if (FlashPtr->ConnectionMode == XQSPIPS_CONNECTION_MODE_PARALLEL) {
+		DevAddress = Address / 2;
+	} else if (FlashPtr->ConnectionMode ==
+			XQSPIPS_CONNECTION_MODE_STACKED) {
+		if (Address >= FlashPtr->DeviceSize) {
+			XQspiPs_SelectPage(FlashPtr->QspiPtr, TRUE);
+			DevAddress = Address - FlashPtr->DeviceSize;
+		} else {
+			XQspiPs_SelectPage(FlashPtr->QspiPtr, FALSE);
+		}
+	}
+
+	return DevAddress;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is a stub for the completion callback. The stub is here in case the
+* upper layers do not set the handler.
+*
+* @param	CallBackRef is a pointer to the upper layer callback reference
+* @param	OpPtr is the completed operation
+* @param	Status is the result of the operation
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void StubFlashHandler(void *CallBackRef, XQspiPs_FlashOp *OpPtr,
+			     int Status)
+{
+	(void) CallBackRef;
+	(void) OpPtr;
+	(void) Status;
+}
+/** @} */
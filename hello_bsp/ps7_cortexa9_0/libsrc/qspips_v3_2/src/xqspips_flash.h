@@ -0,0 +1,218 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_flash.h
+* @addtogroup qspips_v3_2
+* @{
+*
+* This header file contains the interface of the flash device layer of the
+* XQspiPs driver, which runs page program and sector erase operations in the
+* background while keeping flash reads low latency.
+*
+* Program and erase operations are queued with XQspiPs_FlashSubmit(). Each
+* operation is sent as WREN followed by the program or erase command using
+* interrupt driven XQspiPs_Transfer() calls chained from the QSPI status
+* handler. The busy wait for the write-in-progress bit is replaced by a
+* status register read issued from XQspiPs_FlashTick(), which the
+* application calls from a periodic timer interrupt. The completion of each
+* operation is reported through a callback.
+*
+* XQspiPs_FlashRead() may be called from task context at any time. It holds
+* off the queue, suspends a running erase with ERASE_SUS, reads with polled
+* transfers, and resumes the erase with ERASE_RES, so a read waits for at
+* most a status register read, the erase suspend latency of the device or
+* the end of a running page program.
+*
+* The layer installs its own status handler on the XQspiPs instance. The
+* application configures the instance for I/O mode (linear mode off), sets
+* the slave select and connects XQspiPs_InterruptHandler() to the
+* interrupt controller. Addresses are 24 bits per device, so a bank of up
+* to 16 MB per device is supported. The sector being erased must not be
+* read while the erase is suspended.
+*
+* Dual flash connections follow the ConnectionMode of the QSPI instance:
+*	- Dual parallel: the controller stripes data bytes across both
+*	  devices. Flash addresses are halved, a program page is 512 bytes,
+*	  an erase covers the sector of both devices (e.g. 128 KB for SE)
+*	  and the status of both devices is combined. Addresses and lengths
+*	  of program operations and reads must be even.
+*	- Dual stacked: addresses at or above the device size set with
+*	  XQspiPs_FlashSetDeviceSize() go to the upper device, which is
+*	  selected through the upper page bit before each operation or read.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XQSPIPS_FLASH_H		/* prevent circular inclusions */
+#define XQSPIPS_FLASH_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xqspips.h"
+
+/************************** Constant Definitions *****************************/
+
+/** @name Flash layer parameters
+ * @{
+ */
+#define XQSPIPS_FLASH_QUEUE_LEN		16	/**< Queued operations, power
+						  *  of 2 */
+#define XQSPIPS_FLASH_PAGE_SIZE		256	/**< Device program page size */
+#define XQSPIPS_FLASH_MAX_PAGE_SIZE	(2 * XQSPIPS_FLASH_PAGE_SIZE)
+						/**< Page size in dual parallel
+						  *  mode */
+#define XQSPIPS_FLASH_DEF_DEVICE_SIZE	0x1000000 /**< Default device size */
+#define XQSPIPS_FLASH_READ_CHUNK	1024	/**< Bytes per read transfer */
+#define XQSPIPS_FLASH_CMD_SIZE		4	/**< Opcode and 24 bit address */
+#define XQSPIPS_FLASH_DUMMY_SIZE	1	/**< Dummy bytes of QUAD_READ */
+#define XQSPIPS_FLASH_SR_WIP_MASK	0x01	/**< Write in progress bit */
+/* @} */
+
+/** @name Operation types
+ * @{
+ */
+#define XQSPIPS_FLASH_OP_PROGRAM	0	/**< Page program */
+#define XQSPIPS_FLASH_OP_ERASE_SECTOR	1	/**< Sector erase (SE) */
+#define XQSPIPS_FLASH_OP_ERASE_4K	2	/**< 4 KB block erase */
+/* @} */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * A program or erase operation. For a program operation the data must not
+ * cross a page boundary (XQSPIPS_FLASH_PAGE_SIZE, or
+ * XQSPIPS_FLASH_MAX_PAGE_SIZE in dual parallel mode). The data is read from
+ * BufPtr from interrupt context once the operation leaves the queue, so the
+ * buffer must stay valid and unchanged until the completion callback of the
+ * operation.
+ */
+typedef struct {
+	u32 Type;		/**< One of XQSPIPS_FLASH_OP_* */
+	u32 Address;		/**< Flash address */
+	u8 *BufPtr;		/**< Data to program */
+	unsigned ByteCount;	/**< Bytes to program */
+	void *UserRef;		/**< Passed back untouched */
+} XQspiPs_FlashOp;
+
+/**
+ * Completion callback of a queued operation, called from interrupt context.
+ *
+ * @param	CallBackRef is the reference given to
+ *		XQspiPs_FlashSetHandler().
+ * @param	OpPtr is a copy of the completed operation.
+ * @param	Status is XST_SUCCESS or XST_FAILURE.
+ */
+typedef void (*XQspiPs_FlashHandler) (void *CallBackRef,
+				       XQspiPs_FlashOp *OpPtr, int Status);
+
+/**
+ * The flash device layer instance. All fields are private to the driver.
+ */
+typedef struct {
+	XQspiPs *QspiPtr;	/**< QSPI instance in I/O mode */
+	u32 ConnectionMode;	/**< Single, stacked or parallel */
+	u32 PageSize;		/**< Program page size seen by the user */
+	u32 DeviceSize;		/**< Size of one device for stacked mode */
+
+	XQspiPs_FlashOp Queue[XQSPIPS_FLASH_QUEUE_LEN];
+	volatile u32 Head;	/**< Next free queue entry */
+	volatile u32 Tail;	/**< Operation in progress */
+
+	volatile u32 State;	/**< Step of the current operation */
+	volatile u32 Hold;	/**< A read owns the bus */
+	u32 PollTicks;		/**< Ticks left until the next status read */
+	u32 ProgramPollTicks;	/**< Status poll interval while programming */
+	u32 ErasePollTicks;	/**< Status poll interval while erasing */
+
+	u32 Polls;		/**< Status reads issued by the tick */
+	u32 Suspends;		/**< Erases suspended for a read */
+
+	XQspiPs_FlashHandler Handler;
+	void *CallBackRef;	/**< Callback reference for the handler */
+
+	u8 CmdBuf[XQSPIPS_FLASH_CMD_SIZE + XQSPIPS_FLASH_MAX_PAGE_SIZE];
+	u8 StatusBuf[3];	/**< RDSR transfer buffer */
+	u8 ReadBuf[XQSPIPS_FLASH_CMD_SIZE + XQSPIPS_FLASH_DUMMY_SIZE +
+		   XQSPIPS_FLASH_READ_CHUNK];
+} XQspiPs_Flash;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/****************************************************************************/
+/**
+*
+* Check whether all queued operations have completed.
+*
+* @param	FlashPtr is a pointer to the XQspiPs_Flash instance.
+*
+* @return	TRUE if the queue is empty, FALSE otherwise.
+*
+* @note		C-Style signature:
+*		u32 XQspiPs_FlashIsIdle(XQspiPs_Flash *FlashPtr)
+*
+*****************************************************************************/
+#define XQspiPs_FlashIsIdle(FlashPtr)	((FlashPtr)->Head == (FlashPtr)->Tail)
+
+/************************** Function Prototypes ******************************/
+
+/*
+ * Functions implemented in xqspips_flash.c
+ */
+int XQspiPs_FlashInitialize(XQspiPs_Flash *FlashPtr, XQspiPs *QspiPtr);
+void XQspiPs_FlashSetHandler(XQspiPs_Flash *FlashPtr,
+			     XQspiPs_FlashHandler FuncPtr, void *CallBackRef);
+void XQspiPs_FlashSetPollInterval(XQspiPs_Flash *FlashPtr,
+				  u32 ProgramTicks, u32 EraseTicks);
+void XQspiPs_FlashSetDeviceSize(XQspiPs_Flash *FlashPtr, u32 DeviceSize);
+int XQspiPs_FlashSubmit(XQspiPs_Flash *FlashPtr, XQspiPs_FlashOp *OpPtr);
+int XQspiPs_FlashRead(XQspiPs_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+		      unsigned ByteCount);
+void XQspiPs_FlashTick(XQspiPs_Flash *FlashPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/** @} */
@@ -46,6 +46,8 @@
 * 2.03a hk  09/17/13 First release
 * 3.1   hk  06/19/14 When writing to the configuration register, set/reset
 *                    required bits leaving reserved bits untouched. CR# 796813.
+* 3.2   ag  10/18/26 Added XQspiPs_XipInit() for execute in place from the
+*                    linear window.
 *
 * </pre>
 *
@@ -55,9 +57,19 @@
 
 #include "xqspips_hw.h"
 #include "xqspips.h"
+#include "xil_mmu.h"
 
 /************************** Constant Definitions *****************************/
 
+#ifndef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
+#define	XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR 0xFC000000
+#endif
+
+/*
+ * The linear window covers 32 MB (two devices)
+ */
+#define XQSPIPS_XIP_WINDOW_SIZE		0x2000000
+
 /** @name Pre-scaler value for divided by 4
  *
  * Pre-scaler value for divided by 4
@@ -221,4 +233,71 @@ void XQspiPs_LinearInit(u32 BaseAddress)
 				XQSPIPS_ER_ENABLE_MASK);
 
 }
+
+/*****************************************************************************/
+/**
+*
+* Switches the linear mode to the settings used for execute in place: quad
+* I/O read with mode bits and, optionally, continuous read mode. The prescaler
+* and I/O mode settings left by the boot loader are kept. The MMU sections of
+* the linear window are set to executable and write-through cacheable in one
+* Xil_SetTlbAttributesRange() call, so line fills of XIP code are cached in L1
+* and L2.
+*
+* @param	BaseAddress is the base address of the QSPI controller.
+* @param	ConnectionMode is the connection of the flash devices,
+*		XQSPIPS_CONNECTION_MODE_SINGLE, _STACKED or _PARALLEL, as in
+*		the ConnectionMode of the configuration.
+* @param	Continuous selects continuous read mode; the flash then skips
+*		the instruction byte on all reads after the first one.
+*
+* @return	None.
+*
+* @note		This function must run from OCM or DDR, and no code or data
+*		in the linear window may be accessed while it runs. The flash
+*		must have quad mode enabled in its non-volatile configuration.
+*
+******************************************************************************/
+void XQspiPs_XipInit(u32 BaseAddress, u8 ConnectionMode, u32 Continuous)
+{
+	u32 LinearCfg;
+
+	LinearCfg = XQSPIPS_LQSPI_CR_LINEAR_MASK |
+		    XQSPIPS_LQSPI_CR_MODE_EN_MASK |
+		    (XQSPIPS_XIP_DUMMY_BYTES << XQSPIPS_LQSPI_CR_DUMMY_SHIFT) |
+		    XQSPIPS_XIP_INST_QUAD_IO;
+
+	if (Continuous) {
+		LinearCfg |= XQSPIPS_LQSPI_CR_MODE_ON_MASK |
+			     (XQSPIPS_XIP_MODE_CONTINUOUS <<
+			      XQSPIPS_LQSPI_CR_MODE_BITS_SHIFT);
+	} else {
+		LinearCfg |= (XQSPIPS_XIP_MODE_EXIT <<
+			      XQSPIPS_LQSPI_CR_MODE_BITS_SHIFT);
+	}
+
+	if (ConnectionMode == XQSPIPS_CONNECTION_MODE_STACKED) {
+		LinearCfg |= XQSPIPS_LQSPI_CR_TWO_MEM_MASK;
+	} else if (ConnectionMode == XQSPIPS_CONNECTION_MODE_PARALLEL) {
+		LinearCfg |= XQSPIPS_LQSPI_CR_TWO_MEM_MASK |
+			     XQSPIPS_LQSPI_CR_SEP_BUS_MASK;
+	}
+
+	/*
+	 * The configuration is only taken over while the controller is
+	 * disabled
+	 */
+	XQspiPs_WriteReg(BaseAddress, XQSPIPS_ER_OFFSET, 0);
+	XQspiPs_WriteReg(BaseAddress, XQSPIPS_LQSPI_CR_OFFSET, LinearCfg);
+	XQspiPs_WriteReg(BaseAddress, XQSPIPS_ER_OFFSET,
+			 XQSPIPS_ER_ENABLE_MASK);
+
+	/*
+	 * One call for the whole window, so that the caches and the TLB are
+	 * maintained once and not once per section
+	 */
+	(void)Xil_SetTlbAttributesRange(XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR,
+					XQSPIPS_XIP_WINDOW_SIZE,
+					XQSPIPS_XIP_TLB_ATTR);
+}
 /** @} */
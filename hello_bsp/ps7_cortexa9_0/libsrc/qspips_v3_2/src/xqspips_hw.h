@@ -302,6 +302,38 @@ extern "C" {
 							 read data */
 #define XQSPIPS_LQSPI_CR_INST_MASK	 0x000000FF /**< Read instr code */
 #define XQSPIPS_LQSPI_CR_RST_STATE	 0x8000016B /**< Default CR value */
+#define XQSPIPS_LQSPI_CR_MODE_BITS_SHIFT 16	    /**< Mode value shift */
+#define XQSPIPS_LQSPI_CR_DUMMY_SHIFT	 8	    /**< Dummy bytes shift */
+/* @} */
+
+/** @name Execute in place
+ *
+ * Settings used by XQspiPs_XipInit(). Code runs from the linear window with
+ * quad I/O reads (0xEB), a mode byte and 2 dummy bytes (4 clocks). The mode
+ * value 0xA0 asks Spansion and Winbond devices to stay in continuous read
+ * mode, so the instruction byte is skipped on every following line fill.
+ *
+ * Functions and constants are moved to the linear window with the section
+ * attributes below; the .xip_text output section of the linker script places
+ * them at XQSPIPS_XIP_FLASH_OFFSET in flash.
+ *
+ * @{
+ */
+#define XQSPIPS_XIP_INST_QUAD_IO	0xEB	/**< Quad I/O read */
+#define XQSPIPS_XIP_DUMMY_BYTES		2	/**< Dummy bytes after mode */
+#define XQSPIPS_XIP_MODE_CONTINUOUS	0xA0	/**< Stay in continuous read */
+#define XQSPIPS_XIP_MODE_EXIT		0xFF	/**< Leave continuous read */
+#define XQSPIPS_XIP_FLASH_OFFSET	0x00C00000 /**< Flash offset of the
+						     *  .xip_text section */
+#define XQSPIPS_XIP_TLB_ATTR		0x8C0A	/**< Executable, inner/outer
+						  *  write-through section in
+						  *  domain 0. Its AP bits
+						  *  say read-only, but boot.S
+						  *  sets the domains to
+						  *  manager, so they are not
+						  *  checked */
+#define XQSPIPS_XIP_TEXT	__attribute__ ((section (".xip.text")))
+#define XQSPIPS_XIP_RODATA	__attribute__ ((section (".xip.rodata")))
 /* @} */
 
 /** @name Linear QSPI Status Register
@@ -412,6 +444,7 @@ extern "C" {
  */
 void XQspiPs_ResetHw(u32 BaseAddress);
 void XQspiPs_LinearInit(u32 BaseAddress);
+void XQspiPs_XipInit(u32 BaseAddress, u8 ConnectionMode, u32 Continuous);
 
 /************************** Variable Definitions *****************************/
 
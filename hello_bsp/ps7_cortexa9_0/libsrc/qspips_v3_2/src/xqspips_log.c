@@ -0,0 +1,1008 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_log.c
+* @addtogroup qspips_v3_2
+* @{
+*
+* Contains the implementation of the log structured record store. See
+* xqspips_log.h for the on-flash format and the usage.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xqspips_log.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XQSPIPS_LOG_MAGIC	0x474F4C51U	/* "QLOG" */
+#define XQSPIPS_LOG_ERASED	0xFFFFFFFFU	/* Erased flash word */
+#define XQSPIPS_LOG_HALF_SIZE	(XQSPIPS_LOG_SECTOR_HDR_SIZE / 2)
+
+/*
+ * Word offsets in the sector header. The first half is programmed after the
+ * erase, the second half when the sector is opened.
+ */
+#define XQSPIPS_LOG_HDR_MAGIC	0
+#define XQSPIPS_LOG_HDR_ERASES	1
+#define XQSPIPS_LOG_HDR_ECRC	2
+#define XQSPIPS_LOG_HDR_SEQ	4
+#define XQSPIPS_LOG_HDR_FIRST	5
+#define XQSPIPS_LOG_HDR_OCRC	6
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XQspiPs_LogAlign(Count)		(((Count) + 3U) & ~3U)
+
+#define XQspiPs_LogSectorAddr(LogPtr, Index) \
+	((LogPtr)->BaseAddress + ((Index) * (LogPtr)->SectorSize))
+
+/*
+ * An operation is complete once the completion count has passed its number
+ */
+#define XQspiPs_LogOpDone(LogPtr, Op) \
+	((s32)((LogPtr)->OpsCompleted - (Op)) > 0)
+
+#define XQspiPs_LogQueueSpace(LogPtr) \
+	(XQSPIPS_FLASH_QUEUE_LEN - \
+	 ((LogPtr)->FlashPtr->Head - (LogPtr)->FlashPtr->Tail))
+
+/************************** Function Prototypes ******************************/
+
+static u32 XQspiPs_LogCrc(const u8 *DataPtr, u32 ByteCount);
+static void XQspiPs_LogFlashDone(void *CallBackRef, XQspiPs_FlashOp *OpPtr,
+				 int Status);
+static u32 XQspiPs_LogSubmit(XQspiPs_Log *LogPtr, u32 Type, u32 Address,
+			     u8 *BufPtr, u32 ByteCount);
+static void XQspiPs_LogErase(XQspiPs_Log *LogPtr, u32 Index);
+static int XQspiPs_LogOpen(XQspiPs_Log *LogPtr);
+static void XQspiPs_LogPut(XQspiPs_Log *LogPtr, const u8 *DataPtr,
+			   u32 ByteCount);
+static int XQspiPs_LogScan(XQspiPs_Log *LogPtr, u32 Index, u32 *CountPtr);
+static int XQspiPs_LogReadRecord(XQspiPs_Log *LogPtr, u32 Address,
+				 u8 *BufPtr, u32 BufSize, u32 *LengthPtr);
+
+/************************** Variable Definitions *****************************/
+
+/*
+ * CRC-32 (IEEE 802.3, reflected) nibble table
+ */
+static const u32 XQspiPs_LogCrcTable[16] = {
+	0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+	0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+	0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+	0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/*****************************************************************************/
+/**
+*
+* Mounts a log region. The sector headers are read into the RAM index, the
+* end of the newest sector is found by scanning its records, and sectors
+* whose header is missing or torn are queued for erase. The sector written
+* at the time of the last reset is closed; the next append opens a new one.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	FlashPtr is a pointer to an initialized XQspiPs_Flash instance.
+* @param	BaseAddress is the flash address of the region, aligned to
+*		SectorSize.
+* @param	SectorSize is the size of a sector. 4096 selects 4 KB block
+*		erases, any other size sector erases (SE), in which case it
+*		must match the erase sector of the device.
+* @param	NumSectors is the number of sectors in the region.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if a flash read failed.
+*
+* @note		A blank or foreign region comes up with all sectors queued
+*		for erase, so XQspiPs_LogFormat() is only needed to discard
+*		the records of a valid log.
+*
+******************************************************************************/
+int XQspiPs_LogMount(XQspiPs_Log *LogPtr, XQspiPs_Flash *FlashPtr,
+		     u32 BaseAddress, u32 SectorSize, u32 NumSectors)
+{
+	u32 Hdr[XQSPIPS_LOG_SECTOR_HDR_SIZE / 4];
+	u8 Unknown[XQSPIPS_LOG_MAX_SECTORS];
+	XQspiPs_LogSector *SectorPtr;
+	u32 Index;
+	u32 Pos;
+	u32 Count;
+	int Status;
+
+	Xil_AssertNonvoid(LogPtr != NULL);
+	Xil_AssertNonvoid(FlashPtr != NULL);
+	Xil_AssertNonvoid((NumSectors > XQSPIPS_LOG_RESERVE_SECTORS) &&
+			  (NumSectors <= XQSPIPS_LOG_MAX_SECTORS));
+	Xil_AssertNonvoid((SectorSize % FlashPtr->PageSize) == 0);
+	Xil_AssertNonvoid((BaseAddress % SectorSize) == 0);
+
+	memset(LogPtr, 0, sizeof(XQspiPs_Log));
+
+	LogPtr->FlashPtr = FlashPtr;
+	LogPtr->BaseAddress = BaseAddress;
+	LogPtr->SectorSize = SectorSize;
+	LogPtr->NumSectors = NumSectors;
+	LogPtr->EraseType = (SectorSize == 4096) ? XQSPIPS_FLASH_OP_ERASE_4K :
+			    XQSPIPS_FLASH_OP_ERASE_SECTOR;
+	LogPtr->PageSize = FlashPtr->PageSize;
+	LogPtr->Active = NumSectors;
+	for (Index = 0; Index < XQSPIPS_LOG_PAGE_BUFS; Index++) {
+		LogPtr->PageOp[Index] = (u32)-1;
+	}
+
+	XQspiPs_FlashSetHandler(FlashPtr, XQspiPs_LogFlashDone, LogPtr);
+
+	/*
+	 * Build the RAM index from the sector headers
+	 */
+	for (Index = 0; Index < NumSectors; Index++) {
+		SectorPtr = &LogPtr->Sector[Index];
+		Status = XQspiPs_FlashRead(FlashPtr,
+					   XQspiPs_LogSectorAddr(LogPtr, Index),
+					   (u8 *)Hdr, sizeof(Hdr));
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		Unknown[Index] = 0;
+		SectorPtr->State = XQSPIPS_LOG_SECTOR_DIRTY;
+
+		if ((Hdr[XQSPIPS_LOG_HDR_MAGIC] != XQSPIPS_LOG_MAGIC) ||
+		    (Hdr[XQSPIPS_LOG_HDR_ECRC] !=
+		     XQspiPs_LogCrc((u8 *)&Hdr[XQSPIPS_LOG_HDR_MAGIC], 8))) {
+			/* Never formatted or the erase was interrupted */
+			Unknown[Index] = 1;
+			continue;
+		}
+
+		SectorPtr->EraseCount = Hdr[XQSPIPS_LOG_HDR_ERASES];
+		if (SectorPtr->EraseCount > LogPtr->MaxEraseCount) {
+			LogPtr->MaxEraseCount = SectorPtr->EraseCount;
+		}
+
+		if ((Hdr[XQSPIPS_LOG_HDR_SEQ] == XQSPIPS_LOG_ERASED) &&
+		    (Hdr[XQSPIPS_LOG_HDR_FIRST] == XQSPIPS_LOG_ERASED) &&
+		    (Hdr[XQSPIPS_LOG_HDR_OCRC] == XQSPIPS_LOG_ERASED)) {
+			SectorPtr->State = XQSPIPS_LOG_SECTOR_FREE;
+			LogPtr->FreeCount++;
+		} else if (Hdr[XQSPIPS_LOG_HDR_OCRC] ==
+			   XQspiPs_LogCrc((u8 *)&Hdr[XQSPIPS_LOG_HDR_SEQ], 8)) {
+			SectorPtr->State = XQSPIPS_LOG_SECTOR_USED;
+			SectorPtr->Sequence = Hdr[XQSPIPS_LOG_HDR_SEQ];
+			SectorPtr->FirstRecord = Hdr[XQSPIPS_LOG_HDR_FIRST];
+
+			/* Insert into the order list, sorted by sequence */
+			Pos = LogPtr->OrderCount;
+			while ((Pos > 0) &&
+			       ((s32)(LogPtr->Sector[LogPtr->Order[Pos - 1]].
+				      Sequence - SectorPtr->Sequence) > 0)) {
+				LogPtr->Order[Pos] = LogPtr->Order[Pos - 1];
+				Pos--;
+			}
+			LogPtr->Order[Pos] = (u16)Index;
+			LogPtr->OrderCount++;
+		}
+	}
+
+	/*
+	 * Sectors with a torn erase header continue from the highest known
+	 * erase count, so wear leveling does not favour them
+	 */
+	for (Index = 0; Index < NumSectors; Index++) {
+		if (LogPtr->Sector[Index].State == XQSPIPS_LOG_SECTOR_DIRTY) {
+			if (Unknown[Index]) {
+				LogPtr->Sector[Index].EraseCount =
+					LogPtr->MaxEraseCount;
+			}
+			LogPtr->DirtyCount++;
+		}
+	}
+
+	if (LogPtr->OrderCount > 0) {
+		Index = LogPtr->Order[LogPtr->OrderCount - 1];
+		Status = XQspiPs_LogScan(LogPtr, Index, &Count);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		LogPtr->NextSequence = LogPtr->Sector[Index].Sequence + 1;
+		LogPtr->NextRecord = LogPtr->Sector[Index].FirstRecord + Count;
+	}
+
+	XQspiPs_LogService(LogPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Discards all records and queues an erase of every sector. The erase
+* counts are kept.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+*
+* @return	XST_SUCCESS.
+*
+* @note		The erases are queued from XQspiPs_LogService() as the flash
+*		queue drains; appends succeed again once a sector is erased.
+*
+******************************************************************************/
+int XQspiPs_LogFormat(XQspiPs_Log *LogPtr)
+{
+	u32 Index;
+
+	Xil_AssertNonvoid(LogPtr != NULL);
+
+	for (Index = 0; Index < LogPtr->NumSectors; Index++) {
+		if (LogPtr->Sector[Index].State == XQSPIPS_LOG_SECTOR_USED) {
+			LogPtr->Sector[Index].State = XQSPIPS_LOG_SECTOR_DIRTY;
+			LogPtr->DirtyCount++;
+		}
+	}
+
+	LogPtr->Dropped += LogPtr->NextRecord -
+		((LogPtr->OrderCount > 0) ?
+		 LogPtr->Sector[LogPtr->Order[LogPtr->OrderHead]].FirstRecord :
+		 LogPtr->NextRecord);
+	LogPtr->OrderHead = 0;
+	LogPtr->OrderCount = 0;
+	LogPtr->Active = LogPtr->NumSectors;
+
+	XQspiPs_LogService(LogPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Appends a record to the log. The data is copied into the page buffers;
+* every page that fills up is queued for programming.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	DataPtr is the record data.
+* @param	ByteCount is the record length, 1 to XQSPIPS_LOG_MAX_RECORD.
+*
+* @return
+*		- XST_SUCCESS if the record was appended.
+*		- XST_DEVICE_BUSY if the flash queue, the page buffers or the
+*		  erased sectors are exhausted. Nothing was appended; retry
+*		  after background operations have completed.
+*		- XST_INVALID_PARAM if the record does not fit into a sector.
+*
+* @note		None.
+*
+******************************************************************************/
+int XQspiPs_LogAppend(XQspiPs_Log *LogPtr, const u8 *DataPtr, u32 ByteCount)
+{
+	u32 Hdr[XQSPIPS_LOG_RECORD_HDR_SIZE / 4];
+	u32 RecordSize;
+	u32 Fill;
+	u32 First;
+	u32 Last;
+	u32 Ops;
+	u32 Index;
+	u32 Switch;
+	const u32 Pad = 0;
+
+	Xil_AssertNonvoid(LogPtr != NULL);
+	Xil_AssertNonvoid(DataPtr != NULL);
+	Xil_AssertNonvoid((ByteCount > 0) &&
+			  (ByteCount <= XQSPIPS_LOG_MAX_RECORD));
+
+	RecordSize = XQSPIPS_LOG_RECORD_HDR_SIZE + XQspiPs_LogAlign(ByteCount);
+	if (RecordSize > LogPtr->SectorSize - XQSPIPS_LOG_SECTOR_HDR_SIZE) {
+		return XST_INVALID_PARAM;
+	}
+
+	XQspiPs_LogService(LogPtr);
+
+	/*
+	 * Check all resources up front, so a record is either appended
+	 * completely or not at all
+	 */
+	Switch = (LogPtr->Active == LogPtr->NumSectors) ||
+		 (LogPtr->WriteOffset + RecordSize > LogPtr->SectorSize);
+	if (Switch) {
+		if (LogPtr->FreeCount == 0) {
+			return XST_DEVICE_BUSY;
+		}
+		Fill = XQSPIPS_LOG_SECTOR_HDR_SIZE % LogPtr->PageSize;
+		Ops = 2;
+	} else {
+		Fill = LogPtr->WriteOffset % LogPtr->PageSize;
+		Ops = 0;
+	}
+	Ops += (Fill + RecordSize) / LogPtr->PageSize;
+	if (XQspiPs_LogQueueSpace(LogPtr) < Ops) {
+		return XST_DEVICE_BUSY;
+	}
+
+	/*
+	 * Page buffers the record is copied to, relative to the current one.
+	 * A partially filled current page is ours even while its first
+	 * bytes are being programmed.
+	 */
+	First = Switch;
+	Last = First + (Fill + RecordSize - 1) / LogPtr->PageSize;
+	if ((First == 0) && (Fill > 0)) {
+		First = 1;
+	}
+	for (Index = First; Index <= Last; Index++) {
+		if (!XQspiPs_LogOpDone(LogPtr, LogPtr->PageOp[
+			(LogPtr->PageIndex + Index) &
+			(XQSPIPS_LOG_PAGE_BUFS - 1)])) {
+			return XST_DEVICE_BUSY;
+		}
+	}
+
+	if (Switch) {
+		(void)XQspiPs_LogFlush(LogPtr);
+		(void)XQspiPs_LogOpen(LogPtr);
+	}
+
+	Hdr[0] = ByteCount | ((~ByteCount) << 16);
+	Hdr[1] = XQspiPs_LogCrc(DataPtr, ByteCount);
+	XQspiPs_LogPut(LogPtr, (u8 *)Hdr, sizeof(Hdr));
+	XQspiPs_LogPut(LogPtr, DataPtr, ByteCount);
+	XQspiPs_LogPut(LogPtr, (const u8 *)&Pad,
+		       XQspiPs_LogAlign(ByteCount) - ByteCount);
+
+	LogPtr->NextRecord++;
+	LogPtr->UserBytes += ByteCount;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues the programming of the appended bytes of a partially filled page.
+* Later appends continue in the same page; only the bytes not yet
+* programmed are programmed then.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+*
+* @return
+*		- XST_SUCCESS if the page was queued or nothing was pending.
+*		- XST_DEVICE_BUSY if the flash queue is full.
+*
+* @note		Each flush of a partial page adds a program operation to the
+*		page, so flushing after every record raises the write
+*		amplification.
+*
+******************************************************************************/
+int XQspiPs_LogFlush(XQspiPs_Log *LogPtr)
+{
+	u32 Fill;
+	u32 PageAddr;
+
+	Xil_AssertNonvoid(LogPtr != NULL);
+
+	if (LogPtr->Active == LogPtr->NumSectors) {
+		return XST_SUCCESS;
+	}
+
+	Fill = LogPtr->WriteOffset % LogPtr->PageSize;
+	if (Fill <= LogPtr->PageFlushed) {
+		return XST_SUCCESS;
+	}
+	if (XQspiPs_LogQueueSpace(LogPtr) == 0) {
+		return XST_DEVICE_BUSY;
+	}
+
+	PageAddr = XQspiPs_LogSectorAddr(LogPtr, LogPtr->Active) +
+		   LogPtr->WriteOffset - Fill;
+	LogPtr->PageOp[LogPtr->PageIndex] = XQspiPs_LogSubmit(LogPtr,
+		XQSPIPS_FLASH_OP_PROGRAM, PageAddr + LogPtr->PageFlushed,
+		&LogPtr->PageBuf[LogPtr->PageIndex][LogPtr->PageFlushed],
+		Fill - LogPtr->PageFlushed);
+	LogPtr->PageFlushed = Fill;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Runs the background work of the log: sectors whose erase has completed
+* become available, sectors left dirty by a reset are erased, and the oldest
+* sector is reclaimed when fewer than XQSPIPS_LOG_RESERVE_SECTORS sectors
+* are erased or being erased.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+*
+* @return	None.
+*
+* @note		Called by XQspiPs_LogAppend(). An application that appends
+*		rarely calls it from its main loop so erases are queued as
+*		soon as the flash queue has room.
+*
+******************************************************************************/
+void XQspiPs_LogService(XQspiPs_Log *LogPtr)
+{
+	XQspiPs_LogSector *SectorPtr;
+	u32 Index;
+	u32 Next;
+
+	Xil_AssertVoid(LogPtr != NULL);
+
+	/* Erases complete in queue order */
+	while (LogPtr->ErasingCount > 0) {
+		Index = LogPtr->Erasing[LogPtr->ErasingHead];
+		SectorPtr = &LogPtr->Sector[Index];
+		if (!XQspiPs_LogOpDone(LogPtr, SectorPtr->EraseOp)) {
+			break;
+		}
+		SectorPtr->State = XQSPIPS_LOG_SECTOR_FREE;
+		LogPtr->FreeCount++;
+		LogPtr->ErasingHead = (LogPtr->ErasingHead + 1) %
+				      LogPtr->NumSectors;
+		LogPtr->ErasingCount--;
+	}
+
+	for (Index = 0; (LogPtr->DirtyCount > 0) &&
+	     (Index < LogPtr->NumSectors); Index++) {
+		if (XQspiPs_LogQueueSpace(LogPtr) < 2) {
+			return;
+		}
+		if (LogPtr->Sector[Index].State == XQSPIPS_LOG_SECTOR_DIRTY) {
+			LogPtr->DirtyCount--;
+			XQspiPs_LogErase(LogPtr, Index);
+		}
+	}
+
+	/*
+	 * Reclaim the oldest sector, never the one being written
+	 */
+	while ((LogPtr->FreeCount + LogPtr->ErasingCount <
+		XQSPIPS_LOG_RESERVE_SECTORS) &&
+	       (LogPtr->OrderCount > 1) &&
+	       (XQspiPs_LogQueueSpace(LogPtr) >= 2)) {
+		Index = LogPtr->Order[LogPtr->OrderHead];
+		LogPtr->OrderHead = (LogPtr->OrderHead + 1) %
+				    LogPtr->NumSectors;
+		LogPtr->OrderCount--;
+		Next = LogPtr->Order[LogPtr->OrderHead];
+		LogPtr->Dropped += LogPtr->Sector[Next].FirstRecord -
+				   LogPtr->Sector[Index].FirstRecord;
+		XQspiPs_LogErase(LogPtr, Index);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets a cursor to the oldest record of the log.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	CursorPtr is the cursor to initialize.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XQspiPs_LogCursorInit(XQspiPs_Log *LogPtr, XQspiPs_LogCursor *CursorPtr)
+{
+	XQspiPs_LogSector *SectorPtr;
+
+	Xil_AssertVoid(LogPtr != NULL);
+	Xil_AssertVoid(CursorPtr != NULL);
+
+	CursorPtr->Offset = XQSPIPS_LOG_SECTOR_HDR_SIZE;
+	if (LogPtr->OrderCount == 0) {
+		CursorPtr->Sequence = LogPtr->NextSequence;
+		CursorPtr->Record = LogPtr->NextRecord;
+	} else {
+		SectorPtr = &LogPtr->Sector[LogPtr->Order[LogPtr->OrderHead]];
+		CursorPtr->Sequence = SectorPtr->Sequence;
+		CursorPtr->Record = SectorPtr->FirstRecord;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads the record at the cursor and advances the cursor. If the sector of
+* the cursor has been reclaimed, reading continues at the oldest record;
+* the caller detects the gap from the record number.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	CursorPtr is the read position.
+* @param	BufPtr is the buffer the record data is read to.
+* @param	BufSize is the size of the buffer.
+* @param	ByteCountPtr returns the record length.
+*
+* @return
+*		- XST_SUCCESS if a record was read. CursorPtr->Record - 1 is
+*		  its number.
+*		- XST_NO_DATA if there is no programmed record at the cursor.
+*		- XST_BUFFER_TOO_SMALL if the record is larger than BufSize.
+*		  The length is returned and the cursor is not advanced.
+*		- XST_FAILURE if a flash read failed.
+*
+* @note		Must be called from task context.
+*
+******************************************************************************/
+int XQspiPs_LogRead(XQspiPs_Log *LogPtr, XQspiPs_LogCursor *CursorPtr,
+		    u8 *BufPtr, u32 BufSize, u32 *ByteCountPtr)
+{
+	XQspiPs_LogSector *SectorPtr;
+	u32 Pos;
+	u32 Index = 0;
+	int Status;
+
+	Xil_AssertNonvoid(LogPtr != NULL);
+	Xil_AssertNonvoid(CursorPtr != NULL);
+	Xil_AssertNonvoid(BufPtr != NULL);
+	Xil_AssertNonvoid(ByteCountPtr != NULL);
+
+	if (LogPtr->OrderCount == 0) {
+		return XST_NO_DATA;
+	}
+
+	/* Find the sector of the cursor */
+	for (Pos = 0; Pos < LogPtr->OrderCount; Pos++) {
+		Index = LogPtr->Order[(LogPtr->OrderHead + Pos) %
+				      LogPtr->NumSectors];
+		if (LogPtr->Sector[Index].Sequence == CursorPtr->Sequence) {
+			break;
+		}
+	}
+	if (Pos == LogPtr->OrderCount) {
+		SectorPtr = &LogPtr->Sector[LogPtr->Order[LogPtr->OrderHead]];
+		if ((s32)(CursorPtr->Sequence - SectorPtr->Sequence) > 0) {
+			/* Sector not opened yet */
+			return XST_NO_DATA;
+		}
+		XQspiPs_LogCursorInit(LogPtr, CursorPtr);
+		Pos = 0;
+		Index = LogPtr->Order[LogPtr->OrderHead];
+	}
+
+	while (1) {
+		Status = XST_NO_DATA;
+		if (CursorPtr->Offset + XQSPIPS_LOG_RECORD_HDR_SIZE <=
+		    LogPtr->SectorSize) {
+			Status = XQspiPs_LogReadRecord(LogPtr,
+				XQspiPs_LogSectorAddr(LogPtr, Index) +
+				CursorPtr->Offset, BufPtr, BufSize,
+				ByteCountPtr);
+		}
+		if (Status == XST_SUCCESS) {
+			CursorPtr->Offset += XQSPIPS_LOG_RECORD_HDR_SIZE +
+					     XQspiPs_LogAlign(*ByteCountPtr);
+			CursorPtr->Record++;
+			return XST_SUCCESS;
+		}
+		if (Status != XST_NO_DATA) {
+			return Status;
+		}
+
+		/*
+		 * End of the sector. The newest sector may still be written,
+		 * older ones end at their last complete record.
+		 */
+		if (Pos + 1 >= LogPtr->OrderCount) {
+			return XST_NO_DATA;
+		}
+		Pos++;
+		Index = LogPtr->Order[(LogPtr->OrderHead + Pos) %
+				      LogPtr->NumSectors];
+		CursorPtr->Sequence = LogPtr->Sector[Index].Sequence;
+		CursorPtr->Offset = XQSPIPS_LOG_SECTOR_HDR_SIZE;
+		CursorPtr->Record = LogPtr->Sector[Index].FirstRecord;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Completion handler of the flash layer, called from interrupt context.
+* Operations complete in submission order, so a count is all the task side
+* needs to know which page buffers and erases are done.
+*
+* @param	CallBackRef is the XQspiPs_Log instance.
+* @param	OpPtr is the completed operation.
+* @param	Status is the result of the operation.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LogFlashDone(void *CallBackRef, XQspiPs_FlashOp *OpPtr,
+				 int Status)
+{
+	XQspiPs_Log *LogPtr = (XQspiPs_Log *)CallBackRef;
+
+	(void)OpPtr;
+
+	if (Status != XST_SUCCESS) {
+		LogPtr->OpErrors++;
+	}
+	LogPtr->OpsCompleted++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Submits an operation to the flash layer. The caller has checked that the
+* queue has room.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	Type is the operation type.
+* @param	Address is the flash address.
+* @param	BufPtr is the data of a program operation.
+* @param	ByteCount is the length of a program operation.
+*
+* @return	The number of the operation.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XQspiPs_LogSubmit(XQspiPs_Log *LogPtr, u32 Type, u32 Address,
+			     u8 *BufPtr, u32 ByteCount)
+{
+	XQspiPs_FlashOp Op;
+
+	Op.Type = Type;
+	Op.Address = Address;
+	Op.BufPtr = BufPtr;
+	Op.ByteCount = ByteCount;
+	Op.UserRef = NULL;
+
+	(void)XQspiPs_FlashSubmit(LogPtr->FlashPtr, &Op);
+
+	if (Type == XQSPIPS_FLASH_OP_PROGRAM) {
+		LogPtr->ProgramBytes += ByteCount;
+	}
+
+	return LogPtr->OpsSubmitted++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues the erase of a sector followed by the programming of the first half
+* of its header with the new erase count. The caller has checked that the
+* queue has room for both.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	Index is the sector.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LogErase(XQspiPs_Log *LogPtr, u32 Index)
+{
+	XQspiPs_LogSector *SectorPtr = &LogPtr->Sector[Index];
+	u32 Hdr[XQSPIPS_LOG_HALF_SIZE / 4];
+	u32 Tail;
+
+	SectorPtr->EraseCount++;
+	if (SectorPtr->EraseCount > LogPtr->MaxEraseCount) {
+		LogPtr->MaxEraseCount = SectorPtr->EraseCount;
+	}
+
+	Hdr[XQSPIPS_LOG_HDR_MAGIC] = XQSPIPS_LOG_MAGIC;
+	Hdr[XQSPIPS_LOG_HDR_ERASES] = SectorPtr->EraseCount;
+	Hdr[XQSPIPS_LOG_HDR_ECRC] = XQspiPs_LogCrc((u8 *)Hdr, 8);
+	Hdr[3] = XQSPIPS_LOG_ERASED;
+	memcpy(LogPtr->HdrBuf[Index], Hdr, sizeof(Hdr));
+
+	(void)XQspiPs_LogSubmit(LogPtr, LogPtr->EraseType,
+				XQspiPs_LogSectorAddr(LogPtr, Index), NULL, 0);
+	SectorPtr->EraseOp = XQspiPs_LogSubmit(LogPtr,
+				XQSPIPS_FLASH_OP_PROGRAM,
+				XQspiPs_LogSectorAddr(LogPtr, Index),
+				LogPtr->HdrBuf[Index], XQSPIPS_LOG_HALF_SIZE);
+	SectorPtr->State = XQSPIPS_LOG_SECTOR_ERASING;
+
+	Tail = (LogPtr->ErasingHead + LogPtr->ErasingCount) %
+	       LogPtr->NumSectors;
+	LogPtr->Erasing[Tail] = (u16)Index;
+	LogPtr->ErasingCount++;
+	LogPtr->Erases++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Opens the erased sector with the lowest erase count for writing and
+* programs the second half of its header. The caller has checked that a
+* sector is free, the queue has room and the next page buffer is available.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+*
+* @return	XST_SUCCESS.
+*
+* @note		None.
+*
+******************************************************************************/
+static int XQspiPs_LogOpen(XQspiPs_Log *LogPtr)
+{
+	XQspiPs_LogSector *SectorPtr;
+	u32 Hdr[XQSPIPS_LOG_HALF_SIZE / 4];
+	u32 Best = LogPtr->NumSectors;
+	u32 Index;
+	u32 Tail;
+
+	for (Index = 0; Index < LogPtr->NumSectors; Index++) {
+		if ((LogPtr->Sector[Index].State == XQSPIPS_LOG_SECTOR_FREE) &&
+		    ((Best == LogPtr->NumSectors) ||
+		     (LogPtr->Sector[Index].EraseCount <
+		      LogPtr->Sector[Best].EraseCount))) {
+			Best = Index;
+		}
+	}
+
+	SectorPtr = &LogPtr->Sector[Best];
+	SectorPtr->State = XQSPIPS_LOG_SECTOR_USED;
+	SectorPtr->Sequence = LogPtr->NextSequence++;
+	SectorPtr->FirstRecord = LogPtr->NextRecord;
+	LogPtr->FreeCount--;
+
+	Hdr[0] = SectorPtr->Sequence;
+	Hdr[1] = SectorPtr->FirstRecord;
+	Hdr[2] = XQspiPs_LogCrc((u8 *)Hdr, 8);
+	Hdr[3] = XQSPIPS_LOG_ERASED;
+	memcpy(LogPtr->HdrBuf[Best], Hdr, sizeof(Hdr));
+
+	(void)XQspiPs_LogSubmit(LogPtr, XQSPIPS_FLASH_OP_PROGRAM,
+				XQspiPs_LogSectorAddr(LogPtr, Best) +
+				XQSPIPS_LOG_HALF_SIZE,
+				LogPtr->HdrBuf[Best], XQSPIPS_LOG_HALF_SIZE);
+
+	Tail = (LogPtr->OrderHead + LogPtr->OrderCount) % LogPtr->NumSectors;
+	LogPtr->Order[Tail] = (u16)Best;
+	LogPtr->OrderCount++;
+
+	/* The header counts as programmed part of the first page */
+	LogPtr->Active = Best;
+	LogPtr->WriteOffset = XQSPIPS_LOG_SECTOR_HDR_SIZE;
+	LogPtr->PageIndex = (LogPtr->PageIndex + 1) &
+			    (XQSPIPS_LOG_PAGE_BUFS - 1);
+	LogPtr->PageFlushed = XQSPIPS_LOG_SECTOR_HDR_SIZE % LogPtr->PageSize;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copies bytes into the page buffers of the active sector and queues every
+* page that fills up. The caller has checked that the queue has room and the
+* page buffers are available.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	DataPtr is the data.
+* @param	ByteCount is the number of bytes.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LogPut(XQspiPs_Log *LogPtr, const u8 *DataPtr,
+			   u32 ByteCount)
+{
+	u32 Fill;
+	u32 Count;
+	u32 PageAddr;
+
+	while (ByteCount > 0) {
+		Fill = LogPtr->WriteOffset % LogPtr->PageSize;
+		Count = LogPtr->PageSize - Fill;
+		if (Count > ByteCount) {
+			Count = ByteCount;
+		}
+
+		memcpy(&LogPtr->PageBuf[LogPtr->PageIndex][Fill], DataPtr,
+		       Count);
+		DataPtr += Count;
+		ByteCount -= Count;
+		LogPtr->WriteOffset += Count;
+
+		if (Fill + Count == LogPtr->PageSize) {
+			PageAddr = XQspiPs_LogSectorAddr(LogPtr,
+							 LogPtr->Active) +
+				   LogPtr->WriteOffset - LogPtr->PageSize;
+			LogPtr->PageOp[LogPtr->PageIndex] = XQspiPs_LogSubmit(
+				LogPtr, XQSPIPS_FLASH_OP_PROGRAM,
+				PageAddr + LogPtr->PageFlushed,
+				&LogPtr->PageBuf[LogPtr->PageIndex]
+						[LogPtr->PageFlushed],
+				LogPtr->PageSize - LogPtr->PageFlushed);
+			LogPtr->PageIndex = (LogPtr->PageIndex + 1) &
+					    (XQSPIPS_LOG_PAGE_BUFS - 1);
+			LogPtr->PageFlushed = 0;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Counts the valid records of a sector, used by the mount to find the end
+* of the newest sector.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	Index is the sector.
+* @param	CountPtr returns the number of records.
+*
+* @return	XST_SUCCESS or XST_FAILURE if a flash read failed.
+*
+* @note		Uses the page buffers as scratch space, nothing is appended
+*		while the log is mounted.
+*
+******************************************************************************/
+static int XQspiPs_LogScan(XQspiPs_Log *LogPtr, u32 Index, u32 *CountPtr)
+{
+	u32 Offset = XQSPIPS_LOG_SECTOR_HDR_SIZE;
+	u32 Length;
+	int Status;
+
+	*CountPtr = 0;
+
+	while (Offset + XQSPIPS_LOG_RECORD_HDR_SIZE <= LogPtr->SectorSize) {
+		Status = XQspiPs_LogReadRecord(LogPtr,
+			XQspiPs_LogSectorAddr(LogPtr, Index) + Offset,
+			(u8 *)LogPtr->PageBuf, sizeof(LogPtr->PageBuf),
+			&Length);
+		if (Status == XST_NO_DATA) {
+			break;
+		}
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Offset += XQSPIPS_LOG_RECORD_HDR_SIZE +
+			  XQspiPs_LogAlign(Length);
+		(*CountPtr)++;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Reads and checks one record.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+* @param	Address is the flash address of the record header.
+* @param	BufPtr is the buffer the record data is read to.
+* @param	BufSize is the size of the buffer.
+* @param	LengthPtr returns the record length.
+*
+* @return
+*		- XST_SUCCESS if a valid record was read.
+*		- XST_NO_DATA if the location is erased or holds a torn
+*		  record.
+*		- XST_BUFFER_TOO_SMALL if the record does not fit BufSize.
+*		- XST_FAILURE if a flash read failed.
+*
+* @note		Flash reads are done in multiples of 4 bytes, which dual
+*		parallel mode requires.
+*
+******************************************************************************/
+static int XQspiPs_LogReadRecord(XQspiPs_Log *LogPtr, u32 Address,
+				 u8 *BufPtr, u32 BufSize, u32 *LengthPtr)
+{
+	u32 Hdr[XQSPIPS_LOG_RECORD_HDR_SIZE / 4];
+	u32 Tail;
+	u32 Length;
+	u32 Bulk;
+
+	if (XQspiPs_FlashRead(LogPtr->FlashPtr, Address, (u8 *)Hdr,
+			      sizeof(Hdr)) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Length = Hdr[0] & 0xFFFFU;
+	if ((Hdr[0] == XQSPIPS_LOG_ERASED) ||
+	    ((Hdr[0] >> 16) != (~Length & 0xFFFFU)) ||
+	    (Length == 0) || (Length > XQSPIPS_LOG_MAX_RECORD)) {
+		return XST_NO_DATA;
+	}
+
+	*LengthPtr = Length;
+	if (Length > BufSize) {
+		return XST_BUFFER_TOO_SMALL;
+	}
+
+	Address += XQSPIPS_LOG_RECORD_HDR_SIZE;
+	Bulk = Length & ~3U;
+	if ((Bulk > 0) && (XQspiPs_FlashRead(LogPtr->FlashPtr, Address,
+					     BufPtr, Bulk) != XST_SUCCESS)) {
+		return XST_FAILURE;
+	}
+	if (Bulk < Length) {
+		if (XQspiPs_FlashRead(LogPtr->FlashPtr, Address + Bulk,
+				      (u8 *)&Tail, 4) != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		memcpy(&BufPtr[Bulk], &Tail, Length - Bulk);
+	}
+
+	if (XQspiPs_LogCrc(BufPtr, Length) != Hdr[1]) {
+		return XST_NO_DATA;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Computes the CRC-32 of a buffer.
+*
+* @param	DataPtr is the data.
+* @param	ByteCount is the number of bytes.
+*
+* @return	The CRC.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XQspiPs_LogCrc(const u8 *DataPtr, u32 ByteCount)
+{
+	u32 Crc = 0xFFFFFFFFU;
+
+	while (ByteCount-- > 0) {
+		Crc ^= *DataPtr++;
+		Crc = (Crc >> 4) ^ XQspiPs_LogCrcTable[Crc & 0xFU];
+		Crc = (Crc >> 4) ^ XQspiPs_LogCrcTable[Crc & 0xFU];
+	}
+
+	return ~Crc;
+}
+/** @} */
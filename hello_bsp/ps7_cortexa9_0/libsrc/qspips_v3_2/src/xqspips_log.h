@@ -0,0 +1,224 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_log.h
+* @addtogroup qspips_v3_2
+* @{
+*
+* This header file contains the interface of a log structured record store
+* on top of the flash device layer (xqspips_flash.h). Records are appended
+* to the end of the log and read back in order; when the region fills up the
+* oldest sector is erased in the background and its records are dropped.
+*
+* A region of equally sized sectors is used. Each sector starts with a
+* header that is programmed in two steps:
+*	- right after the erase: magic, erase count and a CRC, which marks
+*	  the sector as erased and carries the wear count across resets;
+*	- when the sector is opened for writing: sequence number, number of
+*	  the first record and a CRC.
+* Each record is an 8 byte header (length and CRC32 of the data) followed
+* by the data, padded to 4 bytes. A record is valid only if its CRC
+* matches, so a record torn by a power failure is detected and ends its
+* sector. Flash is never programmed twice, and the sector written at the
+* time of a reset is closed by XQspiPs_LogMount(), so recovery does not
+* depend on the state of partially programmed pages.
+*
+* Appends are copied into a RAM page buffer and programmed one page at a
+* time through the queue of the flash layer, so an append costs a copy and
+* at most one queue submission. The sector to open next is the erased
+* sector with the lowest erase count. Erases are queued when fewer than
+* XQSPIPS_LOG_RESERVE_SECTORS sectors are erased or being erased; the
+* queue runs them without blocking the caller. The RAM index holds the
+* state, erase count, sequence and first record number of every sector.
+*
+* The log owns the completion handler of the flash layer. Functions must be
+* called from task context. Appended records can be read back once their
+* page has been programmed; XQspiPs_LogFlush() programs a partially filled
+* page.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XQSPIPS_LOG_H		/* prevent circular inclusions */
+#define XQSPIPS_LOG_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xqspips_flash.h"
+
+/************************** Constant Definitions *****************************/
+
+/** @name Log parameters
+ * @{
+ */
+#define XQSPIPS_LOG_MAX_SECTORS		256	/**< Sectors in a region */
+#define XQSPIPS_LOG_PAGE_BUFS		8	/**< RAM page buffers, power
+						  *  of 2 */
+#define XQSPIPS_LOG_RESERVE_SECTORS	2	/**< Erased sectors kept ahead
+						  *  of the writer */
+#define XQSPIPS_LOG_SECTOR_HDR_SIZE	32	/**< Sector header bytes */
+#define XQSPIPS_LOG_RECORD_HDR_SIZE	8	/**< Record header bytes */
+#define XQSPIPS_LOG_MAX_RECORD		((XQSPIPS_LOG_PAGE_BUFS - 2) * \
+					 XQSPIPS_FLASH_PAGE_SIZE - \
+					 XQSPIPS_LOG_RECORD_HDR_SIZE)
+					/**< Largest record, bounded by the
+					  *  page buffers */
+/* @} */
+
+/** @name Sector states in the RAM index
+ * @{
+ */
+#define XQSPIPS_LOG_SECTOR_DIRTY	0	/**< Must be erased */
+#define XQSPIPS_LOG_SECTOR_ERASING	1	/**< Erase queued */
+#define XQSPIPS_LOG_SECTOR_FREE		2	/**< Erased, header written */
+#define XQSPIPS_LOG_SECTOR_USED		3	/**< Holds records */
+/* @} */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * RAM index entry of a sector.
+ */
+typedef struct {
+	u8 State;		/**< One of XQSPIPS_LOG_SECTOR_* */
+	u32 EraseCount;		/**< Erases of the sector */
+	u32 Sequence;		/**< Order in which USED sectors were opened */
+	u32 FirstRecord;	/**< Number of the first record */
+	u32 EraseOp;		/**< Operation number of the queued erase */
+} XQspiPs_LogSector;
+
+/**
+ * Read position in the log, see XQspiPs_LogCursorInit().
+ */
+typedef struct {
+	u32 Sequence;		/**< Sequence of the sector being read */
+	u32 Offset;		/**< Offset of the next record in the sector */
+	u32 Record;		/**< Number of the next record */
+} XQspiPs_LogCursor;
+
+/**
+ * The log instance. All fields are private to the driver except the
+ * statistics.
+ */
+typedef struct {
+	XQspiPs_Flash *FlashPtr;	/**< Flash layer instance */
+	u32 BaseAddress;	/**< Flash address of the region */
+	u32 SectorSize;		/**< Sector size, 4 KB or erase sector */
+	u32 NumSectors;		/**< Sectors in the region */
+	u32 EraseType;		/**< XQSPIPS_FLASH_OP_ERASE_* */
+	u32 PageSize;		/**< Program page size of the flash layer */
+
+	XQspiPs_LogSector Sector[XQSPIPS_LOG_MAX_SECTORS];
+	u16 Order[XQSPIPS_LOG_MAX_SECTORS];	/**< USED sectors, oldest
+						  *  first */
+	u32 OrderHead;		/**< Oldest entry of Order */
+	u32 OrderCount;		/**< Entries in Order */
+	u16 Erasing[XQSPIPS_LOG_MAX_SECTORS];	/**< Erase queue order */
+	u32 ErasingHead;	/**< Oldest queued erase */
+	u32 ErasingCount;	/**< Queued erases */
+	u32 FreeCount;		/**< Sectors in FREE state */
+	u32 DirtyCount;		/**< Sectors in DIRTY state */
+	u32 MaxEraseCount;	/**< Highest known erase count */
+
+	u32 Active;		/**< Sector being written, or NumSectors */
+	u32 WriteOffset;	/**< Next free byte in the active sector */
+	u32 NextSequence;	/**< Sequence of the next opened sector */
+	u32 NextRecord;		/**< Number of the next appended record */
+
+	u8 PageBuf[XQSPIPS_LOG_PAGE_BUFS][XQSPIPS_FLASH_MAX_PAGE_SIZE];
+	u32 PageOp[XQSPIPS_LOG_PAGE_BUFS];	/**< Last operation using the
+						  *  buffer */
+	u32 PageIndex;		/**< Buffer of the current page */
+	u32 PageFlushed;	/**< Bytes of the current page submitted */
+	u8 HdrBuf[XQSPIPS_LOG_MAX_SECTORS][XQSPIPS_LOG_SECTOR_HDR_SIZE / 2];
+				/**< Header halves in flight, per sector */
+
+	u32 OpsSubmitted;	/**< Operations submitted to the flash layer */
+	volatile u32 OpsCompleted;	/**< Operations completed */
+	volatile u32 OpErrors;	/**< Operations that failed */
+
+	u32 UserBytes;		/**< Statistics: record data appended */
+	u32 ProgramBytes;	/**< Statistics: bytes programmed */
+	u32 Erases;		/**< Statistics: sectors erased */
+	u32 Dropped;		/**< Statistics: records lost to reclamation */
+} XQspiPs_Log;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/****************************************************************************/
+/**
+*
+* Get the number of the record the next append will get.
+*
+* @param	LogPtr is a pointer to the XQspiPs_Log instance.
+*
+* @return	The record number.
+*
+* @note		C-Style signature:
+*		u32 XQspiPs_LogNextRecord(XQspiPs_Log *LogPtr)
+*
+*****************************************************************************/
+#define XQspiPs_LogNextRecord(LogPtr)	((LogPtr)->NextRecord)
+
+/************************** Function Prototypes ******************************/
+
+/*
+ * Functions implemented in xqspips_log.c
+ */
+int XQspiPs_LogMount(XQspiPs_Log *LogPtr, XQspiPs_Flash *FlashPtr,
+		     u32 BaseAddress, u32 SectorSize, u32 NumSectors);
+int XQspiPs_LogFormat(XQspiPs_Log *LogPtr);
+int XQspiPs_LogAppend(XQspiPs_Log *LogPtr, const u8 *DataPtr, u32 ByteCount);
+int XQspiPs_LogFlush(XQspiPs_Log *LogPtr);
+void XQspiPs_LogService(XQspiPs_Log *LogPtr);
+void XQspiPs_LogCursorInit(XQspiPs_Log *LogPtr, XQspiPs_LogCursor *CursorPtr);
+int XQspiPs_LogRead(XQspiPs_Log *LogPtr, XQspiPs_LogCursor *CursorPtr,
+		    u8 *BufPtr, u32 BufSize, u32 *ByteCountPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/** @} */
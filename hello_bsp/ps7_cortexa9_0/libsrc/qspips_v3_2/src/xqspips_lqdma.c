@@ -0,0 +1,582 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_lqdma.c
+* @addtogroup qspips_v3_2
+* @{
+*
+* Contains the DMA backed asynchronous linear QSPI read functions of the
+* XQspiPs driver. See xqspips_lqdma.h for an overview.
+*
+* A read is split into commands of at most XQSPIPS_LQDMA_CHUNK_SIZE bytes
+* which are chained from the DMA done interrupt. Only one command is on the
+* channel at a time, either a chunk of the current read or a prefetch into
+* the staging buffer. A read issued while a prefetch is running is queued
+* and started from the done interrupt of the prefetch, since it is most
+* likely served from the staging buffer anyway.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+*                    The linear window is 32 MB in dual stacked and dual
+*                    parallel mode.
+*       ag  10/18/26 A staging buffer in a coherent region is not
+*                    invalidated, see xil_coherent.h.
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+
+#ifdef XPAR_XDMAPS_NUM_INSTANCES
+#include "xqspips_lqdma.h"
+#include "xil_cache.h"
+#include "xil_coherent.h"
+#include "xil_exception.h"
+
+/************************** Constant Definitions *****************************/
+
+#ifndef XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR
+#define	XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR 0xFC000000
+#endif
+
+#ifndef XPAR_PS7_QSPI_LINEAR_0_S_AXI_HIGHADDR
+#define	XPAR_PS7_QSPI_LINEAR_0_S_AXI_HIGHADDR 0xFCFFFFFF
+#endif
+
+#define XQSPIPS_LQDMA_WINDOW_SIZE	(XPAR_PS7_QSPI_LINEAR_0_S_AXI_HIGHADDR - \
+					 XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR + 1)
+
+/*
+ * With two devices, stacked or parallel, the linear window spans 32 MB
+ */
+#define XQSPIPS_LQDMA_DUAL_WINDOW_SIZE	0x2000000
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Size of the linear window for the connection mode of the QSPI instance
+ */
+#define XQspiPs_LqspiDmaWindow(LqPtr)					\
+	(((LqPtr)->QspiPtr->Config.ConnectionMode ==			\
+	  XQSPIPS_CONNECTION_MODE_SINGLE) ?				\
+	 XQSPIPS_LQDMA_WINDOW_SIZE : XQSPIPS_LQDMA_DUAL_WINDOW_SIZE)
+
+/************************** Function Prototypes ******************************/
+
+static int XQspiPs_LqspiDmaStartCmd(XQspiPs_LqspiDma *LqPtr, u8 *DstPtr,
+				    u32 Address, u32 ByteCount);
+static void XQspiPs_LqspiDmaServe(XQspiPs_LqspiDma *LqPtr);
+static void XQspiPs_LqspiDmaNext(XQspiPs_LqspiDma *LqPtr);
+static void XQspiPs_LqspiDmaComplete(XQspiPs_LqspiDma *LqPtr, int Status);
+static void XQspiPs_LqspiDmaPrefetch(XQspiPs_LqspiDma *LqPtr);
+static void XQspiPs_LqspiDmaDone(unsigned int Channel, XDmaPs_Cmd *DmaCmd,
+				 void *CallbackRef);
+static void StubLqspiDmaHandler(void *CallBackRef, u8 *RecvBufPtr,
+				unsigned ByteCount, int Status);
+
+/************************** Variable Definitions *****************************/
+
+/*****************************************************************************/
+/**
+*
+* Initializes a DMA backed linear read instance and installs its done
+* handler on the given DMA channel.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+* @param	QspiPtr is a pointer to an initialized XQspiPs instance.
+* @param	DmaPtr is a pointer to an initialized XDmaPs instance.
+* @param	Channel is the DMA channel dedicated to linear reads.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_FAILURE if the done handler could not be installed.
+*
+* @note		Read-ahead is disabled until XQspiPs_LqspiDmaSetReadAhead()
+*		is called.
+*
+******************************************************************************/
+int XQspiPs_LqspiDmaInitialize(XQspiPs_LqspiDma *LqPtr, XQspiPs *QspiPtr,
+				XDmaPs *DmaPtr, unsigned int Channel)
+{
+	Xil_AssertNonvoid(LqPtr != NULL);
+	Xil_AssertNonvoid(QspiPtr != NULL);
+	Xil_AssertNonvoid(DmaPtr != NULL);
+	Xil_AssertNonvoid(QspiPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	memset(LqPtr, 0, sizeof(XQspiPs_LqspiDma));
+
+	LqPtr->QspiPtr = QspiPtr;
+	LqPtr->DmaPtr = DmaPtr;
+	LqPtr->Channel = Channel;
+	LqPtr->Status = XST_SUCCESS;
+	LqPtr->Handler = StubLqspiDmaHandler;
+
+	/* No read yet, so that the first one is never taken as sequential */
+	LqPtr->NextAddress = 0xFFFFFFFFU;
+
+	/*
+	 * Incrementing word bursts on both sides; unaligned heads and tails
+	 * are handled by the DMA program generator.
+	 */
+	LqPtr->DmaCmd.ChanCtrl.SrcBurstSize = XQSPIPS_LQDMA_BURST_SIZE;
+	LqPtr->DmaCmd.ChanCtrl.SrcBurstLen = XQSPIPS_LQDMA_BURST_LEN;
+	LqPtr->DmaCmd.ChanCtrl.SrcInc = 1;
+	LqPtr->DmaCmd.ChanCtrl.DstBurstSize = XQSPIPS_LQDMA_BURST_SIZE;
+	LqPtr->DmaCmd.ChanCtrl.DstBurstLen = XQSPIPS_LQDMA_BURST_LEN;
+	LqPtr->DmaCmd.ChanCtrl.DstInc = 1;
+
+	return XDmaPs_SetDoneHandler(DmaPtr, Channel, XQspiPs_LqspiDmaDone,
+				     LqPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the callback invoked when an asynchronous linear read completes, from
+* the DMA done interrupt, or from XQspiPs_LqspiReadAsync() in the caller's
+* context when the read is served entirely from the staging buffer.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+* @param	FuncPtr is the pointer to the callback function.
+* @param	CallBackRef is the upper layer callback reference passed back
+*		when the callback function is invoked.
+*
+* @return	None.
+*
+* @note		The callback may start the next read with
+*		XQspiPs_LqspiReadAsync().
+*
+******************************************************************************/
+void XQspiPs_LqspiDmaSetHandler(XQspiPs_LqspiDma *LqPtr,
+				XQspiPs_LqspiDmaHandler FuncPtr,
+				void *CallBackRef)
+{
+	Xil_AssertVoid(LqPtr != NULL);
+	Xil_AssertVoid(FuncPtr != NULL);
+
+	LqPtr->Handler = FuncPtr;
+	LqPtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+*
+* Attaches or detaches the read-ahead staging buffer. While attached, every
+* read that starts where the previous read ended triggers a prefetch of the
+* following StageSize bytes of flash into the buffer.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+* @param	StagePtr is the staging buffer, or NULL to disable read-ahead.
+* @param	StageSize is the size of the staging buffer in bytes, at most
+*		XQSPIPS_LQDMA_CHUNK_SIZE. Cache line multiples avoid sharing
+*		lines with other data.
+*
+* @return
+*		- XST_SUCCESS if successful.
+*		- XST_DEVICE_BUSY if a read or prefetch is in progress.
+*
+* @note		None.
+*
+******************************************************************************/
+int XQspiPs_LqspiDmaSetReadAhead(XQspiPs_LqspiDma *LqPtr, u8 *StagePtr,
+				 unsigned StageSize)
+{
+	Xil_AssertNonvoid(LqPtr != NULL);
+	Xil_AssertNonvoid((StagePtr == NULL) ||
+			  ((StageSize > 0) &&
+			   (StageSize <= XQSPIPS_LQDMA_CHUNK_SIZE)));
+
+	if (LqPtr->IsBusy || LqPtr->StageBusy) {
+		return XST_DEVICE_BUSY;
+	}
+
+	LqPtr->StagePtr = StagePtr;
+	LqPtr->StageSize = (StagePtr != NULL) ? StageSize : 0;
+	LqPtr->StageBytes = 0;
+	LqPtr->StageHits = 0;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Starts an asynchronous read from the linear QSPI window into memory. The
+* function returns once the first DMA command is queued; completion is
+* reported to the handler set with XQspiPs_LqspiDmaSetHandler().
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+* @param	RecvBufPtr is the buffer the data is read to.
+* @param	Address is the offset in the linear window to read from.
+* @param	ByteCount is the number of bytes to read.
+*
+* @return
+*		- XST_SUCCESS if the read was started.
+*		- XST_DEVICE_BUSY if a read is already in progress.
+*		- XST_INVALID_PARAM if the range exceeds the linear window.
+*		- XST_FAILURE if the controller is not in linear mode.
+*
+* @note		The buffer must not be accessed until the read completes.
+*		Data cache maintenance for the buffer is done by XDmaPs.
+*
+******************************************************************************/
+int XQspiPs_LqspiReadAsync(XQspiPs_LqspiDma *LqPtr, u8 *RecvBufPtr,
+			   u32 Address, unsigned ByteCount)
+{
+	u32 CpsrVal;
+
+	Xil_AssertNonvoid(LqPtr != NULL);
+	Xil_AssertNonvoid(RecvBufPtr != NULL);
+	Xil_AssertNonvoid(ByteCount > 0);
+
+	if (LqPtr->IsBusy) {
+		return XST_DEVICE_BUSY;
+	}
+
+	if ((Address >= XQspiPs_LqspiDmaWindow(LqPtr)) ||
+	    (ByteCount > (XQspiPs_LqspiDmaWindow(LqPtr) - Address))) {
+		return XST_INVALID_PARAM;
+	}
+
+	/*
+	 * Enable the controller
+	 */
+	XQspiPs_Enable(LqPtr->QspiPtr);
+
+	if ((XQspiPs_GetLqspiConfigReg(LqPtr->QspiPtr) &
+	     XQSPIPS_LQSPI_CR_LINEAR_MASK) == 0) {
+		return XST_FAILURE;
+	}
+
+	LqPtr->RecvBufPtr = RecvBufPtr;
+	LqPtr->Address = Address;
+	LqPtr->ByteCount = ByteCount;
+	LqPtr->DoneBytes = 0;
+	LqPtr->Sequential = (Address == LqPtr->NextAddress);
+	LqPtr->NextAddress = Address + ByteCount;
+	LqPtr->Status = XST_SUCCESS;
+	LqPtr->IsBusy = TRUE;
+
+	/*
+	 * The prefetch may complete at any time, so decide under masked IRQs
+	 * whether the read is started now or by the prefetch done interrupt.
+	 */
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+	if (LqPtr->StageBusy) {
+		LqPtr->Pending = TRUE;
+		mtcpsr(CpsrVal);
+	} else {
+		mtcpsr(CpsrVal);
+		XQspiPs_LqspiDmaServe(LqPtr);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Waits for the asynchronous read in progress, if any, to complete.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+*
+* @return	The status of the last read, XST_SUCCESS or XST_FAILURE.
+*
+* @note		The DMA done interrupt must be enabled since completion is
+*		detected from it.
+*
+******************************************************************************/
+int XQspiPs_LqspiDmaWait(XQspiPs_LqspiDma *LqPtr)
+{
+	Xil_AssertNonvoid(LqPtr != NULL);
+
+	while (LqPtr->IsBusy) {
+		/* Wait for the done interrupt */
+	}
+
+	return LqPtr->Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Copies the part of the current read that is held in the staging buffer and
+* starts the DMA for the rest.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LqspiDmaServe(XQspiPs_LqspiDma *LqPtr)
+{
+	u32 Offset;
+	u32 Copy;
+
+	if ((LqPtr->StageBytes != 0) &&
+	    (LqPtr->Address >= LqPtr->StageAddress) &&
+	    ((LqPtr->Address - LqPtr->StageAddress) < LqPtr->StageBytes)) {
+		Offset = LqPtr->Address - LqPtr->StageAddress;
+		Copy = LqPtr->StageBytes - Offset;
+		if (Copy > LqPtr->ByteCount) {
+			Copy = LqPtr->ByteCount;
+		}
+
+		memcpy(LqPtr->RecvBufPtr, &LqPtr->StagePtr[Offset], Copy);
+		LqPtr->DoneBytes = Copy;
+		LqPtr->StageHits += Copy;
+	}
+
+	XQspiPs_LqspiDmaNext(LqPtr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Starts the next DMA command of the current read, or completes the read if
+* all bytes have been transferred.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LqspiDmaNext(XQspiPs_LqspiDma *LqPtr)
+{
+	u32 Remaining = LqPtr->ByteCount - LqPtr->DoneBytes;
+	int Status;
+
+	if (Remaining == 0) {
+		XQspiPs_LqspiDmaComplete(LqPtr, XST_SUCCESS);
+		return;
+	}
+
+	if (Remaining > XQSPIPS_LQDMA_CHUNK_SIZE) {
+		Remaining = XQSPIPS_LQDMA_CHUNK_SIZE;
+	}
+
+	Status = XQspiPs_LqspiDmaStartCmd(LqPtr,
+					  LqPtr->RecvBufPtr + LqPtr->DoneBytes,
+					  LqPtr->Address + LqPtr->DoneBytes,
+					  Remaining);
+	if (Status != XST_SUCCESS) {
+		XQspiPs_LqspiDmaComplete(LqPtr, XST_FAILURE);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Finishes the current read. For a sequential read the prefetch of the
+* following region is started before the handler is called, so a read
+* issued from the handler finds the data staged.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+* @param	Status is the result of the read.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LqspiDmaComplete(XQspiPs_LqspiDma *LqPtr, int Status)
+{
+	if ((Status == XST_SUCCESS) && (LqPtr->StagePtr != NULL) &&
+	    LqPtr->Sequential) {
+		XQspiPs_LqspiDmaPrefetch(LqPtr);
+	}
+
+	LqPtr->Status = Status;
+	LqPtr->IsBusy = FALSE;
+
+	LqPtr->Handler(LqPtr->CallBackRef, LqPtr->RecvBufPtr,
+		       LqPtr->ByteCount, Status);
+}
+
+/*****************************************************************************/
+/**
+*
+* Starts filling the staging buffer with the flash region that follows the
+* last read, unless that region is already staged.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LqspiDmaPrefetch(XQspiPs_LqspiDma *LqPtr)
+{
+	u32 Address = LqPtr->NextAddress;
+	u32 Bytes = LqPtr->StageSize;
+
+	if (Address >= XQspiPs_LqspiDmaWindow(LqPtr)) {
+		return;
+	}
+	if (Bytes > (XQspiPs_LqspiDmaWindow(LqPtr) - Address)) {
+		Bytes = XQspiPs_LqspiDmaWindow(LqPtr) - Address;
+	}
+
+	if ((Address >= LqPtr->StageAddress) &&
+	    ((Address - LqPtr->StageAddress) + Bytes <= LqPtr->StageBytes)) {
+		return;
+	}
+
+	LqPtr->StageAddress = Address;
+	LqPtr->StageBytes = 0;
+	LqPtr->StageBusy = TRUE;
+
+	if (XQspiPs_LqspiDmaStartCmd(LqPtr, LqPtr->StagePtr, Address,
+				     Bytes) != XST_SUCCESS) {
+		LqPtr->StageBusy = FALSE;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Programs one DMA command from the linear window to memory.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+* @param	DstPtr is the destination in memory.
+* @param	Address is the offset in the linear window.
+* @param	ByteCount is the number of bytes, at most
+*		XQSPIPS_LQDMA_CHUNK_SIZE.
+*
+* @return	The status returned by XDmaPs_Start().
+*
+* @note		None.
+*
+******************************************************************************/
+static int XQspiPs_LqspiDmaStartCmd(XQspiPs_LqspiDma *LqPtr, u8 *DstPtr,
+				    u32 Address, u32 ByteCount)
+{
+	XDmaPs_Cmd *CmdPtr = &LqPtr->DmaCmd;
+
+	CmdPtr->BD.SrcAddr = XPAR_PS7_QSPI_LINEAR_0_S_AXI_BASEADDR + Address;
+	CmdPtr->BD.DstAddr = (u32)DstPtr;
+	CmdPtr->BD.Length = ByteCount;
+	CmdPtr->GeneratedDmaProg = NULL;
+	CmdPtr->GeneratedDmaProgLength = 0;
+	LqPtr->CmdBytes = ByteCount;
+
+	return XDmaPs_Start(LqPtr->DmaPtr, LqPtr->Channel, CmdPtr, 0);
+}
+
+/*****************************************************************************/
+/**
+*
+* DMA done handler of the linear read channel. Called by XDmaPs from the
+* done interrupt of the channel.
+*
+* @param	Channel is the DMA channel.
+* @param	DmaCmd is the completed DMA command.
+* @param	CallbackRef is the XQspiPs_LqspiDma instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void XQspiPs_LqspiDmaDone(unsigned int Channel, XDmaPs_Cmd *DmaCmd,
+				 void *CallbackRef)
+{
+	XQspiPs_LqspiDma *LqPtr = (XQspiPs_LqspiDma *)CallbackRef;
+
+	(void)Channel;
+	(void)DmaCmd;
+
+	if (LqPtr->StageBusy) {
+		/*
+		 * The CPU reads the staging buffer itself, drop any lines
+		 * speculatively fetched while the DMA was running.
+		 */
+		if (Xil_IsCoherent((INTPTR)LqPtr->StagePtr,
+				   LqPtr->CmdBytes) == 0U) {
+			Xil_DCacheInvalidateRange((u32)LqPtr->StagePtr,
+						  LqPtr->CmdBytes);
+		}
+		LqPtr->StageBytes = LqPtr->CmdBytes;
+		LqPtr->StageBusy = FALSE;
+
+		if (LqPtr->Pending) {
+			LqPtr->Pending = FALSE;
+			XQspiPs_LqspiDmaServe(LqPtr);
+		}
+	} else {
+		LqPtr->DoneBytes += LqPtr->CmdBytes;
+		XQspiPs_LqspiDmaNext(LqPtr);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is a stub for the completion callback. The stub is here in case the
+* upper layers do not set the handler.
+*
+* @param	CallBackRef is a pointer to the upper layer callback reference
+* @param	RecvBufPtr is the buffer of the completed read
+* @param	ByteCount is the number of bytes read
+* @param	Status is the result of the read
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void StubLqspiDmaHandler(void *CallBackRef, u8 *RecvBufPtr,
+				unsigned ByteCount, int Status)
+{
+	(void) CallBackRef;
+	(void) RecvBufPtr;
+	(void) ByteCount;
+	(void) Status;
+}
+#endif /* XPAR_XDMAPS_NUM_INSTANCES */
+/** @} */
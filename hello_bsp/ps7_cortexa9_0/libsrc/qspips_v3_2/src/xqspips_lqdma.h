@@ -0,0 +1,180 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_lqdma.h
+* @addtogroup qspips_v3_2
+* @{
+*
+* This header file contains the interface of the DMA backed linear QSPI read
+* support of the XQspiPs driver.
+*
+* XQspiPs_LqspiRead() copies from the linear QSPI window with the CPU, which
+* keeps the core busy for the whole flash access. The functions declared
+* here instead program a PL330 (XDmaPs) channel to move the data from the
+* linear window to memory and return immediately. Completion is reported
+* through a callback, normally from the DMA done interrupt, or can be waited
+* for with XQspiPs_LqspiDmaWait().
+*
+* Optionally a staging buffer can be attached with
+* XQspiPs_LqspiDmaSetReadAhead(). When a read continues where the previous
+* one ended, the driver then prefetches the following flash region into the
+* staging buffer while the application processes the data, and serves the
+* next read from it.
+*
+* The application owns the XDmaPs instance, connects its done and fault
+* interrupts to the interrupt controller and dedicates one channel to an
+* XQspiPs_LqspiDma instance. The QSPI controller must be in linear mode.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.2   ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XQSPIPS_LQDMA_H		/* prevent circular inclusions */
+#define XQSPIPS_LQDMA_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xqspips.h"
+#include "xdmaps.h"
+
+/************************** Constant Definitions *****************************/
+
+/** @name Linear DMA read parameters
+ * @{
+ */
+#define XQSPIPS_LQDMA_BURST_SIZE	4	/**< AXI beat size in bytes */
+#define XQSPIPS_LQDMA_BURST_LEN		16	/**< Beats per AXI burst */
+#define XQSPIPS_LQDMA_CHUNK_SIZE	0x100000 /**< Bytes per DMA command, a
+						   *  PL330 program covers at
+						   *  most 64K bursts */
+/* @} */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * Completion callback of an asynchronous linear read, called from the DMA
+ * done interrupt. A read that completes within XQspiPs_LqspiReadAsync(),
+ * because it is served entirely from the staging buffer, calls it from
+ * there in the context of the caller.
+ *
+ * @param	CallBackRef is the reference given to
+ *		XQspiPs_LqspiDmaSetHandler().
+ * @param	RecvBufPtr is the buffer of the completed read.
+ * @param	ByteCount is the number of bytes read.
+ * @param	Status is XST_SUCCESS, or XST_FAILURE if a DMA command could
+ *		not be started.
+ */
+typedef void (*XQspiPs_LqspiDmaHandler) (void *CallBackRef, u8 *RecvBufPtr,
+					  unsigned ByteCount, int Status);
+
+/**
+ * The DMA backed linear read instance. The user allocates one per DMA
+ * channel; all fields are private to the driver.
+ */
+typedef struct {
+	XQspiPs *QspiPtr;	/**< QSPI instance in linear mode */
+	XDmaPs *DmaPtr;		/**< DMA instance owning the channel */
+	unsigned int Channel;	/**< DMA channel used for reads */
+	XDmaPs_Cmd DmaCmd;	/**< Command of the running transfer */
+	u32 CmdBytes;		/**< Bytes moved by the running command */
+
+	u8 *RecvBufPtr;		/**< Buffer of the current read */
+	u32 Address;		/**< Flash offset of the current read */
+	u32 ByteCount;		/**< Size of the current read */
+	u32 DoneBytes;		/**< Bytes of the current read completed */
+	volatile u32 IsBusy;	/**< A read is in progress */
+	volatile int Status;	/**< Result of the last read */
+	u32 NextAddress;	/**< Flash offset following the last read */
+	u32 Sequential;		/**< Current read follows the last one */
+
+	u8 *StagePtr;		/**< Read-ahead buffer, NULL if disabled */
+	u32 StageSize;		/**< Size of the read-ahead buffer */
+	u32 StageAddress;	/**< Flash offset held in the buffer */
+	u32 StageBytes;		/**< Valid bytes in the buffer */
+	volatile u32 StageBusy;	/**< A prefetch is in progress */
+	u32 Pending;		/**< A read waits for the prefetch */
+	u32 StageHits;		/**< Bytes served from the buffer */
+
+	XQspiPs_LqspiDmaHandler Handler;
+	void *CallBackRef;	/**< Callback reference for the handler */
+} XQspiPs_LqspiDma;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/****************************************************************************/
+/**
+*
+* Check whether an asynchronous linear read is in progress.
+*
+* @param	LqPtr is a pointer to the XQspiPs_LqspiDma instance.
+*
+* @return	TRUE if a read is in progress, FALSE otherwise.
+*
+* @note		C-Style signature:
+*		u32 XQspiPs_LqspiDmaIsBusy(XQspiPs_LqspiDma *LqPtr)
+*
+*****************************************************************************/
+#define XQspiPs_LqspiDmaIsBusy(LqPtr)	((LqPtr)->IsBusy)
+
+/************************** Function Prototypes ******************************/
+
+/*
+ * Functions implemented in xqspips_lqdma.c
+ */
+int XQspiPs_LqspiDmaInitialize(XQspiPs_LqspiDma *LqPtr, XQspiPs *QspiPtr,
+				XDmaPs *DmaPtr, unsigned int Channel);
+void XQspiPs_LqspiDmaSetHandler(XQspiPs_LqspiDma *LqPtr,
+				XQspiPs_LqspiDmaHandler FuncPtr,
+				void *CallBackRef);
+int XQspiPs_LqspiDmaSetReadAhead(XQspiPs_LqspiDma *LqPtr, u8 *StagePtr,
+				 unsigned StageSize);
+int XQspiPs_LqspiReadAsync(XQspiPs_LqspiDma *LqPtr, u8 *RecvBufPtr,
+			   u32 Address, unsigned ByteCount);
+int XQspiPs_LqspiDmaWait(XQspiPs_LqspiDma *LqPtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/** @} */
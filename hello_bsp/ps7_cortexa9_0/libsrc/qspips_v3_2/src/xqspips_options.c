@@ -58,6 +58,9 @@
 *
 * 2.02a hk  26/03/13 Removed XQspi_Reset() in Set_Options() function when
 *			 LQSPI_MODE_OPTION is set. Moved Enable() to XQpsiPs_LqspiRead().
+* 3.2   ag  10/18/26 Added XQspiPs_SetConnectionMode() and
+*		     XQspiPs_SelectPage() for dual stacked and dual parallel
+*		     flash connections.
 *</pre>
 *
 ******************************************************************************/
@@ -425,4 +428,82 @@ void XQspiPs_GetDelays(XQspiPs *InstancePtr, u8 *DelayNss, u8 *DelayBtwn,
 	*DelayNss = (u8)((DelayRegister & XQSPIPS_DR_NSS_MASK) >>
 			  XQSPIPS_DR_NSS_SHIFT);
 }
+
+/*****************************************************************************/
+/**
+*
+* Programs the two memory and separate bus bits of the linear configuration
+* register from the ConnectionMode of the instance, leaving the other bits
+* untouched. The bits apply to both linear and I/O mode: in dual parallel
+* mode the controller stripes the data across the two devices, each holding
+* half of every byte pair, and sends command and address bytes to both; in
+* dual stacked mode the devices share the bus and XQspiPs_SelectPage()
+* chooses the one used in I/O mode.
+*
+* @param	InstancePtr is a pointer to the XQspiPs instance.
+*
+* @return	None.
+*
+* @note		XQspiPs_LinearInit() does the same for the boot time linear
+*		setup.
+*
+******************************************************************************/
+void XQspiPs_SetConnectionMode(XQspiPs *InstancePtr)
+{
+	u32 LqspiCr;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	LqspiCr = XQspiPs_GetLqspiConfigReg(InstancePtr);
+	LqspiCr &= ~(XQSPIPS_LQSPI_CR_TWO_MEM_MASK |
+		     XQSPIPS_LQSPI_CR_SEP_BUS_MASK |
+		     XQSPIPS_LQSPI_CR_U_PAGE_MASK);
+
+	if (InstancePtr->Config.ConnectionMode ==
+			XQSPIPS_CONNECTION_MODE_STACKED) {
+		LqspiCr |= XQSPIPS_LQSPI_CR_TWO_MEM_MASK;
+	} else if (InstancePtr->Config.ConnectionMode ==
+			XQSPIPS_CONNECTION_MODE_PARALLEL) {
+		LqspiCr |= XQSPIPS_LQSPI_CR_TWO_MEM_MASK |
+			   XQSPIPS_LQSPI_CR_SEP_BUS_MASK;
+	}
+
+	XQspiPs_SetLqspiConfigReg(InstancePtr, LqspiCr);
+}
+
+/*****************************************************************************/
+/**
+*
+* Selects the lower or upper device for I/O mode transfers in dual stacked
+* mode by programming the upper page bit of the linear configuration
+* register. The register is only written when the selection changes.
+*
+* @param	InstancePtr is a pointer to the XQspiPs instance.
+* @param	Upper is TRUE to select the upper device, FALSE for the lower.
+*
+* @return	None.
+*
+* @note		Must not be called while a transfer is in progress. Has no
+*		effect on the devices in the other connection modes.
+*
+******************************************************************************/
+void XQspiPs_SelectPage(XQspiPs *InstancePtr, u32 Upper)
+{
+	u32 LqspiCr;
+	u32 NewCr;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	LqspiCr = XQspiPs_GetLqspiConfigReg(InstancePtr);
+	if (Upper) {
+		NewCr = LqspiCr | XQSPIPS_LQSPI_CR_U_PAGE_MASK;
+	} else {
+		NewCr = LqspiCr & ~XQSPIPS_LQSPI_CR_U_PAGE_MASK;
+	}
+
+	if (NewCr != LqspiCr) {
+		XQspiPs_SetLqspiConfigReg(InstancePtr, NewCr);
+	}
+}
 /** @} */
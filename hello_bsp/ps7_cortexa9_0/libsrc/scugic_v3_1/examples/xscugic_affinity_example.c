@@ -0,0 +1,359 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xscugic_affinity_example.c
+*
+* Shows XScuGic_AffinityBalance() spreading interrupt load over both CPUs.
+* The driver must be built with XSCUGIC_STATS defined and the BSP with
+* USE_SMP=1 so that CPU1 can be started.
+*
+* CPU1 is started with the task pool worker, which sets up its GIC CPU
+* interface and sleeps in WFI, so it is free to take interrupts. The load of
+* an EMAC, an SD and a USB controller is emulated by setting the pending bits
+* of their interrupt IDs from the main loop; the handlers busy wait for a
+* different time each, like the receive paths of the real drivers. All three
+* IDs start on CPU0. After every window of WINDOW_MS milliseconds the balancer
+* runs and the handler load of each CPU in percent, before and after the
+* window's rebalancing, is printed together with the number of IDs moved.
+*
+* The first window puts all of the load on CPU0, the balancer then moves the
+* heaviest IDs to CPU1 and the later windows show the load split and no
+* further moves.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.02  ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xscugic.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xil_smp.h"
+#include "xil_taskpool.h"
+#include "xpm_counter.h"
+#include "xtime_l.h"
+
+/* XScuGic_AffinityBalance() and its report only exist in this build */
+#ifndef XSCUGIC_STATS
+#error "build the scugic driver and this example with XSCUGIC_STATS"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define INTC_DEVICE_ID		XPAR_SCUGIC_0_DEVICE_ID
+
+#define EMAC_INTR_ID		XPS_GEM0_INT_ID
+#define SD_INTR_ID		XPS_SDIO0_INT_ID
+#define USB_INTR_ID		XPS_USB0_INT_ID
+
+#define EMAC_US			40U
+#define SD_US			25U
+#define USB_US			10U
+#define RAISE_US		100U	/* Period of the emulated events */
+
+#define LOAD_PRIORITY		0xA0U
+#define TRIGGER_RISING		0x3U
+
+#define WINDOW_MS		200U
+#define NUM_WINDOWS		5U
+
+#define NUM_SOURCES		3U
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u32 IntrId;
+	u32 BusyUs;
+	const char *Name;
+} LoadSource;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int ScuGicAffinityExample(void);
+static int SetupInterrupts(void);
+static void Cpu1Entry(void);
+static void RaiseLoad(void);
+static void LoadHandler(void *CallBackRef);
+static void BusyWaitUs(u32 Us);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic IntcInstance;
+
+static const LoadSource Sources[NUM_SOURCES] = {
+	{EMAC_INTR_ID, EMAC_US, "emac"},
+	{SD_INTR_ID, SD_US, "sd"},
+	{USB_INTR_ID, USB_US, "usb"},
+};
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return ScuGicAffinityExample();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Starts CPU1, raises the emulated load and rebalances after every window.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int ScuGicAffinityExample(void)
+{
+	XScuGic_AffinityReport Report;
+	XTime Start;
+	XTime Now;
+	u32 Window;
+	u32 Cpu;
+	u32 Index;
+
+	Xpm_EnableCycleCounter();
+
+	if (SetupInterrupts() != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (Xil_TaskPoolInit(&IntcInstance) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (Xil_SmpStartCpu1(Cpu1Entry) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	(void)XScuGic_AffinityBalance(&IntcInstance, XSCUGIC_NUM_CPUS, NULL);
+
+	xil_printf("\r\nInterrupt affinity balancing, %d ms windows\r\n",
+		   WINDOW_MS);
+	xil_printf("window  cpu0 %%  cpu1 %%  -> cpu0 %%  cpu1 %%  moved\r\n");
+
+	for (Window = 0U; Window < NUM_WINDOWS; Window++) {
+		XTime_GetTime(&Start);
+		do {
+			RaiseLoad();
+			BusyWaitUs(RAISE_US);
+			XTime_GetTime(&Now);
+		} while ((Now - Start) <
+			 ((XTime)COUNTS_PER_SECOND * WINDOW_MS / 1000U));
+
+		if (XScuGic_AffinityBalance(&IntcInstance, XSCUGIC_NUM_CPUS,
+					    &Report) != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		xil_printf("%6d", Window);
+		for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+			xil_printf("  %6d", (u32)((Report.LoadBefore[Cpu] * 100U) /
+						  Report.WindowCycles));
+		}
+		xil_printf("  ");
+		for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+			xil_printf("  %6d", (u32)((Report.LoadAfter[Cpu] * 100U) /
+						  Report.WindowCycles));
+		}
+		xil_printf("  %5d\r\n", Report.Moved);
+	}
+
+	for (Index = 0U; Index < NUM_SOURCES; Index++) {
+		XScuGic_Disable(&IntcInstance, Sources[Index].IntrId);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the GIC and connects the emulated load sources, all targeting
+* CPU0.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int SetupInterrupts(void)
+{
+	XScuGic_Config *IntcConfig;
+	int Status;
+	u32 Index;
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (IntcConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(&IntcInstance, IntcConfig,
+				       IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			&IntcInstance);
+
+	for (Index = 0U; Index < NUM_SOURCES; Index++) {
+		XScuGic_SetPriorityTriggerType(&IntcInstance,
+					       Sources[Index].IntrId,
+					       LOAD_PRIORITY, TRIGGER_RISING);
+		XScuGic_InterruptMaptoCpu(&IntcInstance, 0U,
+					  Sources[Index].IntrId);
+		Status = XScuGic_Connect(&IntcInstance, Sources[Index].IntrId,
+					 LoadHandler,
+					 (void *)&Sources[Index]);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		XScuGic_Enable(&IntcInstance, Sources[Index].IntrId);
+	}
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Entry of CPU1. Starts its cycle counter for the statistics and runs the
+* task pool worker, which takes interrupts while it waits for tasks.
+*
+* @param	None
+*
+* @return	Does not return.
+*
+* @note		None
+*
+******************************************************************************/
+static void Cpu1Entry(void)
+{
+	Xpm_EnableCycleCounter();
+	Xil_TaskPoolWorker();
+}
+
+/*****************************************************************************/
+/**
+*
+* Sets the pending bit of every emulated load source.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RaiseLoad(void)
+{
+	u32 Index;
+	u32 IntrId;
+
+	for (Index = 0U; Index < NUM_SOURCES; Index++) {
+		IntrId = Sources[Index].IntrId;
+		XScuGic_DistWriteReg(&IntcInstance,
+			XSCUGIC_EN_DIS_OFFSET_CALC(XSCUGIC_PENDING_SET_OFFSET,
+						   IntrId),
+			(u32)1U << (IntrId % 32U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Load handler, busy waits for the time of its source.
+*
+* @param	CallBackRef is the LoadSource of the interrupt.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void LoadHandler(void *CallBackRef)
+{
+	const LoadSource *SourcePtr = (const LoadSource *)CallBackRef;
+
+	BusyWaitUs(SourcePtr->BusyUs);
+}
+
+/*****************************************************************************/
+/**
+*
+* Busy waits on the global timer.
+*
+* @param	Us is the time in microseconds.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void BusyWaitUs(u32 Us)
+{
+	XTime Start;
+	XTime Now;
+
+	XTime_GetTime(&Start);
+	do {
+		XTime_GetTime(&Now);
+	} while ((Now - Start) < ((XTime)COUNTS_PER_SECOND * Us / 1000000U));
+}
@@ -0,0 +1,286 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xscugic_fiq_bench.c
+*
+* Compares the entry latency of an interrupt serviced through the IRQ path
+* (asm_vectors.S, XExc_VectorTable, XScuGic_InterruptHandler and the GIC
+* handler table) with the FIQ fast path installed by XScuGic_SetFiq().
+*
+* The private timer of the CPU stands in for the PL interrupt: it runs in auto
+* reload mode and its handler reads the counter first thing, the counts since
+* the reload are the latency from the timer event to the handler. The
+* minimum, average and maximum latency in nanoseconds are printed for both
+* paths. The handler uses integer code only, as required on the FIQ path.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.02  ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xscugic.h"
+#include "xscutimer.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+
+/************************** Constant Definitions *****************************/
+
+#define INTC_DEVICE_ID		XPAR_SCUGIC_0_DEVICE_ID
+#define TIMER_DEVICE_ID		XPAR_XSCUTIMER_0_DEVICE_ID
+#define TIMER_IRPT_INTR		XPAR_SCUTIMER_INTR
+
+#define TIMER_HZ		(XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2U)
+#define TIMER_LOAD		(TIMER_HZ / 10000U)	/* 100 us period */
+
+#define TIMER_PRIORITY		0x00U
+#define TRIGGER_RISING		0x3U
+
+#define BENCH_SAMPLES		10000U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int ScuGicFiqBench(void);
+static int SetupInterrupts(void);
+static void RunPass(const char *Name);
+static void TimerHandler(void *CallBackRef);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic IntcInstance;
+static XScuTimer TimerInstance;
+
+static volatile u32 Samples;
+static volatile u32 MinCounts;
+static volatile u32 MaxCounts;
+static volatile u64 SumCounts;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return ScuGicFiqBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Measures the IRQ path, installs the FIQ path and measures it.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int ScuGicFiqBench(void)
+{
+	if (SetupInterrupts() != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("\r\nInterrupt entry latency, %d samples\r\n",
+		   BENCH_SAMPLES);
+	xil_printf("path   min ns  avg ns  max ns\r\n");
+
+	Xil_ExceptionEnable();
+	RunPass("IRQ");
+	Xil_ExceptionDisable();
+
+	if (XScuGic_SetFiq(&IntcInstance, TIMER_IRPT_INTR, TimerHandler,
+			   &TimerInstance) != XST_SUCCESS) {
+		xil_printf("FIQ vector out of branch range\r\n");
+		return XST_FAILURE;
+	}
+	Xil_ExceptionEnableMask(XIL_EXCEPTION_ALL);
+	RunPass("FIQ");
+	Xil_ExceptionDisableMask(XIL_EXCEPTION_ALL);
+
+	XScuGic_ClearFiq(&IntcInstance);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the GIC and the private timer and connects the timer handler
+* to the IRQ path.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int SetupInterrupts(void)
+{
+	XScuGic_Config *IntcConfig;
+	XScuTimer_Config *TimerConfig;
+	int Status;
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (IntcConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(&IntcInstance, IntcConfig,
+				       IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	TimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
+	if (TimerConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuTimer_CfgInitialize(&TimerInstance, TimerConfig,
+					 TimerConfig->BaseAddr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuTimer_SetPrescaler(&TimerInstance, 0U);
+	XScuTimer_EnableAutoReload(&TimerInstance);
+	XScuTimer_LoadTimer(&TimerInstance, TIMER_LOAD);
+	XScuTimer_EnableInterrupt(&TimerInstance);
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			&IntcInstance);
+
+	XScuGic_SetPriorityTriggerType(&IntcInstance, TIMER_IRPT_INTR,
+				       TIMER_PRIORITY, TRIGGER_RISING);
+	Status = XScuGic_Connect(&IntcInstance, TIMER_IRPT_INTR,
+				 TimerHandler, &TimerInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuGic_Enable(&IntcInstance, TIMER_IRPT_INTR);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Collects BENCH_SAMPLES timer interrupts and prints one result line.
+*
+* @param	Name is the name of the path printed in the table.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RunPass(const char *Name)
+{
+	u32 Min;
+	u32 Avg;
+	u32 Max;
+
+	Samples = 0U;
+	MinCounts = 0xFFFFFFFFU;
+	MaxCounts = 0U;
+	SumCounts = 0U;
+
+	XScuTimer_RestartTimer(&TimerInstance);
+	XScuTimer_Start(&TimerInstance);
+	while (Samples < BENCH_SAMPLES) {
+		/* Idle, the handler collects the samples */
+	}
+	XScuTimer_Stop(&TimerInstance);
+
+	Min = (u32)(((u64)MinCounts * 1000000000U) / TIMER_HZ);
+	Avg = (u32)((SumCounts * 1000000000U) / TIMER_HZ / Samples);
+	Max = (u32)(((u64)MaxCounts * 1000000000U) / TIMER_HZ);
+
+	xil_printf("%s   %6d  %6d  %6d\r\n", Name, Min, Avg, Max);
+}
+
+/*****************************************************************************/
+/**
+*
+* Private timer handler, used on both paths. Records the counts elapsed since
+* the reload.
+*
+* @param	CallBackRef is the timer instance.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void TimerHandler(void *CallBackRef)
+{
+	XScuTimer *TimerPtr = (XScuTimer *)CallBackRef;
+	u32 Counts;
+
+	Counts = TIMER_LOAD - XScuTimer_GetCounterValue(TimerPtr);
+	XScuTimer_ClearInterruptStatus(TimerPtr);
+
+	if (Samples < BENCH_SAMPLES) {
+		if (Counts < MinCounts) {
+			MinCounts = Counts;
+		}
+		if (Counts > MaxCounts) {
+			MaxCounts = Counts;
+		}
+		SumCounts += Counts;
+		Samples++;
+	}
+}
@@ -0,0 +1,333 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xscugic_nest_bench.c
+*
+* Measures the latency of a high priority interrupt while a low priority
+* handler keeps the CPU busy, with the nested mode of XScuGic_InterruptHandler
+* off and on.
+*
+* The private timer of the CPU runs in auto reload mode with a high priority
+* and stands for the motor control interrupt. The load is a low priority
+* software generated interrupt, which the main loop raises continuously and
+* whose handler busy waits for LOAD_US microseconds, like a long EMAC or SD
+* handler. The timer handler reads the counter first thing: the counts since
+* the reload are the latency from the timer event to the handler. The average
+* and maximum latency in nanoseconds and the deepest nesting seen by the timer
+* handler are printed for each mode.
+*
+* Without nesting the maximum latency is close to LOAD_US, with nesting it is
+* the cost of the exception entry and the dispatch.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 3.02  ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xscugic.h"
+#include "xscutimer.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define INTC_DEVICE_ID		XPAR_SCUGIC_0_DEVICE_ID
+#define TIMER_DEVICE_ID		XPAR_XSCUTIMER_0_DEVICE_ID
+#define TIMER_IRPT_INTR		XPAR_SCUTIMER_INTR
+#define LOAD_SGI_ID		1U
+
+#define TIMER_HZ		(XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2U)
+#define TIMER_LOAD		(TIMER_HZ / 1000U)	/* 1 ms period */
+
+#define TIMER_PRIORITY		0x08U	/* Most urgent but one */
+#define LOAD_PRIORITY		0xA0U
+#define TRIGGER_RISING		0x3U
+
+#define LOAD_US			200U
+#define BENCH_SAMPLES		5000U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int ScuGicNestBench(void);
+static int SetupInterrupts(void);
+static void RunPass(u32 Nested);
+static void TimerHandler(void *CallBackRef);
+static void LoadHandler(void *CallBackRef);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic IntcInstance;
+static XScuTimer TimerInstance;
+
+static volatile u32 Samples;
+static volatile u32 LoadCalls;
+static volatile u32 MaxDepth;
+static volatile u32 MaxCounts;
+static volatile u64 SumCounts;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return ScuGicNestBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Sets up the interrupt sources and measures both modes.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int ScuGicNestBench(void)
+{
+	if (SetupInterrupts() != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("\r\nInterrupt latency under %d us handler load\r\n",
+		   LOAD_US);
+	xil_printf("mode      samples  load irqs  avg ns   max ns  depth\r\n");
+
+	RunPass(0U);
+	RunPass(1U);
+
+	XScuGic_SetNesting(&IntcInstance, 0U);
+	Xil_ExceptionDisable();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the GIC and the private timer and connects both handlers.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int SetupInterrupts(void)
+{
+	XScuGic_Config *IntcConfig;
+	XScuTimer_Config *TimerConfig;
+	int Status;
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (IntcConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(&IntcInstance, IntcConfig,
+				       IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	TimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
+	if (TimerConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuTimer_CfgInitialize(&TimerInstance, TimerConfig,
+					 TimerConfig->BaseAddr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuTimer_SetPrescaler(&TimerInstance, 0U);
+	XScuTimer_EnableAutoReload(&TimerInstance);
+	XScuTimer_LoadTimer(&TimerInstance, TIMER_LOAD);
+	XScuTimer_EnableInterrupt(&TimerInstance);
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			&IntcInstance);
+
+	XScuGic_SetPriorityTriggerType(&IntcInstance, TIMER_IRPT_INTR,
+				       TIMER_PRIORITY, TRIGGER_RISING);
+	XScuGic_SetPriorityTriggerType(&IntcInstance, LOAD_SGI_ID,
+				       LOAD_PRIORITY, TRIGGER_RISING);
+
+	Status = XScuGic_Connect(&IntcInstance, TIMER_IRPT_INTR,
+				 TimerHandler, &TimerInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_Connect(&IntcInstance, LOAD_SGI_ID,
+				 LoadHandler, NULL);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XScuGic_Enable(&IntcInstance, TIMER_IRPT_INTR);
+	XScuGic_Enable(&IntcInstance, LOAD_SGI_ID);
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Collects BENCH_SAMPLES timer interrupts while raising the load interrupt
+* continuously and prints one result line.
+*
+* @param	Nested selects the nested mode of the interrupt handler.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RunPass(u32 Nested)
+{
+	u32 Avg;
+	u32 Max;
+
+	XScuGic_SetNesting(&IntcInstance, Nested);
+
+	Samples = 0U;
+	LoadCalls = 0U;
+	MaxDepth = 0U;
+	MaxCounts = 0U;
+	SumCounts = 0U;
+
+	XScuTimer_RestartTimer(&TimerInstance);
+	XScuTimer_Start(&TimerInstance);
+
+	while (Samples < BENCH_SAMPLES) {
+		(void)XScuGic_SoftwareIntr(&IntcInstance, LOAD_SGI_ID,
+					   (u32)1U << XPAR_CPU_ID);
+	}
+
+	XScuTimer_Stop(&TimerInstance);
+
+	Avg = (u32)((SumCounts * 1000000000U) / TIMER_HZ / Samples);
+	Max = (u32)(((u64)MaxCounts * 1000000000U) / TIMER_HZ);
+
+	xil_printf("%s  %8d  %9d  %6d  %7d  %5d\r\n",
+		   (Nested != 0U) ? "nested" : "masked", Samples, LoadCalls,
+		   Avg, Max, MaxDepth);
+}
+
+/*****************************************************************************/
+/**
+*
+* Private timer handler. Records the counts elapsed since the reload.
+*
+* @param	CallBackRef is the timer instance.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void TimerHandler(void *CallBackRef)
+{
+	XScuTimer *TimerPtr = (XScuTimer *)CallBackRef;
+	u32 Counts;
+	u32 Depth;
+
+	Counts = TIMER_LOAD - XScuTimer_GetCounterValue(TimerPtr);
+	XScuTimer_ClearInterruptStatus(TimerPtr);
+
+	if (Samples < BENCH_SAMPLES) {
+		if (Counts > MaxCounts) {
+			MaxCounts = Counts;
+		}
+		SumCounts += Counts;
+		Depth = XScuGic_GetNestingDepth();
+		if (Depth > MaxDepth) {
+			MaxDepth = Depth;
+		}
+		Samples++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Load handler, busy waits for LOAD_US microseconds.
+*
+* @param	CallBackRef is unused.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void LoadHandler(void *CallBackRef)
+{
+	XTime Start;
+	XTime Now;
+
+	(void)CallBackRef;
+
+	LoadCalls++;
+	XTime_GetTime(&Start);
+	do {
+		XTime_GetTime(&Now);
+	} while ((Now - Start) < ((XTime)COUNTS_PER_SECOND * LOAD_US / 1000000U));
+}
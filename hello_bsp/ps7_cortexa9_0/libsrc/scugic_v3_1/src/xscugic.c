@@ -72,6 +72,11 @@
 * 3.00  kvn  02/13/14 Modified code for MISRA-C:2012 compliance.
 * 3.01	pkp	 06/19/15 Added XScuGic_InterruptMaptoCpu API for an interrupt
 *			  target CPU mapping
+* 3.02  ag   10/18/26 Added XScuGic_CpuInitialize for the second CPU of an
+*		      SMP system.
+*		      Fixed XScuGic_InterruptMaptoCpu, which set the targets of
+*		      the other three interrupts of the register to all CPUs
+*		      and wrote the CPU number instead of the CPU mask.
 *
 * </pre>
 *
@@ -245,6 +250,42 @@ static void CPUInitialize(XScuGic *InstancePtr)
 
 }
 
+/*****************************************************************************/
+/**
+*
+* Initialize the GIC for the calling CPU when it shares an instance that was
+* initialized by XScuGic_CfgInitialize() on another CPU. The interrupt IDs
+* 0 - 31 and the CPU interface are banked per CPU, so this entails:
+*
+* - Write the default priority of the banked interrupts and disable them
+* - Set the priority mask and enable the CPU interface
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+*
+* @return	None
+*
+* @note		Used by the second CPU of an SMP system, see xil_smp.h.
+*
+******************************************************************************/
+void XScuGic_CpuInitialize(XScuGic *InstancePtr)
+{
+	u32 Int_Id;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	for (Int_Id = 0U; Int_Id < 32U; Int_Id = Int_Id + 4U) {
+		XScuGic_DistWriteReg(InstancePtr,
+					XSCUGIC_PRIORITY_OFFSET_CALC(Int_Id),
+					DEFAULT_PRIORITY);
+	}
+	XScuGic_DistWriteReg(InstancePtr,
+		XSCUGIC_EN_DIS_OFFSET_CALC(XSCUGIC_DISABLE_OFFSET, 0U),
+		0xFFFFFFFFU);
+
+	CPUInitialize(InstancePtr);
+}
+
 /*****************************************************************************/
 /**
 *
@@ -288,6 +329,7 @@ s32  XScuGic_CfgInitialize(XScuGic *InstancePtr,
 
 		InstancePtr->IsReady = 0;
 		InstancePtr->Config = ConfigPtr;
+		InstancePtr->NestingEnabled = 0U;
 
 
 		for (Int_Id = 0U; Int_Id<XSCUGIC_MAX_NUM_INTR_INPUTS;Int_Id++) {
@@ -731,10 +773,14 @@ void XScuGic_InterruptMaptoCpu(XScuGic *InstancePtr, u8 Cpu_Id, u32 Int_Id)
 	RegValue = XScuGic_DistReadReg(InstancePtr,
 			XSCUGIC_SPI_TARGET_OFFSET_CALC(Int_Id));
 
-	Offset =  (Int_Id & 0x3);
+	Offset =  (Int_Id & 0x3U);
 
-	RegValue = (RegValue | (~(0xFF << (Offset*8))) );
-	RegValue |= ((Cpu_Id) << (Offset*8));
+	/*
+	 * Replace the target byte of Int_Id only, the register holds the
+	 * targets of four interrupts. The byte is a mask of CPUs.
+	 */
+	RegValue = (RegValue & (~((u32)0xFFU << (Offset*8U))));
+	RegValue |= (((u32)1U << Cpu_Id) << (Offset*8U));
 
 	XScuGic_DistWriteReg(InstancePtr,
 						 XSCUGIC_SPI_TARGET_OFFSET_CALC(Int_Id),
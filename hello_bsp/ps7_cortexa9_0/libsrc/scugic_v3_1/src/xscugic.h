@@ -72,9 +72,62 @@
 * user must use XScuGic_Connect() when the interrupt handler takes an
 * argument other than the base address.
 *
+* <b>Interrupt Statistics</b>
+*
+* When the driver is compiled with XSCUGIC_STATS defined, for example through
+* the extra compiler flags of the BSP, XScuGic_InterruptHandler and
+* XScuGic_DeviceInterruptHandler record for each interrupt ID the number of
+* handler calls, the total and maximum handler time and the shortest and
+* longest time between two calls. Times are in CPU cycles from the PMU cycle
+* counter, which must be running on every CPU that dispatches interrupts, see
+* Xpm_EnableCycleCounter(). XScuGic_StatsSnapshot() and XScuGic_StatsReset()
+* read and clear the records. Without XSCUGIC_STATS neither the records nor
+* the calls in the dispatchers are compiled.
+*
+* <b>Interrupt Affinity</b>
+*
+* With XSCUGIC_STATS defined, XScuGic_AffinityBalance() moves the shared
+* peripheral interrupts between the CPUs so that the handler load recorded by
+* the statistics is spread evenly. It is meant to be called periodically from
+* thread context. Interrupts that must stay on one CPU are routed with
+* XScuGic_AffinityPin() and are left alone by the balancer. Interrupts that
+* are not pinned and target an offline CPU are moved to an online one on
+* every call.
+*
+* <b>FIQ Fast Path</b>
+*
+* XScuGic_SetFiq() routes a single interrupt ID to FIQ. The ID stays in group 0
+* while all other IDs move to group 1 and keep using IRQ. Its handler is called
+* from a dedicated FIQ vector that reads the handler and the CPU interface
+* address from the banked FIQ registers, bypassing XExc_VectorTable and the
+* GIC handler table. The handler must not use NEON or floating point code, see
+* xscugic_fiq.c. Give the FIQ ID a higher priority than every other enabled
+* interrupt; a group 1 interrupt that outranks it can be acknowledged on the
+* FIQ and is then called from the handler table in FIQ mode.
+*
 * <b>Nested Interrupts Processing</b>
 *
-* Nested interrupts are not supported by this driver.
+* By default XScuGic_InterruptHandler runs every handler with IRQs masked.
+* XScuGic_SetNesting() switches the handler into nested mode: after the
+* interrupt is acknowledged the handler is entered in system mode with IRQs
+* enabled, on a per nesting level stack. The GIC only signals an interrupt
+* whose priority is higher than the running priority of the CPU interface, so
+* only higher priority sources preempt a running handler and the EOI writes
+* stay in acknowledge order. A priority value of 0 is the most urgent.
+*
+* Every level stacks one exception frame on the IRQ mode stack (about 320
+* bytes with NEON state). The handler entered at XSCUGIC_NEST_MAX_DEPTH still
+* runs, with IRQs masked, so _IRQ_STACK_SIZE in the linker script must be at
+* least (XSCUGIC_NEST_MAX_DEPTH + 1) times that, 1600 bytes for the default
+* depth of 4; the linker script of the application reserves 2048. Handlers
+* running at the deepest level are not preempted.
+*
+* The binary point register is banked per CPU. XScuGic_SetNesting() saves,
+* programs and restores the copy of the calling CPU only. On an SMP system
+* the other CPU keeps its own binary point, which sets how far its handlers
+* can preempt each other. Nested mode applies to
+* XScuGic_InterruptHandler only, XScuGic_DeviceInterruptHandler always runs
+* with IRQs masked.
 *
 * NOTE:
 * The generic interrupt controller is not a part of the snoop control unit
@@ -133,6 +186,18 @@
 * 2.0   adk  12/10/13 Updated as per the New Tcl API's
 * 2.1   adk  25/04/14 Fixed the CR:789373 changes are made in the driver tcl file.
 * 3.00  kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
+* 3.02  ag   10/18/26 Added opt-in nested interrupt mode, see
+*		      XScuGic_SetNesting().
+*		      Added per interrupt dispatch statistics, built when
+*		      XSCUGIC_STATS is defined.
+*		      Added FIQ fast path for one interrupt ID, see
+*		      XScuGic_SetFiq().
+*		      Added XScuGic_CpuInitialize for the second CPU of an
+*		      SMP system.
+*		      Fixed XScuGic_InterruptMaptoCpu to replace the target
+*		      of the ID instead of ORing in the CPU number.
+*		      Added interrupt affinity balancer, see
+*		      XScuGic_AffinityBalance().
 *
 * </pre>
 *
@@ -155,6 +220,38 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+/**
+ * Number of CPUs which may dispatch interrupts through this driver, the CPU
+ * number is read from the MPIDR. May be overridden from the compiler command
+ * line.
+ */
+#ifndef XSCUGIC_NUM_CPUS
+#define XSCUGIC_NUM_CPUS		2U
+#endif
+#define XSCUGIC_MPIDR_CPU_MASK		0x3U
+
+/** @name Nested interrupt mode
+ * Maximum preemption depth and size in bytes of the stack used by each
+ * nesting level. They may be overridden from the compiler command line.
+ * @{
+ */
+#ifndef XSCUGIC_NEST_MAX_DEPTH
+#define XSCUGIC_NEST_MAX_DEPTH		4U
+#endif
+#ifndef XSCUGIC_NEST_STACK_SIZE
+#define XSCUGIC_NEST_STACK_SIZE		1024U
+#endif
+#define XSCUGIC_NEST_BIN_PT		0x2U	/**< All implemented priority
+						  bits are group priority */
+/*@}*/
+
+/**
+ * XScuGic_AffinityBalance() applies new targets only if they lower the load of
+ * the busiest CPU by at least 1/XSCUGIC_AFFINITY_HYSTERESIS.
+ */
+#ifndef XSCUGIC_AFFINITY_HYSTERESIS
+#define XSCUGIC_AFFINITY_HYSTERESIS	8U
+#endif
 
 /**************************** Type Definitions *******************************/
 
@@ -190,8 +287,40 @@ typedef struct
 	XScuGic_Config *Config;  /**< Configuration table entry */
 	u32 IsReady;		 /**< Device is initialized and ready */
 	u32 UnhandledInterrupts; /**< Intc Statistics */
+	u32 NestingEnabled;	 /**< Handlers run preemptible */
+	u32 SavedBinPt;		 /**< Binary point of the CPU that enabled
+				      nested mode, before it did */
 } XScuGic;
 
+#ifdef XSCUGIC_STATS
+/**
+ * Dispatch statistics of one interrupt ID, summed over the CPUs. Handler
+ * times include the time spent in handlers which preempted it in nested mode.
+ * The inter-arrival times are measured per CPU with a 32 bit cycle counter,
+ * so gaps longer than 2^32 cycles are not represented correctly.
+ */
+typedef struct
+{
+	u32 Count;		/**< Number of handler calls */
+	u64 TotalCycles;	/**< Sum of the handler times */
+	u32 MaxCycles;		/**< Longest handler time */
+	u32 MinInterArrival;	/**< Shortest time between two calls */
+	u32 MaxInterArrival;	/**< Longest time between two calls */
+} XScuGic_IntrStats;
+
+/**
+ * Result of one XScuGic_AffinityBalance() window. Loads are the handler
+ * cycles per CPU in the window.
+ */
+typedef struct
+{
+	u32 WindowCycles;			/**< Length of the window */
+	u64 LoadBefore[XSCUGIC_NUM_CPUS];	/**< Measured load */
+	u64 LoadAfter[XSCUGIC_NUM_CPUS];	/**< Load with new targets */
+	u32 Moved;				/**< IDs moved to another CPU */
+} XScuGic_AffinityReport;
+#endif
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /****************************************************************************/
@@ -285,6 +414,7 @@ void XScuGic_Disable(XScuGic *InstancePtr, u32 Int_Id);
 
 s32  XScuGic_CfgInitialize(XScuGic *InstancePtr, XScuGic_Config *ConfigPtr,
 							u32 EffectiveAddr);
+void XScuGic_CpuInitialize(XScuGic *InstancePtr);
 
 s32  XScuGic_SoftwareIntr(XScuGic *InstancePtr, u32 Int_Id, u32 Cpu_Id);
 
@@ -302,6 +432,34 @@ XScuGic_Config *XScuGic_LookupConfig(u16 DeviceId);
  * Interrupt functions in xscugic_intr.c
  */
 void XScuGic_InterruptHandler(XScuGic *InstancePtr);
+void XScuGic_SetNesting(XScuGic *InstancePtr, u32 Enable);
+u32  XScuGic_GetNestingDepth(void);
+
+/*
+ * FIQ fast path functions in xscugic_fiq.c
+ */
+s32  XScuGic_SetFiq(XScuGic *InstancePtr, u32 Int_Id,
+			Xil_InterruptHandler Handler, void *CallBackRef);
+void XScuGic_ClearFiq(XScuGic *InstancePtr);
+
+/*
+ * Statistics functions in xscugic_stats.c
+ */
+#ifdef XSCUGIC_STATS
+u32  XScuGic_StatsEnter(u32 Int_Id);
+void XScuGic_StatsExit(u32 Int_Id, u32 EntryCycles);
+void XScuGic_StatsSnapshot(XScuGic_IntrStats *Table);
+void XScuGic_StatsSnapshotCpu(u32 Cpu, XScuGic_IntrStats *Table);
+void XScuGic_StatsReset(void);
+
+/*
+ * Affinity functions in xscugic_affinity.c
+ */
+void XScuGic_AffinityPin(XScuGic *InstancePtr, u32 Int_Id, u32 Cpu);
+void XScuGic_AffinityUnpin(u32 Int_Id);
+s32  XScuGic_AffinityBalance(XScuGic *InstancePtr, u32 OnlineCpus,
+			     XScuGic_AffinityReport *ReportPtr);
+#endif
 
 /*
  * Self-test functions in xscugic_selftest.c
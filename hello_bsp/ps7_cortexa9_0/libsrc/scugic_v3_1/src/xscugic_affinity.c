@@ -0,0 +1,426 @@
+/******************************************************************************
+*
+* Copyright (C) 2010 - 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xscugic_affinity.c
+*
+* This file contains the interrupt affinity balancer of the driver. It is
+* built when XSCUGIC_STATS is defined and takes the load of each interrupt ID
+* from the handler cycles recorded by the dispatch statistics.
+*
+* XScuGic_AffinityBalance() is called periodically from thread context. It
+* computes for every ID the handler cycles spent since the previous call and
+* redistributes the shared peripheral interrupts (IDs 32 and above) over the
+* online CPUs: the heaviest ID is placed on the least loaded CPU first
+* (longest processing time first). The banked IDs 0 - 31 and the IDs pinned
+* with XScuGic_AffinityPin() keep their CPU and count as fixed load. The new
+* targets are written only when they lower the load of the busiest CPU by at
+* least 1/XSCUGIC_AFFINITY_HYSTERESIS, so sources do not move back and forth
+* on noise. IDs that are not pinned and target an offline CPU are always
+* moved to the least loaded online CPU first. IDs that target no CPU are left
+* alone.
+*
+* A handler cycle total below the one seen in the previous window means the
+* statistics were reset with XScuGic_StatsReset(), the whole total is then
+* taken as the load of the window.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------------
+* 3.02  ag   10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "xscugic.h"
+
+#ifdef XSCUGIC_STATS
+
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XSCUGIC_FIRST_SPI_ID		32U
+#define XSCUGIC_NUM_SPI_IDS	(XSCUGIC_MAX_NUM_INTR_INPUTS - XSCUGIC_FIRST_SPI_ID)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XScuGic_IsPinned(Int_Id) \
+	((AffinityPinned[(Int_Id) / 32U] & ((u32)1U << ((Int_Id) % 32U))) != 0U)
+
+/************************** Function Prototypes ******************************/
+
+static u32 GetTargetCpu(XScuGic *InstancePtr, u32 Int_Id);
+static u32 LeastLoadedCpu(const u64 *Load, u32 OnlineCpus);
+static u64 MaxLoad(const u64 *Load, u32 OnlineCpus);
+
+/************************** Variable Definitions *****************************/
+
+static u32 AffinityPinned[(XSCUGIC_MAX_NUM_INTR_INPUTS + 31U) / 32U];
+static u32 AffinityPrimed;
+static u32 AffinityLastCycles;
+static u64 AffinityPrevTotal[XSCUGIC_NUM_CPUS][XSCUGIC_MAX_NUM_INTR_INPUTS];
+
+/*
+ * Scratch of XScuGic_AffinityBalance, kept off the stack
+ */
+static XScuGic_IntrStats AffinitySnap[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static u64 AffinityLoad[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static u8 AffinityCurrent[XSCUGIC_MAX_NUM_INTR_INPUTS];
+static u8 AffinityOrder[XSCUGIC_NUM_SPI_IDS];
+static u8 AffinityOffline[XSCUGIC_NUM_SPI_IDS];
+
+/*****************************************************************************/
+/**
+* Route a shared peripheral interrupt to a CPU and keep it there.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Int_Id is the interrupt ID, 32 to XSCUGIC_MAX_NUM_INTR_INPUTS - 1.
+* @param	Cpu is the CPU number.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XScuGic_AffinityPin(XScuGic *InstancePtr, u32 Int_Id, u32 Cpu)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid((Int_Id >= XSCUGIC_FIRST_SPI_ID) &&
+		       (Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS));
+	Xil_AssertVoid(Cpu < XSCUGIC_NUM_CPUS);
+
+	XScuGic_InterruptMaptoCpu(InstancePtr, (u8)Cpu, Int_Id);
+	AffinityPinned[Int_Id / 32U] |= (u32)1U << (Int_Id % 32U);
+}
+
+/*****************************************************************************/
+/**
+* Let the balancer move an interrupt pinned with XScuGic_AffinityPin() again.
+*
+* @param	Int_Id is the interrupt ID.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void XScuGic_AffinityUnpin(u32 Int_Id)
+{
+	Xil_AssertVoid(Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS);
+
+	AffinityPinned[Int_Id / 32U] &= ~((u32)1U << (Int_Id % 32U));
+}
+
+/*****************************************************************************/
+/**
+* Rebalance the shared peripheral interrupts over the online CPUs according
+* to the handler cycles recorded since the previous call.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	OnlineCpus is the number of CPUs whose GIC CPU interface is
+*		set up and which take interrupts, 1 to XSCUGIC_NUM_CPUS.
+* @param	ReportPtr receives the window length and the per CPU load
+*		before and after, may be NULL.
+*
+* @return
+*		- XST_SUCCESS if the window was evaluated, ReportPtr->Moved
+*		tells how many IDs changed CPU, including the IDs moved off
+*		offline CPUs.
+*		- XST_NO_DATA on the first call, which only starts the window.
+*
+* @note		Not reentrant, call from one thread. The PMU cycle counter of
+*		the calling CPU times the window. Load after is projected from
+*		the loads measured in the window with the new targets.
+*
+******************************************************************************/
+s32 XScuGic_AffinityBalance(XScuGic *InstancePtr, u32 OnlineCpus,
+			    XScuGic_AffinityReport *ReportPtr)
+{
+	u64 Current[XSCUGIC_NUM_CPUS];
+	u64 Proposed[XSCUGIC_NUM_CPUS];
+	u64 Before[XSCUGIC_NUM_CPUS];
+	u64 Delta;
+	u32 Now;
+	u32 Window;
+	u32 NumSpi = 0U;
+	u32 NumOffline = 0U;
+	u32 Moved = 0U;
+	u32 Int_Id;
+	u32 Cpu;
+	u32 Index;
+	u32 Pos;
+	u8 Id;
+	u8 NewCpu[XSCUGIC_MAX_NUM_INTR_INPUTS];
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid((OnlineCpus >= 1U) &&
+			  (OnlineCpus <= XSCUGIC_NUM_CPUS));
+
+	Now = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+	Window = Now - AffinityLastCycles;
+	AffinityLastCycles = Now;
+
+	/*
+	 * Handler cycles of each ID in the window, and the measured load of
+	 * each CPU.
+	 */
+	for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS; Int_Id++) {
+		AffinityLoad[Int_Id] = 0U;
+	}
+	for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+		Before[Cpu] = 0U;
+		Current[Cpu] = 0U;
+		Proposed[Cpu] = 0U;
+		XScuGic_StatsSnapshotCpu(Cpu, AffinitySnap);
+		for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS;
+		     Int_Id++) {
+			if (AffinitySnap[Int_Id].TotalCycles <
+			    AffinityPrevTotal[Cpu][Int_Id]) {
+				/* Reset since the previous window */
+				Delta = AffinitySnap[Int_Id].TotalCycles;
+			} else {
+				Delta = AffinitySnap[Int_Id].TotalCycles -
+					AffinityPrevTotal[Cpu][Int_Id];
+			}
+			AffinityPrevTotal[Cpu][Int_Id] =
+				AffinitySnap[Int_Id].TotalCycles;
+			if (Int_Id < XSCUGIC_FIRST_SPI_ID) {
+				/* Banked, stays on this CPU */
+				Current[Cpu] += Delta;
+				Proposed[Cpu] += Delta;
+			} else {
+				AffinityLoad[Int_Id] += Delta;
+			}
+			Before[Cpu] += Delta;
+		}
+	}
+
+	if (AffinityPrimed == 0U) {
+		AffinityPrimed = 1U;
+		return XST_NO_DATA;
+	}
+
+	/*
+	 * Load of the online CPUs with the current targets. IDs that target
+	 * no CPU, and pinned IDs on an offline CPU, are left alone.
+	 */
+	for (Int_Id = XSCUGIC_FIRST_SPI_ID; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS;
+	     Int_Id++) {
+		Cpu = GetTargetCpu(InstancePtr, Int_Id);
+		AffinityCurrent[Int_Id] = (u8)Cpu;
+		if (Cpu < OnlineCpus) {
+			Current[Cpu] += AffinityLoad[Int_Id];
+		} else if ((Cpu < XSCUGIC_NUM_CPUS) &&
+			   !XScuGic_IsPinned(Int_Id)) {
+			AffinityOffline[NumOffline] = (u8)Int_Id;
+			NumOffline++;
+		} else {
+			/* Not routed, or pinned to an offline CPU */
+		}
+	}
+
+	/*
+	 * An offline CPU takes no interrupts, so its IDs move whether or not
+	 * the rebalance below is applied.
+	 */
+	for (Index = 0U; Index < NumOffline; Index++) {
+		Id = AffinityOffline[Index];
+		Cpu = LeastLoadedCpu(Current, OnlineCpus);
+		XScuGic_InterruptMaptoCpu(InstancePtr, (u8)Cpu, Id);
+		AffinityCurrent[Id] = (u8)Cpu;
+		Current[Cpu] += AffinityLoad[Id];
+		Moved++;
+	}
+
+	/*
+	 * Pinned IDs are fixed load on their CPU, the others are sorted by
+	 * decreasing load.
+	 */
+	for (Int_Id = XSCUGIC_FIRST_SPI_ID; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS;
+	     Int_Id++) {
+		Cpu = AffinityCurrent[Int_Id];
+		if (Cpu >= OnlineCpus) {
+			continue;
+		}
+		NewCpu[Int_Id] = (u8)Cpu;
+
+		if (XScuGic_IsPinned(Int_Id) || (AffinityLoad[Int_Id] == 0U)) {
+			Proposed[Cpu] += AffinityLoad[Int_Id];
+			continue;
+		}
+		Pos = NumSpi;
+		while ((Pos > 0U) &&
+		       (AffinityLoad[AffinityOrder[Pos - 1U]] <
+			AffinityLoad[Int_Id])) {
+			AffinityOrder[Pos] = AffinityOrder[Pos - 1U];
+			Pos--;
+		}
+		AffinityOrder[Pos] = (u8)Int_Id;
+		NumSpi++;
+	}
+
+	for (Index = 0U; Index < NumSpi; Index++) {
+		Id = AffinityOrder[Index];
+		Cpu = LeastLoadedCpu(Proposed, OnlineCpus);
+		NewCpu[Id] = (u8)Cpu;
+		Proposed[Cpu] += AffinityLoad[Id];
+	}
+
+	/*
+	 * Apply the new targets only for a clear gain.
+	 */
+	Delta = MaxLoad(Current, OnlineCpus);
+	if (MaxLoad(Proposed, OnlineCpus) <
+	    (Delta - (Delta / XSCUGIC_AFFINITY_HYSTERESIS))) {
+		for (Index = 0U; Index < NumSpi; Index++) {
+			Id = AffinityOrder[Index];
+			if (NewCpu[Id] != AffinityCurrent[Id]) {
+				XScuGic_InterruptMaptoCpu(InstancePtr,
+							  NewCpu[Id], Id);
+				Moved++;
+			}
+		}
+	} else {
+		for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+			Proposed[Cpu] = Current[Cpu];
+		}
+	}
+
+	if (ReportPtr != NULL) {
+		ReportPtr->WindowCycles = Window;
+		ReportPtr->Moved = Moved;
+		for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+			ReportPtr->LoadBefore[Cpu] = Before[Cpu];
+			ReportPtr->LoadAfter[Cpu] = Proposed[Cpu];
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Return the first CPU in the SPI target mask of an interrupt ID.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Int_Id is the interrupt ID.
+*
+* @return	CPU number, XSCUGIC_NUM_CPUS if no CPU is targeted.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 GetTargetCpu(XScuGic *InstancePtr, u32 Int_Id)
+{
+	u32 Mask;
+	u32 Cpu;
+
+	Mask = XScuGic_DistReadReg(InstancePtr,
+				   XSCUGIC_SPI_TARGET_OFFSET_CALC(Int_Id));
+	Mask = (Mask >> ((Int_Id & 0x3U) * 8U)) & 0xFFU;
+
+	for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+		if ((Mask & ((u32)1U << Cpu)) != 0U) {
+			break;
+		}
+	}
+
+	return Cpu;
+}
+
+/*****************************************************************************/
+/**
+* Return the online CPU with the smallest load.
+*
+* @param	Load is the load per CPU.
+* @param	OnlineCpus is the number of online CPUs.
+*
+* @return	CPU number.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 LeastLoadedCpu(const u64 *Load, u32 OnlineCpus)
+{
+	u32 Best = 0U;
+	u32 Cpu;
+
+	for (Cpu = 1U; Cpu < OnlineCpus; Cpu++) {
+		if (Load[Cpu] < Load[Best]) {
+			Best = Cpu;
+		}
+	}
+
+	return Best;
+}
+
+/*****************************************************************************/
+/**
+* Return the largest load of the online CPUs.
+*
+* @param	Load is the load per CPU.
+* @param	OnlineCpus is the number of online CPUs.
+*
+* @return	Largest load.
+*
+* @note		None.
+*
+******************************************************************************/
+static u64 MaxLoad(const u64 *Load, u32 OnlineCpus)
+{
+	u64 Max = 0U;
+	u32 Cpu;
+
+	for (Cpu = 0U; Cpu < OnlineCpus; Cpu++) {
+		if (Load[Cpu] > Max) {
+			Max = Load[Cpu];
+		}
+	}
+
+	return Max;
+}
+
+#endif /* XSCUGIC_STATS */
@@ -0,0 +1,359 @@
+/******************************************************************************
+*
+* Copyright (C) 2010 - 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xscugic_fiq.c
+*
+* This file contains the FIQ fast path of the driver. One interrupt ID is kept
+* in group 0 (secure) and all others are moved to group 1 (non-secure), with
+* FIQEn set in the CPU interface group 0 is signalled on nFIQ and group 1
+* stays on nIRQ. The FIQ entry of the vector table is patched to branch to
+* XScuGic_FiqVector, which acknowledges the interrupt, calls the handler and
+* writes the EOI without going through XExc_VectorTable or the GIC handler
+* table. The CPU interface base address, the handler, its argument and the
+* FIQ interrupt ID are kept in the banked FIQ registers r8 - r10 and r12, so
+* no memory is read to find them.
+*
+* With AckCtl set a secure read of the acknowledge register returns the
+* highest priority pending interrupt of either group. If a group 1 interrupt
+* is acknowledged on the FIQ, for example because it has a higher priority
+* than the FIQ source, the vector calls its handler from the GIC handler
+* table instead, in FIQ mode.
+*
+* The FIQ handler runs with IRQs and FIQs masked on the FIQ stack. Unlike the
+* FIQHandler of the standalone BSP the fast vector does not save the NEON and
+* VFP registers, so the handler must not use floating point or NEON code.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------------
+* 3.02  ag   10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "xil_cache.h"
+#include "xil_cache_l.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xscugic.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XSCUGIC_FIQ_VECTOR_OFFSET	0x1CU	/* FIQ entry of the table */
+#define XSCUGIC_ARM_B_OPCODE		0xEA000000U
+#define XSCUGIC_ARM_B_OFFSET_MASK	0x00FFFFFFU
+#define XSCUGIC_ARM_B_RANGE		0x02000000	/* +/- 32 MB */
+
+#define XSCUGIC_CNTR_DEFAULT	(XSCUGIC_CNTR_EN_S_MASK | \
+				 XSCUGIC_CNTR_EN_NS_MASK | \
+				 XSCUGIC_CNTR_ACKCTL_MASK)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+void XScuGic_FiqVector(void);
+void XScuGic_FiqDispatch(u32 Int_Id);
+static void LoadFiqBank(u32 CpuBaseAddress, Xil_InterruptHandler Handler,
+			void *CallBackRef, u32 Int_Id);
+static void WriteFiqVector(u32 Insn);
+static void SetGroups(XScuGic *InstancePtr, u32 Group0Id);
+
+/************************** Variable Definitions *****************************/
+
+static u32 SavedFiqInsn;	/* Original FIQ vector instruction */
+static u32 FiqInstalled;
+static XScuGic_Config *FiqConfig;	/* Handler table for other IDs */
+
+/*
+ * FIQ vector. r8 holds the CPU interface base address, r9 the handler, r10
+ * its argument and r12 the FIQ interrupt ID, r11 keeps the acknowledged
+ * value across the handler call. r0 - r3 are caller saved and not banked,
+ * r12 is pushed as the handlers may change it. Any other acknowledged ID is
+ * passed to XScuGic_FiqDispatch. The special IDs 1020 - 1023 are neither
+ * handled nor ended.
+ */
+__asm__(
+"	.text\n"
+"	.arm\n"
+"	.align	2\n"
+"	.global	XScuGic_FiqVector\n"
+"	.type	XScuGic_FiqVector, %function\n"
+"XScuGic_FiqVector:\n"
+"	push	{r0-r3, r12, lr}\n"
+"	ldr	r11, [r8, #0x0C]\n"
+"	ubfx	r0, r11, #0, #10\n"
+"	cmp	r0, #1020\n"
+"	bhs	1f\n"
+"	cmp	r0, r12\n"
+"	bne	2f\n"
+"	mov	r0, r10\n"
+"	blx	r9\n"
+"	b	3f\n"
+"2:\n"
+"	bl	XScuGic_FiqDispatch\n"
+"3:\n"
+"	str	r11, [r8, #0x10]\n"
+"1:\n"
+"	pop	{r0-r3, r12, lr}\n"
+"	subs	pc, lr, #4\n"
+"	.size	XScuGic_FiqVector, .-XScuGic_FiqVector\n"
+);
+
+/*****************************************************************************/
+/**
+* Route one interrupt ID to FIQ and service it through the fast FIQ vector.
+*
+* The interrupt is placed in group 0 and every other interrupt in group 1,
+* FIQEn, AckCtl and SBPR are set in the CPU interface, the banked FIQ
+* registers of the calling CPU are loaded and the FIQ entry of the vector
+* table at VBAR is patched to branch to XScuGic_FiqVector. The handler is
+* also connected in the handler table, so that it still runs should
+* XScuGic_InterruptHandler acknowledge the interrupt while FIQs are masked.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Int_Id is the interrupt ID, 0 to XSCUGIC_MAX_NUM_INTR_INPUTS - 1.
+* @param	Handler is the handler called in FIQ mode.
+* @param	CallBackRef is the argument passed to the handler.
+*
+* @return
+*		- XST_SUCCESS if the FIQ path is installed.
+*		- XST_FAILURE if XScuGic_FiqVector is out of branch range of
+*		the vector table.
+*
+* @note		The caller sets the priority and trigger type of the interrupt,
+*		enables it in the distributor and then enables FIQs with
+*		Xil_ExceptionEnableMask(XIL_EXCEPTION_FIQ). Priority values of
+*		group 1 interrupts keep their meaning for secure accesses, the
+*		priority mask and nested mode are unchanged. Only one ID can be
+*		routed to FIQ at a time, installing another one replaces it.
+*		IDs 0 - 31 are banked, their groups are set for the calling CPU
+*		only. Give the FIQ interrupt a higher priority than every
+*		group 1 interrupt, otherwise those that outrank it are taken
+*		on the FIQ and handled there with FIQs masked.
+*
+******************************************************************************/
+s32 XScuGic_SetFiq(XScuGic *InstancePtr, u32 Int_Id,
+		   Xil_InterruptHandler Handler, void *CallBackRef)
+{
+	u32 Vector;
+	s32 Offset;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS);
+	Xil_AssertNonvoid(Handler != NULL);
+
+	Vector = mfcp(XREG_CP15_VEC_BASE_ADDR) + XSCUGIC_FIQ_VECTOR_OFFSET;
+	Offset = (s32)((UINTPTR)XScuGic_FiqVector - (Vector + 8U));
+	if ((Offset >= XSCUGIC_ARM_B_RANGE) || (Offset < -XSCUGIC_ARM_B_RANGE)) {
+		return XST_FAILURE;
+	}
+
+	InstancePtr->Config->HandlerTable[Int_Id].Handler = Handler;
+	InstancePtr->Config->HandlerTable[Int_Id].CallBackRef = CallBackRef;
+	FiqConfig = InstancePtr->Config;
+
+	LoadFiqBank(InstancePtr->Config->CpuBaseAddress, Handler, CallBackRef,
+		    Int_Id);
+
+	if (FiqInstalled == 0U) {
+		SavedFiqInsn = Xil_In32(Vector);
+		FiqInstalled = 1U;
+	}
+	WriteFiqVector(XSCUGIC_ARM_B_OPCODE |
+		       (((u32)Offset >> 2U) & XSCUGIC_ARM_B_OFFSET_MASK));
+
+	SetGroups(InstancePtr, Int_Id);
+	XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_CONTROL_OFFSET,
+			    XSCUGIC_CNTR_DEFAULT | XSCUGIC_CNTR_FIQEN_MASK |
+			    XSCUGIC_CNTR_SBPR_MASK);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Undo XScuGic_SetFiq(). All interrupts are put back in group 0 and signalled
+* as IRQ, and the original FIQ vector is restored.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+*
+* @return	None.
+*
+* @note		The handler connected by XScuGic_SetFiq() stays in the
+*		handler table.
+*
+******************************************************************************/
+void XScuGic_ClearFiq(XScuGic *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_CONTROL_OFFSET,
+			    XSCUGIC_CNTR_DEFAULT);
+	SetGroups(InstancePtr, XSCUGIC_MAX_NUM_INTR_INPUTS);
+
+	if (FiqInstalled != 0U) {
+		WriteFiqVector(SavedFiqInsn);
+		FiqInstalled = 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+* Call the handler of an interrupt that the FIQ vector acknowledged but that
+* is not the FIQ interrupt, see XScuGic_FiqVector.
+*
+* @param	Int_Id is the acknowledged interrupt ID.
+*
+* @return	None.
+*
+* @note		Called in FIQ mode with IRQs and FIQs masked, the vector
+*		writes the EOI on return.
+*
+******************************************************************************/
+void XScuGic_FiqDispatch(u32 Int_Id)
+{
+	XScuGic_VectorTableEntry *TablePtr;
+
+	TablePtr = &FiqConfig->HandlerTable[Int_Id];
+	if (TablePtr->Handler != NULL) {
+		TablePtr->Handler(TablePtr->CallBackRef);
+	}
+}
+
+/*****************************************************************************/
+/**
+* Load the banked FIQ registers r8 - r10 and r12 of the calling CPU. The
+* operands are bound to r0 - r3 and the CPSR is kept in r4, which are not
+* banked.
+*
+* @param	CpuBaseAddress is the CPU interface base address.
+* @param	Handler is the FIQ handler.
+* @param	CallBackRef is the argument passed to the handler.
+* @param	Int_Id is the FIQ interrupt ID.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void LoadFiqBank(u32 CpuBaseAddress, Xil_InterruptHandler Handler,
+			void *CallBackRef, u32 Int_Id)
+{
+	register u32 Base __asm__("r0") = CpuBaseAddress;
+	register u32 Func __asm__("r1") = (u32)(UINTPTR)Handler;
+	register u32 Ref __asm__("r2") = (u32)(UINTPTR)CallBackRef;
+	register u32 Id __asm__("r3") = Int_Id;
+
+	__asm__ __volatile__(
+		"mrs	r4, cpsr\n"
+		"cpsid	if, #0x11\n"
+		"mov	r8, %0\n"
+		"mov	r9, %1\n"
+		"mov	r10, %2\n"
+		"mov	r12, %3\n"
+		"msr	cpsr_c, r4\n"
+		: : "r" (Base), "r" (Func), "r" (Ref), "r" (Id)
+		: "r4", "memory");
+}
+
+/*****************************************************************************/
+/**
+* Write the FIQ entry of the vector table and make the new instruction
+* visible to instruction fetches.
+*
+* @param	Insn is the instruction to write.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void WriteFiqVector(u32 Insn)
+{
+	u32 Vector;
+
+	Vector = mfcp(XREG_CP15_VEC_BASE_ADDR) + XSCUGIC_FIQ_VECTOR_OFFSET;
+
+	Xil_Out32(Vector, Insn);
+	Xil_DCacheFlushRange((INTPTR)Vector, 4U);
+	Xil_L1ICacheInvalidateRange(Vector, 4U);
+	mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0U);
+	dsb();
+	isb();
+}
+
+/*****************************************************************************/
+/**
+* Put every interrupt ID in group 1 except Group0Id.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Group0Id is the ID to keep in group 0, or
+*		XSCUGIC_MAX_NUM_INTR_INPUTS to put all IDs back in group 0.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void SetGroups(XScuGic *InstancePtr, u32 Group0Id)
+{
+	u32 Int_Id;
+	u32 RegValue;
+
+	for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS;
+	     Int_Id += 32U) {
+		if (Group0Id == XSCUGIC_MAX_NUM_INTR_INPUTS) {
+			RegValue = 0U;
+		} else if ((Group0Id / 32U) == (Int_Id / 32U)) {
+			RegValue = ~((u32)1U << (Group0Id % 32U));
+		} else {
+			RegValue = 0xFFFFFFFFU;
+		}
+		XScuGic_DistWriteReg(InstancePtr,
+			XSCUGIC_EN_DIS_OFFSET_CALC(XSCUGIC_SECURITY_OFFSET,
+						   Int_Id), RegValue);
+	}
+}
@@ -60,6 +60,8 @@
 *			  XScuGic_SetPriTrigTypeByDistAddr and
 *             XScuGic_GetPriTrigTypeByDistAddr here from xscugic.c
 * 3.00  kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
+* 3.02  ag   10/18/26 XScuGic_DeviceInterruptHandler calls the statistics
+*		      hooks around the handler when XSCUGIC_STATS is defined.
 *
 * </pre>
 *
@@ -310,6 +312,9 @@ void XScuGic_DeviceInterruptHandler(void *DeviceId)
 	u32 IntIDFull;
 	XScuGic_VectorTableEntry *TablePtr;
 	XScuGic_Config *CfgPtr;
+#ifdef XSCUGIC_STATS
+	u32 EntryCycles;
+#endif
 
 	CfgPtr = &XScuGic_ConfigTable[(INTPTR )DeviceId];
 
@@ -344,7 +349,13 @@ void XScuGic_DeviceInterruptHandler(void *DeviceId)
 	 */
 	TablePtr = &(CfgPtr->HandlerTable[InterruptID]);
 	if(TablePtr != NULL) {
+#ifdef XSCUGIC_STATS
+		EntryCycles = XScuGic_StatsEnter(InterruptID);
+#endif
 		TablePtr->Handler(TablePtr->CallBackRef);
+#ifdef XSCUGIC_STATS
+		XScuGic_StatsExit(InterruptID, EntryCycles);
+#endif
 	}
 
 IntrExit:
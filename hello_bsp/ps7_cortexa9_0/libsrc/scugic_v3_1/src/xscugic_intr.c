@@ -60,6 +60,11 @@
 * 1.01a sdm  11/09/11 XScuGic_InterruptHandler has changed correspondingly
 *		      since the HandlerTable has now moved to XScuGic_Config.
 * 3.00  kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
+* 3.02  ag   10/18/26 Added opt-in nested mode. XScuGic_InterruptHandler can
+*		      run handlers preemptible on a per level stack, see
+*		      XScuGic_SetNesting().
+*		      Calls the statistics hooks around the handler when
+*		      XSCUGIC_STATS is defined.
 *
 * </pre>
 *
@@ -79,17 +84,71 @@
 #include "xil_types.h"
 #include "xil_assert.h"
 #include "xscugic.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
 
 /************************** Constant Definitions *****************************/
 
+#define XSCUGIC_NEST_STACK_WORDS	(XSCUGIC_NEST_STACK_SIZE / 8U)
+
 /**************************** Type Definitions *******************************/
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
 /************************** Function Prototypes ******************************/
 
+void XScuGic_NestCall(Xil_InterruptHandler Handler, void *CallBackRef,
+			void *StackTop);
+
 /************************** Variable Definitions *****************************/
 
+/*
+ * Stacks used by the handlers in nested mode, one per CPU and nesting level,
+ * and the current nesting depth of each CPU. The depth is only changed from
+ * IRQ mode with IRQs masked.
+ */
+static u64 NestStack[XSCUGIC_NUM_CPUS][XSCUGIC_NEST_MAX_DEPTH]
+			[XSCUGIC_NEST_STACK_WORDS];
+static volatile u32 NestDepth[XSCUGIC_NUM_CPUS];
+
+/*
+ * XScuGic_NestCall(Handler, CallBackRef, StackTop) is entered in IRQ mode. It
+ * keeps SPSR_irq and LR_irq, which a preempting interrupt overwrites, in
+ * callee saved registers, switches to system mode with IRQs enabled and calls
+ * Handler(CallBackRef) on StackTop. The interrupted system mode SP and LR are
+ * restored before going back to IRQ mode with IRQs masked. The FIQ mask is
+ * left as it was. The driver Makefile only builds C sources, so the mode
+ * switch is written here rather than in a .S file.
+ */
+__asm__(
+"	.text\n"
+"	.arm\n"
+"	.align	2\n"
+"	.global	XScuGic_NestCall\n"
+"	.type	XScuGic_NestCall, %function\n"
+"XScuGic_NestCall:\n"
+"	push	{r4-r7}\n"
+"	mrs	r4, spsr\n"
+"	mov	r5, lr\n"
+"	cps	#0x1F\n"
+"	mov	r6, sp\n"
+"	mov	r7, lr\n"
+"	mov	sp, r2\n"
+"	mov	r2, r0\n"
+"	mov	r0, r1\n"
+"	cpsie	i\n"
+"	blx	r2\n"
+"	cpsid	i\n"
+"	mov	sp, r6\n"
+"	mov	lr, r7\n"
+"	cps	#0x12\n"
+"	msr	spsr_cxsf, r4\n"
+"	mov	lr, r5\n"
+"	pop	{r4-r7}\n"
+"	bx	lr\n"
+"	.size	XScuGic_NestCall, .-XScuGic_NestCall\n"
+);
+
 /*****************************************************************************/
 /**
 * This function is the primary interrupt handler for the driver.  It must be
@@ -103,6 +162,9 @@
 * initialized.  It does not verify that entries in the table are valid before
 * calling an interrupt handler.
 *
+* In nested mode the handler is called in system mode with IRQs enabled on the
+* stack of the current nesting level, so that higher priority interrupts can
+* preempt it. At XSCUGIC_NEST_MAX_DEPTH the handler is called with IRQs masked.
 *
 * @param	InstancePtr is a pointer to the XScuGic instance.
 *
@@ -116,7 +178,12 @@ void XScuGic_InterruptHandler(XScuGic *InstancePtr)
 
 	u32 InterruptID;
 	    u32 IntIDFull;
+	    u32 Cpu;
+	    u32 Depth;
 	    XScuGic_VectorTableEntry *TablePtr;
+#ifdef XSCUGIC_STATS
+	    u32 EntryCycles;
+#endif
 
 	    /* Assert that the pointer to the instance is valid
 	     */
@@ -139,9 +206,9 @@ void XScuGic_InterruptHandler(XScuGic *InstancePtr)
 	     * processors.
 	     */
 	    /*
-	     * If pre-eption is required:
-	     * Re-enable pre-emption by setting the CPSR I bit for non-secure ,
-	     * interrupts or the F bit for secure interrupts
+	     * In nested mode pre-emption is re-enabled by XScuGic_NestCall, which
+	     * clears the CPSR I bit around the handler. The GIC running priority
+	     * keeps equal and lower priority interrupts pending until the EOI.
 	     */
 
 	    /*
@@ -154,8 +221,30 @@ void XScuGic_InterruptHandler(XScuGic *InstancePtr)
 	     */
 	    TablePtr = &(InstancePtr->Config->HandlerTable[InterruptID]);
 		if(TablePtr != NULL) {
+#ifdef XSCUGIC_STATS
+		EntryCycles = XScuGic_StatsEnter(InterruptID);
+#endif
+		/* The CPU number is only needed, and read, in nested mode */
+		if (InstancePtr->NestingEnabled != 0U) {
+			Cpu = mfcp(XREG_CP15_MULTI_PROC_AFFINITY) &
+						XSCUGIC_MPIDR_CPU_MASK;
+		} else {
+			Cpu = XSCUGIC_NUM_CPUS;
+		}
+		if ((Cpu < XSCUGIC_NUM_CPUS) &&
+		    (NestDepth[Cpu] < XSCUGIC_NEST_MAX_DEPTH)) {
+			Depth = NestDepth[Cpu];
+			NestDepth[Cpu] = Depth + 1U;
+			XScuGic_NestCall(TablePtr->Handler, TablePtr->CallBackRef,
+				&NestStack[Cpu][Depth][XSCUGIC_NEST_STACK_WORDS]);
+			NestDepth[Cpu] = Depth;
+		} else {
 	        TablePtr->Handler(TablePtr->CallBackRef);
 		}
+#ifdef XSCUGIC_STATS
+		XScuGic_StatsExit(InterruptID, EntryCycles);
+#endif
+		}
 
 	IntrExit:
 	    /*
@@ -168,3 +257,64 @@ void XScuGic_InterruptHandler(XScuGic *InstancePtr)
 	     * Return from the interrupt. Change security domains could happen here.
      */
 }
+
+/*****************************************************************************/
+/**
+* Enable or disable nested mode for XScuGic_InterruptHandler. When enabling,
+* the binary point register is saved and set so that all implemented priority
+* bits are used for preemption, when disabling the saved value is restored.
+*
+* @param	InstancePtr is a pointer to the XScuGic instance.
+* @param	Enable is 1 to let higher priority interrupts preempt running
+*		handlers, 0 to run every handler with IRQs masked.
+*
+* @return	None.
+*
+* @note		Must not be called from an interrupt handler. _IRQ_STACK_SIZE
+*		must be large enough for XSCUGIC_NEST_MAX_DEPTH + 1 exception
+*		frames, see xscugic.h. The binary point register is banked,
+*		only the copy of the calling CPU is saved, set and restored,
+*		so enable and disable nested mode on the same CPU. The other
+*		CPU keeps its own binary point.
+*
+******************************************************************************/
+void XScuGic_SetNesting(XScuGic *InstancePtr, u32 Enable)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+	Xil_AssertVoid(Enable <= 1U);
+
+	if ((Enable != 0U) && (InstancePtr->NestingEnabled == 0U)) {
+		InstancePtr->SavedBinPt = XScuGic_CPUReadReg(InstancePtr,
+					XSCUGIC_BIN_PT_OFFSET);
+		XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_BIN_PT_OFFSET,
+					XSCUGIC_NEST_BIN_PT);
+	} else if ((Enable == 0U) && (InstancePtr->NestingEnabled != 0U)) {
+		XScuGic_CPUWriteReg(InstancePtr, XSCUGIC_BIN_PT_OFFSET,
+					InstancePtr->SavedBinPt);
+	} else {
+		/* Already in the requested mode */
+	}
+	InstancePtr->NestingEnabled = Enable;
+}
+
+/*****************************************************************************/
+/**
+* Return the nesting depth of the calling CPU, the number of handlers entered
+* through nested mode that have not returned yet.
+*
+* @param	None.
+*
+* @return	0 outside of interrupt context or when nested mode is off,
+*		1 in a handler that was not preempting another one, and so on.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 XScuGic_GetNestingDepth(void)
+{
+	u32 Cpu;
+
+	Cpu = mfcp(XREG_CP15_MULTI_PROC_AFFINITY) & XSCUGIC_MPIDR_CPU_MASK;
+	return (Cpu < XSCUGIC_NUM_CPUS) ? NestDepth[Cpu] : 0U;
+}
@@ -0,0 +1,313 @@
+/******************************************************************************
+*
+* Copyright (C) 2010 - 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xscugic_stats.c
+*
+* This file contains the optional per interrupt dispatch statistics of the
+* driver. It is empty unless XSCUGIC_STATS is defined. The dispatchers call
+* XScuGic_StatsEnter() before and XScuGic_StatsExit() after the handler, both
+* in IRQ mode with IRQs masked, and each CPU updates its own records, so no
+* locking is needed on the update path.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- ---------------------------------------------------------
+* 3.02  ag   10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+#include "xil_assert.h"
+#include "xscugic.h"
+
+#ifdef XSCUGIC_STATS
+
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/*
+ * Record of one interrupt ID on one CPU
+ */
+typedef struct
+{
+	u32 Count;
+	u32 MaxCycles;
+	u64 TotalCycles;
+	u32 LastEntry;
+	u32 MinInterArrival;
+	u32 MaxInterArrival;
+} XScuGic_StatsRecord;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XScuGic_StatsCpu() \
+	(mfcp(XREG_CP15_MULTI_PROC_AFFINITY) & XSCUGIC_MPIDR_CPU_MASK)
+
+#define XScuGic_StatsCycles()	mfcp(XREG_CP15_PERF_CYCLE_COUNTER)
+
+/************************** Function Prototypes ******************************/
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic_StatsRecord StatsTable[XSCUGIC_NUM_CPUS]
+					[XSCUGIC_MAX_NUM_INTR_INPUTS];
+
+/*****************************************************************************/
+/**
+* Record the start of a handler call. Called by the dispatchers before the
+* handler runs.
+*
+* @param	Int_Id is the acknowledged interrupt ID.
+*
+* @return	The cycle counter value at entry, to be passed to
+*		XScuGic_StatsExit().
+*
+* @note		Called in IRQ mode with IRQs masked.
+*
+******************************************************************************/
+u32 XScuGic_StatsEnter(u32 Int_Id)
+{
+	XScuGic_StatsRecord *RecPtr;
+	u32 Cpu;
+	u32 Now;
+	u32 Gap;
+
+	Now = XScuGic_StatsCycles();
+	Cpu = XScuGic_StatsCpu();
+
+	if ((Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS) &&
+	    (Cpu < XSCUGIC_NUM_CPUS)) {
+		RecPtr = &StatsTable[Cpu][Int_Id];
+		if (RecPtr->Count != 0U) {
+			Gap = Now - RecPtr->LastEntry;
+			if ((RecPtr->Count == 1U) ||
+			    (Gap < RecPtr->MinInterArrival)) {
+				RecPtr->MinInterArrival = Gap;
+			}
+			if (Gap > RecPtr->MaxInterArrival) {
+				RecPtr->MaxInterArrival = Gap;
+			}
+		}
+		RecPtr->LastEntry = Now;
+		RecPtr->Count++;
+	}
+
+	return Now;
+}
+
+/*****************************************************************************/
+/**
+* Record the end of a handler call. Called by the dispatchers after the
+* handler returned.
+*
+* @param	Int_Id is the acknowledged interrupt ID.
+* @param	EntryCycles is the value returned by XScuGic_StatsEnter().
+*
+* @return	None.
+*
+* @note		Called in IRQ mode with IRQs masked.
+*
+******************************************************************************/
+void XScuGic_StatsExit(u32 Int_Id, u32 EntryCycles)
+{
+	XScuGic_StatsRecord *RecPtr;
+	u32 Cpu;
+	u32 Cycles;
+
+	Cycles = XScuGic_StatsCycles() - EntryCycles;
+	Cpu = XScuGic_StatsCpu();
+
+	if ((Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS) &&
+	    (Cpu < XSCUGIC_NUM_CPUS)) {
+		RecPtr = &StatsTable[Cpu][Int_Id];
+		RecPtr->TotalCycles += Cycles;
+		if (Cycles > RecPtr->MaxCycles) {
+			RecPtr->MaxCycles = Cycles;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* Copy the statistics of all interrupt IDs, summed over the CPUs. IDs which
+* were never dispatched have a Count of 0 and MinInterArrival of 0.
+*
+* @param	Table is an array of XSCUGIC_MAX_NUM_INTR_INPUTS entries,
+*		indexed by interrupt ID, that receives the statistics.
+*
+* @return	None.
+*
+* @note		IRQs are masked on the calling CPU during the copy, so its
+*		records are consistent. A record of another CPU may be caught
+*		in the middle of an update.
+*
+******************************************************************************/
+void XScuGic_StatsSnapshot(XScuGic_IntrStats *Table)
+{
+	XScuGic_StatsRecord *RecPtr;
+	XScuGic_IntrStats *OutPtr;
+	u32 CpsrVal;
+	u32 Int_Id;
+	u32 Cpu;
+
+	Xil_AssertVoid(Table != NULL);
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+
+	for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS; Int_Id++) {
+		OutPtr = &Table[Int_Id];
+		OutPtr->Count = 0U;
+		OutPtr->TotalCycles = 0U;
+		OutPtr->MaxCycles = 0U;
+		OutPtr->MinInterArrival = 0U;
+		OutPtr->MaxInterArrival = 0U;
+
+		for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+			RecPtr = &StatsTable[Cpu][Int_Id];
+			if (RecPtr->Count == 0U) {
+				continue;
+			}
+			if (RecPtr->Count > 1U) {
+				if ((OutPtr->MinInterArrival == 0U) ||
+				    (RecPtr->MinInterArrival <
+				     OutPtr->MinInterArrival)) {
+					OutPtr->MinInterArrival =
+						RecPtr->MinInterArrival;
+				}
+				if (RecPtr->MaxInterArrival >
+				    OutPtr->MaxInterArrival) {
+					OutPtr->MaxInterArrival =
+						RecPtr->MaxInterArrival;
+				}
+			}
+			OutPtr->Count += RecPtr->Count;
+			OutPtr->TotalCycles += RecPtr->TotalCycles;
+			if (RecPtr->MaxCycles > OutPtr->MaxCycles) {
+				OutPtr->MaxCycles = RecPtr->MaxCycles;
+			}
+		}
+	}
+
+	mtcpsr(CpsrVal);
+}
+
+/*****************************************************************************/
+/**
+* Copy the statistics of all interrupt IDs as recorded on one CPU.
+*
+* @param	Cpu is the CPU number, 0 to XSCUGIC_NUM_CPUS - 1.
+* @param	Table is an array of XSCUGIC_MAX_NUM_INTR_INPUTS entries,
+*		indexed by interrupt ID, that receives the statistics.
+*
+* @return	None.
+*
+* @note		See XScuGic_StatsSnapshot().
+*
+******************************************************************************/
+void XScuGic_StatsSnapshotCpu(u32 Cpu, XScuGic_IntrStats *Table)
+{
+	XScuGic_StatsRecord *RecPtr;
+	XScuGic_IntrStats *OutPtr;
+	u32 CpsrVal;
+	u32 Int_Id;
+
+	Xil_AssertVoid(Cpu < XSCUGIC_NUM_CPUS);
+	Xil_AssertVoid(Table != NULL);
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+
+	for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS; Int_Id++) {
+		RecPtr = &StatsTable[Cpu][Int_Id];
+		OutPtr = &Table[Int_Id];
+		OutPtr->Count = RecPtr->Count;
+		OutPtr->TotalCycles = RecPtr->TotalCycles;
+		OutPtr->MaxCycles = RecPtr->MaxCycles;
+		OutPtr->MinInterArrival = RecPtr->MinInterArrival;
+		OutPtr->MaxInterArrival = RecPtr->MaxInterArrival;
+	}
+
+	mtcpsr(CpsrVal);
+}
+
+/*****************************************************************************/
+/**
+* Clear the statistics of all interrupt IDs on all CPUs.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		A handler running on another CPU while the records are cleared
+*		may leave one partial call in its record.
+*
+******************************************************************************/
+void XScuGic_StatsReset(void)
+{
+	XScuGic_StatsRecord *RecPtr;
+	u32 CpsrVal;
+	u32 Int_Id;
+	u32 Cpu;
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | XIL_EXCEPTION_IRQ);
+
+	for (Cpu = 0U; Cpu < XSCUGIC_NUM_CPUS; Cpu++) {
+		for (Int_Id = 0U; Int_Id < XSCUGIC_MAX_NUM_INTR_INPUTS;
+		     Int_Id++) {
+			RecPtr = &StatsTable[Cpu][Int_Id];
+			RecPtr->Count = 0U;
+			RecPtr->MaxCycles = 0U;
+			RecPtr->TotalCycles = 0U;
+			RecPtr->LastEntry = 0U;
+			RecPtr->MinInterArrival = 0U;
+			RecPtr->MaxInterArrival = 0U;
+		}
+	}
+
+	mtcpsr(CpsrVal);
+}
+
+#endif /* XSCUGIC_STATS */
@@ -58,12 +58,20 @@
 * 						Inhibit mask in Cmd Transfer API.
 *						Added Support for SD Card v1.0
 * 2.5 	sg	   07/09/15 Added SD 3.0 features
+*       ag     10/18/26 Added optional per-command latency histograms.
+*       ag     10/18/26 XSdPs_ReadPolled and XSdPs_WritePolled maintain the
+*                       cache for the used ADMA2 descriptors and the data
+*                       buffer with one Xil_DCacheMaintainList call.
+*       ag     10/18/26 Skip the cache maintenance of descriptors and data
+*                       buffers in coherent regions, see xil_coherent.h.
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 #include "xsdps.h"
+#include "xil_cache.h"
+#include "xil_coherent.h"
 /*
  * The header sleep.h and API usleep() can only be used with an arm design.
  * MB_Sleep() is used for microblaze design.
@@ -113,6 +121,10 @@ static u8 ExtCsd[512] __attribute__ ((aligned(32)));
 u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd);
 int XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt);
 void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff);
+static u32 XSdPs_FillADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt,
+				const u8 *Buff);
+static void XSdPs_DmaCacheSync(XSdPs *InstancePtr, u32 DescLines,
+				const u8 *Buff, u32 Len, u32 BuffOp);
 extern int XSdPs_Uhs_ModeInit(XSdPs *InstancePtr, u8 Mode);
 static int XSdPs_IdentifyCard(XSdPs *InstancePtr);
 static int XSdPs_Switch_Voltage(XSdPs *InstancePtr);
@@ -248,6 +260,8 @@ int XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
 			XSDPS_BLK_SIZE_OFFSET, XSDPS_BLK_SIZE_512_MASK);
 
+	XSdPs_StatsReset(InstancePtr);
+
 	Status = XST_SUCCESS;
 
 RETURN_PATH:
@@ -866,6 +880,8 @@ int XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
 		goto RETURN_PATH;
 	}
 
+	XSdPs_StatsCmdStart(InstancePtr, CommandReg);
+
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress, XSDPS_CMD_OFFSET,
 			CommandReg);
 
@@ -889,6 +905,8 @@ int XSdPs_CmdTransfer(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt)
 			XSDPS_NORM_INTR_STS_OFFSET,
 			XSDPS_INTR_CC_MASK);
 
+	XSdPs_StatsCmdDone(InstancePtr);
+
 	Status = XST_SUCCESS;
 
 RETURN_PATH:
@@ -1017,6 +1035,7 @@ int XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 	u32 Status;
 	u32 PresentStateReg;
 	u32 StatusReg;
+	u32 DescLines;
 
 	if(InstancePtr->Config.CardDetect) {
 		/* Check status to ensure card is initialized */
@@ -1039,7 +1058,7 @@ int XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 		}
 	}
 
-	XSdPs_SetupADMA2DescTbl(InstancePtr, BlkCnt, Buff);
+	DescLines = XSdPs_FillADMA2DescTbl(InstancePtr, BlkCnt, Buff);
 
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
 			XSDPS_XFER_MODE_OFFSET,
@@ -1047,7 +1066,8 @@ int XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 			XSDPS_TM_BLK_CNT_EN_MASK | XSDPS_TM_DAT_DIR_SEL_MASK |
 			XSDPS_TM_DMA_EN_MASK | XSDPS_TM_MUL_SIN_BLK_SEL_MASK);
 
-	Xil_DCacheInvalidateRange(Buff, BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+	XSdPs_DmaCacheSync(InstancePtr, DescLines, Buff,
+			BlkCnt * XSDPS_BLK_SIZE_512_MASK, XIL_CACHE_OP_INVALIDATE);
 
 	/* Send block read command */
 	Status = XSdPs_CmdTransfer(InstancePtr, CMD18, Arg, BlkCnt);
@@ -1070,6 +1090,8 @@ int XSdPs_ReadPolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 		}
 	} while((StatusReg & XSDPS_INTR_TC_MASK) == 0);
 
+	XSdPs_StatsXferDone(InstancePtr);
+
 	/* Write to clear bit */
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
 			XSDPS_NORM_INTR_STS_OFFSET, XSDPS_INTR_TC_MASK);
@@ -1103,6 +1125,7 @@ int XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 	u32 Status;
 	u32 PresentStateReg;
 	u32 StatusReg;
+	u32 DescLines;
 
 	if(InstancePtr->Config.CardDetect) {
 		/* Check status to ensure card is initialized */
@@ -1126,8 +1149,9 @@ int XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 
 	}
 
-	XSdPs_SetupADMA2DescTbl(InstancePtr, BlkCnt, Buff);
-	Xil_DCacheFlushRange(Buff, BlkCnt * XSDPS_BLK_SIZE_512_MASK);
+	DescLines = XSdPs_FillADMA2DescTbl(InstancePtr, BlkCnt, Buff);
+	XSdPs_DmaCacheSync(InstancePtr, DescLines, Buff,
+			BlkCnt * XSDPS_BLK_SIZE_512_MASK, XIL_CACHE_OP_FLUSH);
 
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
 			XSDPS_XFER_MODE_OFFSET,
@@ -1157,8 +1181,11 @@ int XSdPs_WritePolled(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
 			Status = XST_FAILURE;
 			goto RETURN_PATH;
 		}
+		XSdPs_StatsPollWrite(InstancePtr);
 	} while((StatusReg & XSDPS_INTR_TC_MASK) == 0);
 
+	XSdPs_StatsXferDone(InstancePtr);
+
 	/* Write to clear bit */
 	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
 			XSDPS_NORM_INTR_STS_OFFSET, XSDPS_INTR_TC_MASK);
@@ -1217,6 +1244,34 @@ RETURN_PATH:
 *
 ******************************************************************************/
 void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff)
+{
+	(void)XSdPs_FillADMA2DescTbl(InstancePtr, BlkCnt, Buff);
+
+	if (Xil_IsCoherent((INTPTR)&(InstancePtr->Adma2_DescrTbl[0]),
+			   sizeof(XSdPs_Adma2Descriptor) * 32) == 0U) {
+		Xil_DCacheFlushRange((INTPTR)&(InstancePtr->Adma2_DescrTbl[0]),
+				sizeof(XSdPs_Adma2Descriptor) * 32);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Write the ADMA2 descriptor table for a transfer and point the ADMA SAR to
+* it, without cache maintenance of the table.
+*
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	BlkCnt - block count.
+* @param	Buff pointer to data buffer.
+*
+* @return	Number of descriptors used.
+*
+* @note		None.
+*
+******************************************************************************/
+static u32 XSdPs_FillADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt,
+				const u8 *Buff)
 {
 	u32 TotalDescLines = 0;
 	u32 DescNum = 0;
@@ -1262,9 +1317,7 @@ void XSdPs_SetupADMA2DescTbl(XSdPs *InstancePtr, u32 BlkCnt, const u8 *Buff)
 	XSdPs_WriteReg(InstancePtr->Config.BaseAddress, XSDPS_ADMA_SAR_OFFSET,
 			(u32)(UINTPTR)&(InstancePtr->Adma2_DescrTbl[0]));
 
-	Xil_DCacheFlushRange(&(InstancePtr->Adma2_DescrTbl[0]),
-			sizeof(XSdPs_Adma2Descriptor) * 32);
-
+	return TotalDescLines;
 }
 
 /*****************************************************************************/
@@ -1396,3 +1449,46 @@ RETURN_PATH:
 
 }
 /** @} */
+
+/*****************************************************************************/
+/**
+*
+* Flush the used ADMA2 descriptors and flush or invalidate the data buffer of
+* a transfer in one cache maintenance pass.
+*
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	DescLines is the number of descriptors used.
+* @param	Buff pointer to data buffer.
+* @param	Len is the length of the data buffer in bytes.
+* @param	BuffOp is XIL_CACHE_OP_FLUSH for a write and
+*		XIL_CACHE_OP_INVALIDATE for a read.
+*
+* @return	None
+*
+* @note		Ranges in coherent regions are left out.
+*
+******************************************************************************/
+static void XSdPs_DmaCacheSync(XSdPs *InstancePtr, u32 DescLines,
+				const u8 *Buff, u32 Len, u32 BuffOp)
+{
+	Xil_CacheListEntry CacheList[2];
+	u32 Count = 0U;
+
+	CacheList[Count].Addr = (INTPTR)&(InstancePtr->Adma2_DescrTbl[0]);
+	CacheList[Count].Len = sizeof(XSdPs_Adma2Descriptor) * DescLines;
+	CacheList[Count].Op = XIL_CACHE_OP_FLUSH;
+	if (Xil_IsCoherent(CacheList[Count].Addr, CacheList[Count].Len) == 0U) {
+		Count++;
+	}
+	CacheList[Count].Addr = (INTPTR)Buff;
+	CacheList[Count].Len = Len;
+	CacheList[Count].Op = BuffOp;
+	if (Xil_IsCoherent(CacheList[Count].Addr, CacheList[Count].Len) == 0U) {
+		Count++;
+	}
+
+	if (Count != 0U) {
+		Xil_DCacheMaintainList(CacheList, Count);
+	}
+}
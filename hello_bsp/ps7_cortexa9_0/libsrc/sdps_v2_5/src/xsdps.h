@@ -93,6 +93,15 @@
 * by the host controller. The current driver supports read/write on eMMC card
 * using 4-bit and high speed mode currently.
 *
+* Latency statistics:
+* When the driver is compiled with XSDPS_ENABLE_STATS defined (for example
+* by adding -DXSDPS_ENABLE_STATS to the extra compiler flags of the BSP),
+* every command is timed with the global timer and the elapsed ticks are
+* accumulated in log2 histograms per command type (control, read, write)
+* and per phase (command, data, card busy). XSdPs_StatsDump() prints the
+* histograms and XSdPs_StatsReset() clears them. Without the define the
+* instance carries no extra state and both calls expand to nothing.
+*
 * Features not supported include - card write protect, password setting,
 * lock/unlock, interrupts, SDMA mode, programmed I/O mode and
 * 64-bit addressed ADMA2, erase/pre-erase commands.
@@ -117,6 +126,8 @@
 * 						Inhibit mask in Cmd Transfer API.
 *						Added Support for SD Card v1.0
 * 2.5 	sg		07/09/15 Added SD 3.0 features
+*       ag     10/18/26 Added optional per-command latency histograms,
+*                       enabled by building with XSDPS_ENABLE_STATS.
 *
 * </pre>
 *
@@ -133,9 +144,36 @@ extern "C" {
 #include "xstatus.h"
 #include "xsdps_hw.h"
 #include <string.h>
+#ifdef XSDPS_ENABLE_STATS
+#include "xtime_l.h"
+#endif
 
 /************************** Constant Definitions *****************************/
 
+#ifdef XSDPS_ENABLE_STATS
+/** @name Latency statistics
+ * Command types and phases used to index XSdPs_Stats.Hist.
+ * @{
+ */
+#define XSDPS_STATS_TYPE_CTRL		0U	/**< Command without data */
+#define XSDPS_STATS_TYPE_READ		1U	/**< Card to host data */
+#define XSDPS_STATS_TYPE_WRITE		2U	/**< Host to card data */
+#define XSDPS_STATS_NUM_TYPES		3U
+
+#define XSDPS_STATS_PHASE_CMD		0U	/**< Issue to command complete */
+#define XSDPS_STATS_PHASE_DATA		1U	/**< Command complete to end of
+						  *  data on the bus */
+#define XSDPS_STATS_PHASE_BUSY		2U	/**< End of data to release of
+						  *  card busy (writes only) */
+#define XSDPS_STATS_NUM_PHASES		3U
+
+#define XSDPS_STATS_NUM_BUCKETS		24U	/**< Bucket n holds samples of
+						  *  [2^n, 2^(n+1)) timer ticks,
+						  *  the last one everything
+						  *  longer */
+/*@}*/
+#endif
+
 /**************************** Type Definitions *******************************/
 /**
  * This typedef contains configuration information for the device.
@@ -155,6 +193,30 @@ typedef struct {
 	u32 Address;		/**< Address of current dma transfer */
 } XSdPs_Adma2Descriptor;
 
+#ifdef XSDPS_ENABLE_STATS
+/**
+ * Latency histogram of one phase of one command type. Times are in global
+ * timer ticks, see COUNTS_PER_SECOND in xtime_l.h.
+ */
+typedef struct {
+	u32 Count;		/**< Number of samples */
+	u32 MinTicks;		/**< Shortest sample */
+	u32 MaxTicks;		/**< Longest sample */
+	u64 TotalTicks;		/**< Sum of all samples */
+	u32 Bucket[XSDPS_STATS_NUM_BUCKETS];	/**< log2 distribution */
+} XSdPs_Histogram;
+
+/**
+ * Latency statistics of a driver instance.
+ */
+typedef struct {
+	XSdPs_Histogram Hist[XSDPS_STATS_NUM_TYPES][XSDPS_STATS_NUM_PHASES];
+	XTime PhaseStart;	/**< Start of the phase being timed */
+	u8 CurType;		/**< Type of the command in flight */
+	u8 DataDone;		/**< End of data already recorded */
+} XSdPs_Stats;
+#endif
+
 /**
  * The XSdPs driver instance data. The user is required to allocate a
  * variable of this type for every SD device in the system. A pointer
@@ -184,6 +246,9 @@ typedef struct {
 #else
 	XSdPs_Adma2Descriptor Adma2_DescrTbl[32] __attribute__ ((aligned(32)));
 #endif
+#ifdef XSDPS_ENABLE_STATS
+	XSdPs_Stats Stats;	/**< Per-command latency histograms */
+#endif
 } XSdPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -207,6 +272,22 @@ int XSdPs_MmcCardInitialize(XSdPs *InstancePtr);
 int XSdPs_CardInitialize(XSdPs *InstancePtr);
 int XSdPs_Get_Mmc_ExtCsd(XSdPs *InstancePtr, u8 *ReadBuff);
 
+#ifdef XSDPS_ENABLE_STATS
+void XSdPs_StatsReset(XSdPs *InstancePtr);
+void XSdPs_StatsDump(XSdPs *InstancePtr);
+void XSdPs_StatsCmdStart(XSdPs *InstancePtr, u32 CommandReg);
+void XSdPs_StatsCmdDone(XSdPs *InstancePtr);
+void XSdPs_StatsPollWrite(XSdPs *InstancePtr);
+void XSdPs_StatsXferDone(XSdPs *InstancePtr);
+#else
+#define XSdPs_StatsReset(InstancePtr)
+#define XSdPs_StatsDump(InstancePtr)
+#define XSdPs_StatsCmdStart(InstancePtr, CommandReg)
+#define XSdPs_StatsCmdDone(InstancePtr)
+#define XSdPs_StatsPollWrite(InstancePtr)
+#define XSdPs_StatsXferDone(InstancePtr)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
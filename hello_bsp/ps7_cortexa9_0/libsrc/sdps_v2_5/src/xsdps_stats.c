@@ -0,0 +1,293 @@
+/******************************************************************************
+*
+* Copyright (C) 2013 - 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xsdps_stats.c
+* @addtogroup sdps_v2_5
+* @{
+*
+* Contains the optional per-command latency histograms of the XSdPs driver.
+* Everything in this file is built only when XSDPS_ENABLE_STATS is defined;
+* see xsdps.h for a description of the command types and phases.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 2.5   ag     10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps.h"
+
+#ifdef XSDPS_ENABLE_STATS
+
+#include "xil_printf.h"
+
+/************************** Constant Definitions *****************************/
+#define XSDPS_CMD_INDEX_MASK	0x3F00U
+#define XSDPS_TICKS_PER_USEC	(COUNTS_PER_SECOND / 1000000U)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static void XSdPs_StatsRecord(XSdPs *InstancePtr, u32 Phase);
+
+/************************** Variable Definitions *****************************/
+static const char8 *XSdPs_StatsTypeName[XSDPS_STATS_NUM_TYPES] = {
+	"CTRL", "READ", "WRITE"
+};
+
+static const char8 *XSdPs_StatsPhaseName[XSDPS_STATS_NUM_PHASES] = {
+	"cmd", "data", "busy"
+};
+
+/*****************************************************************************/
+/**
+*
+* Clears all latency histograms of the instance.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_StatsReset(XSdPs *InstancePtr)
+{
+	u32 Type;
+	u32 Phase;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	memset(&InstancePtr->Stats, 0, sizeof(XSdPs_Stats));
+	for (Type = 0U; Type < XSDPS_STATS_NUM_TYPES; Type++) {
+		for (Phase = 0U; Phase < XSDPS_STATS_NUM_PHASES; Phase++) {
+			InstancePtr->Stats.Hist[Type][Phase].MinTicks =
+					0xFFFFFFFFU;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Starts timing the command phase. Called by XSdPs_CmdTransfer right before
+* the command register is written.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	CommandReg is the value about to be written to the command
+*		register. It is used to classify the command.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_StatsCmdStart(XSdPs *InstancePtr, u32 CommandReg)
+{
+	u32 Index = CommandReg & XSDPS_CMD_INDEX_MASK;
+
+	if ((CommandReg & XSDPS_DAT_PRESENT_SEL_MASK) == 0U) {
+		InstancePtr->Stats.CurType = XSDPS_STATS_TYPE_CTRL;
+	} else if ((Index == CMD24) || (Index == CMD25)) {
+		InstancePtr->Stats.CurType = XSDPS_STATS_TYPE_WRITE;
+	} else {
+		InstancePtr->Stats.CurType = XSDPS_STATS_TYPE_READ;
+	}
+	InstancePtr->Stats.DataDone = 0U;
+
+	XTime_GetTime(&InstancePtr->Stats.PhaseStart);
+}
+
+/*****************************************************************************/
+/**
+*
+* Records the command phase once command complete has been seen and starts
+* timing the data phase.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_StatsCmdDone(XSdPs *InstancePtr)
+{
+	XSdPs_StatsRecord(InstancePtr, XSDPS_STATS_PHASE_CMD);
+}
+
+/*****************************************************************************/
+/**
+*
+* Called from the transfer complete poll loop of a write. The first time the
+* controller reports that the write transfer is no longer active the data
+* phase is recorded; the remaining time until transfer complete is the card
+* busy phase.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_StatsPollWrite(XSdPs *InstancePtr)
+{
+	u32 PresentStateReg;
+
+	if (InstancePtr->Stats.DataDone == 0U) {
+		PresentStateReg = XSdPs_ReadReg(InstancePtr->Config.BaseAddress,
+				XSDPS_PRES_STATE_OFFSET);
+		if ((PresentStateReg & XSDPS_PSR_WR_ACTIVE_MASK) == 0U) {
+			XSdPs_StatsRecord(InstancePtr, XSDPS_STATS_PHASE_DATA);
+			InstancePtr->Stats.DataDone = 1U;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Records the last phase of a data transfer once transfer complete has been
+* seen: the data phase of a read, or the busy phase of a write.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_StatsXferDone(XSdPs *InstancePtr)
+{
+	if (InstancePtr->Stats.DataDone == 0U) {
+		XSdPs_StatsRecord(InstancePtr, XSDPS_STATS_PHASE_DATA);
+		InstancePtr->Stats.DataDone = 1U;
+	} else {
+		XSdPs_StatsRecord(InstancePtr, XSDPS_STATS_PHASE_BUSY);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints all non-empty histograms of the instance through xil_printf.
+* Times are printed in microseconds, bucket bounds in global timer ticks.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None.
+*
+******************************************************************************/
+void XSdPs_StatsDump(XSdPs *InstancePtr)
+{
+	XSdPs_Histogram *HistPtr;
+	u32 Type;
+	u32 Phase;
+	u32 Index;
+	u32 Avg;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	xil_printf("SD latency, %d ticks/us\r\n", XSDPS_TICKS_PER_USEC);
+	for (Type = 0U; Type < XSDPS_STATS_NUM_TYPES; Type++) {
+		for (Phase = 0U; Phase < XSDPS_STATS_NUM_PHASES; Phase++) {
+			HistPtr = &InstancePtr->Stats.Hist[Type][Phase];
+			if (HistPtr->Count == 0U) {
+				continue;
+			}
+			Avg = (u32)(HistPtr->TotalTicks / HistPtr->Count);
+			xil_printf("%s/%s: n=%d min=%dus avg=%dus max=%dus\r\n",
+				XSdPs_StatsTypeName[Type],
+				XSdPs_StatsPhaseName[Phase], HistPtr->Count,
+				HistPtr->MinTicks / XSDPS_TICKS_PER_USEC,
+				Avg / XSDPS_TICKS_PER_USEC,
+				HistPtr->MaxTicks / XSDPS_TICKS_PER_USEC);
+			for (Index = 0U; Index < XSDPS_STATS_NUM_BUCKETS;
+					Index++) {
+				if (HistPtr->Bucket[Index] != 0U) {
+					xil_printf("  >=%d: %d\r\n",
+						(Index == 0U) ? 0U :
+						(1U << Index),
+						HistPtr->Bucket[Index]);
+				}
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Adds the time since the start of the current phase to the histogram of
+* that phase and starts the next phase at the same instant.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+* @param	Phase is the phase that has just ended.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XSdPs_StatsRecord(XSdPs *InstancePtr, u32 Phase)
+{
+	XSdPs_Histogram *HistPtr;
+	XTime Now;
+	u64 Elapsed;
+	u32 Ticks;
+	u32 Index;
+
+	XTime_GetTime(&Now);
+	Elapsed = Now - InstancePtr->Stats.PhaseStart;
+	InstancePtr->Stats.PhaseStart = Now;
+
+	Ticks = (Elapsed > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (u32)Elapsed;
+
+	HistPtr = &InstancePtr->Stats.Hist[InstancePtr->Stats.CurType][Phase];
+	HistPtr->Count++;
+	HistPtr->TotalTicks += Ticks;
+	if (Ticks < HistPtr->MinTicks) {
+		HistPtr->MinTicks = Ticks;
+	}
+	if (Ticks > HistPtr->MaxTicks) {
+		HistPtr->MaxTicks = Ticks;
+	}
+
+	Index = 0U;
+	while (((Ticks >> 1) != 0U) &&
+			(Index < (XSDPS_STATS_NUM_BUCKETS - 1U))) {
+		Ticks >>= 1;
+		Index++;
+	}
+	HistPtr->Bucket[Index]++;
+}
+
+#endif /* XSDPS_ENABLE_STATS */
+/** @} */
@@ -0,0 +1,239 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_cache_bench.c
+*
+* Measures the D-cache range maintenance for lengths from 64 bytes to 8 MiB.
+*
+* For each length the buffer is written, so that its lines are dirty, and
+* then flushed with
+*  - the former per line loop, which issues an L2 sync after every line,
+*  - Xil_DCacheFlushRange by address, with the flush all threshold disabled,
+*  - Xil_DCacheFlush, which flushes the whole caches by set/way and by way,
+*  - Xil_DCacheFlushRange with the default threshold,
+* and finally invalidated with Xil_DCacheInvalidateRange. Times are printed
+* in microseconds. The first length at which the whole cache flush beats the
+* flush by address is a good value for Xil_DCacheSetFlushAllThreshold().
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xil_printf.h"
+#include "xl2cc.h"
+#include "xpm_counter.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define CPU_MHZ			(XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000000U)
+#define MIN_LEN			64U
+#define MAX_LEN			(8U * 1024U * 1024U)
+#define CACHE_LINE		32U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CyclesToUs(Cycles)	((Cycles) / CPU_MHZ)
+
+/************************** Function Prototypes ******************************/
+
+int CacheBench(void);
+static void DirtyBuffer(u32 Len);
+static void LegacyFlushRange(u32 Addr, u32 Len);
+
+/************************** Variable Definitions *****************************/
+
+static u8 Buffer[MAX_LEN] __attribute__ ((aligned(32)));
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return CacheBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the measurements for every length and prints one line per length.
+*
+* @param	None
+*
+* @return	XST_SUCCESS.
+*
+* @note		None
+*
+******************************************************************************/
+int CacheBench(void)
+{
+	u32 Len;
+	u32 Start;
+	u32 Legacy;
+	u32 Range;
+	u32 All;
+	u32 Auto;
+	u32 Inval;
+	u32 Crossover = 0U;
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("\r\nD-cache range maintenance, times in us\r\n");
+	xil_printf("   length   per line     range  whole cache      auto"
+		   "  invalidate\r\n");
+
+	for (Len = MIN_LEN; Len <= MAX_LEN; Len *= 2U) {
+		DirtyBuffer(Len);
+		Start = Xpm_GetCycleCounter();
+		LegacyFlushRange((u32)Buffer, Len);
+		Legacy = Xpm_GetCycleCounter() - Start;
+
+		Xil_DCacheSetFlushAllThreshold(0U);
+		DirtyBuffer(Len);
+		Start = Xpm_GetCycleCounter();
+		Xil_DCacheFlushRange((INTPTR)Buffer, Len);
+		Range = Xpm_GetCycleCounter() - Start;
+
+		DirtyBuffer(Len);
+		Start = Xpm_GetCycleCounter();
+		Xil_DCacheFlush();
+		All = Xpm_GetCycleCounter() - Start;
+
+		Xil_DCacheSetFlushAllThreshold(512U * 1024U);
+		DirtyBuffer(Len);
+		Start = Xpm_GetCycleCounter();
+		Xil_DCacheFlushRange((INTPTR)Buffer, Len);
+		Auto = Xpm_GetCycleCounter() - Start;
+
+		DirtyBuffer(Len);
+		Start = Xpm_GetCycleCounter();
+		Xil_DCacheInvalidateRange((INTPTR)Buffer, Len);
+		Inval = Xpm_GetCycleCounter() - Start;
+
+		if ((Crossover == 0U) && (All < Range)) {
+			Crossover = Len;
+		}
+
+		xil_printf("%9d  %9d  %8d  %11d  %8d  %10d\r\n", Len,
+			   CyclesToUs(Legacy), CyclesToUs(Range),
+			   CyclesToUs(All), CyclesToUs(Auto),
+			   CyclesToUs(Inval));
+	}
+
+	xil_printf("Whole cache flush is faster from %d bytes\r\n", Crossover);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the start of the buffer so that its lines are dirty in the caches.
+*
+* @param	Len is the number of bytes to write.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void DirtyBuffer(u32 Len)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Len; Index += 4U) {
+		*(volatile u32 *)&Buffer[Index] = Index;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* The range flush as done before, with an L2 sync after every line and
+* interrupts masked for the whole range.
+*
+* @param	Addr is the start of the range.
+* @param	Len is the length of the range in bytes.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void LegacyFlushRange(u32 Addr, u32 Len)
+{
+	u32 LocalAddr = Addr & ~(CACHE_LINE - 1U);
+	u32 End = Addr + Len;
+	u32 CpsrVal;
+
+	CpsrVal = mfcpsr();
+	mtcpsr(CpsrVal | 0xC0U);
+
+	while (LocalAddr < End) {
+		mtcp(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC, LocalAddr);
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_PA_OFFSET,
+			  LocalAddr);
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET, 0U);
+		LocalAddr += CACHE_LINE;
+	}
+
+	dsb();
+	mtcpsr(CpsrVal);
+}
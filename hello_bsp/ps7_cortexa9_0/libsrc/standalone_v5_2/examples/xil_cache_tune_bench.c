@@ -0,0 +1,344 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_cache_tune_bench.c
+*
+* Sweeps the prefetch settings of Xil_CacheSetTuning() over a bandwidth and
+* a latency workload, to pick the settings of a deployment.
+*
+* For each combination of the L1 prefetcher, the L2 data prefetch and its
+* offset, double linefill and early BRESP, the benchmark measures
+*  - read bandwidth, summing a 4 MB buffer,
+*  - copy bandwidth, copying 2 MB to another 2 MB buffer,
+*  - write bandwidth, filling a 4 MB buffer,
+*  - load latency, chasing a random cycle of pointers 64 bytes apart over
+*    4 MB, which defeats the prefetchers,
+* and prints one line. The best setting for each workload is printed at the
+* end and the settings found at the start are restored.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_cache.h"
+#include "xil_cache_tune.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define CPU_MHZ			(XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000000U)
+#define BUF_LEN			(4U * 1024U * 1024U)
+#define CHASE_STRIDE		64U
+#define CHASE_NODES		(BUF_LEN / CHASE_STRIDE)
+
+#define NUM_OFFSETS		5U
+#define NUM_SETTINGS		(2U * NUM_OFFSETS * 2U * 2U)
+
+/* Index of each workload in the results */
+#define WL_READ			0U
+#define WL_COPY			1U
+#define WL_WRITE		2U
+#define WL_CHASE		3U
+#define NUM_WORKLOADS		4U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CyclesToMBps(Bytes, Cycles) \
+	((u32)(((u64)(Bytes) * CPU_MHZ) / (Cycles)))
+#define CyclesToNs(Cycles)	(((Cycles) * 1000U) / CPU_MHZ)
+
+/************************** Function Prototypes ******************************/
+
+int CacheTuneBench(void);
+static void MakeSetting(u32 Index, const Xil_CacheTuning *Base,
+			Xil_CacheTuning *Tuning);
+static void RunWorkloads(u32 *Result);
+static void BuildChase(void);
+
+/************************** Variable Definitions *****************************/
+
+static u32 BufA[BUF_LEN / 4U] __attribute__ ((aligned(64)));
+static u32 BufB[BUF_LEN / 4U] __attribute__ ((aligned(64)));
+static volatile u32 Sink;
+
+/*
+ * Prefetch offsets of the sweep, NUM_OFFSETS means L2 data prefetch off
+ */
+static const u8 Offsets[NUM_OFFSETS - 1U] = { 0U, 7U, 15U, 31U };
+
+static const char *const WorkloadNames[NUM_WORKLOADS] = {
+	"read MB/s", "copy MB/s", "write MB/s", "chase ns"
+};
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a setting was refused.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return CacheTuneBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the workloads for every setting and prints the table.
+*
+* @param	None
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a setting was refused.
+*
+* @note		None
+*
+******************************************************************************/
+int CacheTuneBench(void)
+{
+	Xil_CacheTuning Base;
+	Xil_CacheTuning Tuning;
+	u32 Result[NUM_WORKLOADS];
+	u32 Best[NUM_WORKLOADS];
+	u32 BestIndex[NUM_WORKLOADS];
+	u32 Index;
+	u32 Workload;
+	s32 Status = XST_SUCCESS;
+
+	Xil_CacheGetTuning(&Base);
+	Xpm_EnableCycleCounter();
+	BuildChase();
+
+	for (Workload = 0U; Workload < NUM_WORKLOADS; Workload++) {
+		Best[Workload] = (Workload == WL_CHASE) ? 0xFFFFFFFFU : 0U;
+		BestIndex[Workload] = 0U;
+	}
+
+	xil_printf("\r\nPrefetch sweep, base ACTLR prefetch %d, L2 offset %d\r\n",
+		   Base.L1Prefetch, Base.PrefetchOffset);
+	xil_printf("  # L1pf L2pf off dlf ebresp  read MB/s  copy MB/s"
+		   "  write MB/s  chase ns\r\n");
+
+	for (Index = 0U; Index < NUM_SETTINGS; Index++) {
+		MakeSetting(Index, &Base, &Tuning);
+		if (Xil_CacheSetTuning(&Tuning) != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			break;
+		}
+
+		RunWorkloads(Result);
+
+		for (Workload = 0U; Workload < NUM_WORKLOADS; Workload++) {
+			if (((Workload == WL_CHASE) &&
+			     (Result[Workload] < Best[Workload])) ||
+			    ((Workload != WL_CHASE) &&
+			     (Result[Workload] > Best[Workload]))) {
+				Best[Workload] = Result[Workload];
+				BestIndex[Workload] = Index;
+			}
+		}
+
+		xil_printf("%3d %4d %4d %3d %3d %6d  %9d  %9d  %10d  %8d\r\n",
+			   Index, Tuning.L1Prefetch, Tuning.L2DataPrefetch,
+			   Tuning.PrefetchOffset, Tuning.DoubleLinefill,
+			   Tuning.EarlyBresp, Result[WL_READ], Result[WL_COPY],
+			   Result[WL_WRITE], Result[WL_CHASE]);
+	}
+
+	(void)Xil_CacheSetTuning(&Base);
+
+	for (Workload = 0U; Workload < NUM_WORKLOADS; Workload++) {
+		xil_printf("Best %s: %d with setting %d\r\n",
+			   WorkloadNames[Workload], Best[Workload],
+			   BestIndex[Workload]);
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Derives the setting of a sweep index from the base settings.
+*
+* @param	Index is the sweep index, below NUM_SETTINGS.
+* @param	Base holds the settings found at the start.
+* @param	Tuning is filled in with the setting.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void MakeSetting(u32 Index, const Xil_CacheTuning *Base,
+			Xil_CacheTuning *Tuning)
+{
+	u32 Offset = (Index / 4U) % NUM_OFFSETS;
+
+	*Tuning = *Base;
+	Tuning->EarlyBresp = (u8)(Index % 2U);
+	Tuning->DoubleLinefill = (u8)((Index / 2U) % 2U);
+	if (Offset == (NUM_OFFSETS - 1U)) {
+		Tuning->L2DataPrefetch = 0U;
+		Tuning->PrefetchOffset = 0U;
+	} else {
+		Tuning->L2DataPrefetch = 1U;
+		Tuning->PrefetchOffset = Offsets[Offset];
+	}
+	Tuning->L1Prefetch = (u8)(Index / (4U * NUM_OFFSETS));
+}
+
+/*****************************************************************************/
+/**
+*
+* Runs the four workloads, each on buffers flushed from the caches.
+*
+* @param	Result is filled in per workload, MB/s or ns per load.
+*
+* @return	None
+*
+* @note		The chase reads the links in BufB, which the copy and write
+*		workloads leave alone.
+*
+******************************************************************************/
+static void RunWorkloads(u32 *Result)
+{
+	u32 Start;
+	u32 Cycles;
+	u32 Index;
+	u32 Sum = 0U;
+	u32 Node = 0U;
+
+	Xil_DCacheFlush();
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < (BUF_LEN / 4U); Index += 4U) {
+		Sum += BufA[Index] + BufA[Index + 1U] + BufA[Index + 2U] +
+		       BufA[Index + 3U];
+	}
+	Cycles = Xpm_GetCycleCounter() - Start;
+	Sink = Sum;
+	Result[WL_READ] = CyclesToMBps(BUF_LEN, Cycles);
+
+	Xil_DCacheFlush();
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < (BUF_LEN / 8U); Index += 4U) {
+		BufA[(BUF_LEN / 8U) + Index] = BufA[Index];
+		BufA[(BUF_LEN / 8U) + Index + 1U] = BufA[Index + 1U];
+		BufA[(BUF_LEN / 8U) + Index + 2U] = BufA[Index + 2U];
+		BufA[(BUF_LEN / 8U) + Index + 3U] = BufA[Index + 3U];
+	}
+	Cycles = Xpm_GetCycleCounter() - Start;
+	Result[WL_COPY] = CyclesToMBps(BUF_LEN / 2U, Cycles);
+
+	Xil_DCacheFlush();
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < (BUF_LEN / 4U); Index += 4U) {
+		BufA[Index] = Index;
+		BufA[Index + 1U] = Index;
+		BufA[Index + 2U] = Index;
+		BufA[Index + 3U] = Index;
+	}
+	Xil_DCacheFlush();
+	Cycles = Xpm_GetCycleCounter() - Start;
+	Result[WL_WRITE] = CyclesToMBps(BUF_LEN, Cycles);
+
+	Xil_DCacheFlush();
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < CHASE_NODES; Index++) {
+		Node = BufB[Node];
+	}
+	Cycles = Xpm_GetCycleCounter() - Start;
+	Sink = Node;
+	Result[WL_CHASE] = CyclesToNs(Cycles) / CHASE_NODES;
+}
+
+/*****************************************************************************/
+/**
+*
+* Links the nodes of BufB into one random cycle, with Sattolo's algorithm.
+* Each node holds the word index of the next one.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void BuildChase(void)
+{
+	u32 Index;
+	u32 Other;
+	u32 Temp;
+	u32 Seed = 0x12345678U;
+	const u32 Words = CHASE_STRIDE / 4U;
+
+	for (Index = 0U; Index < CHASE_NODES; Index++) {
+		BufB[Index * Words] = Index;
+	}
+
+	/* Shuffle the node numbers into a single cycle */
+	for (Index = CHASE_NODES - 1U; Index > 0U; Index--) {
+		Seed = (Seed * 1664525U) + 1013904223U;
+		Other = (Seed >> 8) % Index;
+		Temp = BufB[Index * Words];
+		BufB[Index * Words] = BufB[Other * Words];
+		BufB[Other * Words] = Temp;
+	}
+
+	/* Turn node numbers into word indexes */
+	for (Index = 0U; Index < CHASE_NODES; Index++) {
+		BufB[Index * Words] *= Words;
+	}
+}
@@ -0,0 +1,232 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_coherent_bench.c
+*
+* Measures the cycles a driver saves per DMA transfer with buffers in a
+* coherent region, and what the CPU pays to access them.
+*
+* A source and a destination buffer are taken from cacheable memory and
+* from a XIL_COHERENT_NONCACHE region. For lengths from 512 bytes to 64 KB
+* the benchmark times
+*  - the cache maintenance a driver does around one transfer, flushing the
+*    source after the CPU wrote it and invalidating the destination, or only
+*    the Xil_IsCoherent() checks for the coherent buffers,
+*  - the CPU writing the source and reading the destination,
+* and prints the cycles for both kinds of buffers. Coherent buffers pay off
+* when the saved maintenance outweighs the slower CPU access, which is the
+* case for buffers the CPU touches little, like descriptors and buffers
+* handed from one DMA master to another.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_cache.h"
+#include "xil_coherent.h"
+#include "xil_mmu.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define MIN_LEN			512U
+#define MAX_LEN			(64U * 1024U)
+#define REGION_LEN		(4U * MAX_LEN)
+#define CACHE_LINE		32U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int CoherentBench(void);
+static u32 MaintainTransfer(u32 *Src, u32 *Dst, u32 Len);
+static u32 CpuAccess(u32 *Src, const u32 *Dst, u32 Len);
+
+/************************** Variable Definitions *****************************/
+
+static u32 CachedSrc[MAX_LEN / 4U] __attribute__ ((aligned(32)));
+static u32 CachedDst[MAX_LEN / 4U] __attribute__ ((aligned(32)));
+static u8 Region[REGION_LEN] __attribute__ ((aligned(4096)));
+static volatile u32 Sink;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the region could not be set up.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return CoherentBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Registers the coherent region and runs the measurements.
+*
+* @param	None
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the region could not be set up.
+*
+* @note		None
+*
+******************************************************************************/
+int CoherentBench(void)
+{
+	u32 *CoherentSrc;
+	u32 *CoherentDst;
+	u32 Len;
+	u32 CachedSync;
+	u32 CoherentSync;
+	u32 CachedCpu;
+	u32 CoherentCpu;
+
+	if (Xil_CoherentAddRegion((INTPTR)Region, REGION_LEN,
+				  XIL_COHERENT_NONCACHE) != XST_SUCCESS) {
+		xil_printf("Coherent region failed\r\n");
+		return XST_FAILURE;
+	}
+	CoherentSrc = Xil_CoherentAlloc(MAX_LEN, CACHE_LINE,
+					XIL_COHERENT_NONCACHE);
+	CoherentDst = Xil_CoherentAlloc(MAX_LEN, CACHE_LINE,
+					XIL_COHERENT_NONCACHE);
+	if ((CoherentSrc == NULL) || (CoherentDst == NULL)) {
+		xil_printf("Coherent allocation failed\r\n");
+		return XST_FAILURE;
+	}
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("\r\nCycles per transfer, cache maintenance and CPU access\r\n");
+	xil_printf("   length  cached sync  coherent sync  saved"
+		   "  cached cpu  coherent cpu\r\n");
+
+	for (Len = MIN_LEN; Len <= MAX_LEN; Len *= 2U) {
+		CachedCpu = CpuAccess(CachedSrc, CachedDst, Len);
+		CachedSync = MaintainTransfer(CachedSrc, CachedDst, Len);
+		CoherentCpu = CpuAccess(CoherentSrc, CoherentDst, Len);
+		CoherentSync = MaintainTransfer(CoherentSrc, CoherentDst, Len);
+
+		xil_printf("%9d  %11d  %13d  %5d  %10d  %12d\r\n", Len,
+			   CachedSync, CoherentSync, CachedSync - CoherentSync,
+			   CachedCpu, CoherentCpu);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Does the cache maintenance of a driver around one transfer from Src to
+* Dst, as XDmaPs_Start does.
+*
+* @param	Src is the source buffer, written by the CPU.
+* @param	Dst is the destination buffer, read by the CPU afterwards.
+* @param	Len is the length of the transfer in bytes.
+*
+* @return	Cycles taken.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 MaintainTransfer(u32 *Src, u32 *Dst, u32 Len)
+{
+	u32 Start;
+
+	Start = Xpm_GetCycleCounter();
+	if (Xil_IsCoherent((INTPTR)Src, Len) == 0U) {
+		Xil_DCacheFlushRange((INTPTR)Src, Len);
+	}
+	if (Xil_IsCoherent((INTPTR)Dst, Len) == 0U) {
+		Xil_DCacheInvalidateRange((INTPTR)Dst, Len);
+	}
+
+	return Xpm_GetCycleCounter() - Start;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the source and reads the destination with the CPU, as the producer
+* and the consumer of a transfer.
+*
+* @param	Src is the source buffer.
+* @param	Dst is the destination buffer.
+* @param	Len is the length of the buffers in bytes.
+*
+* @return	Cycles taken.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 CpuAccess(u32 *Src, const u32 *Dst, u32 Len)
+{
+	u32 Start;
+	u32 Index;
+	u32 Sum = 0U;
+
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < (Len / 4U); Index++) {
+		Src[Index] = Index;
+	}
+	for (Index = 0U; Index < (Len / 4U); Index++) {
+		Sum += Dst[Index];
+	}
+	Sink = Sum;
+
+	return Xpm_GetCycleCounter() - Start;
+}
@@ -0,0 +1,424 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_defer_bench.c
+*
+* Measures the worst case time a driver interrupt handler keeps interrupts
+* masked, and the latency it adds to a timer interrupt, with the driver
+* callback called in the handler and with the callback deferred through
+* xil_defer.
+*
+* The driver is emulated on the EMAC interrupt ID, whose pending bit the main
+* loop sets every RAISE_US microseconds. Its handler clears a status word and
+* calls the receive callback, the way XEmacPs_IntrHandler does; the callback
+* busy waits for WORK_US microseconds like protocol processing. In the
+* deferred pass the callback is Xil_DeferHandler() and the processing runs
+* from the deferred work SGI with interrupts enabled.
+*
+* The private timer interrupts every millisecond with a high priority and
+* records its latency from the timer event. For each pass the longest time
+* in the EMAC handler, the maximum timer latency and the number of completed
+* work runs are printed.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xscugic.h"
+#include "xscutimer.h"
+#include "xil_defer.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define INTC_DEVICE_ID		XPAR_SCUGIC_0_DEVICE_ID
+#define TIMER_DEVICE_ID		XPAR_XSCUTIMER_0_DEVICE_ID
+#define TIMER_IRPT_INTR		XPAR_SCUTIMER_INTR
+#define EMAC_INTR_ID		XPS_GEM0_INT_ID
+
+#define CPU_HZ			XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ
+#define TIMER_HZ		(CPU_HZ / 2U)
+#define TIMER_LOAD		(TIMER_HZ / 1000U)	/* 1 ms period */
+
+#define TIMER_PRIORITY		0x08U
+#define EMAC_PRIORITY		0xA0U
+#define TRIGGER_RISING		0x3U
+
+#define WORK_US			150U
+#define RAISE_US		500U
+#define BENCH_SAMPLES		2000U	/* Timer interrupts per pass */
+
+/**************************** Type Definitions *******************************/
+
+/*
+ * Emulated driver instance
+ */
+typedef struct {
+	volatile u32 Status;
+	void (*RecvHandler)(void *CallBackRef);
+	void *RecvRef;
+} EmacEmul;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int DeferBench(void);
+static int SetupInterrupts(void);
+static void RunPass(const char *Name);
+static void TimerHandler(void *CallBackRef);
+static void EmacIntrHandler(void *CallBackRef);
+static void RecvCallback(void *CallBackRef);
+static void RecvWork(void *Arg, u32 Data);
+static void BusyWaitUs(u32 Us);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic IntcInstance;
+static XScuTimer TimerInstance;
+static EmacEmul Emac;
+static Xil_DeferWork RecvDeferWork;
+
+static volatile u32 Samples;
+static volatile u32 MaxLatency;
+static volatile u32 MaxMasked;
+static volatile u32 WorkRuns;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return DeferBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the pass with the callback in the handler, then the deferred pass.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int DeferBench(void)
+{
+	Xil_DeferStats Stats;
+
+	Xpm_EnableCycleCounter();
+
+	if (SetupInterrupts() != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	xil_printf("\r\nDriver callback of %d us, raised every %d us\r\n",
+		   WORK_US, RAISE_US);
+	xil_printf("callback  max masked us  max timer latency us  runs\r\n");
+
+	Emac.RecvHandler = RecvCallback;
+	Emac.RecvRef = NULL;
+	RunPass("in isr  ");
+
+	if (Xil_DeferInit(&IntcInstance) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuGic_SetNesting(&IntcInstance, 1U);
+	Xil_DeferWorkInit(&RecvDeferWork, 0U, RecvWork, NULL);
+	Emac.RecvHandler = Xil_DeferHandler;
+	Emac.RecvRef = &RecvDeferWork;
+	RunPass("deferred");
+
+	Xil_DeferGetStats(&Stats);
+	xil_printf("deferred: %d scheduled, %d coalesced, %d dropped\r\n",
+		   Stats.Scheduled, Stats.Coalesced, Stats.Dropped);
+
+	XScuGic_Disable(&IntcInstance, EMAC_INTR_ID);
+	XScuGic_SetNesting(&IntcInstance, 0U);
+	Xil_ExceptionDisable();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initializes the GIC and the private timer and connects both handlers.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int SetupInterrupts(void)
+{
+	XScuGic_Config *IntcConfig;
+	XScuTimer_Config *TimerConfig;
+	int Status;
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (IntcConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(&IntcInstance, IntcConfig,
+				       IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	TimerConfig = XScuTimer_LookupConfig(TIMER_DEVICE_ID);
+	if (TimerConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuTimer_CfgInitialize(&TimerInstance, TimerConfig,
+					 TimerConfig->BaseAddr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	XScuTimer_SetPrescaler(&TimerInstance, 0U);
+	XScuTimer_EnableAutoReload(&TimerInstance);
+	XScuTimer_LoadTimer(&TimerInstance, TIMER_LOAD);
+	XScuTimer_EnableInterrupt(&TimerInstance);
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			&IntcInstance);
+
+	XScuGic_SetPriorityTriggerType(&IntcInstance, TIMER_IRPT_INTR,
+				       TIMER_PRIORITY, TRIGGER_RISING);
+	XScuGic_SetPriorityTriggerType(&IntcInstance, EMAC_INTR_ID,
+				       EMAC_PRIORITY, TRIGGER_RISING);
+
+	Status = XScuGic_Connect(&IntcInstance, TIMER_IRPT_INTR,
+				 TimerHandler, &TimerInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_Connect(&IntcInstance, EMAC_INTR_ID,
+				 EmacIntrHandler, &Emac);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XScuGic_Enable(&IntcInstance, TIMER_IRPT_INTR);
+	XScuGic_Enable(&IntcInstance, EMAC_INTR_ID);
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Raises the EMAC interrupt until BENCH_SAMPLES timer interrupts are
+* collected and prints one result line.
+*
+* @param	Name is the label of the pass.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RunPass(const char *Name)
+{
+	Samples = 0U;
+	MaxLatency = 0U;
+	MaxMasked = 0U;
+	WorkRuns = 0U;
+
+	XScuTimer_RestartTimer(&TimerInstance);
+	XScuTimer_Start(&TimerInstance);
+
+	while (Samples < BENCH_SAMPLES) {
+		XScuGic_DistWriteReg(&IntcInstance,
+			XSCUGIC_EN_DIS_OFFSET_CALC(XSCUGIC_PENDING_SET_OFFSET,
+						   EMAC_INTR_ID),
+			(u32)1U << (EMAC_INTR_ID % 32U));
+		BusyWaitUs(RAISE_US);
+	}
+
+	XScuTimer_Stop(&TimerInstance);
+
+	xil_printf("%s  %13d  %20d  %4d\r\n", Name,
+		   MaxMasked / (CPU_HZ / 1000000U),
+		   (u32)(((u64)MaxLatency * 1000000U) / TIMER_HZ), WorkRuns);
+}
+
+/*****************************************************************************/
+/**
+*
+* Private timer handler. Records the counts elapsed since the reload.
+*
+* @param	CallBackRef is the timer instance.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void TimerHandler(void *CallBackRef)
+{
+	XScuTimer *TimerPtr = (XScuTimer *)CallBackRef;
+	u32 Counts;
+
+	Counts = TIMER_LOAD - XScuTimer_GetCounterValue(TimerPtr);
+	XScuTimer_ClearInterruptStatus(TimerPtr);
+
+	if (Samples < BENCH_SAMPLES) {
+		if (Counts > MaxLatency) {
+			MaxLatency = Counts;
+		}
+		Samples++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Emulated EMAC interrupt handler. Clears the status and calls the receive
+* callback, and records its own duration.
+*
+* @param	CallBackRef is the EmacEmul instance.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void EmacIntrHandler(void *CallBackRef)
+{
+	EmacEmul *EmacPtr = (EmacEmul *)CallBackRef;
+	u32 Start;
+	u32 Cycles;
+
+	Start = Xpm_GetCycleCounter();
+
+	EmacPtr->Status = 0U;
+	EmacPtr->RecvHandler(EmacPtr->RecvRef);
+
+	Cycles = Xpm_GetCycleCounter() - Start;
+	if (Cycles > MaxMasked) {
+		MaxMasked = Cycles;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Receive callback called in the interrupt handler.
+*
+* @param	CallBackRef is unused.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RecvCallback(void *CallBackRef)
+{
+	RecvWork(CallBackRef, 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* Receive processing, busy waits for WORK_US microseconds.
+*
+* @param	Arg is unused.
+* @param	Data is unused.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RecvWork(void *Arg, u32 Data)
+{
+	(void)Arg;
+	(void)Data;
+
+	BusyWaitUs(WORK_US);
+	WorkRuns++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Busy waits on the global timer.
+*
+* @param	Us is the time in microseconds.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void BusyWaitUs(u32 Us)
+{
+	XTime Start;
+	XTime Now;
+
+	XTime_GetTime(&Start);
+	do {
+		XTime_GetTime(&Now);
+	} while ((Now - Start) < ((XTime)COUNTS_PER_SECOND * Us / 1000000U));
+}
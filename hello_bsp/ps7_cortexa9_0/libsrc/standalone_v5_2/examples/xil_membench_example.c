@@ -0,0 +1,119 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_membench_example.c
+*
+* Prints the latency and STREAM tables of Xil_MemBenchReport() for a 16 MB
+* DDR buffer and the 192 KB of OCM mapped at address 0, which the linker
+* script leaves unused.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_membench.h"
+#include "xil_printf.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define DDR_LEN			(16U * 1024U * 1024U)
+#define OCM_ADDR		XPAR_PS7_RAM_0_S_AXI_BASEADDR
+#define OCM_LEN			0x30000U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int MemBenchExample(void);
+
+/************************** Variable Definitions *****************************/
+
+static u8 DdrBuf[DDR_LEN] __attribute__ ((aligned(4096)));
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a buffer could not be remapped.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return MemBenchExample();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the memory benchmark suite.
+*
+* @param	None
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a buffer could not be remapped.
+*
+* @note		None
+*
+******************************************************************************/
+int MemBenchExample(void)
+{
+	s32 Status;
+
+	Status = Xil_MemBenchReport((INTPTR)DdrBuf, DDR_LEN, OCM_ADDR,
+				    OCM_LEN);
+	if (Status != XST_SUCCESS) {
+		xil_printf("Memory benchmark failed\r\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
@@ -0,0 +1,277 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_mmu_bench.c
+*
+* Measures the cost of changing memory attributes in the translation table.
+*
+* A 1 MB section of a buffer is set non-cacheable and back to write-back
+*  - the former way, with a flush of the whole D-cache and of the whole TLB,
+*  - with Xil_SetTlbAttributes, which flushes the section by range,
+* and then ranges of 4 KB pages inside the next section are changed with
+* Xil_SetTlbAttributesRange. Before each change the range is written through
+* the cache, after it the data is read back through the new mapping to check
+* that nothing was lost. Times are printed in microseconds.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_cache.h"
+#include "xil_mmu.h"
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define CPU_MHZ			(XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000000U)
+
+#define NORM_WB_CACHE		0x15DE6U	/* as DDR in translation_table.S */
+#define NORM_NONCACHE		0x14DE2U	/* TEX=b100, C=b0, B=b0 */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CyclesToUs(Cycles)	((Cycles) / CPU_MHZ)
+
+/************************** Function Prototypes ******************************/
+
+int MmuBench(void);
+static void FillRange(u8 *Ptr, u32 Len);
+static s32 CheckRange(const u8 *Ptr, u32 Len);
+static void LegacySetTlbAttributes(INTPTR Addr, u32 attrib);
+
+/************************** Variable Definitions *****************************/
+
+extern u32 MMUTable;
+
+static u8 Buffer[2U * XIL_MMU_SECTION_SIZE]
+	__attribute__ ((aligned(0x100000)));
+
+static const u32 PageLens[] = {
+	XIL_MMU_PAGE_SIZE, 4U * XIL_MMU_PAGE_SIZE, 16U * XIL_MMU_PAGE_SIZE,
+	64U * XIL_MMU_PAGE_SIZE
+};
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the data was kept, else XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return MmuBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the measurements and prints one line per case.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the data was kept, else XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int MmuBench(void)
+{
+	u8 *Section = &Buffer[0];
+	u8 *Pages = &Buffer[XIL_MMU_SECTION_SIZE];
+	u32 Start;
+	u32 Set;
+	u32 Restore;
+	u32 Index;
+	s32 Status = XST_SUCCESS;
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("\r\nTranslation table changes, times in us\r\n");
+	xil_printf("                        length  non-cacheable  write-back\r\n");
+
+	FillRange(Section, XIL_MMU_SECTION_SIZE);
+	Start = Xpm_GetCycleCounter();
+	LegacySetTlbAttributes((INTPTR)Section, NORM_NONCACHE);
+	Set = Xpm_GetCycleCounter() - Start;
+	Status |= CheckRange(Section, XIL_MMU_SECTION_SIZE);
+	Start = Xpm_GetCycleCounter();
+	LegacySetTlbAttributes((INTPTR)Section, NORM_WB_CACHE);
+	Restore = Xpm_GetCycleCounter() - Start;
+	xil_printf("whole cache and TLB  %9d  %13d  %10d\r\n",
+		   XIL_MMU_SECTION_SIZE, CyclesToUs(Set), CyclesToUs(Restore));
+
+	FillRange(Section, XIL_MMU_SECTION_SIZE);
+	Start = Xpm_GetCycleCounter();
+	Xil_SetTlbAttributes((INTPTR)Section, NORM_NONCACHE);
+	Set = Xpm_GetCycleCounter() - Start;
+	Status |= CheckRange(Section, XIL_MMU_SECTION_SIZE);
+	Start = Xpm_GetCycleCounter();
+	Xil_SetTlbAttributes((INTPTR)Section, NORM_WB_CACHE);
+	Restore = Xpm_GetCycleCounter() - Start;
+	xil_printf("Xil_SetTlbAttributes %9d  %13d  %10d\r\n",
+		   XIL_MMU_SECTION_SIZE, CyclesToUs(Set), CyclesToUs(Restore));
+
+	for (Index = 0U; Index < (sizeof(PageLens) / sizeof(PageLens[0]));
+	     Index++) {
+		FillRange(Pages, PageLens[Index]);
+		Start = Xpm_GetCycleCounter();
+		if (Xil_SetTlbAttributesRange((INTPTR)Pages, PageLens[Index],
+					      NORM_NONCACHE) != XST_SUCCESS) {
+			xil_printf("No free page table\r\n");
+			return XST_FAILURE;
+		}
+		Set = Xpm_GetCycleCounter() - Start;
+		Status |= CheckRange(Pages, PageLens[Index]);
+		Start = Xpm_GetCycleCounter();
+		(void)Xil_SetTlbAttributesRange((INTPTR)Pages, PageLens[Index],
+						NORM_WB_CACHE);
+		Restore = Xpm_GetCycleCounter() - Start;
+		xil_printf("4 KB pages           %9d  %13d  %10d\r\n",
+			   PageLens[Index], CyclesToUs(Set),
+			   CyclesToUs(Restore));
+	}
+
+	/* Map the page section as one section again */
+	Xil_SetTlbAttributes((INTPTR)Pages, NORM_WB_CACHE);
+
+	if (Status != XST_SUCCESS) {
+		xil_printf("Data lost across an attribute change\r\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes a pattern to a range through the cache.
+*
+* @param	Ptr is the start of the range.
+* @param	Len is the number of bytes to write.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void FillRange(u8 *Ptr, u32 Len)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Len; Index += 4U) {
+		*(volatile u32 *)&Ptr[Index] = (u32)&Ptr[Index];
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Checks the pattern written by FillRange.
+*
+* @param	Ptr is the start of the range.
+* @param	Len is the number of bytes to check.
+*
+* @return	XST_SUCCESS if the pattern is intact, else XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static s32 CheckRange(const u8 *Ptr, u32 Len)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < Len; Index += 4U) {
+		if (*(const volatile u32 *)&Ptr[Index] != (u32)&Ptr[Index]) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* The section attribute change as done before, with a flush of the whole
+* D-cache and an invalidation of the whole TLB.
+*
+* @param	Addr is an address in the section.
+* @param	attrib specifies the attributes for the section.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void LegacySetTlbAttributes(INTPTR Addr, u32 attrib)
+{
+	u32 *ptr;
+	u32 section;
+
+	section = ((u32)Addr) / XIL_MMU_SECTION_SIZE;
+	ptr = &MMUTable + section;
+	*ptr = (((u32)Addr) & 0xFFF00000U) | attrib;
+
+	Xil_DCacheFlush();
+
+	mtcp(XREG_CP15_INVAL_UTLB_UNLOCKED, 0U);
+	mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0U);
+
+	dsb();
+	isb();
+}
@@ -0,0 +1,172 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_snprintf_bench.c
+*
+* Compares the cost in CPU cycles of xil_snprintf() with newlib's snprintf()
+* for a few formats that are common in packet and record formatting. Each
+* format is run XIL_BENCH_ITERATIONS times into a RAM buffer after a warm-up
+* call, and the average cycles per call, measured with the PMU cycle counter,
+* are printed over stdout.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include "xil_printf.h"
+#include "xpm_counter.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XIL_BENCH_ITERATIONS	1000U
+#define XIL_BENCH_BUF_SIZE	64U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/*
+ * Runs Stmt XIL_BENCH_ITERATIONS times and yields the average cycles.
+ */
+#define XIL_BENCH_RUN(Result, Stmt)					\
+	{								\
+		u32 Iter;						\
+		u32 Start;						\
+		Stmt;							\
+		Start = Xpm_GetCycleCounter();				\
+		for (Iter = 0U; Iter < XIL_BENCH_ITERATIONS; Iter++) {	\
+			Stmt;						\
+		}							\
+		(Result) = (Xpm_GetCycleCounter() - Start) /		\
+				XIL_BENCH_ITERATIONS;			\
+	}
+
+/************************** Function Prototypes ******************************/
+
+int SnprintfBench(void);
+
+/************************** Variable Definitions *****************************/
+
+static char8 Buf[XIL_BENCH_BUF_SIZE];
+static volatile s32 IntArg = -123456;
+static volatile u32 HexArg = 0xC0FFEEU;
+static volatile u64 LongArg = 0x123456789ABCDEFULL;
+static const char8 *StrArg = "sensor";
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return SnprintfBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Formats the same arguments with both implementations and prints a table of
+* average cycles per call.
+*
+* @param	None
+*
+* @return	XST_SUCCESS
+*
+* @note		None
+*
+******************************************************************************/
+int SnprintfBench(void)
+{
+	u32 Xil;
+	u32 Newlib;
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("\r\nsnprintf cycles/call (%d iterations)\r\n",
+			XIL_BENCH_ITERATIONS);
+	xil_printf("format              xil_snprintf  newlib\r\n");
+
+	XIL_BENCH_RUN(Xil, xil_snprintf(Buf, sizeof(Buf), "%d", IntArg));
+	XIL_BENCH_RUN(Newlib, snprintf(Buf, sizeof(Buf), "%d", (int)IntArg));
+	xil_printf("%%d                  %8d  %8d\r\n", Xil, Newlib);
+
+	XIL_BENCH_RUN(Xil, xil_snprintf(Buf, sizeof(Buf), "%08x", HexArg));
+	XIL_BENCH_RUN(Newlib, snprintf(Buf, sizeof(Buf), "%08lx",
+			(unsigned long)HexArg));
+	xil_printf("%%08x                %8d  %8d\r\n", Xil, Newlib);
+
+	XIL_BENCH_RUN(Xil, xil_snprintf(Buf, sizeof(Buf), "%s=%d",
+			StrArg, IntArg));
+	XIL_BENCH_RUN(Newlib, snprintf(Buf, sizeof(Buf), "%s=%d",
+			StrArg, (int)IntArg));
+	xil_printf("%%s=%%d               %8d  %8d\r\n", Xil, Newlib);
+
+	XIL_BENCH_RUN(Xil, xil_snprintf(Buf, sizeof(Buf), "%-10s|%5u|%c",
+			StrArg, HexArg, 'x'));
+	XIL_BENCH_RUN(Newlib, snprintf(Buf, sizeof(Buf), "%-10s|%5lu|%c",
+			StrArg, (unsigned long)HexArg, 'x'));
+	xil_printf("%%-10s|%%5u|%%c       %8d  %8d\r\n", Xil, Newlib);
+
+	XIL_BENCH_RUN(Xil, xil_snprintf(Buf, sizeof(Buf), "%llu", LongArg));
+	XIL_BENCH_RUN(Newlib, snprintf(Buf, sizeof(Buf), "%llu",
+			(unsigned long long)LongArg));
+	xil_printf("%%llu                %8d  %8d\r\n", Xil, Newlib);
+
+	XIL_BENCH_RUN(Xil, xil_snprintf(Buf, sizeof(Buf), "%llx", LongArg));
+	XIL_BENCH_RUN(Newlib, snprintf(Buf, sizeof(Buf), "%llx",
+			(unsigned long long)LongArg));
+	xil_printf("%%llx                %8d  %8d\r\n", Xil, Newlib);
+
+	return XST_SUCCESS;
+}
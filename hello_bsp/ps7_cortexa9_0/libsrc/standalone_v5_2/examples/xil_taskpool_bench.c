@@ -0,0 +1,283 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_taskpool_bench.c
+*
+* Measures the parallel speedup of a data parallel image kernel with the
+* work stealing task pool on CPU0 and CPU1.
+*
+* A 3x3 box filter is applied to a 1024 x 1024 8 bit image, split into
+* BENCH_CHUNKS bands of rows. The bands are first run one after the other on
+* CPU0, then CPU1 is started with Xil_TaskPoolWorker() and the bands are run
+* with Xil_TaskParallelFor(). Both results are compared, and the time per
+* frame, the speedup and the number of bands each CPU ran are printed.
+*
+* Build the BSP and this application with USE_SMP=1.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_printf.h"
+#include "xil_exception.h"
+#include "xil_smp.h"
+#include "xil_taskpool.h"
+#include "xscugic.h"
+#include "xstatus.h"
+#include "xtime_l.h"
+
+#if USE_SMP!=1
+#error "build the BSP and this example with USE_SMP=1"
+#endif
+
+/************************** Constant Definitions *****************************/
+
+#define INTC_DEVICE_ID		XPAR_SCUGIC_0_DEVICE_ID
+
+#define IMAGE_WIDTH		1024U
+#define IMAGE_HEIGHT		1024U
+#define BENCH_CHUNKS		64U
+#define BENCH_FRAMES		10U
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int TaskPoolBench(void);
+static void BoxFilterBand(void *Arg, u32 Index);
+static u32 ElapsedUs(XTime Start);
+
+/************************** Variable Definitions *****************************/
+
+static XScuGic IntcInstance;
+
+static u8 SrcImage[IMAGE_HEIGHT][IMAGE_WIDTH];
+static u8 SerialImage[IMAGE_HEIGHT][IMAGE_WIDTH];
+static u8 ParallelImage[IMAGE_HEIGHT][IMAGE_WIDTH];
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the benchmark.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return TaskPoolBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the filter serially, starts CPU1 and runs it through the task pool.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int TaskPoolBench(void)
+{
+	XScuGic_Config *IntcConfig;
+	Xil_TaskPoolStats Stats[XIL_SMP_NUM_CPUS];
+	XTime Start;
+	u32 SerialUs;
+	u32 ParallelUs;
+	u32 Frame;
+	u32 Index;
+	u32 Row;
+	u32 Col;
+	s32 Status;
+
+	for (Row = 0U; Row < IMAGE_HEIGHT; Row++) {
+		for (Col = 0U; Col < IMAGE_WIDTH; Col++) {
+			SrcImage[Row][Col] = (u8)((Row * 7U) ^ (Col * 13U));
+		}
+	}
+
+	IntcConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (IntcConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(&IntcInstance, IntcConfig,
+				       IntcConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			&IntcInstance);
+	Xil_ExceptionEnable();
+
+	/*
+	 * One CPU
+	 */
+	XTime_GetTime(&Start);
+	for (Frame = 0U; Frame < BENCH_FRAMES; Frame++) {
+		for (Index = 0U; Index < BENCH_CHUNKS; Index++) {
+			BoxFilterBand(SerialImage, Index);
+		}
+	}
+	SerialUs = ElapsedUs(Start) / BENCH_FRAMES;
+
+	/*
+	 * Both CPUs
+	 */
+	if (Xil_TaskPoolInit(&IntcInstance) != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	if (Xil_SmpStartCpu1(Xil_TaskPoolWorker) != XST_SUCCESS) {
+		xil_printf("CPU1 did not start\r\n");
+		return XST_FAILURE;
+	}
+
+	Xil_TaskPoolResetStats();
+	XTime_GetTime(&Start);
+	for (Frame = 0U; Frame < BENCH_FRAMES; Frame++) {
+		Xil_TaskParallelFor(BoxFilterBand, ParallelImage,
+				    BENCH_CHUNKS);
+	}
+	ParallelUs = ElapsedUs(Start) / BENCH_FRAMES;
+	Xil_TaskPoolGetStats(0U, &Stats[0]);
+	Xil_TaskPoolGetStats(1U, &Stats[1]);
+
+	for (Row = 0U; Row < IMAGE_HEIGHT; Row++) {
+		for (Col = 0U; Col < IMAGE_WIDTH; Col++) {
+			if (SerialImage[Row][Col] != ParallelImage[Row][Col]) {
+				xil_printf("Mismatch at %d,%d\r\n", Row, Col);
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	xil_printf("\r\n3x3 box filter %dx%d, %d bands, %d frames\r\n",
+		   IMAGE_WIDTH, IMAGE_HEIGHT, BENCH_CHUNKS, BENCH_FRAMES);
+	xil_printf("1 CPU   %8d us/frame\r\n", SerialUs);
+	xil_printf("2 CPUs  %8d us/frame  speedup %d.%02dx\r\n", ParallelUs,
+		   SerialUs / ParallelUs, ((SerialUs % ParallelUs) * 100U) /
+		   ParallelUs);
+	xil_printf("bands run CPU0 %d  CPU1 %d (stolen %d), wakeups %d\r\n",
+		   Stats[0].Executed, Stats[1].Executed, Stats[1].Stolen,
+		   Stats[0].Wakeups);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Filters one band of rows of SrcImage into the destination image. The border
+* rows and columns are copied.
+*
+* @param	Arg is the destination image.
+* @param	Index is the band number.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void BoxFilterBand(void *Arg, u32 Index)
+{
+	u8 (*Dst)[IMAGE_WIDTH] = (u8 (*)[IMAGE_WIDTH])Arg;
+	u32 First = Index * (IMAGE_HEIGHT / BENCH_CHUNKS);
+	u32 Last = First + (IMAGE_HEIGHT / BENCH_CHUNKS);
+	u32 Row;
+	u32 Col;
+	u32 Sum;
+
+	for (Row = First; Row < Last; Row++) {
+		if ((Row == 0U) || (Row == (IMAGE_HEIGHT - 1U))) {
+			for (Col = 0U; Col < IMAGE_WIDTH; Col++) {
+				Dst[Row][Col] = SrcImage[Row][Col];
+			}
+			continue;
+		}
+		Dst[Row][0] = SrcImage[Row][0];
+		for (Col = 1U; Col < (IMAGE_WIDTH - 1U); Col++) {
+			Sum = (u32)SrcImage[Row - 1U][Col - 1U] +
+			      SrcImage[Row - 1U][Col] +
+			      SrcImage[Row - 1U][Col + 1U] +
+			      SrcImage[Row][Col - 1U] +
+			      SrcImage[Row][Col] +
+			      SrcImage[Row][Col + 1U] +
+			      SrcImage[Row + 1U][Col - 1U] +
+			      SrcImage[Row + 1U][Col] +
+			      SrcImage[Row + 1U][Col + 1U];
+			Dst[Row][Col] = (u8)(Sum / 9U);
+		}
+		Dst[Row][IMAGE_WIDTH - 1U] = SrcImage[Row][IMAGE_WIDTH - 1U];
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns the microseconds elapsed since Start.
+*
+* @param	Start is a global timer value.
+*
+* @return	Elapsed time in microseconds.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 ElapsedUs(XTime Start)
+{
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return (u32)(((Now - Start) * 1000000U) / COUNTS_PER_SECOND);
+}
@@ -0,0 +1,332 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_testmem_bench.c
+*
+* Runs Xil_TestMemFast() over a 32 MB DDR buffer and prints the bandwidth of
+* each subtest, first with the CPU writing every pattern and then with the
+* fixed pattern written by the PL330 through Xil_TestMemSetFill().
+*
+* The PL330 cannot compare memory, so the checks stay on the CPU. The fill
+* streams an 8 byte pattern from a fixed source address.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xparameters.h"
+#include "xil_testmem.h"
+#include "xil_cache.h"
+#include "xil_exception.h"
+#include "xil_printf.h"
+#include "xdmaps.h"
+#include "xscugic.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define DMA_DEVICE_ID		XPAR_XDMAPS_1_DEVICE_ID
+#define INTC_DEVICE_ID		XPAR_SCUGIC_SINGLE_DEVICE_ID
+#define DMA_FAULT_INTR		XPAR_XDMAPS_0_FAULT_INTR
+#define DMA_DONE_INTR_0		XPAR_XDMAPS_0_DONE_INTR_0
+#define DMA_CHANNEL		0
+
+#define TEST_WORDS		(8U * 1024U * 1024U)
+#define TEST_PATTERN		0xA5C3F00FU
+
+/* 65536 bursts of 128 bytes fit the two level loop of the PL330 program */
+#define DMA_CHUNK		(4U * 1024U * 1024U)
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+
+int TestMemBench(void);
+static int SetupInterruptSystem(XScuGic *GicPtr, XDmaPs *DmaPtr);
+static s32 DmaFill(void *CallBackRef, u32 *Addr, u32 Words, u32 Value);
+static int RunTest(const char *Name);
+
+/************************** Variable Definitions *****************************/
+
+static XDmaPs DmaInstance;
+static XScuGic GicInstance;
+
+static u32 TestBuf[TEST_WORDS] __attribute__ ((aligned(32)));
+static u32 FillSrc[2] __attribute__ ((aligned(32)));
+
+static const char *SubtestNames[XIL_TESTMEM_MAXTEST + 1U] = {
+	"all", "increment", "walking ones", "walking zeros",
+	"inverse address", "fixed pattern"
+};
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the memory passed, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return TestMemBench();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the memory test with the CPU and with the PL330 fill.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the memory passed, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int TestMemBench(void)
+{
+	XDmaPs_Config *DmaConfig;
+	int Status;
+
+	xil_printf("\r\nMemory test, %d MB at 0x%08x\r\n",
+		   (TEST_WORDS * 4U) / (1024U * 1024U), (u32)TestBuf);
+
+	Status = RunTest("cpu");
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	DmaConfig = XDmaPs_LookupConfig(DMA_DEVICE_ID);
+	if (DmaConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XDmaPs_CfgInitialize(&DmaInstance, DmaConfig,
+				      DmaConfig->BaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Status = SetupInterruptSystem(&GicInstance, &DmaInstance);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Xil_TestMemSetFill(DmaFill, &DmaInstance);
+	Status = RunTest("pl330 fill");
+	Xil_TestMemSetFill(NULL, NULL);
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Runs all the subtests over the buffer and prints their bandwidth.
+*
+* @param	Name is printed in the heading.
+*
+* @return	XST_SUCCESS if the memory passed, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int RunTest(const char *Name)
+{
+	Xil_TestMemResult Result;
+	u32 Index;
+	s32 Status;
+
+	Status = Xil_TestMemFast(TestBuf, TEST_WORDS, TEST_PATTERN,
+				 XIL_TESTMEM_ALLMEMTESTS, &Result);
+
+	xil_printf("\r\n%s\r\n", Name);
+	xil_printf("subtest              MB/s\r\n");
+	for (Index = XIL_TESTMEM_INCREMENT; Index <= XIL_TESTMEM_MAXTEST;
+	     Index++) {
+		xil_printf("%-18s %6d\r\n", SubtestNames[Index],
+			   Result.MBps[Index]);
+	}
+
+	if (Status != 0) {
+		xil_printf("%s failed at 0x%08x, expected 0x%08x read 0x%08x\r\n",
+			   SubtestNames[Result.FailTest],
+			   (u32)Result.FailAddr, Result.Expected,
+			   Result.Actual);
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Fills memory with a word using the PL330, in chunks that fit one DMA
+* program.
+*
+* @param	CallBackRef is a pointer to the DMA instance.
+* @param	Addr is the start of the memory to fill.
+* @param	Words is the number of words.
+* @param	Value is the word to write.
+*
+* @return	XST_SUCCESS if the DMA completed, otherwise XST_FAILURE so
+*		that the CPU writes the words.
+*
+* @note		The source address does not increment, so the driver does
+*		not flush it and it is flushed here.
+*
+******************************************************************************/
+static s32 DmaFill(void *CallBackRef, u32 *Addr, u32 Words, u32 Value)
+{
+	XDmaPs *DmaPtr = (XDmaPs *)CallBackRef;
+	XDmaPs_Cmd DmaCmd;
+	u32 Bytes = Words * 4U;
+	u32 Offset;
+	u32 Len;
+	int Status;
+
+	/* Bursts of 8 bytes need the length to be a multiple of them */
+	if ((((u32)Addr | Bytes) & 0x7U) != 0U) {
+		return XST_FAILURE;
+	}
+
+	FillSrc[0] = Value;
+	FillSrc[1] = Value;
+	Xil_DCacheFlushRange((INTPTR)FillSrc, sizeof(FillSrc));
+
+	memset(&DmaCmd, 0, sizeof(XDmaPs_Cmd));
+	DmaCmd.ChanCtrl.SrcBurstSize = 8;
+	DmaCmd.ChanCtrl.SrcBurstLen = 16;
+	DmaCmd.ChanCtrl.SrcInc = 0;
+	DmaCmd.ChanCtrl.DstBurstSize = 8;
+	DmaCmd.ChanCtrl.DstBurstLen = 16;
+	DmaCmd.ChanCtrl.DstInc = 1;
+	DmaCmd.BD.SrcAddr = (u32)FillSrc;
+
+	for (Offset = 0U; Offset < Bytes; Offset += Len) {
+		Len = Bytes - Offset;
+		if (Len > DMA_CHUNK) {
+			Len = DMA_CHUNK;
+		}
+		DmaCmd.BD.DstAddr = (u32)Addr + Offset;
+		DmaCmd.BD.Length = Len;
+
+		Status = XDmaPs_Start(DmaPtr, DMA_CHANNEL, &DmaCmd, 0);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		while (XDmaPs_IsActive(DmaPtr, DMA_CHANNEL) != 0) {
+			;
+		}
+		if (DmaCmd.DmaStatus != 0) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Connects the DMA done and fault interrupts to the GIC and enables
+* interrupts.
+*
+* @param	GicPtr is a pointer to the GIC instance.
+* @param	DmaPtr is a pointer to the DMA instance.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static int SetupInterruptSystem(XScuGic *GicPtr, XDmaPs *DmaPtr)
+{
+	XScuGic_Config *GicConfig;
+	int Status;
+
+	Xil_ExceptionInit();
+
+	GicConfig = XScuGic_LookupConfig(INTC_DEVICE_ID);
+	if (GicConfig == NULL) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_CfgInitialize(GicPtr, GicConfig,
+				       GicConfig->CpuBaseAddress);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_IRQ_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler,
+			GicPtr);
+
+	Status = XScuGic_Connect(GicPtr, DMA_FAULT_INTR,
+				 (Xil_InterruptHandler)XDmaPs_FaultISR,
+				 DmaPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Status = XScuGic_Connect(GicPtr, DMA_DONE_INTR_0,
+				 (Xil_InterruptHandler)XDmaPs_DoneISR_0,
+				 DmaPtr);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+
+	XScuGic_Enable(GicPtr, DMA_FAULT_INTR);
+	XScuGic_Enable(GicPtr, DMA_DONE_INTR_0);
+
+	Xil_ExceptionEnable();
+
+	return XST_SUCCESS;
+}
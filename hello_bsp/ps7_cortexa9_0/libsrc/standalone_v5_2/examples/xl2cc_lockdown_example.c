@@ -0,0 +1,242 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xl2cc_lockdown_example.c
+*
+* Shows the effect of L2 lockdown by way on a loop whose working set is
+* evicted between its runs.
+*
+* A 64 KB table stands for the working set of a control loop. Before each
+* run of the loop a 2 MB buffer is written, as DMA traffic would, and L1 is
+* flushed, so that the loop reads the table from L2 or DDR. The loop is run
+* with the table unlocked and then locked into one way with
+* XL2cc_LockRange(). For each case the worst and the mean time of a run and
+* the L2 data read hit rate are printed.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters.h"
+#include "xil_cache_l.h"
+#include "xil_printf.h"
+#include "xl2cc_lockdown.h"
+#include "xpm_counter.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions *****************************/
+
+#define CPU_MHZ			(XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 1000000U)
+#define TABLE_LEN		(64U * 1024U)
+#define TRAFFIC_LEN		(2U * 1024U * 1024U)
+#define NUM_RUNS		100U
+#define LOCK_WAYS		0x80U		/* way 7 */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define CyclesToNs(Cycles)	(((Cycles) * 1000U) / CPU_MHZ)
+
+/************************** Function Prototypes ******************************/
+
+int L2LockdownExample(void);
+static void RunLoop(const char *Name);
+static u32 ControlLoop(void);
+static void Traffic(void);
+
+/************************** Variable Definitions *****************************/
+
+static u32 Table[TABLE_LEN / 4U] __attribute__ ((aligned(32)));
+static u32 TrafficBuf[TRAFFIC_LEN / 4U] __attribute__ ((aligned(32)));
+static volatile u32 Sink;
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the lock succeeded, else XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+#ifndef TESTAPP_GEN
+int main(void)
+{
+	return L2LockdownExample();
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Runs the loop without and with the table locked in L2.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if the lock succeeded, else XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int L2LockdownExample(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < (TABLE_LEN / 4U); Index++) {
+		Table[Index] = Index;
+	}
+
+	Xpm_EnableCycleCounter();
+
+	xil_printf("\r\nL2 has %d ways of %d bytes\r\n", XL2cc_GetNumWays(),
+		   XL2cc_GetWaySize());
+	xil_printf("          worst ns    mean ns  hit rate %%\r\n");
+
+	RunLoop("unlocked");
+
+	if (XL2cc_LockRange((INTPTR)Table, TABLE_LEN, LOCK_WAYS) !=
+	    XST_SUCCESS) {
+		xil_printf("Lock failed\r\n");
+		return XST_FAILURE;
+	}
+	RunLoop("locked  ");
+	XL2cc_UnlockWays(LOCK_WAYS);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Runs the loop NUM_RUNS times after traffic and prints the statistics.
+*
+* @param	Name is the name of the case.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void RunLoop(const char *Name)
+{
+	u32 Run;
+	u32 Cycles;
+	u32 Worst = 0U;
+	u32 Total = 0U;
+	u32 Hits = 0U;
+	u32 Requests = 0U;
+	u32 RunHits;
+	u32 RunRequests;
+
+	for (Run = 0U; Run < NUM_RUNS; Run++) {
+		Traffic();
+		Xil_L1DCacheFlush();
+
+		XL2cc_HitRateStart();
+		Cycles = ControlLoop();
+		(void)XL2cc_HitRateStop(&RunHits, &RunRequests);
+
+		Hits += RunHits;
+		Requests += RunRequests;
+		Total += Cycles;
+		if (Cycles > Worst) {
+			Worst = Cycles;
+		}
+	}
+
+	xil_printf("%s  %8d  %9d  %6d.%d\r\n", Name, CyclesToNs(Worst),
+		   CyclesToNs(Total / NUM_RUNS),
+		   (Requests != 0U) ? ((Hits * 100U) / Requests) : 0U,
+		   (Requests != 0U) ? (((Hits * 1000U) / Requests) % 10U) : 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* The loop under test, one pass over the table.
+*
+* @param	None
+*
+* @return	Cycles the pass took.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 ControlLoop(void)
+{
+	u32 Start;
+	u32 Index;
+	u32 Sum = 0U;
+
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < (TABLE_LEN / 4U); Index += 8U) {
+		Sum += Table[Index];
+	}
+	Sink = Sum;
+
+	return Xpm_GetCycleCounter() - Start;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes the traffic buffer, which replaces the unlocked lines of L2.
+*
+* @param	None
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void Traffic(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < (TRAFFIC_LEN / 4U); Index += 8U) {
+		TrafficBuf[Index] = Index;
+	}
+}
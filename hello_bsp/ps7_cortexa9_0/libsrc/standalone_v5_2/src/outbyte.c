@@ -1,5 +1,6 @@
 #include "xparameters.h"
 #include "xuartps_hw.h"
+#include "xil_outbuf.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,5 +12,9 @@ void outbyte(char c);
 #endif 
 
 void outbyte(char c) {
-	 XUartPs_SendByte(STDOUT_BASEADDRESS, c);
+	if (Xil_OutBufEnabled != 0U) {
+		Xil_OutBufPut((u8)c);
+	} else {
+		XUartPs_SendByte(STDOUT_BASEADDRESS, c);
+	}
 }
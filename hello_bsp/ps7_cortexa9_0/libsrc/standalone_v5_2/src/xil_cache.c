@@ -89,6 +89,17 @@
 *					  added into Xil_L2CacheInvalidateRange API. Xil_L1DCacheInvalidate
 *					  and Xil_L2CacheInvalidate APIs are modified to flush the complete
 *					  stack instead of just System Stack
+* 5.2    ag  10/18/26 Xil_DCacheFlushRange, Xil_DCacheInvalidateRange,
+*					  Xil_L2CacheFlushRange and Xil_L2CacheInvalidateRange do
+*					  the L1 and L2 passes over up to XIL_CACHE_MASK_CHUNK bytes
+*					  with interrupts masked and a single L2 sync per range
+*					  instead of one per line. Xil_DCacheFlushRange flushes the
+*					  whole caches from a length set with
+*					  Xil_DCacheSetFlushAllThreshold.
+* 5.2    ag  10/18/26 Added Xil_DCacheMaintainList for lists of DMA buffers and
+*					  descriptors.
+* 5.2    ag  10/18/26 Xil_L2CacheFlush only cleans the ways locked with
+*					  XL2cc_LockRange.
 *
 * </pre>
 *
@@ -112,6 +123,52 @@
 
 #define IRQ_FIQ_MASK 0xC0U	/* Mask IRQ and FIQ interrupts in cpsr */
 
+/*
+ * Range maintenance masks IRQ and FIQ for at most this many bytes at a time
+ */
+#ifndef XIL_CACHE_MASK_CHUNK
+#define XIL_CACHE_MASK_CHUNK	8192U
+#endif
+
+/*
+ * Default length from which Xil_DCacheFlushRange flushes the whole caches,
+ * the size of the L2 cache
+ */
+#ifndef XIL_CACHE_FLUSH_ALL_THRESHOLD
+#define XIL_CACHE_FLUSH_ALL_THRESHOLD	(512U * 1024U)
+#endif
+
+static u32 DCacheFlushAllThreshold = XIL_CACHE_FLUSH_ALL_THRESHOLD;
+
+/*
+ * Merged range of Xil_DCacheMaintainList
+ */
+typedef struct {
+	u32 Start;
+	u32 End;
+	u32 Op;
+} Xil_CacheRun;
+
+/*
+ * L1 data cache line operation by MVA, with the inline assembly of each
+ * compiler
+ */
+#ifdef __GNUC__
+#define XIL_DCACHE_LINE_OP(Op, Adr) \
+	__asm__ __volatile__("mcr " Op :: "r" (Adr))
+#elif defined (__ICCARM__)
+#define XIL_DCACHE_LINE_OP(Op, Adr) \
+	__asm volatile ("mcr " Op :: "r" (Adr))
+#else
+#define XIL_DCACHE_LINE_OP(Op, Adr) \
+	{ volatile register u32 Reg __asm(Op); Reg = (Adr); }
+#endif
+
+static u32 Xil_DCacheListNextRun(const Xil_CacheListEntry *List, u32 Count,
+				 u32 Index, Xil_CacheRun *RunPtr);
+static void Xil_DCacheListPass(const Xil_CacheListEntry *List, u32 Count,
+			       u32 First, u32 Last, u32 Pass);
+
 #ifdef __GNUC__
 	extern s32  _stack_end;
 	extern s32  __undef_stack;
@@ -165,6 +222,56 @@ static void Xil_L2CacheSync(void)
 #endif
 }
 
+/****************************************************************************
+*
+* Return the end of the next part of a range that is maintained with
+* interrupts masked.
+*
+* @param	adr is the cache line aligned start of the part.
+* @param	end is the end of the range.
+*
+* @return	End of the part, at most XIL_CACHE_MASK_CHUNK bytes after adr.
+*
+* @note		None.
+*
+****************************************************************************/
+#ifdef __GNUC__
+static inline u32 Xil_DCacheChunkEnd(u32 adr, u32 end)
+#else
+static u32 Xil_DCacheChunkEnd(u32 adr, u32 end)
+#endif
+{
+	u32 chunkend = end;
+
+	if ((end - adr) > XIL_CACHE_MASK_CHUNK) {
+		chunkend = adr + XIL_CACHE_MASK_CHUNK;
+	}
+
+	return chunkend;
+}
+
+/****************************************************************************
+*
+* Set the length from which Xil_DCacheFlushRange flushes the whole L1 and
+* L2 caches instead of the range. The best value depends on the memory
+* load and can be measured with examples/xil_cache_bench.c.
+*
+* @param	Bytes is the length, or 0 to always flush by address.
+*
+* @return	None.
+*
+* @note		The default is XIL_CACHE_FLUSH_ALL_THRESHOLD. The whole L2
+*		flush runs with IRQ and FIQ masked, as in Xil_DCacheFlush,
+*		for as long as the clean and invalidate of the 512 KB L2
+*		takes, not XIL_CACHE_MASK_CHUNK bytes. Pass 0 when that
+*		interrupt latency is not acceptable.
+*
+****************************************************************************/
+void Xil_DCacheSetFlushAllThreshold(u32 Bytes)
+{
+	DCacheFlushAllThreshold = Bytes;
+}
+
 /****************************************************************************
 *
 * Enable the Data cache.
@@ -318,18 +425,18 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 	u32 end;
 	u32 tempadr = adr;
 	u32 tempend;
+	u32 chunkend;
+	u32 LocalAddr;
 	u32 currmask;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
-
 	if (len != 0U) {
 		end = tempadr + len;
 		tempend = end;
-		/* Select L1 Data cache in CSSR */
-		mtcp(XREG_CP15_CACHE_SIZE_SEL, 0U);
+
+		currmask = mfcpsr();
+		mtcpsr(currmask | IRQ_FIQ_MASK);
 
 		if ((tempadr & (cacheline-1U)) != 0U) {
 			tempadr &= (~(cacheline - 1U));
@@ -340,7 +447,6 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 			Xil_L2CacheFlushLine(tempadr);
 			/* Enable Write-back and line fills */
 			Xil_L2WriteDebugCtrl(0x0U);
-			Xil_L2CacheSync();
 			tempadr += cacheline;
 		}
 		if ((tempend & (cacheline-1U)) != 0U) {
@@ -352,31 +458,53 @@ void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
 			Xil_L2CacheFlushLine(tempend);
 			/* Enable Write-back and line fills */
 			Xil_L2WriteDebugCtrl(0x0U);
-			Xil_L2CacheSync();
 		}
 
+		mtcpsr(currmask);
+
+		/*
+		 * Invalidate L2 before L1 so that L1 cannot refill from a
+		 * stale L2 line. The dsb between the passes waits for the L2
+		 * operations, which are atomic by line, and a single L2 sync
+		 * ends the range.
+		 */
 		while (tempadr < tempend) {
-			/* Invalidate L2 cache line */
-			*L2CCOffset = tempadr;
-			Xil_L2CacheSync();
+			chunkend = Xil_DCacheChunkEnd(tempadr, tempend);
+
+			currmask = mfcpsr();
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+
+			for (LocalAddr = tempadr; LocalAddr < chunkend;
+			     LocalAddr += cacheline) {
+				/* Invalidate L2 cache line */
+				*L2CCOffset = LocalAddr;
+			}
+			dsb();
+
+			for (LocalAddr = tempadr; LocalAddr < chunkend;
+			     LocalAddr += cacheline) {
 #ifdef __GNUC__
-			/* Invalidate L1 Data cache line */
-			__asm__ __volatile__("mcr " \
-			XREG_CP15_INVAL_DC_LINE_MVA_POC :: "r" (tempadr));
+				/* Invalidate L1 Data cache line */
+				__asm__ __volatile__("mcr " \
+				XREG_CP15_INVAL_DC_LINE_MVA_POC :: "r" (LocalAddr));
 #elif defined (__ICCARM__)
-			__asm volatile ("mcr " \
-			XREG_CP15_INVAL_DC_LINE_MVA_POC :: "r" (tempadr));
+				__asm volatile ("mcr " \
+				XREG_CP15_INVAL_DC_LINE_MVA_POC :: "r" (LocalAddr));
 #else
-			{ volatile register u32 Reg
-				__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
-			  Reg = tempadr; }
+				{ volatile register u32 Reg
+					__asm(XREG_CP15_INVAL_DC_LINE_MVA_POC);
+				  Reg = LocalAddr; }
 #endif
-			tempadr += cacheline;
+			}
+
+			mtcpsr(currmask);
+			tempadr = chunkend;
 		}
+
+		Xil_L2CacheSync();
 	}
 
 	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************
@@ -448,7 +576,9 @@ void Xil_DCacheFlushLine(u32 adr)
 *
 * @return	None.
 *
-* @note		None.
+* @note		From the length set with Xil_DCacheSetFlushAllThreshold()
+*		the whole caches are flushed, and interrupts stay masked for
+*		the whole L2 flush rather than XIL_CACHE_MASK_CHUNK bytes.
 *
 ****************************************************************************/
 void Xil_DCacheFlushRange(INTPTR adr, u32 len)
@@ -456,13 +586,12 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
 	u32 end;
+	u32 chunkend;
+	u32 tempadr;
 	u32 currmask;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET);
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
-
 	if (len != 0U) {
 		/* Back the starting address up to the start of a cache line
 		 * perform cache operations until adr+len
@@ -470,28 +599,301 @@ void Xil_DCacheFlushRange(INTPTR adr, u32 len)
 		end = LocalAddr + len;
 		LocalAddr &= ~(cacheline - 1U);
 
-		while (LocalAddr < end) {
+		if ((DCacheFlushAllThreshold != 0U) &&
+		    (len >= DCacheFlushAllThreshold)) {
+			/*
+			 * Flushing the whole caches is cheaper. Set/way
+			 * operations do not reach the L1 of the other CPU,
+			 * so with SMP the L1 is still flushed by address.
+			 * The L2 way operation must not be mixed with line
+			 * operations from a handler, so it stays masked for
+			 * its whole length, see
+			 * Xil_DCacheSetFlushAllThreshold().
+			 */
+#if USE_SMP==1
+			Xil_L1DCacheFlushRange(LocalAddr, end - LocalAddr);
+#else
+			Xil_L1DCacheFlush();
+#endif
+			currmask = mfcpsr();
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+			Xil_L2CacheFlush();
+			mtcpsr(currmask);
+		} else {
+			/*
+			 * L1 first, so that its dirty lines reach L2 before L2
+			 * is flushed, then one L2 sync for the whole range.
+			 */
+			while (LocalAddr < end) {
+				chunkend = Xil_DCacheChunkEnd(LocalAddr, end);
+
+				currmask = mfcpsr();
+				mtcpsr(currmask | IRQ_FIQ_MASK);
+
+				for (tempadr = LocalAddr; tempadr < chunkend;
+				     tempadr += cacheline) {
 #ifdef __GNUC__
-			/* Flush L1 Data cache line */
-			__asm__ __volatile__("mcr " \
-			XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC :: "r" (LocalAddr));
+					/* Flush L1 Data cache line */
+					__asm__ __volatile__("mcr " \
+					XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC :: "r" (tempadr));
 #elif defined (__ICCARM__)
-			__asm volatile ("mcr " \
-			XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC :: "r" (LocalAddr));
+					__asm volatile ("mcr " \
+					XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC :: "r" (tempadr));
 #else
-			{ volatile register u32 Reg
-				__asm(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC);
-			  Reg = LocalAddr; }
+					{ volatile register u32 Reg
+						__asm(XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC);
+					  Reg = tempadr; }
 #endif
-			/* Flush L2 cache line */
-			*L2CCOffset = LocalAddr;
+				}
+				dsb();
+
+				for (tempadr = LocalAddr; tempadr < chunkend;
+				     tempadr += cacheline) {
+					/* Flush L2 cache line */
+					*L2CCOffset = tempadr;
+				}
+
+				mtcpsr(currmask);
+				LocalAddr = chunkend;
+			}
+
 			Xil_L2CacheSync();
-			LocalAddr += cacheline;
 		}
 	}
 	dsb();
+}
+/****************************************************************************
+*
+* Maintain the Data cache for a list of ranges, such as the buffers and
+* descriptors of a DMA batch, in one pass.
+*
+* Consecutive entries with the same operation are merged when their ranges
+* overlap or touch; for XIL_CACHE_OP_FLUSH and XIL_CACHE_OP_STORE it is
+* enough that they share or touch a cache line. All L1 clean operations are
+* issued first, followed by a dsb, then all L2 operations, a dsb and the L1
+* invalidations, and a single L2 sync ends the list. Unaligned ends of an
+* XIL_CACHE_OP_INVALIDATE range are flushed as in Xil_DCacheInvalidateRange.
+*
+* @param	List is the array of entries.
+* @param	Count is the number of entries.
+*
+* @return	None.
+*
+* @note		The merged ranges are taken in groups of about
+*		XIL_CACHE_MASK_CHUNK bytes. Each group goes through all three
+*		passes with interrupts masked, so that no interrupt can refill
+*		L2 from a dirty L1 line between the L2 and L1 invalidation of
+*		a range, and interrupts are unmasked between groups. A single
+*		range is maintained with interrupts masked, so large buffers
+*		should rather use the range APIs.
+*
+****************************************************************************/
+void Xil_DCacheMaintainList(const Xil_CacheListEntry *List, u32 Count)
+{
+	Xil_CacheRun Run;
+	u32 Pass;
+	u32 First = 0U;
+	u32 Last;
+	u32 Done;
+	u32 currmask;
+
+	currmask = mfcpsr();
+	mtcpsr(currmask | IRQ_FIQ_MASK);
+
+	while (First < Count) {
+		/* Bound the time with interrupts masked */
+		Last = First;
+		Done = 0U;
+		while ((Last < Count) && (Done < XIL_CACHE_MASK_CHUNK)) {
+			Last = Xil_DCacheListNextRun(List, Count, Last, &Run);
+			Done += Run.End - Run.Start;
+		}
+
+		for (Pass = 0U; Pass < 3U; Pass++) {
+			Xil_DCacheListPass(List, Count, First, Last, Pass);
+
+			/* Wait for the pass before the next one starts */
+			dsb();
+		}
+
+		First = Last;
+		if (First < Count) {
+			mtcpsr(currmask);
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+		}
+	}
+
+	Xil_L2CacheSync();
+	dsb();
 	mtcpsr(currmask);
 }
+
+/****************************************************************************
+*
+* Issue one pass of Xil_DCacheMaintainList over a group of merged ranges.
+* Pass 0 cleans L1 and flushes the unaligned ends of invalidated ranges,
+* pass 1 maintains L2 and pass 2 invalidates L1.
+*
+* @param	List is the array of entries.
+* @param	Count is the number of entries.
+* @param	First is the first entry of the group.
+* @param	Last is the entry after the group, the end of a merged range.
+* @param	Pass is the pass, 0 to 2.
+*
+* @return	None.
+*
+* @note		Called with interrupts masked.
+*
+****************************************************************************/
+static void Xil_DCacheListPass(const Xil_CacheListEntry *List, u32 Count,
+			       u32 First, u32 Last, u32 Pass)
+{
+	const u32 cacheline = 32U;
+	Xil_CacheRun Run;
+	u32 Index;
+	u32 Next;
+	u32 LocalAddr;
+	u32 End;
+	u32 L2Offset;
+
+	for (Index = First; Index < Last; Index = Next) {
+		Next = Xil_DCacheListNextRun(List, Count, Index, &Run);
+		if (Run.Start == Run.End) {
+			continue;
+		}
+
+		if (Run.Op != XIL_CACHE_OP_INVALIDATE) {
+			LocalAddr = Run.Start & ~(cacheline - 1U);
+			End = Run.End;
+			if (Pass == 0U) {
+				for (; LocalAddr < End; LocalAddr += cacheline) {
+					if (Run.Op == XIL_CACHE_OP_FLUSH) {
+						XIL_DCACHE_LINE_OP(
+						    XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC,
+						    LocalAddr);
+					} else {
+						XIL_DCACHE_LINE_OP(
+						    XREG_CP15_CLEAN_DC_LINE_MVA_POC,
+						    LocalAddr);
+					}
+				}
+			} else if (Pass == 1U) {
+				L2Offset = (Run.Op == XIL_CACHE_OP_FLUSH) ?
+				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET :
+				    XPS_L2CC_CACHE_CLEAN_PA_OFFSET;
+				for (; LocalAddr < End; LocalAddr += cacheline) {
+					Xil_Out32(XPS_L2CC_BASEADDR + L2Offset,
+						  LocalAddr);
+				}
+			} else {
+				/* Nothing to invalidate */
+			}
+		} else {
+			/* Unaligned ends are flushed, the rest invalidated */
+			LocalAddr = (Run.Start + cacheline - 1U) &
+				    ~(cacheline - 1U);
+			End = Run.End & ~(cacheline - 1U);
+			if (Pass == 0U) {
+				if ((Run.Start & (cacheline - 1U)) != 0U) {
+					XIL_DCACHE_LINE_OP(
+					    XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC,
+					    Run.Start & ~(cacheline - 1U));
+				}
+				if ((Run.End & (cacheline - 1U)) != 0U) {
+					XIL_DCACHE_LINE_OP(
+					    XREG_CP15_CLEAN_INVAL_DC_LINE_MVA_POC,
+					    End);
+				}
+			} else if (Pass == 1U) {
+				/* Disable Write-back and line fills */
+				Xil_L2WriteDebugCtrl(0x3U);
+				if ((Run.Start & (cacheline - 1U)) != 0U) {
+					Xil_Out32(XPS_L2CC_BASEADDR +
+					    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET,
+					    Run.Start & ~(cacheline - 1U));
+				}
+				if ((Run.End & (cacheline - 1U)) != 0U) {
+					Xil_Out32(XPS_L2CC_BASEADDR +
+					    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET,
+					    End);
+				}
+				/* Enable Write-back and line fills */
+				Xil_L2WriteDebugCtrl(0x0U);
+				for (; LocalAddr < End; LocalAddr += cacheline) {
+					Xil_Out32(XPS_L2CC_BASEADDR +
+					    XPS_L2CC_CACHE_INVLD_PA_OFFSET,
+					    LocalAddr);
+				}
+			} else {
+				for (; LocalAddr < End; LocalAddr += cacheline) {
+					XIL_DCACHE_LINE_OP(
+					    XREG_CP15_INVAL_DC_LINE_MVA_POC,
+					    LocalAddr);
+				}
+			}
+		}
+	}
+}
+
+/****************************************************************************
+*
+* Merge the list entries starting at an index into one range.
+*
+* @param	List is the array of entries.
+* @param	Count is the number of entries.
+* @param	Index is the first entry of the range.
+* @param	RunPtr receives the start, end and operation of the range.
+*
+* @return	Index of the first entry after the range.
+*
+* @note		None.
+*
+****************************************************************************/
+static u32 Xil_DCacheListNextRun(const Xil_CacheListEntry *List, u32 Count,
+				 u32 Index, Xil_CacheRun *RunPtr)
+{
+	const u32 cacheline = 32U;
+	u32 Next = Index + 1U;
+	u32 Start;
+	u32 End;
+	u32 Low;
+	u32 High;
+
+	RunPtr->Start = (u32)List[Index].Addr;
+	RunPtr->End = RunPtr->Start + List[Index].Len;
+	RunPtr->Op = List[Index].Op;
+
+	while (Next < Count) {
+		if (List[Next].Op != RunPtr->Op) {
+			break;
+		}
+		Start = (u32)List[Next].Addr;
+		End = Start + List[Next].Len;
+
+		/* Invalidation must not reach bytes outside the entries */
+		if (RunPtr->Op == XIL_CACHE_OP_INVALIDATE) {
+			Low = RunPtr->Start;
+			High = RunPtr->End;
+		} else {
+			Low = RunPtr->Start & ~(cacheline - 1U);
+			High = (RunPtr->End + cacheline - 1U) & ~(cacheline - 1U);
+		}
+		if ((Start > High) || (End < Low)) {
+			break;
+		}
+
+		if (Start < RunPtr->Start) {
+			RunPtr->Start = Start;
+		}
+		if (End > RunPtr->End) {
+			RunPtr->End = End;
+		}
+		Next++;
+	}
+
+	return Next;
+}
+
 /****************************************************************************
 *
 * Store a Data cache line. If the byte specified by the address (adr)
@@ -1434,14 +1836,12 @@ void Xil_L2CacheInvalidateRange(u32 adr, u32 len)
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
 	u32 end;
+	u32 chunkend;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INVLD_PA_OFFSET);
 
 	u32 currmask;
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
-
 	if (len != 0U) {
 		/* Back the starting address up to the start of a cache line
 		 * perform cache operations until adr+len
@@ -1449,22 +1849,32 @@ void Xil_L2CacheInvalidateRange(u32 adr, u32 len)
 		end = LocalAddr + len;
 		LocalAddr = LocalAddr & ~(cacheline - 1U);
 
-		/* Disable Write-back and line fills */
-		Xil_L2WriteDebugCtrl(0x3U);
-
 		while (LocalAddr < end) {
-			*L2CCOffset = LocalAddr;
-			Xil_L2CacheSync();
-			LocalAddr += cacheline;
+			chunkend = Xil_DCacheChunkEnd(LocalAddr, end);
+
+			currmask = mfcpsr();
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+
+			/* Disable Write-back and line fills */
+			Xil_L2WriteDebugCtrl(0x3U);
+
+			while (LocalAddr < chunkend) {
+				*L2CCOffset = LocalAddr;
+				LocalAddr += cacheline;
+			}
+
+			/* Enable Write-back and line fills */
+			Xil_L2WriteDebugCtrl(0x0U);
+
+			mtcpsr(currmask);
 		}
 
-		/* Enable Write-back and line fills */
-		Xil_L2WriteDebugCtrl(0x0U);
+		/* One sync for the range, the line operations are atomic */
+		Xil_L2CacheSync();
 	}
 
 	/* synchronize the processor */
 	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************
@@ -1480,20 +1890,30 @@ void Xil_L2CacheInvalidateRange(u32 adr, u32 len)
 * @return	None.
 *
 * @note		The bottom 4 bits are set to 0, forced by architecture.
+*		Ways locked with XL2cc_LockRange are cleaned but keep their
+*		lines.
 *
 ****************************************************************************/
 void Xil_L2CacheFlush(void)
 {
 	u16 L2CCReg;
 	u32 ResultL2Cache;
+	u32 LockedWays;
 
 	/* Flush the caches */
 
 	/* Disable Write-back and line fills */
 	Xil_L2WriteDebugCtrl(0x3U);
 
+	/*
+	 * Ways locked with XL2cc_LockRange are only cleaned, so that the
+	 * locked lines stay in the cache
+	 */
+	LockedWays = Xil_In32(XPS_L2CC_BASEADDR +
+			      XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET) & 0x0000FFFFU;
+
 	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_WAY_OFFSET,
-		  0x0000FFFFU);
+		  0x0000FFFFU & ~LockedWays);
 	ResultL2Cache = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_WAY_OFFSET)
 							& 0x0000FFFFU;
 
@@ -1502,6 +1922,16 @@ void Xil_L2CacheFlush(void)
 									& 0x0000FFFFU;
 	}
 
+	if (LockedWays != 0U) {
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_CLEAN_WAY_OFFSET,
+			  LockedWays);
+		while ((Xil_In32(XPS_L2CC_BASEADDR +
+				 XPS_L2CC_CACHE_CLEAN_WAY_OFFSET) &
+			0x0000FFFFU) != 0U) {
+			;
+		}
+	}
+
 	Xil_L2CacheSync();
 	/* Enable Write-back and line fills */
 	Xil_L2WriteDebugCtrl(0x0U);
@@ -1557,13 +1987,12 @@ void Xil_L2CacheFlushRange(u32 adr, u32 len)
 	u32 LocalAddr = adr;
 	const u32 cacheline = 32U;
 	u32 end;
+	u32 chunkend;
 	volatile u32 *L2CCOffset = (volatile u32 *)(XPS_L2CC_BASEADDR +
 				    XPS_L2CC_CACHE_INV_CLN_PA_OFFSET);
 
 	u32 currmask;
 
-	currmask = mfcpsr();
-	mtcpsr(currmask | IRQ_FIQ_MASK);
 	if (len != 0U) {
 		/* Back the starting address up to the start of a cache line
 		 * perform cache operations until adr+len
@@ -1571,21 +2000,32 @@ void Xil_L2CacheFlushRange(u32 adr, u32 len)
 		end = LocalAddr + len;
 		LocalAddr = LocalAddr & ~(cacheline - 1U);
 
-		/* Disable Write-back and line fills */
-		Xil_L2WriteDebugCtrl(0x3U);
-
 		while (LocalAddr < end) {
-			*L2CCOffset = LocalAddr;
-			Xil_L2CacheSync();
-			LocalAddr += cacheline;
+			chunkend = Xil_DCacheChunkEnd(LocalAddr, end);
+
+			currmask = mfcpsr();
+			mtcpsr(currmask | IRQ_FIQ_MASK);
+
+			/* Disable Write-back and line fills */
+			Xil_L2WriteDebugCtrl(0x3U);
+
+			while (LocalAddr < chunkend) {
+				*L2CCOffset = LocalAddr;
+				LocalAddr += cacheline;
+			}
+
+			/* Enable Write-back and line fills */
+			Xil_L2WriteDebugCtrl(0x0U);
+
+			mtcpsr(currmask);
 		}
 
-		/* Enable Write-back and line fills */
-		Xil_L2WriteDebugCtrl(0x0U);
+		/* One sync for the range, the line operations are atomic */
+		Xil_L2CacheSync();
 	}
+
 	/* synchronize the processor */
 	dsb();
-	mtcpsr(currmask);
 }
 
 /****************************************************************************
@@ -44,6 +44,8 @@
 * 1.00a ecm  01/29/10 First release
 * 3.04a sdm  01/02/12 Remove redundant dsb/dmb instructions in cache maintenance
 *		      APIs.
+* 5.2   ag   10/18/26 Added Xil_DCacheSetFlushAllThreshold.
+*		      Added Xil_DCacheMaintainList.
 * </pre>
 *
 ******************************************************************************/
@@ -56,12 +58,27 @@
 extern "C" {
 #endif
 
+/*
+ * Operations of a Xil_DCacheMaintainList entry
+ */
+#define XIL_CACHE_OP_FLUSH		0U	/* Clean and invalidate */
+#define XIL_CACHE_OP_INVALIDATE		1U
+#define XIL_CACHE_OP_STORE		2U	/* Clean */
+
+typedef struct {
+	INTPTR Addr;
+	u32 Len;
+	u32 Op;
+} Xil_CacheListEntry;
+
 void Xil_DCacheEnable(void);
 void Xil_DCacheDisable(void);
 void Xil_DCacheInvalidate(void);
 void Xil_DCacheInvalidateRange(INTPTR adr, u32 len);
 void Xil_DCacheFlush(void);
 void Xil_DCacheFlushRange(INTPTR adr, u32 len);
+void Xil_DCacheSetFlushAllThreshold(u32 Bytes);
+void Xil_DCacheMaintainList(const Xil_CacheListEntry *List, u32 Count);
 
 void Xil_ICacheEnable(void);
 void Xil_ICacheDisable(void);
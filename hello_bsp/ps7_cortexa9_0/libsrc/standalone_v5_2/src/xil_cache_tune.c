@@ -0,0 +1,250 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_cache_tune.c
+*
+* This file contains the functions to change the prefetch and the latency
+* settings of the caches at run time. For more information, see
+* xil_cache_tune.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_cache_tune.h"
+#include "xil_cache_l.h"
+#include "xil_io.h"
+#include "xil_assert.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xstatus.h"
+#include "xparameters_ps.h"
+#include "xl2cc.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_ACTLR_L2_PREFETCH_HINT	0x00000002U
+#define XIL_ACTLR_L1_PREFETCH		0x00000004U
+
+#define XIL_L2CC_LATENCY_MASK		0x00000777U
+
+#define IRQ_FIQ_MASK			0xC0U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#define Xil_TuneBit(Enable, Mask)	(((Enable) != 0U) ? (Mask) : 0U)
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Prototypes ******************************/
+
+/******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* Read the prefetch and latency settings of the caches.
+*
+* @param	Tuning is filled in with the current settings, ACTLR is that
+*		of the calling CPU.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void Xil_CacheGetTuning(Xil_CacheTuning *Tuning)
+{
+	u32 Actlr;
+	u32 Aux;
+	u32 Prefetch;
+
+	Xil_AssertVoid(Tuning != NULL);
+
+	Actlr = mfcp(XREG_CP15_AUX_CONTROL);
+	Aux = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET);
+	Prefetch = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_PREFETCH_CTRL_OFFSET);
+
+	Tuning->L1Prefetch = ((Actlr & XIL_ACTLR_L1_PREFETCH) != 0U) ? 1U : 0U;
+	Tuning->L2PrefetchHint =
+		((Actlr & XIL_ACTLR_L2_PREFETCH_HINT) != 0U) ? 1U : 0U;
+	Tuning->L2InstrPrefetch =
+		((Prefetch & XPS_L2CC_PREF_IPFE_MASK) != 0U) ? 1U : 0U;
+	Tuning->L2DataPrefetch =
+		((Prefetch & XPS_L2CC_PREF_DPFE_MASK) != 0U) ? 1U : 0U;
+	Tuning->PrefetchOffset = (u8)(Prefetch & XPS_L2CC_PREF_OFFSET_MASK);
+	Tuning->DoubleLinefill =
+		((Prefetch & XPS_L2CC_PREF_DLFE_MASK) != 0U) ? 1U : 0U;
+	Tuning->EarlyBresp = ((Aux & XPS_L2CC_AUX_EBRESPE_MASK) != 0U) ? 1U : 0U;
+	Tuning->TagRamLatency = Xil_In32(XPS_L2CC_BASEADDR +
+					 XPS_L2CC_TAG_RAM_CNTRL_OFFSET) &
+				XIL_L2CC_LATENCY_MASK;
+	Tuning->DataRamLatency = Xil_In32(XPS_L2CC_BASEADDR +
+					  XPS_L2CC_DATA_RAM_CNTRL_OFFSET) &
+				 XIL_L2CC_LATENCY_MASK;
+}
+
+/****************************************************************************/
+/**
+*
+* Apply prefetch and latency settings to the caches.
+*
+* The ACTLR bits are changed in place. When a PL310 setting differs from the
+* current one, L1 and L2 are flushed, the L2 cache is disabled, the prefetch
+* control, auxiliary control and latency registers are written, and the L2
+* cache is invalidated and enabled again.
+*
+* @param	Tuning holds the new settings, usually a copy from
+*		Xil_CacheGetTuning() with some fields changed.
+*
+* @return	XST_SUCCESS, or XST_INVALID_PARAM for a prefetch offset the
+*		PL310 does not support, in which case nothing is changed.
+*
+* @note		Interrupts are masked throughout. While L2 is disabled no other
+*		master may use cacheable memory, so call it before CPU1 and
+*		the DMA engines are started. Lines locked with
+*		XL2cc_LockRange are lost, the ways stay locked.
+*
+*****************************************************************************/
+s32 Xil_CacheSetTuning(const Xil_CacheTuning *Tuning)
+{
+	u32 Actlr;
+	u32 Aux;
+	u32 NewAux;
+	u32 Prefetch;
+	u32 NewPrefetch;
+	u32 TagLatency;
+	u32 DataLatency;
+	u32 Ctrl;
+	u32 CurrMask;
+
+	Xil_AssertNonvoid(Tuning != NULL);
+
+	if ((Tuning->PrefetchOffset > 7U) && (Tuning->PrefetchOffset != 15U) &&
+	    (Tuning->PrefetchOffset != 23U) && (Tuning->PrefetchOffset != 31U)) {
+		return XST_INVALID_PARAM;
+	}
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	Actlr = mfcp(XREG_CP15_AUX_CONTROL);
+	Actlr &= ~(XIL_ACTLR_L1_PREFETCH | XIL_ACTLR_L2_PREFETCH_HINT);
+	Actlr |= Xil_TuneBit(Tuning->L1Prefetch, XIL_ACTLR_L1_PREFETCH);
+	Actlr |= Xil_TuneBit(Tuning->L2PrefetchHint, XIL_ACTLR_L2_PREFETCH_HINT);
+	mtcp(XREG_CP15_AUX_CONTROL, Actlr);
+	isb();
+
+	Aux = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET);
+	NewAux = (Aux & ~XPS_L2CC_AUX_EBRESPE_MASK) |
+		 Xil_TuneBit(Tuning->EarlyBresp, XPS_L2CC_AUX_EBRESPE_MASK);
+
+	/* The prefetch enables of the prefetch control alias those of aux */
+	NewAux &= ~(XPS_L2CC_AUX_IPFE_MASK | XPS_L2CC_AUX_DPFE_MASK);
+	NewAux |= Xil_TuneBit(Tuning->L2InstrPrefetch, XPS_L2CC_AUX_IPFE_MASK);
+	NewAux |= Xil_TuneBit(Tuning->L2DataPrefetch, XPS_L2CC_AUX_DPFE_MASK);
+
+	Prefetch = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_PREFETCH_CTRL_OFFSET);
+	NewPrefetch = Prefetch & ~(XPS_L2CC_PREF_DLFE_MASK |
+				   XPS_L2CC_PREF_IPFE_MASK |
+				   XPS_L2CC_PREF_DPFE_MASK |
+				   XPS_L2CC_PREF_OFFSET_MASK);
+	NewPrefetch |= Xil_TuneBit(Tuning->DoubleLinefill,
+				   XPS_L2CC_PREF_DLFE_MASK);
+	NewPrefetch |= Xil_TuneBit(Tuning->L2InstrPrefetch,
+				   XPS_L2CC_PREF_IPFE_MASK);
+	NewPrefetch |= Xil_TuneBit(Tuning->L2DataPrefetch,
+				   XPS_L2CC_PREF_DPFE_MASK);
+	NewPrefetch |= (u32)Tuning->PrefetchOffset;
+
+	TagLatency = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_TAG_RAM_CNTRL_OFFSET);
+	DataLatency = Xil_In32(XPS_L2CC_BASEADDR +
+			       XPS_L2CC_DATA_RAM_CNTRL_OFFSET);
+
+	if ((NewAux != Aux) || (NewPrefetch != Prefetch) ||
+	    ((TagLatency & XIL_L2CC_LATENCY_MASK) != Tuning->TagRamLatency) ||
+	    ((DataLatency & XIL_L2CC_LATENCY_MASK) != Tuning->DataRamLatency)) {
+		Ctrl = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CNTRL_OFFSET);
+
+		/* The PL310 takes these settings only while disabled */
+		if ((Ctrl & XPS_L2CC_ENABLE_MASK) != 0U) {
+			Xil_L1DCacheFlush();
+			Xil_L2CacheFlush();
+			Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CNTRL_OFFSET,
+				  Ctrl & ~XPS_L2CC_ENABLE_MASK);
+			dsb();
+		}
+
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET, NewAux);
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_PREFETCH_CTRL_OFFSET,
+			  NewPrefetch);
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_TAG_RAM_CNTRL_OFFSET,
+			  (TagLatency & ~XIL_L2CC_LATENCY_MASK) |
+			  (Tuning->TagRamLatency & XIL_L2CC_LATENCY_MASK));
+		Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_DATA_RAM_CNTRL_OFFSET,
+			  (DataLatency & ~XIL_L2CC_LATENCY_MASK) |
+			  (Tuning->DataRamLatency & XIL_L2CC_LATENCY_MASK));
+
+		if ((Ctrl & XPS_L2CC_ENABLE_MASK) != 0U) {
+			Xil_Out32(XPS_L2CC_BASEADDR +
+				  XPS_L2CC_CACHE_INVLD_WAY_OFFSET, 0x0000FFFFU);
+			while ((Xil_In32(XPS_L2CC_BASEADDR +
+					 XPS_L2CC_CACHE_INVLD_WAY_OFFSET) &
+				0x0000FFFFU) != 0U) {
+				;
+			}
+			Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET,
+				  0U);
+			Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CNTRL_OFFSET,
+				  Ctrl);
+			Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET,
+				  0U);
+		}
+		dsb();
+	}
+
+	mtcpsr(CurrMask);
+
+	return XST_SUCCESS;
+}
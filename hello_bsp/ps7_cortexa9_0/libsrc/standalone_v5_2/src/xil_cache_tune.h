@@ -0,0 +1,110 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_cache_tune.h
+*
+* This header file contains the interface to change the prefetch and the
+* latency settings of the caches at run time.
+*
+* boot.S and Xil_L2CacheEnable() set the L1 and L2 prefetchers, the PL310
+* auxiliary control and the tag and data RAM latencies to fixed values.
+* Streaming DMA buffers and pointer chasing want different values, so
+* Xil_CacheGetTuning() reads the current settings into an Xil_CacheTuning
+* and Xil_CacheSetTuning() applies a changed copy:
+*  - L1Prefetch and L2PrefetchHint are the D-side prefetch and the L2
+*    prefetch hint bits of ACTLR of the calling CPU, changed in place.
+*  - L2InstrPrefetch, L2DataPrefetch, PrefetchOffset and DoubleLinefill are
+*    fields of the PL310 prefetch control register, EarlyBresp is the early
+*    BRESP bit of the auxiliary control register, TagRamLatency and
+*    DataRamLatency are the raw latency control registers. The PL310 is
+*    flushed, disabled, set up, invalidated and enabled again to change any
+*    of them.
+*
+* Xil_L2CacheEnable() restores the defaults of xl2cc.h when it enables the
+* L2 cache again.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_CACHE_TUNE_H /* prevent circular inclusions */
+#define XIL_CACHE_TUNE_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+/**************************** Type Definitions ******************************/
+
+/**
+ * Prefetch and latency settings of the L1 and L2 caches
+ */
+typedef struct {
+	u8 L1Prefetch;		/**< ACTLR D-side prefetch */
+	u8 L2PrefetchHint;	/**< ACTLR L2 prefetch hint */
+	u8 L2InstrPrefetch;	/**< PL310 instruction prefetch */
+	u8 L2DataPrefetch;	/**< PL310 data prefetch */
+	u8 PrefetchOffset;	/**< PL310 prefetch offset, 0 - 7, 15, 23 or 31 */
+	u8 DoubleLinefill;	/**< PL310 double linefill */
+	u8 EarlyBresp;		/**< PL310 early BRESP */
+	u32 TagRamLatency;	/**< PL310 tag RAM latency control */
+	u32 DataRamLatency;	/**< PL310 data RAM latency control */
+} Xil_CacheTuning;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions ****************************/
+
+/************************** Function Prototypes *****************************/
+
+void Xil_CacheGetTuning(Xil_CacheTuning *Tuning);
+s32 Xil_CacheSetTuning(const Xil_CacheTuning *Tuning);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_CACHE_TUNE_H */
@@ -0,0 +1,238 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_coherent.c
+*
+* This file contains the coherent DMA buffer regions. For more information,
+* see xil_coherent.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_coherent.h"
+#include "xil_mmu.h"
+#include "xil_assert.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * Normal memory, outer and inner non-cacheable, shareable
+ */
+#define XIL_COHERENT_NONCACHE_ATTR	0x14DE2U
+
+#define IRQ_FIQ_MASK			0xC0U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions *****************************/
+
+u32 Xil_CoherentNumRegions;
+
+static Xil_CoherentRegion CoherentRegions[XIL_COHERENT_MAX_REGIONS];
+
+/************************** Function Prototypes ******************************/
+
+/******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* Register a coherent region.
+*
+* @param	Base is the start of the region.
+* @param	Size is the length of the region in bytes.
+* @param	Type is XIL_COHERENT_NONCACHE, to map the region
+*		non-cacheable, in which case Base and Size must be multiples
+*		of 4 KB, or XIL_COHERENT_ACP for a region only PL masters
+*		access through the ACP.
+*
+* @return	XST_SUCCESS, XST_INVALID_PARAM for a misaligned region, one
+*		that wraps past the end of the address space or one that
+*		overlaps a registered region, or XST_FAILURE if all
+*		XIL_COHERENT_MAX_REGIONS are used or the region could not be
+*		mapped.
+*
+* @note		Register regions at start up, before the drivers use them.
+*		Data in a XIL_COHERENT_NONCACHE region is kept, its lines
+*		are flushed from the caches when it is mapped.
+*
+*****************************************************************************/
+s32 Xil_CoherentAddRegion(INTPTR Base, u32 Size, u32 Type)
+{
+	Xil_CoherentRegion *Region;
+	u32 Index;
+	u32 CurrMask;
+	s32 Status;
+
+	Xil_AssertNonvoid(Size != 0U);
+	Xil_AssertNonvoid((Type == XIL_COHERENT_NONCACHE) ||
+			  (Type == XIL_COHERENT_ACP));
+
+	if (Xil_CoherentNumRegions == XIL_COHERENT_MAX_REGIONS) {
+		return XST_FAILURE;
+	}
+	if ((Type == XIL_COHERENT_NONCACHE) &&
+	    ((((u32)Base | Size) & (XIL_MMU_PAGE_SIZE - 1U)) != 0U)) {
+		return XST_INVALID_PARAM;
+	}
+	if (((u32)Base + Size) < (u32)Base) {
+		return XST_INVALID_PARAM;
+	}
+	for (Index = 0U; Index < Xil_CoherentNumRegions; Index++) {
+		if (((u32)Base < CoherentRegions[Index].End) &&
+		    (CoherentRegions[Index].Base < ((u32)Base + Size))) {
+			return XST_INVALID_PARAM;
+		}
+	}
+
+	if (Type == XIL_COHERENT_NONCACHE) {
+		Status = Xil_SetTlbAttributesRange(Base, Size,
+						   XIL_COHERENT_NONCACHE_ATTR);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	Region = &CoherentRegions[Xil_CoherentNumRegions];
+	Region->Base = (u32)Base;
+	Region->End = (u32)Base + Size;
+	Region->Next = (u32)Base;
+	Region->Type = Type;
+
+	/* Publish the region before the count that makes it visible */
+	dmb();
+	Xil_CoherentNumRegions++;
+
+	mtcpsr(CurrMask);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Allocate a buffer from the coherent regions of a type.
+*
+* @param	Size is the length of the buffer in bytes.
+* @param	Align is the alignment of the buffer, a power of 2. Use the
+*		cache line size or more for buffers that are also accessed
+*		through a cacheable alias.
+* @param	Type is XIL_COHERENT_NONCACHE or XIL_COHERENT_ACP.
+*
+* @return	The buffer, or NULL if no region of the type has room.
+*
+* @note		The buffers cannot be freed, allocate them at start up.
+*
+*****************************************************************************/
+void *Xil_CoherentAlloc(u32 Size, u32 Align, u32 Type)
+{
+	Xil_CoherentRegion *Region;
+	void *Buffer = NULL;
+	u32 Index;
+	u32 Start;
+	u32 CurrMask;
+
+	Xil_AssertNonvoid(Align != 0U);
+	Xil_AssertNonvoid((Align & (Align - 1U)) == 0U);
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	for (Index = 0U; Index < Xil_CoherentNumRegions; Index++) {
+		Region = &CoherentRegions[Index];
+		if (Region->Type != Type) {
+			continue;
+		}
+		Start = (Region->Next + (Align - 1U)) & ~(Align - 1U);
+		if ((Start >= Region->Next) && (Start <= Region->End) &&
+		    (Size <= (Region->End - Start))) {
+			Region->Next = Start + Size;
+			Buffer = (void *)Start;
+			break;
+		}
+	}
+
+	mtcpsr(CurrMask);
+
+	return Buffer;
+}
+
+/****************************************************************************/
+/**
+*
+* Check a buffer against the registered coherent regions, see
+* Xil_IsCoherent().
+*
+* @param	Addr is the start of the buffer.
+* @param	Len is the length of the buffer in bytes.
+*
+* @return	1 if the buffer lies wholly inside one XIL_COHERENT_NONCACHE
+*		region, else 0.
+*
+* @note		XIL_COHERENT_ACP regions are never reported, the PS masters
+*		that call this through their drivers do not use the ACP.
+*
+*****************************************************************************/
+u32 Xil_CoherentCheck(INTPTR Addr, u32 Len)
+{
+	u32 Index;
+	u32 Start = (u32)Addr;
+
+	for (Index = 0U; Index < Xil_CoherentNumRegions; Index++) {
+		if ((CoherentRegions[Index].Type == XIL_COHERENT_NONCACHE) &&
+		    (Start >= CoherentRegions[Index].Base) &&
+		    (Start <= CoherentRegions[Index].End) &&
+		    (Len <= (CoherentRegions[Index].End - Start))) {
+			return 1U;
+		}
+	}
+
+	return 0U;
+}
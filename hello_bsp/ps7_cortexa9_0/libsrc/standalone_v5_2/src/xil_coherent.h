@@ -0,0 +1,137 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_coherent.h
+*
+* This header file contains the interface for DMA buffers that need no cache
+* maintenance.
+*
+* A coherent region is a range of memory that the application registers with
+* Xil_CoherentAddRegion(), of one of two types:
+*  - XIL_COHERENT_NONCACHE: the region is mapped normal non-cacheable with
+*    Xil_SetTlbAttributesRange(), so that every master of the PS, GEM, SDIO,
+*    USB, the PL330 and the device configuration DMA, sees what the CPU sees.
+*  - XIL_COHERENT_ACP: the region stays cacheable and is only accessed by PL
+*    masters through the Accelerator Coherency Port with coherent AXI
+*    attributes, so that the SCU keeps it coherent with L1 and L2.
+* The PS masters are not connected to the ACP, for them only the first type
+* is coherent.
+*
+* Xil_CoherentAlloc() hands out aligned buffers from the registered regions.
+* The drivers call Xil_IsCoherent() before each Xil_DCacheFlushRange(),
+* Xil_DCacheInvalidateRange() or Xil_DCacheMaintainList() entry of a DMA
+* buffer and skip the maintenance for buffers wholly inside a
+* XIL_COHERENT_NONCACHE region. Buffers in XIL_COHERENT_ACP regions are still
+* maintained, as the PS masters reach them around the caches. With no region
+* registered the check is one load and compare.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_COHERENT_H /* prevent circular inclusions */
+#define XIL_COHERENT_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_COHERENT_NONCACHE		0U
+#define XIL_COHERENT_ACP		1U
+
+#ifndef XIL_COHERENT_MAX_REGIONS
+#define XIL_COHERENT_MAX_REGIONS	4U
+#endif
+
+/**************************** Type Definitions ******************************/
+
+/**
+ * A registered coherent region
+ */
+typedef struct {
+	u32 Base;	/**< First byte */
+	u32 End;	/**< Byte after the last */
+	u32 Next;	/**< Next free byte for Xil_CoherentAlloc */
+	u32 Type;	/**< XIL_COHERENT_NONCACHE or XIL_COHERENT_ACP */
+} Xil_CoherentRegion;
+
+/************************** Variable Definitions ****************************/
+
+extern u32 Xil_CoherentNumRegions;
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_CoherentAddRegion(INTPTR Base, u32 Size, u32 Type);
+void *Xil_CoherentAlloc(u32 Size, u32 Align, u32 Type);
+u32 Xil_CoherentCheck(INTPTR Addr, u32 Len);
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/*****************************************************************************/
+/**
+*
+* Check whether a DMA buffer of a PS master lies wholly inside a
+* XIL_COHERENT_NONCACHE region, so that its cache maintenance can be skipped.
+*
+* @param	Addr is the start of the buffer.
+* @param	Len is the length of the buffer in bytes.
+*
+* @return	1 if the buffer is coherent, else 0.
+*
+* @note		None.
+*
+******************************************************************************/
+static inline u32 Xil_IsCoherent(INTPTR Addr, u32 Len)
+{
+	return (Xil_CoherentNumRegions != 0U) ? Xil_CoherentCheck(Addr, Len) :
+						 0U;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_COHERENT_H */
@@ -0,0 +1,468 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_defer.c
+*
+* This file contains the deferred interrupt work layer. See xil_defer.h for a
+* description of its operation.
+*
+* Each priority has a bounded multi producer, multi consumer queue of work
+* item pointers after Vyukov: every cell carries a sequence number that tells
+* whether it is free for the producer at a given position or filled for the
+* consumer, and producers and consumers claim positions with a compare and
+* swap on Head and Tail. An interrupt handler that preempts a producer or a
+* consumer on the same CPU, or a handler on the other CPU, therefore never
+* waits for it. The GCC __sync builtins compile to LDREX/STREX with DMB, see
+* xil_taskpool.c.
+*
+* The Queued flag of a work item is set by the schedule that queues it and
+* cleared just before its function runs, so an item is on at most one queue
+* once and XIL_DEFER_QUEUE_SIZE items of a priority can always be queued.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_defer.h"
+#include "xil_assert.h"
+#include "xil_smp.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_DEFER_QUEUE_MASK		(XIL_DEFER_QUEUE_SIZE - 1U)
+#define XIL_DEFER_SGI_TRIGGER		0x3U
+
+/**************************** Type Definitions ******************************/
+
+typedef struct {
+	volatile u32 Seq;
+	Xil_DeferWork *WorkPtr;
+} Xil_DeferCell;
+
+typedef struct {
+	volatile u32 Head;		/* Next position to fill */
+	u32 Pad0[7];
+	volatile u32 Tail;		/* Next position to take */
+	u32 Pad1[7];
+	Xil_DeferCell Cells[XIL_DEFER_QUEUE_SIZE];
+} Xil_DeferQueue;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+static s32 Xil_DeferPush(Xil_DeferQueue *QueuePtr, Xil_DeferWork *WorkPtr);
+static Xil_DeferWork *Xil_DeferPop(Xil_DeferQueue *QueuePtr);
+static void Xil_DeferSgiHandler(void *CallBackRef);
+
+/************************** Variable Definitions ****************************/
+
+static Xil_DeferQueue DeferQueues[XIL_DEFER_NUM_PRIORITIES]
+	__attribute__ ((aligned(32)));
+static Xil_DeferStats DeferStats;
+static XScuGic *DeferGicPtr;
+
+/*****************************************************************************/
+/**
+*
+* Initialize the queues and, with a GIC instance, the interrupt that runs the
+* queued work.
+*
+* @param	GicPtr is the GIC instance, initialized with
+*		XScuGic_CfgInitialize() and with XScuGic_InterruptHandler
+*		registered as the IRQ exception handler, or NULL to run the
+*		work from Xil_DeferRun() only.
+*
+* @return	XST_SUCCESS, or the error of XScuGic_Connect().
+*
+* @note		The nested mode of the GIC driver is left as it is. The
+*		caller enables it with XScuGic_SetNesting() if the work is to
+*		run with interrupts enabled, otherwise the SGI handler runs
+*		the work with IRQs masked. On an SMP system call
+*		XScuGic_Enable() for XIL_DEFER_SGI_ID on CPU1 as well.
+*
+******************************************************************************/
+s32 Xil_DeferInit(XScuGic *GicPtr)
+{
+	u32 Priority;
+	u32 Index;
+	s32 Status;
+
+	for (Priority = 0U; Priority < XIL_DEFER_NUM_PRIORITIES; Priority++) {
+		DeferQueues[Priority].Head = 0U;
+		DeferQueues[Priority].Tail = 0U;
+		for (Index = 0U; Index < XIL_DEFER_QUEUE_SIZE; Index++) {
+			DeferQueues[Priority].Cells[Index].Seq = Index;
+			DeferQueues[Priority].Cells[Index].WorkPtr = NULL;
+		}
+	}
+	Xil_DeferResetStats();
+	DeferGicPtr = NULL;
+
+	if (GicPtr == NULL) {
+		return XST_SUCCESS;
+	}
+
+	Status = XScuGic_Connect(GicPtr, XIL_DEFER_SGI_ID,
+				 Xil_DeferSgiHandler, NULL);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	XScuGic_SetPriorityTriggerType(GicPtr, XIL_DEFER_SGI_ID,
+				       XIL_DEFER_SGI_PRIORITY,
+				       XIL_DEFER_SGI_TRIGGER);
+	XScuGic_Enable(GicPtr, XIL_DEFER_SGI_ID);
+	DeferGicPtr = GicPtr;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Initialize a work item.
+*
+* @param	WorkPtr is the work item.
+* @param	Priority is the queue of the item, 0 is the most urgent.
+* @param	Func is called with Arg and the ORed Data of the schedules.
+* @param	Arg is passed to Func.
+*
+* @return	None.
+*
+* @note		The item must not be queued.
+*
+******************************************************************************/
+void Xil_DeferWorkInit(Xil_DeferWork *WorkPtr, u32 Priority,
+		       Xil_DeferFunc Func, void *Arg)
+{
+	Xil_AssertVoid(WorkPtr != NULL);
+	Xil_AssertVoid(Priority < XIL_DEFER_NUM_PRIORITIES);
+	Xil_AssertVoid(Func != NULL);
+
+	WorkPtr->Func = Func;
+	WorkPtr->Arg = Arg;
+	WorkPtr->Priority = Priority;
+	WorkPtr->Data = 0U;
+	WorkPtr->Queued = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Queue a work item, unless it is queued already, and raise the interrupt
+* that runs it. May be called from interrupt handlers on either CPU and from
+* thread context.
+*
+* @param	WorkPtr is the work item.
+* @param	Data is ORed into the data passed to the work function.
+*
+* @return	XST_SUCCESS if the item is queued, XST_FAILURE if its queue
+*		was full and the schedule is lost.
+*
+* @note		None.
+*
+******************************************************************************/
+s32 Xil_DeferSchedule(Xil_DeferWork *WorkPtr, u32 Data)
+{
+	Xil_AssertNonvoid(WorkPtr != NULL);
+
+	(void)__sync_fetch_and_or(&WorkPtr->Data, Data);
+
+	if (__sync_lock_test_and_set(&WorkPtr->Queued, 1U) != 0U) {
+		(void)__sync_fetch_and_add(&DeferStats.Coalesced, 1U);
+		return XST_SUCCESS;
+	}
+
+	if (Xil_DeferPush(&DeferQueues[WorkPtr->Priority], WorkPtr) !=
+	    XST_SUCCESS) {
+		__sync_lock_release(&WorkPtr->Queued);
+		(void)__sync_fetch_and_add(&DeferStats.Dropped, 1U);
+		return XST_FAILURE;
+	}
+	(void)__sync_fetch_and_add(&DeferStats.Scheduled, 1U);
+
+	if (DeferGicPtr != NULL) {
+		(void)XScuGic_SoftwareIntr(DeferGicPtr, XIL_DEFER_SGI_ID,
+					   (u32)1U << Xil_SmpCpuId());
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Driver callback that schedules the work item given as callback reference,
+* for callbacks of type void (*)(void *CallBackRef).
+*
+* @param	CallBackRef is the Xil_DeferWork.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_DeferHandler(void *CallBackRef)
+{
+	(void)Xil_DeferSchedule((Xil_DeferWork *)CallBackRef, 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* Driver callback that schedules the work item given as callback reference,
+* for callbacks of type void (*)(void *CallBackRef, u32 Mask).
+*
+* @param	CallBackRef is the Xil_DeferWork.
+* @param	Data is ORed into the data passed to the work function.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_DeferHandlerData(void *CallBackRef, u32 Data)
+{
+	(void)Xil_DeferSchedule((Xil_DeferWork *)CallBackRef, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* Run the queued work until the queues are empty, most urgent first.
+*
+* @param	None.
+*
+* @return	Number of work functions called.
+*
+* @note		Runs with the interrupt state of the caller. It is called by
+*		the handler of XIL_DEFER_SGI_ID, or from the main loop of an
+*		application that passed NULL to Xil_DeferInit().
+*
+******************************************************************************/
+u32 Xil_DeferRun(void)
+{
+	Xil_DeferWork *WorkPtr;
+	u32 Priority = 0U;
+	u32 Count = 0U;
+	u32 Data;
+
+	while (Priority < XIL_DEFER_NUM_PRIORITIES) {
+		WorkPtr = Xil_DeferPop(&DeferQueues[Priority]);
+		if (WorkPtr == NULL) {
+			Priority++;
+			continue;
+		}
+
+		/*
+		 * Clear Queued before taking Data, a schedule in between
+		 * queues the item again and its Data is not lost.
+		 */
+		__sync_lock_release(&WorkPtr->Queued);
+		__sync_synchronize();
+		Data = __sync_fetch_and_and(&WorkPtr->Data, 0U);
+
+		WorkPtr->Func(WorkPtr->Arg, Data);
+		Count++;
+
+		/*
+		 * The function, or a handler that preempted it, may have
+		 * queued more urgent work. The SGI raised for it stays
+		 * pending behind this one, so drain it here from level 0.
+		 */
+		Priority = 0U;
+	}
+
+	(void)__sync_fetch_and_add(&DeferStats.Run, Count);
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+*
+* Read the counters.
+*
+* @param	StatsPtr receives the counters.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_DeferGetStats(Xil_DeferStats *StatsPtr)
+{
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	StatsPtr->Scheduled = DeferStats.Scheduled;
+	StatsPtr->Coalesced = DeferStats.Coalesced;
+	StatsPtr->Dropped = DeferStats.Dropped;
+	StatsPtr->Run = DeferStats.Run;
+}
+
+/*****************************************************************************/
+/**
+*
+* Clear the counters.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_DeferResetStats(void)
+{
+	DeferStats.Scheduled = 0U;
+	DeferStats.Coalesced = 0U;
+	DeferStats.Dropped = 0U;
+	DeferStats.Run = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Put a work item on a queue.
+*
+* @param	QueuePtr is the queue.
+* @param	WorkPtr is the work item.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the queue is full.
+*
+* @note		None.
+*
+******************************************************************************/
+static s32 Xil_DeferPush(Xil_DeferQueue *QueuePtr, Xil_DeferWork *WorkPtr)
+{
+	Xil_DeferCell *CellPtr;
+	u32 Pos = QueuePtr->Head;
+	s32 Diff;
+
+	for (;;) {
+		CellPtr = &QueuePtr->Cells[Pos & XIL_DEFER_QUEUE_MASK];
+		Diff = (s32)(CellPtr->Seq - Pos);
+		if (Diff == 0) {
+			if (__sync_bool_compare_and_swap(&QueuePtr->Head, Pos,
+							 Pos + 1U)) {
+				break;
+			}
+		} else if (Diff < 0) {
+			return XST_FAILURE;
+		} else {
+			/* Another producer took the position */
+		}
+		Pos = QueuePtr->Head;
+	}
+
+	CellPtr->WorkPtr = WorkPtr;
+	__sync_synchronize();
+	CellPtr->Seq = Pos + 1U;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Take the oldest work item from a queue.
+*
+* @param	QueuePtr is the queue.
+*
+* @return	The work item, or NULL if the queue is empty or its oldest
+*		item is still being written by a preempted producer, which
+*		raises the SGI again when it completes.
+*
+* @note		None.
+*
+******************************************************************************/
+static Xil_DeferWork *Xil_DeferPop(Xil_DeferQueue *QueuePtr)
+{
+	Xil_DeferCell *CellPtr;
+	Xil_DeferWork *WorkPtr;
+	u32 Pos = QueuePtr->Tail;
+	s32 Diff;
+
+	for (;;) {
+		CellPtr = &QueuePtr->Cells[Pos & XIL_DEFER_QUEUE_MASK];
+		Diff = (s32)(CellPtr->Seq - (Pos + 1U));
+		if (Diff == 0) {
+			if (__sync_bool_compare_and_swap(&QueuePtr->Tail, Pos,
+							 Pos + 1U)) {
+				break;
+			}
+		} else if (Diff < 0) {
+			return NULL;
+		} else {
+			/* Another consumer took the position */
+		}
+		Pos = QueuePtr->Tail;
+	}
+
+	__sync_synchronize();
+	WorkPtr = CellPtr->WorkPtr;
+	__sync_synchronize();
+	CellPtr->Seq = Pos + XIL_DEFER_QUEUE_SIZE;
+
+	return WorkPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* Handler of XIL_DEFER_SGI_ID, runs the queued work. In the nested mode of
+* the GIC driver it runs with interrupts enabled.
+*
+* @param	CallBackRef is unused.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void Xil_DeferSgiHandler(void *CallBackRef)
+{
+	(void)CallBackRef;
+
+	(void)Xil_DeferRun();
+}
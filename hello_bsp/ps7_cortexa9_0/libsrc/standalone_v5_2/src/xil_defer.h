@@ -0,0 +1,146 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_defer.h
+*
+* This header file contains the interface of the deferred interrupt work
+* layer. It moves the heavy part of interrupt handling out of the IRQ
+* handlers, which run with interrupts masked, into work functions that run
+* with interrupts enabled.
+*
+* A work item, Xil_DeferWork, names a function, its argument and a priority,
+* 0 being the most urgent of XIL_DEFER_NUM_PRIORITIES. An interrupt handler
+* acknowledges its device and calls Xil_DeferSchedule(), which puts the item
+* on the lock-free queue of its priority and returns. An item that is
+* scheduled again before it has run stays queued once; the Data words passed
+* meanwhile are ORed together and handed to the function, which suits the
+* status masks of the driver callbacks.
+*
+* The driver callbacks themselves can be deferred without changing the
+* drivers: register Xil_DeferHandler() or Xil_DeferHandlerData() as the
+* callback of the driver, for example with XEmacPs_SetHandler(),
+* XUsbPs_IntrSetHandler() or XCanPs_SetHandler(), and the Xil_DeferWork as
+* its callback reference. The driver clears the interrupt status as before
+* and the user function runs later.
+*
+* The queued work runs in one of two ways:
+*  - Xil_DeferInit() with a GIC instance connects the software generated
+*    interrupt XIL_DEFER_SGI_ID at XIL_DEFER_SGI_PRIORITY, the lowest priority
+*    above the 0xF0 mask set by XScuGic_CfgInitialize(). Scheduling raises
+*    the SGI, and its handler runs the work. With the nested mode of
+*    XScuGic_InterruptHandler, which the application enables with
+*    XScuGic_SetNesting(), the work runs with interrupts enabled, so every
+*    other interrupt preempts it.
+*  - Xil_DeferInit() with NULL leaves the dispatch to the application, which
+*    calls Xil_DeferRun() from its main loop.
+* All the levels drain in order inside one run of the handler. After each
+* item the scan starts again at priority 0, so of the work queued at that
+* point a lower priority number runs first. Deferred work never preempts a
+* running item, the SGI has a single priority. Items of one priority run in
+* the order they were scheduled.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_DEFER_H /* prevent circular inclusions */
+#define XIL_DEFER_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+#include "xscugic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_DEFER_NUM_PRIORITIES	4U
+#define XIL_DEFER_QUEUE_SIZE	32U	/* Items per priority, power of 2 */
+#define XIL_DEFER_SGI_ID	14U	/* Runs the queued work */
+#define XIL_DEFER_SGI_PRIORITY	0xE8U	/* Lowest above the 0xF0 mask */
+
+/**************************** Type Definitions ******************************/
+
+typedef void (*Xil_DeferFunc)(void *Arg, u32 Data);
+
+/*
+ * Work item. Initialize with Xil_DeferWorkInit() and keep it alive while it
+ * may be queued.
+ */
+typedef struct {
+	Xil_DeferFunc Func;
+	void *Arg;
+	u32 Priority;
+	volatile u32 Data;	/* ORed Data of the pending schedules */
+	volatile u32 Queued;	/* On a queue and not started yet */
+} Xil_DeferWork;
+
+/*
+ * Counters, see Xil_DeferGetStats().
+ */
+typedef struct {
+	u32 Scheduled;		/* Items put on a queue */
+	u32 Coalesced;		/* Schedules of an item already queued */
+	u32 Dropped;		/* Schedules lost, queue full */
+	u32 Run;		/* Work functions called */
+} Xil_DeferStats;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_DeferInit(XScuGic *GicPtr);
+void Xil_DeferWorkInit(Xil_DeferWork *WorkPtr, u32 Priority,
+		       Xil_DeferFunc Func, void *Arg);
+s32 Xil_DeferSchedule(Xil_DeferWork *WorkPtr, u32 Data);
+void Xil_DeferHandler(void *CallBackRef);
+void Xil_DeferHandlerData(void *CallBackRef, u32 Data);
+u32 Xil_DeferRun(void);
+void Xil_DeferGetStats(Xil_DeferStats *StatsPtr);
+void Xil_DeferResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_DEFER_H */
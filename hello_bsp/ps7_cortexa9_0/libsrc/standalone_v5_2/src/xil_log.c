@@ -0,0 +1,257 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_log.c
+*
+* This file contains the deferred binary trace log. See xil_log.h for the
+* record format and the ways of reading the log back.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_log.h"
+#include "xil_io.h"
+#include "xpseudo_asm.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_LOG_BUF_MASK	(XIL_LOG_BUF_WORDS - 1U)
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#define Xil_LogTimestamp()	\
+	Xil_In32(GLOBAL_TMR_BASEADDR + GTIMER_COUNTER_LOWER_OFFSET)
+
+/************************** Function Prototypes *****************************/
+
+static void Xil_LogEmitWord(Xil_LogOutHandler OutFn, u32 Word);
+
+/************************** Variable Definitions ****************************/
+
+/*
+ * Statically initialized so that records can be written from the very first
+ * instruction of main() and so that a memory dump is self describing.
+ */
+Xil_LogCtrlBlock Xil_LogCtrl = {
+	XIL_LOG_CTRL_MAGIC, XIL_LOG_BUF_WORDS, 0U, 0U, 0U, {0U}
+};
+
+/****************************************************************************/
+/**
+*
+* Appends one record to the trace log. Normally called through the
+* Xil_Log0() .. Xil_Log4() macros, which supply the format string ID.
+*
+* @param	FmtId is the format string ID.
+* @param	NumArgs is the number of valid arguments, at most
+*		XIL_LOG_MAX_ARGS.
+* @param	Arg0..Arg3 are the arguments.
+*
+* @return	None.
+*
+* @note		Safe to call from any context and from both CPUs. If the
+*		ring is full the record is dropped and Xil_LogCtrl.Dropped
+*		is incremented.
+*
+****************************************************************************/
+void Xil_LogWrite(u32 FmtId, u32 NumArgs, u32 Arg0, u32 Arg1, u32 Arg2,
+		u32 Arg3)
+{
+	volatile u32 *Buf = Xil_LogCtrl.Buf;
+	u32 Stamp;
+	u32 Count;
+	u32 Len;
+	u32 Head;
+
+	Count = (NumArgs > XIL_LOG_MAX_ARGS) ? XIL_LOG_MAX_ARGS : NumArgs;
+	Len = XIL_LOG_HDR_WORDS + Count;
+
+	/* Reserve Len words */
+	do {
+		Head = Xil_LogCtrl.Head;
+		if (((Head + Len) - Xil_LogCtrl.Tail) > XIL_LOG_BUF_WORDS) {
+			(void)__sync_fetch_and_add(&Xil_LogCtrl.Dropped, 1U);
+			return;
+		}
+	} while (__sync_val_compare_and_swap(&Xil_LogCtrl.Head, Head,
+			Head + Len) != Head);
+
+	/*
+	 * Stamps are not ordered with the ring. A record that preempts this
+	 * one between the reserve and the stamp lands after it with an older
+	 * stamp, so stamps may step back across preemption. Such steps are
+	 * short, and the decoder only counts a step back of more than half
+	 * the timer range as a wrap.
+	 */
+	Stamp = Xil_LogTimestamp();
+
+	Buf[(Head + 1U) & XIL_LOG_BUF_MASK] = FmtId;
+	Buf[(Head + 2U) & XIL_LOG_BUF_MASK] = Stamp;
+	if (Count > 0U) {
+		Buf[(Head + 3U) & XIL_LOG_BUF_MASK] = Arg0;
+	}
+	if (Count > 1U) {
+		Buf[(Head + 4U) & XIL_LOG_BUF_MASK] = Arg1;
+	}
+	if (Count > 2U) {
+		Buf[(Head + 5U) & XIL_LOG_BUF_MASK] = Arg2;
+	}
+	if (Count > 3U) {
+		Buf[(Head + 6U) & XIL_LOG_BUF_MASK] = Arg3;
+	}
+
+	/* Commit: the header must become visible after the body */
+	dmb();
+	Buf[Head & XIL_LOG_BUF_MASK] = XIL_LOG_HDR_MAGIC | Count;
+}
+
+/****************************************************************************/
+/**
+*
+* Moves committed records out of the ring, byte by byte and little endian,
+* through the given output function. If records were dropped since the last
+* call, a record with format ID XIL_LOG_FMT_DROPPED and the drop count as
+* its argument is emitted first.
+*
+* @param	OutFn is called for every byte, for example outbyte.
+* @param	MaxRecords bounds the number of records drained by this call,
+*		XIL_LOG_DRAIN_ALL drains everything that is committed.
+*
+* @return	The number of records drained.
+*
+* @note		Only one caller may drain at a time. Draining stops at the
+*		first record that has been reserved but not yet committed.
+*
+****************************************************************************/
+u32 Xil_LogDrain(Xil_LogOutHandler OutFn, u32 MaxRecords)
+{
+	volatile u32 *Buf = Xil_LogCtrl.Buf;
+	u32 Records = 0U;
+	u32 Dropped;
+	u32 Tail;
+	u32 Hdr;
+	u32 Len;
+	u32 Index;
+
+	Dropped = __sync_fetch_and_and(&Xil_LogCtrl.Dropped, 0U);
+	if (Dropped != 0U) {
+		Xil_LogEmitWord(OutFn, XIL_LOG_HDR_MAGIC | 1U);
+		Xil_LogEmitWord(OutFn, XIL_LOG_FMT_DROPPED);
+		Xil_LogEmitWord(OutFn, Xil_LogTimestamp());
+		Xil_LogEmitWord(OutFn, Dropped);
+	}
+
+	Tail = Xil_LogCtrl.Tail;
+	while ((Records < MaxRecords) && (Tail != Xil_LogCtrl.Head)) {
+		Hdr = Buf[Tail & XIL_LOG_BUF_MASK];
+		if ((Hdr & XIL_LOG_HDR_MAGIC_MASK) != XIL_LOG_HDR_MAGIC) {
+			break;
+		}
+		dmb();
+
+		Len = XIL_LOG_HDR_WORDS + (Hdr & XIL_LOG_HDR_NARGS_MASK);
+		for (Index = 0U; Index < Len; Index++) {
+			Xil_LogEmitWord(OutFn,
+				Buf[(Tail + Index) & XIL_LOG_BUF_MASK]);
+			Buf[(Tail + Index) & XIL_LOG_BUF_MASK] = 0U;
+		}
+
+		/* The cleared words must be visible before they are reused */
+		dmb();
+		Tail += Len;
+		Xil_LogCtrl.Tail = Tail;
+		Records++;
+	}
+
+	return Records;
+}
+
+/****************************************************************************/
+/**
+*
+* Discards all records and the drop count.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		Must not run concurrently with Xil_LogWrite().
+*
+****************************************************************************/
+void Xil_LogReset(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XIL_LOG_BUF_WORDS; Index++) {
+		Xil_LogCtrl.Buf[Index] = 0U;
+	}
+	Xil_LogCtrl.Dropped = 0U;
+	Xil_LogCtrl.Tail = 0U;
+	Xil_LogCtrl.Head = 0U;
+	dmb();
+}
+
+/****************************************************************************/
+/**
+*
+* Emits one 32 bit word through the output function, least significant
+* byte first.
+*
+* @param	OutFn is the output function.
+* @param	Word is the word to emit.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Xil_LogEmitWord(Xil_LogOutHandler OutFn, u32 Word)
+{
+	OutFn((char8)(Word & 0xFFU));
+	OutFn((char8)((Word >> 8U) & 0xFFU));
+	OutFn((char8)((Word >> 16U) & 0xFFU));
+	OutFn((char8)((Word >> 24U) & 0xFFU));
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_log.h
+*
+* This header file contains the interface of the deferred binary trace log.
+*
+* xil_printf() converts every argument to text on the target, digit by digit,
+* before a single character reaches the output device. The trace log instead
+* stores, for each call, a record of raw 32 bit words:
+* <pre>
+*   word 0   XIL_LOG_HDR_MAGIC | number of arguments
+*   word 1   format string ID
+*   word 2   lower 32 bits of the global timer
+*   word 3.. arguments, at most XIL_LOG_MAX_ARGS
+* </pre>
+* The format strings themselves are placed by the Xil_LogN() macros in the
+* .xil_log_fmt section. The linker script maps that section as INFO, so the
+* strings are kept in the ELF but never loaded; the format string ID is the
+* address of the string within that section. The host tool
+* xil_logdecode.py reads the strings back from the ELF and prints the text.
+*
+* Records are appended to the ring in Xil_LogCtrl without taking a lock:
+* space is reserved with an exclusive compare and swap on the head index,
+* the body is written and the header word is stored last to commit the
+* record. Writers may therefore be in task context, in interrupt handlers or
+* on the other CPU. A reservation that does not fit in the ring is dropped
+* and counted.
+*
+* The ring can be emptied in three ways:
+* - Xil_LogDrain() passes the raw record bytes to an output function, for
+*   example outbyte() for the stdout UART or a wrapper around
+*   XCoresightPs_DccSendByte() for the JTAG DCC channel.
+* - A debugger dumps the memory of the Xil_LogCtrl symbol, whose size is
+*   sizeof(Xil_LogCtrl), and feeds the dump to the host tool.
+* - The host tool can also read a raw capture of the UART or DCC stream.
+*
+* %s arguments are logged as pointers; the host tool resolves them when they
+* point to constant data inside the ELF.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_LOG_H /* prevent circular inclusions */
+#define XIL_LOG_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * Size of the ring in 32 bit words, a power of two. Override it with
+ * -DXIL_LOG_BUF_WORDS=<n> in the BSP compiler flags.
+ */
+#ifndef XIL_LOG_BUF_WORDS
+#define XIL_LOG_BUF_WORDS	1024U
+#endif
+
+#define XIL_LOG_MAX_ARGS	4U
+#define XIL_LOG_HDR_WORDS	3U
+
+#define XIL_LOG_CTRL_MAGIC	0x584C4F47U	/* "XLOG" */
+#define XIL_LOG_HDR_MAGIC	0xA5000000U
+#define XIL_LOG_HDR_MAGIC_MASK	0xFF000000U
+#define XIL_LOG_HDR_NARGS_MASK	0x000000FFU
+
+/*
+ * Format string ID of the record Xil_LogDrain() emits when records have
+ * been dropped since the last drain. Its only argument is the drop count.
+ */
+#define XIL_LOG_FMT_DROPPED	0xFFFFFFFFU
+
+/*
+ * MaxRecords value for Xil_LogDrain() that empties the whole ring.
+ */
+#define XIL_LOG_DRAIN_ALL	0xFFFFFFFFU
+
+/**************************** Type Definitions ******************************/
+
+/**
+ * The trace log control block and ring. The layout is fixed; the host tool
+ * decodes memory dumps of it.
+ */
+typedef struct {
+	u32 Magic;		/**< XIL_LOG_CTRL_MAGIC */
+	u32 SizeWords;		/**< Number of words in Buf */
+	volatile u32 Head;	/**< Next word to reserve, free running */
+	volatile u32 Tail;	/**< Next word to drain, free running */
+	volatile u32 Dropped;	/**< Records dropped because of a full ring */
+	volatile u32 Buf[XIL_LOG_BUF_WORDS];	/**< Record storage */
+} Xil_LogCtrlBlock;
+
+/**
+ * Output function used by Xil_LogDrain(), called once per byte.
+ */
+typedef void (*Xil_LogOutHandler)(char8 Data);
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/****************************************************************************/
+/**
+* Places a format string in the .xil_log_fmt section and yields its ID.
+*
+* @param	Fmt is a string literal in xil_printf() syntax.
+*
+* @return	The format string ID.
+*
+* @note		C-Style signature: u32 XIL_LOG_FMT(const char8 *Fmt)
+*
+******************************************************************************/
+#define XIL_LOG_FMT(Fmt)						\
+	({								\
+		static const char8 Xil_LogFmtStr[]			\
+		__attribute__((section(".xil_log_fmt"), used)) = Fmt;	\
+		(u32)Xil_LogFmtStr;					\
+	})
+
+/****************************************************************************/
+/**
+* Log a record with zero to four 32 bit arguments.
+*
+* @param	Fmt is a string literal in xil_printf() syntax.
+* @param	A0..A3 are the arguments, converted to u32.
+*
+* @return	None.
+*
+******************************************************************************/
+#define Xil_Log0(Fmt)	\
+	Xil_LogWrite(XIL_LOG_FMT(Fmt), 0U, 0U, 0U, 0U, 0U)
+#define Xil_Log1(Fmt, A0)	\
+	Xil_LogWrite(XIL_LOG_FMT(Fmt), 1U, (u32)(A0), 0U, 0U, 0U)
+#define Xil_Log2(Fmt, A0, A1)	\
+	Xil_LogWrite(XIL_LOG_FMT(Fmt), 2U, (u32)(A0), (u32)(A1), 0U, 0U)
+#define Xil_Log3(Fmt, A0, A1, A2)	\
+	Xil_LogWrite(XIL_LOG_FMT(Fmt), 3U, (u32)(A0), (u32)(A1), \
+			(u32)(A2), 0U)
+#define Xil_Log4(Fmt, A0, A1, A2, A3)	\
+	Xil_LogWrite(XIL_LOG_FMT(Fmt), 4U, (u32)(A0), (u32)(A1), \
+			(u32)(A2), (u32)(A3))
+
+/************************** Variable Definitions ****************************/
+
+extern Xil_LogCtrlBlock Xil_LogCtrl;
+
+/************************** Function Prototypes *****************************/
+
+void Xil_LogWrite(u32 FmtId, u32 NumArgs, u32 Arg0, u32 Arg1, u32 Arg2,
+		u32 Arg3);
+u32 Xil_LogDrain(Xil_LogOutHandler OutFn, u32 MaxRecords);
+void Xil_LogReset(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_LOG_H */
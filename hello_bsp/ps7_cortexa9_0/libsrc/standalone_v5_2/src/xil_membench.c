@@ -0,0 +1,351 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_membench.c
+*
+* Contains the memory bandwidth and latency measurements. See xil_membench.h
+* for a description.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_membench.h"
+#include "xil_mmu.h"
+#include "xil_printf.h"
+#include "xil_assert.h"
+#include "xpm_counter.h"
+#include "xparameters.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_MEMBENCH_CPU_MHZ	(XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 1000000U)
+
+/* Loads timed per latency point, after one pass to warm the caches */
+#define XIL_MEMBENCH_LOADS	(64U * 1024U)
+
+#define XIL_MEMBENCH_MIN_SET	1024U
+
+/* Section attributes of DDR in translation_table.S and non-cacheable */
+#define XIL_MEMBENCH_CACHED	0x15DE6U
+#define XIL_MEMBENCH_NONCACHED	0x14DE2U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#define XIL_MEMBENCH_MBPS(Bytes, Cycles) \
+	((u32)(((u64)(Bytes) * XIL_MEMBENCH_CPU_MHZ) / (Cycles)))
+
+/************************** Function Prototypes *****************************/
+
+static void Xil_MemBenchBuildChase(u32 *Nodes, u32 NumNodes);
+static void Xil_MemBenchPrintStream(const char *Name, INTPTR Addr, u32 Len);
+
+/************************** Variable Definitions ****************************/
+
+static volatile u32 MemBenchSink;
+
+/*****************************************************************************/
+/**
+*
+* Run the STREAM kernels on three arrays of doubles in a buffer.
+*
+* @param	Addr is the start of the buffer, 8 byte aligned.
+* @param	Len is the length of the buffer in bytes. To measure memory and
+*		not the caches, use at least four times the L2 size.
+* @param	Result is filled in with the best bandwidth of each kernel
+*		over XIL_MEMBENCH_STREAM_REPS runs.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_MemBenchStream(INTPTR Addr, u32 Len,
+			Xil_MemBenchStreamResult *Result)
+{
+	double *A = (double *)Addr;
+	u32 N = Len / (3U * sizeof(double));
+	double *B = A + N;
+	double *C = B + N;
+	const double Scalar = 3.0;
+	u32 Best[4] = { 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU };
+	u32 Cycles[4];
+	u32 Start;
+	u32 Rep;
+	u32 Kernel;
+	u32 Index;
+
+	Xil_AssertVoid(Result != NULL);
+	Xil_AssertVoid((Addr & 0x7U) == 0U);
+	Xil_AssertVoid(N != 0U);
+
+	for (Index = 0U; Index < N; Index++) {
+		A[Index] = 1.0;
+		B[Index] = 2.0;
+		C[Index] = 0.0;
+	}
+
+	Xpm_StartCycleCounter();
+
+	for (Rep = 0U; Rep < XIL_MEMBENCH_STREAM_REPS; Rep++) {
+		Start = Xpm_GetCycleCounter();
+		for (Index = 0U; Index < N; Index++) {
+			C[Index] = A[Index];
+		}
+		Cycles[0] = Xpm_GetCycleCounter() - Start;
+
+		Start = Xpm_GetCycleCounter();
+		for (Index = 0U; Index < N; Index++) {
+			B[Index] = Scalar * C[Index];
+		}
+		Cycles[1] = Xpm_GetCycleCounter() - Start;
+
+		Start = Xpm_GetCycleCounter();
+		for (Index = 0U; Index < N; Index++) {
+			C[Index] = A[Index] + B[Index];
+		}
+		Cycles[2] = Xpm_GetCycleCounter() - Start;
+
+		Start = Xpm_GetCycleCounter();
+		for (Index = 0U; Index < N; Index++) {
+			A[Index] = B[Index] + (Scalar * C[Index]);
+		}
+		Cycles[3] = Xpm_GetCycleCounter() - Start;
+
+		for (Kernel = 0U; Kernel < 4U; Kernel++) {
+			if ((Cycles[Kernel] != 0U) &&
+			    (Cycles[Kernel] < Best[Kernel])) {
+				Best[Kernel] = Cycles[Kernel];
+			}
+		}
+	}
+
+	/* Copy and scale move two arrays, add and triad three */
+	Result->Copy = XIL_MEMBENCH_MBPS(2U * N * sizeof(double), Best[0]);
+	Result->Scale = XIL_MEMBENCH_MBPS(2U * N * sizeof(double), Best[1]);
+	Result->Add = XIL_MEMBENCH_MBPS(3U * N * sizeof(double), Best[2]);
+	Result->Triad = XIL_MEMBENCH_MBPS(3U * N * sizeof(double), Best[3]);
+}
+
+/*****************************************************************************/
+/**
+*
+* Measure the load latency over a working set.
+*
+* @param	Addr is the start of the working set, 64 byte aligned.
+* @param	WorkingSet is the length of the working set in bytes, at least
+*		two nodes of XIL_MEMBENCH_NODE_SIZE bytes.
+*
+* @return	Latency of one load in tenths of a nanosecond.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 Xil_MemBenchLatency(INTPTR Addr, u32 WorkingSet)
+{
+	u32 *Nodes = (u32 *)Addr;
+	u32 NumNodes = WorkingSet / XIL_MEMBENCH_NODE_SIZE;
+	u32 Node = 0U;
+	u32 Index;
+	u32 Start;
+	u32 Cycles;
+
+	Xil_AssertNonvoid((Addr & (XIL_MEMBENCH_NODE_SIZE - 1U)) == 0U);
+	Xil_AssertNonvoid(NumNodes >= 2U);
+
+	Xil_MemBenchBuildChase(Nodes, NumNodes);
+	Xpm_StartCycleCounter();
+
+	/* Warm up, so that sets that fit a cache are timed from the cache */
+	for (Index = 0U; Index < NumNodes; Index++) {
+		Node = Nodes[Node];
+	}
+
+	Start = Xpm_GetCycleCounter();
+	for (Index = 0U; Index < XIL_MEMBENCH_LOADS; Index++) {
+		Node = Nodes[Node];
+	}
+	Cycles = Xpm_GetCycleCounter() - Start;
+	MemBenchSink = Node;
+
+	return (u32)(((u64)Cycles * 10000U) /
+		     ((u64)XIL_MEMBENCH_LOADS * XIL_MEMBENCH_CPU_MHZ));
+}
+
+/*****************************************************************************/
+/**
+*
+* Print the latency and the STREAM tables for a DDR and an OCM buffer.
+*
+* @param	DdrAddr is the start of the DDR buffer, 4 KB aligned.
+* @param	DdrLen is the length of the DDR buffer in bytes, a multiple of
+*		4 KB. It bounds the largest latency working set and is the
+*		STREAM length for cached DDR.
+* @param	OcmAddr is the start of the OCM buffer, 4 KB aligned.
+* @param	OcmLen is the length of the OCM buffer in bytes, a multiple of
+*		4 KB, or 0 to skip the OCM rows.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a buffer could not be mapped
+*		non-cacheable.
+*
+* @note		The buffers are mapped non-cacheable for their rows and back
+*		to write-back cacheable afterwards.
+*
+******************************************************************************/
+s32 Xil_MemBenchReport(INTPTR DdrAddr, u32 DdrLen, INTPTR OcmAddr,
+		       u32 OcmLen)
+{
+	u32 WorkingSet;
+	u32 Latency;
+	u32 UncachedLen;
+	s32 Status;
+
+	xil_printf("\r\nLoad latency, CPU at %d MHz\r\n", XIL_MEMBENCH_CPU_MHZ);
+	xil_printf("working set       ns  cycles\r\n");
+	for (WorkingSet = XIL_MEMBENCH_MIN_SET; WorkingSet <= DdrLen;
+	     WorkingSet *= 2U) {
+		Latency = Xil_MemBenchLatency(DdrAddr, WorkingSet);
+		xil_printf("%11d  %4d.%d  %6d\r\n", WorkingSet, Latency / 10U,
+			   Latency % 10U,
+			   (Latency * XIL_MEMBENCH_CPU_MHZ) / 10000U);
+	}
+
+	xil_printf("\r\nSTREAM, best of %d, MB/s\r\n", XIL_MEMBENCH_STREAM_REPS);
+	xil_printf("memory                 length   copy  scale    add  triad\r\n");
+	Xil_MemBenchPrintStream("DDR cached   ", DdrAddr, DdrLen);
+	if (OcmLen != 0U) {
+		Xil_MemBenchPrintStream("OCM cached   ", OcmAddr, OcmLen);
+	}
+
+	/* Without the caches, a short run is enough */
+	UncachedLen = (OcmLen < DdrLen) ? OcmLen : DdrLen;
+	if (OcmLen == 0U) {
+		UncachedLen = (DdrLen < 0x40000U) ? DdrLen : 0x40000U;
+	}
+
+	Status = Xil_SetTlbAttributesRange(DdrAddr, UncachedLen,
+					   XIL_MEMBENCH_NONCACHED);
+	if (Status != XST_SUCCESS) {
+		return XST_FAILURE;
+	}
+	Xil_MemBenchPrintStream("DDR uncached ", DdrAddr, UncachedLen);
+	(void)Xil_SetTlbAttributesRange(DdrAddr, UncachedLen,
+					XIL_MEMBENCH_CACHED);
+
+	if (OcmLen != 0U) {
+		Status = Xil_SetTlbAttributesRange(OcmAddr, OcmLen,
+						   XIL_MEMBENCH_NONCACHED);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Xil_MemBenchPrintStream("OCM uncached ", OcmAddr, OcmLen);
+		(void)Xil_SetTlbAttributesRange(OcmAddr, OcmLen,
+						XIL_MEMBENCH_CACHED);
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Link nodes into one random cycle with Sattolo's algorithm. The first word
+* of each node holds the word index of the next node.
+*
+* @param	Nodes is the start of the nodes.
+* @param	NumNodes is the number of nodes.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void Xil_MemBenchBuildChase(u32 *Nodes, u32 NumNodes)
+{
+	const u32 Words = XIL_MEMBENCH_NODE_SIZE / 4U;
+	u32 Seed = 0x2545F491U;
+	u32 Index;
+	u32 Other;
+	u32 Temp;
+
+	for (Index = 0U; Index < NumNodes; Index++) {
+		Nodes[Index * Words] = Index;
+	}
+
+	for (Index = NumNodes - 1U; Index > 0U; Index--) {
+		Seed = (Seed * 1664525U) + 1013904223U;
+		Other = (Seed >> 8) % Index;
+		Temp = Nodes[Index * Words];
+		Nodes[Index * Words] = Nodes[Other * Words];
+		Nodes[Other * Words] = Temp;
+	}
+
+	for (Index = 0U; Index < NumNodes; Index++) {
+		Nodes[Index * Words] *= Words;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Run the STREAM kernels on a buffer and print one table row.
+*
+* @param	Name is the name of the row.
+* @param	Addr is the start of the buffer.
+* @param	Len is the length of the buffer in bytes.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void Xil_MemBenchPrintStream(const char *Name, INTPTR Addr, u32 Len)
+{
+	Xil_MemBenchStreamResult Result;
+
+	Xil_MemBenchStream(Addr, Len, &Result);
+	xil_printf("%s  %9d  %5d  %5d  %5d  %5d\r\n", Name, Len, Result.Copy,
+		   Result.Scale, Result.Add, Result.Triad);
+}
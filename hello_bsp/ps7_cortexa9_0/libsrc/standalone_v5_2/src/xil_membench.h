@@ -0,0 +1,120 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_membench.h
+*
+* This file contains functions to measure the bandwidth and the latency of
+* the memory hierarchy, the L1 and L2 caches, the OCM and the DDR.
+*
+* <b>Measurements</b>
+*
+* <pre>
+* Xil_MemBenchStream:
+*       The copy, scale, add and triad kernels of STREAM on three arrays of
+*       doubles that share the given buffer. Each kernel runs a number of
+*       times and the best time gives the bandwidth, with the bytes read and
+*       written counted as in STREAM.
+*
+* Xil_MemBenchLatency:
+*       Chases pointers through a random cycle of nodes, one per 64 byte
+*       line, over a working set. Every load depends on the one before and
+*       the order defeats the prefetchers, so the time per load is the load
+*       latency of the level the working set fits in.
+*
+* Xil_MemBenchReport:
+*       Prints over stdout a latency table for working sets from 1 KB to the
+*       DDR buffer size, and a STREAM table for the DDR and the OCM buffers,
+*       cached and mapped non-cacheable.
+* </pre>
+*
+* Times are taken with the PMU cycle counter of the calling CPU, which the
+* functions start if it is stopped but never reset, so that measurements
+* in progress elsewhere are kept. The working sets are written, so the
+* buffers must hold no data of value.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_MEMBENCH_H /* prevent circular inclusions */
+#define XIL_MEMBENCH_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_MEMBENCH_STREAM_REPS	5U
+#define XIL_MEMBENCH_NODE_SIZE		64U
+
+/**************************** Type Definitions ******************************/
+
+/**
+ * Bandwidth of the STREAM kernels in MB/s
+ */
+typedef struct {
+	u32 Copy;	/**< c = a */
+	u32 Scale;	/**< b = s * c */
+	u32 Add;	/**< c = a + b */
+	u32 Triad;	/**< a = b + s * c */
+} Xil_MemBenchStreamResult;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions ****************************/
+
+/************************** Function Prototypes *****************************/
+
+void Xil_MemBenchStream(INTPTR Addr, u32 Len,
+			Xil_MemBenchStreamResult *Result);
+u32 Xil_MemBenchLatency(INTPTR Addr, u32 WorkingSet);
+s32 Xil_MemBenchReport(INTPTR DdrAddr, u32 DdrLen, INTPTR OcmAddr,
+		       u32 OcmLen);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_MEMBENCH_H */
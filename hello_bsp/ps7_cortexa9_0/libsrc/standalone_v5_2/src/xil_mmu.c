@@ -55,6 +55,11 @@
 * 3.11a  asa 09/23/13 Modified Xil_SetTlbAttributes to flush the complete
 *			 D cache after the translation table update. Removed the
 *			 redundant TLB invalidation in the same API at the beginning.
+* 5.2   ag   10/18/26 Added Xil_SetTlbAttributesRange, which maps parts of a
+*		      section with 4 KB pages from second level tables, cleans
+*		      only the changed descriptors, flushes only the range and
+*		      invalidates the TLB by MVA. Xil_SetTlbAttributes uses it
+*		      for its section.
 * </pre>
 *
 * @note
@@ -70,19 +75,42 @@
 #include "xil_types.h"
 #include "xil_mmu.h"
 #include "xil_errata.h"
+#include "xstatus.h"
+#include "xil_assert.h"
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
+#define Xil_MmuIsPageTable(Desc)	(((Desc) & 0x3U) == 0x1U)
+
 /**************************** Type Definitions *******************************/
 
 /************************** Constant Definitions *****************************/
 
+#define XIL_MMU_PAGES_PER_SECTION	256U
+#define XIL_MMU_SECTION_MASK		0xFFF00000U
+#define XIL_MMU_PAGE_MASK		0xFFFFF000U
+#define XIL_MMU_TABLE_BASE_MASK		0xFFFFFC00U
+#define XIL_MMU_DOMAIN_MASK		0x000001E0U
+
+/*
+ * Above this many pages the whole TLB is invalidated instead of by MVA
+ */
+#define XIL_MMU_TLB_MVA_MAX		64U
+
 /************************** Variable Definitions *****************************/
 
 extern u32 MMUTable;
 
+static u32 MmuPageTables[XIL_MMU_NUM_PAGE_TABLES][XIL_MMU_PAGES_PER_SECTION]
+	__attribute__ ((aligned(1024)));
+static u8 MmuPageTableUsed[XIL_MMU_NUM_PAGE_TABLES];
+
 /************************** Function Prototypes ******************************/
 
+static u32 Xil_MmuSectionToPage(u32 attrib);
+static s32 Xil_MmuFindPageTable(void);
+static u32 *Xil_MmuSplitSection(u32 *SectionPtr, u32 Section);
+
 /*****************************************************************************
 *
 * Set the memory attributes for a section, in the translation table. Each
@@ -94,29 +122,268 @@ extern u32 MMUTable;
 * @return	None.
 *
 * @note		The MMU and D-cache need not be disabled before changing an
-*		translation table attribute.
+*		translation table attribute. A section mapped with 4 KB pages
+*		is mapped as one section again.
 *
 ******************************************************************************/
 void Xil_SetTlbAttributes(INTPTR Addr, u32 attrib)
 {
-	u32 *ptr;
-	u32 section;
-
-	section = Addr / 0x100000U;
-	ptr = &MMUTable;
-	ptr += section;
-	if(ptr != NULL) {
-		*ptr = (Addr & 0xFFF00000U) | attrib;
+	(void)Xil_SetTlbAttributesRange(Addr & XIL_MMU_SECTION_MASK,
+					XIL_MMU_SECTION_SIZE, attrib);
+}
+
+/*****************************************************************************
+*
+* Set the memory attributes for a range of 4 KB pages, in the translation
+* table.
+*
+* Sections covered completely by the range are written as sections. The
+* pages of a partly covered section are mapped through a second level table
+* from a pool of XIL_MMU_NUM_PAGE_TABLES, which is taken when the section is
+* first split and given back when the whole section is set again.
+*
+* All descriptors are updated before the changed ones are cleaned to memory
+* in one Xil_DCacheMaintainList call and the range is flushed. The TLB is
+* then invalidated by MVA for each page of the range, or completely for
+* ranges of more than XIL_MMU_TLB_MVA_MAX pages.
+*
+* @param	Addr is the start of the range, 4 KB aligned.
+* @param	Size is the length of the range in bytes, a multiple of 4 KB.
+* @param	attrib specifies the attributes in the format of a section
+*		descriptor, as for Xil_SetTlbAttributes. For pages the
+*		domain and the NS bit are those of the split section.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if not enough second level tables
+*		are free, in which case the table is not changed.
+*
+* @note		Not reentrant, call from one thread.
+*
+******************************************************************************/
+s32 Xil_SetTlbAttributesRange(INTPTR Addr, u32 Size, u32 attrib)
+{
+	Xil_CacheListEntry CacheList[3];
+	u32 CacheCount = 0U;
+	u32 *TablePtr = &MMUTable;
+	u32 *PagePtr;
+	u32 Start = (u32)Addr;
+	u32 Last;
+	u32 FirstSection;
+	u32 LastSection;
+	u32 Section;
+	u32 PageLo;
+	u32 PageHi;
+	u32 Page;
+	u32 PageAttr;
+	u32 Needed = 0U;
+	u32 Free = 0U;
+	u32 Index;
+	u32 Va;
+	u32 NumPages;
+
+	Xil_AssertNonvoid((Start & (XIL_MMU_PAGE_SIZE - 1U)) == 0U);
+	Xil_AssertNonvoid((Size & (XIL_MMU_PAGE_SIZE - 1U)) == 0U);
+	Xil_AssertNonvoid(Size != 0U);
+
+	Last = Start + (Size - 1U);
+	FirstSection = Start / XIL_MMU_SECTION_SIZE;
+	LastSection = Last / XIL_MMU_SECTION_SIZE;
+	NumPages = Size / XIL_MMU_PAGE_SIZE;
+	PageAttr = Xil_MmuSectionToPage(attrib);
+
+	/*
+	 * Only the first and the last section can be partly covered, check
+	 * that they get a second level table before changing anything.
+	 */
+	if (((Start & ~XIL_MMU_SECTION_MASK) != 0U) &&
+	    !Xil_MmuIsPageTable(TablePtr[FirstSection])) {
+		Needed++;
+	}
+	if (((Last & ~XIL_MMU_SECTION_MASK) != ~XIL_MMU_SECTION_MASK) &&
+	    !Xil_MmuIsPageTable(TablePtr[LastSection]) &&
+	    ((LastSection != FirstSection) || (Needed == 0U))) {
+		Needed++;
+	}
+	for (Index = 0U; Index < XIL_MMU_NUM_PAGE_TABLES; Index++) {
+		if (MmuPageTableUsed[Index] == 0U) {
+			Free++;
+		}
+	}
+	if (Needed > Free) {
+		return XST_FAILURE;
 	}
 
-	Xil_DCacheFlush();
+	for (Section = FirstSection; Section <= LastSection; Section++) {
+		PageLo = (Section == FirstSection) ?
+			 ((Start / XIL_MMU_PAGE_SIZE) % XIL_MMU_PAGES_PER_SECTION) :
+			 0U;
+		PageHi = (Section == LastSection) ?
+			 ((Last / XIL_MMU_PAGE_SIZE) % XIL_MMU_PAGES_PER_SECTION) :
+			 (XIL_MMU_PAGES_PER_SECTION - 1U);
 
-	mtcp(XREG_CP15_INVAL_UTLB_UNLOCKED, 0U);
+		if ((PageLo == 0U) &&
+		    (PageHi == (XIL_MMU_PAGES_PER_SECTION - 1U))) {
+			/* Whole section, give back its second level table */
+			if (Xil_MmuIsPageTable(TablePtr[Section])) {
+				PagePtr = (u32 *)(TablePtr[Section] &
+						  XIL_MMU_TABLE_BASE_MASK);
+				MmuPageTableUsed[(PagePtr - &MmuPageTables[0][0]) /
+						 XIL_MMU_PAGES_PER_SECTION] = 0U;
+			}
+			TablePtr[Section] = (Section * XIL_MMU_SECTION_SIZE) |
+					    attrib;
+			continue;
+		}
+
+		if (Xil_MmuIsPageTable(TablePtr[Section])) {
+			PagePtr = (u32 *)(TablePtr[Section] &
+					  XIL_MMU_TABLE_BASE_MASK);
+		} else {
+			PagePtr = Xil_MmuSplitSection(TablePtr, Section);
+		}
+
+		for (Page = PageLo; Page <= PageHi; Page++) {
+			PagePtr[Page] = (PageAttr == 0U) ? 0U :
+				((Section * XIL_MMU_SECTION_SIZE) +
+				 (Page * XIL_MMU_PAGE_SIZE)) | PageAttr;
+		}
+		CacheList[CacheCount].Addr = (INTPTR)&PagePtr[PageLo];
+		CacheList[CacheCount].Len = (PageHi - PageLo + 1U) * 4U;
+		CacheList[CacheCount].Op = XIL_CACHE_OP_STORE;
+		CacheCount++;
+	}
+
+	CacheList[CacheCount].Addr = (INTPTR)&TablePtr[FirstSection];
+	CacheList[CacheCount].Len = (LastSection - FirstSection + 1U) * 4U;
+	CacheList[CacheCount].Op = XIL_CACHE_OP_STORE;
+	CacheCount++;
+
+	Xil_DCacheMaintainList(CacheList, CacheCount);
+	Xil_DCacheFlushRange((INTPTR)Start, Size);
+
+	if (NumPages > XIL_MMU_TLB_MVA_MAX) {
+#if USE_SMP==1
+		mtcp(XREG_CP15_INVAL_TLB_IS, 0U);
+#else
+		mtcp(XREG_CP15_INVAL_UTLB_UNLOCKED, 0U);
+#endif
+	} else {
+		Va = Start;
+		for (Page = 0U; Page < NumPages; Page++) {
+#if USE_SMP==1
+			mtcp(XREG_CP15_INVAL_TLB_MVA_IS, Va);
+#else
+			mtcp(XREG_CP15_INVAL_UTLB_MVA, Va);
+#endif
+			Va += XIL_MMU_PAGE_SIZE;
+		}
+	}
 	/* Invalidate all branch predictors */
 	mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0U);
 
 	dsb(); /* ensure completion of the BP and TLB invalidation */
-    isb(); /* synchronize context on this processor */
+	isb(); /* synchronize context on this processor */
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************
+*
+* Convert the attributes of a section descriptor to those of a small page
+* descriptor.
+*
+* @param	attrib is the section descriptor without the base address.
+*
+* @return	Small page descriptor without the base address, 0 for a fault
+*		entry.
+*
+******************************************************************************/
+static u32 Xil_MmuSectionToPage(u32 attrib)
+{
+	u32 Page;
+
+	if ((attrib & 0x3U) == 0U) {
+		return 0U;
+	}
+
+	Page = 0x2U;				/* Small page */
+	Page |= attrib & 0xCU;			/* C, B */
+	Page |= (attrib >> 4U) & 0x1U;		/* XN */
+	Page |= ((attrib >> 10U) & 0x3U) << 4U;	/* AP[1:0] */
+	Page |= ((attrib >> 12U) & 0x7U) << 6U;	/* TEX */
+	Page |= ((attrib >> 15U) & 0x1U) << 9U;	/* AP[2] */
+	Page |= ((attrib >> 16U) & 0x1U) << 10U;	/* S */
+	Page |= ((attrib >> 17U) & 0x1U) << 11U;	/* nG */
+
+	return Page;
+}
+
+/*****************************************************************************
+*
+* Find a free second level table.
+*
+* @param	None.
+*
+* @return	Index of the table, or -1 if all are in use.
+*
+******************************************************************************/
+static s32 Xil_MmuFindPageTable(void)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < XIL_MMU_NUM_PAGE_TABLES; Index++) {
+		if (MmuPageTableUsed[Index] == 0U) {
+			return (s32)Index;
+		}
+	}
+
+	return -1;
+}
+
+/*****************************************************************************
+*
+* Map a section through a second level table with the same attributes, so
+* that its pages can be changed one by one.
+*
+* @param	TablePtr is the first level table.
+* @param	Section is the section number.
+*
+* @return	The second level table.
+*
+* @note		The caller has checked that a table is free. The table is
+*		cleaned to memory before the first level entry points to it,
+*		the TLB need not be invalidated as the mapping is unchanged.
+*
+******************************************************************************/
+static u32 *Xil_MmuSplitSection(u32 *TablePtr, u32 Section)
+{
+	u32 Desc = TablePtr[Section];
+	u32 PageAttr = Xil_MmuSectionToPage(Desc & ~XIL_MMU_SECTION_MASK);
+	u32 *PagePtr;
+	u32 Page;
+	s32 Index;
+	Xil_CacheListEntry CacheEntry;
+
+	Index = Xil_MmuFindPageTable();
+	Xil_AssertNonvoid(Index >= 0);
+	MmuPageTableUsed[Index] = 1U;
+	PagePtr = &MmuPageTables[Index][0];
+
+	for (Page = 0U; Page < XIL_MMU_PAGES_PER_SECTION; Page++) {
+		PagePtr[Page] = (PageAttr == 0U) ? 0U :
+			((Section * XIL_MMU_SECTION_SIZE) +
+			 (Page * XIL_MMU_PAGE_SIZE)) | PageAttr;
+	}
+
+	CacheEntry.Addr = (INTPTR)PagePtr;
+	CacheEntry.Len = XIL_MMU_PAGES_PER_SECTION * 4U;
+	CacheEntry.Op = XIL_CACHE_OP_STORE;
+	Xil_DCacheMaintainList(&CacheEntry, 1U);
+
+	/* Page table descriptor with the domain and NS bit of the section */
+	TablePtr[Section] = (u32)PagePtr | (Desc & XIL_MMU_DOMAIN_MASK) |
+			    (((Desc >> 19U) & 0x1U) << 3U) | 0x1U;
+
+	return PagePtr;
 }
 
 /*****************************************************************************
@@ -43,6 +43,7 @@
 * 1.00a sdm  01/12/12 Initial version
 * 4.2	pkp	 07/21/14 Included xil_types.h file which contains definition for
 *					  u32 which resolves issue of CR#805869
+* 5.2   ag   10/18/26 Added Xil_SetTlbAttributesRange for 4 KB pages.
 * </pre>
 *
 * @note
@@ -68,11 +69,22 @@ extern "C" {
 
 /************************** Constant Definitions *****************************/
 
+#define XIL_MMU_SECTION_SIZE	0x100000U
+#define XIL_MMU_PAGE_SIZE	0x1000U
+
+/*
+ * Number of second level tables, each maps one 1 MB section with 4 KB pages
+ */
+#ifndef XIL_MMU_NUM_PAGE_TABLES
+#define XIL_MMU_NUM_PAGE_TABLES	16U
+#endif
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes ******************************/
 
 void Xil_SetTlbAttributes(INTPTR Addr, u32 attrib);
+s32 Xil_SetTlbAttributesRange(INTPTR Addr, u32 Size, u32 attrib);
 void Xil_EnableMMU(void);
 void Xil_DisableMMU(void);
 
@@ -0,0 +1,326 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_outbuf.c
+*
+* This file contains the buffered stdout backend used by outbyte(). See
+* xil_outbuf.h for a description of its operation.
+*
+* The ring indices are free running; the number of buffered characters is
+* Head - Tail. Producers run with IRQ masked so that characters written from
+* task and interrupt context cannot interleave inside the ring and so that
+* the interrupt handler never sees a half updated index.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_outbuf.h"
+#include "xparameters.h"
+#include "xil_exception.h"
+#include "xstatus.h"
+#include "xuartps_hw.h"
+
+#ifdef STDOUT_BASEADDRESS
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_OUTBUF_FIFO_DEPTH	64U	/* TX FIFO size of the PS UART */
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+static void Xil_OutBufDrain(void);
+
+/************************** Variable Definitions ****************************/
+
+u32 Xil_OutBufEnabled = 0U;
+
+static u8 *OutBufPtr;
+static u32 OutBufMask;
+static u32 OutBufPolicy;
+static volatile u32 OutBufHead;
+static volatile u32 OutBufTail;
+static volatile u32 OutBufLost;
+
+/****************************************************************************/
+/**
+*
+* Switches stdout to the buffered backend. From now on characters are queued
+* in the given ring and sent from the UART TX-empty interrupt; the caller
+* must connect Xil_OutBufIntrHandler() to the interrupt of the stdout UART
+* and enable it in the interrupt controller.
+*
+* @param	BufPtr is the ring storage. It must stay valid until
+*		Xil_OutBufDisable() is called.
+* @param	Size is the size of the ring in bytes, a power of two.
+* @param	Policy is XIL_OUTBUF_DROP, XIL_OUTBUF_OVERWRITE or
+*		XIL_OUTBUF_BLOCK and selects what happens when the ring is full.
+*
+* @return
+*		- XST_SUCCESS if the backend is enabled.
+*		- XST_INVALID_PARAM if a parameter is out of range.
+*
+* @note		None.
+*
+****************************************************************************/
+s32 Xil_OutBufInit(u8 *BufPtr, u32 Size, u32 Policy)
+{
+	if ((BufPtr == NULL) || (Size == 0U) ||
+	    ((Size & (Size - 1U)) != 0U) || (Policy > XIL_OUTBUF_BLOCK)) {
+		return XST_INVALID_PARAM;
+	}
+
+	Xil_OutBufDisable();
+
+	OutBufPtr = BufPtr;
+	OutBufMask = Size - 1U;
+	OutBufPolicy = Policy;
+	OutBufHead = 0U;
+	OutBufTail = 0U;
+	OutBufLost = 0U;
+	Xil_OutBufEnabled = 1U;
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* Sends out all buffered characters and switches stdout back to synchronous
+* output.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_OutBufDisable(void)
+{
+	if (Xil_OutBufEnabled != 0U) {
+		Xil_OutBufFlush();
+		Xil_OutBufEnabled = 0U;
+		XUartPs_WriteReg(STDOUT_BASEADDRESS, XUARTPS_IDR_OFFSET,
+				XUARTPS_IXR_TXEMPTY);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Queues one character for output. If nothing is buffered and the TX FIFO
+* has room the character goes straight to the FIFO, otherwise it is put in
+* the ring and the TX-empty interrupt is enabled.
+*
+* @param	Data is the character to send.
+*
+* @return	None.
+*
+* @note		Called by outbyte() once the backend is enabled.
+*
+****************************************************************************/
+void Xil_OutBufPut(u8 Data)
+{
+	u32 Cpsr;
+	u32 Head;
+
+	Cpsr = mfcpsr();
+	mtcpsr(Cpsr | XIL_EXCEPTION_IRQ);
+
+	Head = OutBufHead;
+	if (Head == OutBufTail) {
+		if (!XUartPs_IsTransmitFull(STDOUT_BASEADDRESS)) {
+			XUartPs_WriteReg(STDOUT_BASEADDRESS,
+					XUARTPS_FIFO_OFFSET, (u32)Data);
+			goto RETURN_PATH;
+		}
+		/*
+		 * The FIFO is full, so it is guaranteed to signal TX-empty
+		 * again once it has drained.
+		 */
+		XUartPs_WriteReg(STDOUT_BASEADDRESS, XUARTPS_IER_OFFSET,
+				XUARTPS_IXR_TXEMPTY);
+	} else if ((Head - OutBufTail) > OutBufMask) {
+		if (OutBufPolicy == XIL_OUTBUF_DROP) {
+			OutBufLost++;
+			goto RETURN_PATH;
+		} else if (OutBufPolicy == XIL_OUTBUF_OVERWRITE) {
+			OutBufTail++;
+			OutBufLost++;
+		} else {
+			while ((Head - OutBufTail) > OutBufMask) {
+				Xil_OutBufDrain();
+			}
+		}
+	} else {
+		/* Ring is neither empty nor full */
+	}
+
+	OutBufPtr[Head & OutBufMask] = Data;
+	OutBufHead = Head + 1U;
+
+RETURN_PATH:
+	mtcpsr(Cpsr);
+}
+
+/****************************************************************************/
+/**
+*
+* TX-empty interrupt handler of the stdout UART. Refills the TX FIFO from the
+* ring and disables the interrupt once the ring is empty.
+*
+* @param	CallBackRef is unused.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_OutBufIntrHandler(void *CallBackRef)
+{
+	u32 IsrStatus;
+	u32 Count;
+
+	(void)CallBackRef;
+
+	IsrStatus = XUartPs_ReadReg(STDOUT_BASEADDRESS, XUARTPS_IMR_OFFSET) &
+		XUartPs_ReadReg(STDOUT_BASEADDRESS, XUARTPS_ISR_OFFSET);
+	XUartPs_WriteReg(STDOUT_BASEADDRESS, XUARTPS_ISR_OFFSET, IsrStatus);
+
+	if ((XUartPs_ReadReg(STDOUT_BASEADDRESS, XUARTPS_SR_OFFSET) &
+			XUARTPS_SR_TXEMPTY) != 0U) {
+		/* The whole FIFO is free, fill it without polling */
+		Count = 0U;
+		while ((OutBufHead != OutBufTail) &&
+				(Count < XIL_OUTBUF_FIFO_DEPTH)) {
+			XUartPs_WriteReg(STDOUT_BASEADDRESS,
+				XUARTPS_FIFO_OFFSET,
+				(u32)OutBufPtr[OutBufTail & OutBufMask]);
+			OutBufTail++;
+			Count++;
+		}
+	} else {
+		Xil_OutBufDrain();
+	}
+
+	if (OutBufHead == OutBufTail) {
+		XUartPs_WriteReg(STDOUT_BASEADDRESS, XUARTPS_IDR_OFFSET,
+				XUARTPS_IXR_TXEMPTY);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Waits until every buffered character has left the UART. Works with
+* interrupts enabled or disabled.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+void Xil_OutBufFlush(void)
+{
+	u32 Cpsr;
+
+	while (OutBufHead != OutBufTail) {
+		Cpsr = mfcpsr();
+		mtcpsr(Cpsr | XIL_EXCEPTION_IRQ);
+		Xil_OutBufDrain();
+		mtcpsr(Cpsr);
+	}
+
+	while ((XUartPs_ReadReg(STDOUT_BASEADDRESS, XUARTPS_SR_OFFSET) &
+			XUARTPS_SR_TXEMPTY) == 0U) {
+		;
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* Returns the number of characters discarded because the ring was full.
+*
+* @param	None.
+*
+* @return	The number of lost characters since Xil_OutBufInit().
+*
+* @note		None.
+*
+****************************************************************************/
+u32 Xil_OutBufGetLost(void)
+{
+	return OutBufLost;
+}
+
+/****************************************************************************/
+/**
+*
+* Moves characters from the ring into the TX FIFO until either the ring is
+* empty or the FIFO is full. Must be called with IRQ masked.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+****************************************************************************/
+static void Xil_OutBufDrain(void)
+{
+	while ((OutBufHead != OutBufTail) &&
+			!XUartPs_IsTransmitFull(STDOUT_BASEADDRESS)) {
+		XUartPs_WriteReg(STDOUT_BASEADDRESS, XUARTPS_FIFO_OFFSET,
+				(u32)OutBufPtr[OutBufTail & OutBufMask]);
+		OutBufTail++;
+	}
+}
+
+#endif /* STDOUT_BASEADDRESS */
@@ -0,0 +1,112 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_outbuf.h
+*
+* This header file contains the interface of the buffered stdout backend.
+*
+* By default outbyte() writes every character synchronously into the TX FIFO
+* of the stdout UART and spins while the FIFO is full, so a single
+* xil_printf() of a few dozen characters costs milliseconds at 115200 baud.
+* Once Xil_OutBufInit() has been called outbyte(), and with it xil_printf(),
+* print() and write(), only copies the character into a RAM ring. The ring is
+* drained into the TX FIFO from the UART TX-empty interrupt, which the
+* application connects to Xil_OutBufIntrHandler().
+*
+* When the ring is full the policy given to Xil_OutBufInit() applies:
+* <pre>
+* XIL_OUTBUF_DROP:      the new character is discarded.
+* XIL_OUTBUF_OVERWRITE: the oldest buffered character is discarded.
+* XIL_OUTBUF_BLOCK:     the caller moves characters from the ring into the
+*                       TX FIFO itself, polling, until there is room.
+* </pre>
+* Characters discarded by the first two policies are counted and can be read
+* with Xil_OutBufGetLost().
+*
+* The stdout UART must be dedicated to this backend; its interrupt must not
+* be handled by the XUartPs driver at the same time. Call Xil_OutBufFlush()
+* before anything that stops interrupt processing, such as a reset.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_OUTBUF_H /* prevent circular inclusions */
+#define XIL_OUTBUF_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * Policies applied when a character is written into a full ring.
+ */
+#define XIL_OUTBUF_DROP		0U
+#define XIL_OUTBUF_OVERWRITE	1U
+#define XIL_OUTBUF_BLOCK	2U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions ****************************/
+
+extern u32 Xil_OutBufEnabled;
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_OutBufInit(u8 *BufPtr, u32 Size, u32 Policy);
+void Xil_OutBufDisable(void);
+void Xil_OutBufPut(u8 Data);
+void Xil_OutBufIntrHandler(void *CallBackRef);
+void Xil_OutBufFlush(void);
+u32 Xil_OutBufGetLost(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_OUTBUF_H */
@@ -12,9 +12,14 @@
 #include <string.h>
 #include <stdarg.h>
 
-static void padding( const s32 l_flag,const struct params_s *par);
+static void outc( const char8 c, struct params_s *par);
+static void padding( const s32 l_flag, struct params_s *par);
 static void outs(const charptr lp, struct params_s *par);
+static void outnum( const s32 n, const s32 base, struct params_s *par);
+static void outnum64( const s64 n, const s32 base, struct params_s *par);
 static s32 getnum( charptr* linep);
+static s32 xil_format( struct params_s *out, const char8 *ctrl1,
+			va_list argp);
 
 typedef struct params_s {
     s32 len;
@@ -24,6 +29,9 @@ typedef struct params_s {
     s32 do_padding;
     s32 left_flag;
     s32 unsigned_flag;
+    char8 *buf;		/* NULL: output goes to outbyte()        */
+    u32 size;		/* size of buf including the terminator  */
+    u32 count;		/* characters produced so far            */
 } params_t;
 
 
@@ -36,21 +44,40 @@ typedef struct params_s {
 /*---------------------------------------------------*/
 
 
+/*---------------------------------------------------*/
+/*                                                   */
+/* This routine emits one character, either through  */
+/* outbyte() or into the caller's buffer. Characters */
+/* that do not fit in the buffer are counted only.   */
+/*                                                   */
+static void outc( const char8 c, struct params_s *par)
+{
+    if (par->buf != NULL) {
+        if ((par->count + 1U) < par->size) {
+            par->buf[par->count] = c;
+        }
+    }
+    else {
+#ifdef STDOUT_BASEADDRESS
+        outbyte(c);
+#endif
+    }
+    par->count++;
+}
+
 /*---------------------------------------------------*/
 /*                                                   */
 /* This routine puts pad characters into the output  */
 /* buffer.                                           */
 /*                                                   */
-static void padding( const s32 l_flag, const struct params_s *par)
+static void padding( const s32 l_flag, struct params_s *par)
 {
     s32 i;
 
     if ((par->do_padding != 0) && (l_flag != 0) && (par->len < par->num1)) {
 		i=(par->len);
         for (; i<(par->num1); i++) {
-#ifdef STDOUT_BASEADDRESS
-            outbyte( par->pad_character);
-#endif
+            outc( par->pad_character, par);
 		}
     }
 }
@@ -73,10 +100,8 @@ static void outs(const charptr lp, struct params_s *par)
     /* Move string to the buffer                     */
     while (((*LocalPtr) != (char8)0) && ((par->num2) != 0)) {
 		(par->num2)--;
-#ifdef STDOUT_BASEADDRESS
-        outbyte(*LocalPtr);
+        outc(*LocalPtr, par);
 		LocalPtr += 1;
-#endif
 }
 
     /* Pad on right if needed                        */
@@ -134,10 +159,60 @@ static void outnum( const s32 n, const s32 base, struct params_s *par)
     par->len = (s32)strlen(outbuf);
     padding( !(par->left_flag), par);
     while (&outbuf[i] >= outbuf) {
-#ifdef STDOUT_BASEADDRESS
-	outbyte( outbuf[i] );
+	outc( outbuf[i], par );
+		i--;
+}
+    padding( par->left_flag, par);
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* 64 bit version of outnum, used for the ll length  */
+/* modifier. Kept separate so that the common 32 bit */
+/* conversions do not pay for 64 bit divisions.      */
+/*                                                   */
+
+static void outnum64( const s64 n, const s32 base, struct params_s *par)
+{
+    s32 negative;
+	s32 i;
+    char8 outbuf[32];
+    const char8 digits[] = "0123456789ABCDEF";
+    u64 num;
+
+    /* Check if number is negative                   */
+    if ((par->unsigned_flag == 0) && (base == 10) && (n < 0)) {
+        negative = 1;
+		num = (u64)(-(n));
+    }
+    else{
+        num = (u64)n;
+        negative = 0;
+    }
+
+    /* Build number (backwards) in outbuf            */
+    i = 0;
+    do {
+		outbuf[i] = digits[(num % (u64)base)];
+		i++;
+		num /= (u64)base;
+    } while (num > 0U);
+
+    if (negative != 0) {
+		outbuf[i] = '-';
+		i++;
+	}
+
+    outbuf[i] = 0;
+    i--;
+
+    /* Move the converted number to the buffer and   */
+    /* add in the padding where needed.              */
+    par->len = (s32)strlen(outbuf);
+    padding( !(par->left_flag), par);
+    while (&outbuf[i] >= outbuf) {
+	outc( outbuf[i], par );
 		i--;
-#endif
 }
     padding( par->left_flag, par);
 }
@@ -187,6 +262,79 @@ static s32 getnum( charptr* linep)
 /* void esp_printf( const func_ptr f_ptr,
    const charptr ctrl1, ...) */
 void xil_printf( const char8 *ctrl1, ...)
+{
+    va_list argp;
+
+    va_start( argp, ctrl1);
+    xil_vprintf( ctrl1, argp);
+    va_end( argp);
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* xil_printf taking a va_list.                      */
+/*                                                   */
+void xil_vprintf( const char8 *ctrl1, va_list argp)
+{
+    params_t out;
+
+    out.buf = NULL;
+    out.size = 0U;
+    out.count = 0U;
+    (void)xil_format( &out, ctrl1, argp);
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* These routines format like xil_printf but write   */
+/* into buf, never more than size characters         */
+/* including the terminating NUL. The return value   */
+/* is the length the complete output would have, so  */
+/* a return value of size or more means truncation.  */
+/* No device I/O is done.                            */
+/*                                                   */
+s32 xil_snprintf( char8 *buf, u32 size, const char8 *ctrl1, ...)
+{
+    s32 len;
+    va_list argp;
+
+    va_start( argp, ctrl1);
+    len = xil_vsnprintf( buf, size, ctrl1, argp);
+    va_end( argp);
+
+    return len;
+}
+
+s32 xil_vsnprintf( char8 *buf, u32 size, const char8 *ctrl1, va_list argp)
+{
+    params_t out;
+    static char8 dummy;
+
+    /* A zero size buffer only counts; never write to it */
+    out.buf = (size != 0U) ? buf : &dummy;
+    out.size = size;
+    out.count = 0U;
+    (void)xil_format( &out, ctrl1, argp);
+
+    if (size != 0U) {
+        if (out.count < size) {
+            buf[out.count] = (char8)0;
+        }
+        else {
+            buf[size - 1U] = (char8)0;
+        }
+    }
+
+    return (s32)out.count;
+}
+
+/*---------------------------------------------------*/
+/*                                                   */
+/* The formatting engine shared by all of the above. */
+/* Returns the number of characters produced.        */
+/*                                                   */
+static s32 xil_format( struct params_s *out, const char8 *ctrl1,
+			va_list argp)
 {
 	s32 Check;
     s32 long_flag;
@@ -195,20 +343,19 @@ void xil_printf( const char8 *ctrl1, ...)
     params_t par;
 
     char8 ch;
-    va_list argp;
     char8 *ctrl = (char8 *)ctrl1;
 
-    va_start( argp, ctrl1);
+    par.buf = out->buf;
+    par.size = out->size;
+    par.count = 0U;
 
     while ((ctrl != NULL) && (*ctrl != (char8)0)) {
 
         /* move format string chars to buffer until a  */
         /* format control is found.                    */
         if (*ctrl != '%') {
-#ifdef STDOUT_BASEADDRESS
-            outbyte(*ctrl);
+            outc(*ctrl, &par);
 			ctrl += 1;
-#endif
             continue;
         }
 
@@ -255,9 +402,7 @@ void xil_printf( const char8 *ctrl1, ...)
 
         switch (tolower((s32)ch)) {
             case '%':
-#ifdef STDOUT_BASEADDRESS
-                outbyte( '%');
-#endif
+                outc( '%', &par);
                 Check = 1;
                 break;
 
@@ -272,7 +417,7 @@ void xil_printf( const char8 *ctrl1, ...)
                 break;
 
             case 'l':
-                long_flag = 1;
+                long_flag++;
                 Check = 0;
                 break;
 
@@ -281,7 +426,10 @@ void xil_printf( const char8 *ctrl1, ...)
                 /* fall through */
             case 'i':
             case 'd':
-                if ((long_flag != 0) || (ch == 'D')) {
+                if (long_flag > 1) {
+                    outnum64( va_arg(argp, s64), 10L, &par);
+                }
+                else if ((long_flag != 0) || (ch == 'D')) {
                     outnum( va_arg(argp, s32), 10L, &par);
                 }
                 else {
@@ -293,7 +441,12 @@ void xil_printf( const char8 *ctrl1, ...)
             case 'X':
             case 'x':
                 par.unsigned_flag = 1;
-                outnum((s32)va_arg(argp, s32), 16L, &par);
+                if (long_flag > 1) {
+                    outnum64( va_arg(argp, s64), 16L, &par);
+                }
+                else {
+                    outnum((s32)va_arg(argp, s32), 16L, &par);
+                }
                 Check = 1;
                 break;
 
@@ -303,39 +456,27 @@ void xil_printf( const char8 *ctrl1, ...)
                 break;
 
             case 'c':
-#ifdef STDOUT_BASEADDRESS
-                outbyte( va_arg( argp, s32));
-#endif
+                outc( (char8)va_arg( argp, s32), &par);
                 Check = 1;
                 break;
 
             case '\\':
                 switch (*ctrl) {
                     case 'a':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x07));
-#endif
+                        outc( ((char8)0x07), &par);
                         break;
                     case 'h':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x08));
-#endif
+                        outc( ((char8)0x08), &par);
                         break;
                     case 'r':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x0D));
-#endif
+                        outc( ((char8)0x0D), &par);
                         break;
                     case 'n':
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( ((char8)0x0D));
-                        outbyte( ((char8)0x0A));
-#endif
+                        outc( ((char8)0x0D), &par);
+                        outc( ((char8)0x0A), &par);
                         break;
                     default:
-#ifdef STDOUT_BASEADDRESS
-                        outbyte( *ctrl);
-#endif
+                        outc( *ctrl, &par);
                         break;
                 }
                 ctrl += 1;
@@ -354,7 +495,9 @@ void xil_printf( const char8 *ctrl1, ...)
         }
         goto try_next;
     }
-    va_end( argp);
+
+    out->count = par.count;
+    return (s32)par.count;
 }
 
 /*---------------------------------------------------*/
@@ -33,6 +33,9 @@ typedef s32 (*func_ptr)(int c);
 /*                                                   */
 
 void xil_printf( const char8 *ctrl1, ...);
+void xil_vprintf( const char8 *ctrl1, va_list argp);
+s32 xil_snprintf( char8 *buf, u32 size, const char8 *ctrl1, ...);
+s32 xil_vsnprintf( char8 *buf, u32 size, const char8 *ctrl1, va_list argp);
 void print( const char8 *ptr);
 extern void outbyte (char8 c);
 extern char8 inbyte(void);
@@ -0,0 +1,169 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_smp.c
+*
+* This file contains the release of CPU1 and its C entry point. See xil_smp.h
+* for a description of the start sequence. Like _boot_cpu1 in boot.S, it is
+* only built with USE_SMP=1.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_smp.h"
+#include "xil_assert.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xstatus.h"
+
+#if USE_SMP==1
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_SMP_START_TIMEOUT	10000000U	/* Polls of the running flag */
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+extern void _boot_cpu1(void);
+
+/************************** Variable Definitions ****************************/
+
+static void (*volatile SmpCpu1Entry)(void);
+static volatile u32 SmpCpu1Started;
+
+/*****************************************************************************/
+/**
+*
+* Release CPU1 and let it run Entry.
+*
+* @param	Entry is the function run by CPU1. It should not return, if it
+*		does CPU1 waits in WFE.
+*
+* @return
+*		- XST_SUCCESS if CPU1 reached Entry.
+*		- XST_DEVICE_IS_STARTED if CPU1 was already released.
+*		- XST_FAILURE if CPU1 did not start, for example because it
+*		is not waiting on the release address.
+*
+* @note		Must be called on CPU0 after the caches and the MMU are set
+*		up, the BSP must be built with USE_SMP=1.
+*
+******************************************************************************/
+s32 Xil_SmpStartCpu1(void (*Entry)(void))
+{
+	u32 Timeout;
+
+	Xil_AssertNonvoid(Entry != NULL);
+
+	if (SmpCpu1Started != 0U) {
+		return XST_DEVICE_IS_STARTED;
+	}
+
+	/*
+	 * CPU1 polls the release address in the loop of the boot ROM or the
+	 * FSBL, outside coherency, so that write is pushed out to memory.
+	 * SmpCpu1Entry is read once _boot_cpu1 has enabled the MMU and the
+	 * caches of CPU1 and joined coherency, which keeps it up to date.
+	 */
+	SmpCpu1Entry = Entry;
+	Xil_Out32(XIL_SMP_CPU1_RELEASE_ADDR, (u32)(UINTPTR)_boot_cpu1);
+	Xil_DCacheFlushRange((INTPTR)XIL_SMP_CPU1_RELEASE_ADDR, 4U);
+	dsb();
+	__asm__ __volatile__ ("sev");
+
+	for (Timeout = 0U; Timeout < XIL_SMP_START_TIMEOUT; Timeout++) {
+		if (SmpCpu1Started != 0U) {
+			return XST_SUCCESS;
+		}
+	}
+
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Tell whether CPU1 has been released and reached its entry function.
+*
+* @param	None.
+*
+* @return	1 if CPU1 runs, 0 otherwise.
+*
+* @note		None.
+*
+******************************************************************************/
+u32 Xil_SmpCpu1Running(void)
+{
+	return SmpCpu1Started;
+}
+
+/*****************************************************************************/
+/**
+*
+* C entry point of CPU1, called from _boot_cpu1 in SYS mode on the stack of
+* CPU1 with IRQs and FIQs masked.
+*
+* @param	None.
+*
+* @return	Does not return.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_SmpSecondaryEntry(void)
+{
+	SmpCpu1Started = 1U;
+	dsb();
+
+	SmpCpu1Entry();
+
+	for (;;) {
+		__asm__ __volatile__ ("wfe");
+	}
+}
+
+#endif /* USE_SMP==1 */
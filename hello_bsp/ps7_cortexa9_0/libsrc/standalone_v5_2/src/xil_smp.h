@@ -0,0 +1,107 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_smp.h
+*
+* This header file contains the interface used to run code on CPU1 of the
+* Zynq from an image built for ps7_cortexa9_0.
+*
+* The BSP and the application are built with USE_SMP=1. CPU0 boots as usual.
+* Xil_SmpStartCpu1() writes the address of _boot_cpu1 (boot.S) to the CPU1
+* release address 0xFFFFFFF0 and issues SEV; CPU1, parked there by the FSBL or
+* the boot ROM, jumps to it. _boot_cpu1 sets up the stacks of CPU1 from the
+* .stack_cpu1 section of the linker script, which only reserves them when
+* _boot_cpu1 is linked in, enables the MMU with the
+* translation table of CPU0, joins coherency and calls the function given to
+* Xil_SmpStartCpu1() on the SYS mode stack of CPU1. Both cores share the
+* image, the heap and the vector table.
+*
+* CPU1 does not run the C runtime initialization and must not call the
+* stdio functions concurrently with CPU0. Its GIC CPU interface and banked
+* interrupts (IDs 0 - 31) are set up by the code it runs, see
+* XScuGic_CpuInitialize().
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_SMP_H /* prevent circular inclusions */
+#define XIL_SMP_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_SMP_NUM_CPUS		2U
+#define XIL_SMP_CPU1_RELEASE_ADDR	0xFFFFFFF0U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/****************************************************************************/
+/**
+*
+* Return the number of the calling CPU, 0 or 1.
+*
+* @note		C-Style signature: u32 Xil_SmpCpuId(void)
+*
+*****************************************************************************/
+#define Xil_SmpCpuId()	(mfcp(XREG_CP15_MULTI_PROC_AFFINITY) & 0x3U)
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_SmpStartCpu1(void (*Entry)(void));
+u32 Xil_SmpCpu1Running(void);
+void Xil_SmpSecondaryEntry(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_SMP_H */
@@ -0,0 +1,491 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_taskpool.c
+*
+* This file contains the work stealing task pool. See xil_taskpool.h for a
+* description of its operation.
+*
+* The deques follow Chase and Lev: Top and Bottom are free running indices,
+* the owner writes Bottom and the thief advances Top with a compare and swap,
+* which the owner also uses to take the last task. The GCC __sync builtins
+* compile to LDREX/STREX with DMB, which work across the cores because the
+* DDR is mapped shareable and both cores have the SMP bit set. Top and Bottom
+* are kept in separate cache lines.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include "xil_taskpool.h"
+#include "xil_assert.h"
+#include "xil_exception.h"
+#include "xstatus.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_TASKPOOL_DEQUE_MASK		(XIL_TASKPOOL_DEQUE_SIZE - 1U)
+#define XIL_TASKPOOL_SGI_TRIGGER	0x3U
+
+/**************************** Type Definitions ******************************/
+
+typedef struct {
+	volatile u32 Top;		/* Next task to steal */
+	u32 Pad0[7];
+	volatile u32 Bottom;		/* Next free slot of the owner */
+	u32 Pad1[7];
+	Xil_Task Buf[XIL_TASKPOOL_DEQUE_SIZE];
+} Xil_TaskDeque;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+#define Xil_TaskOtherCpu(Cpu)	((Cpu) ^ 1U)
+
+/************************** Function Prototypes *****************************/
+
+static s32 Xil_TaskPop(Xil_TaskDeque *DequePtr, Xil_Task *TaskPtr);
+static s32 Xil_TaskSteal(Xil_TaskDeque *DequePtr, Xil_Task *TaskPtr);
+static void Xil_TaskRun(u32 Cpu, const Xil_Task *TaskPtr);
+static s32 Xil_TaskRunOne(u32 Cpu);
+static void Xil_TaskWakeHandler(void *CallBackRef);
+
+/************************** Variable Definitions ****************************/
+
+static Xil_TaskDeque TaskDeques[XIL_SMP_NUM_CPUS] __attribute__ ((aligned(32)));
+static volatile u32 TaskIdle[XIL_SMP_NUM_CPUS];
+static Xil_TaskPoolStats TaskStats[XIL_SMP_NUM_CPUS];
+static XScuGic *TaskGicPtr;
+
+/*****************************************************************************/
+/**
+*
+* Initialize the task pool and the wakeup interrupt on CPU0.
+*
+* @param	GicPtr is the GIC instance, initialized with
+*		XScuGic_CfgInitialize(). XScuGic_InterruptHandler must be
+*		registered as the IRQ exception handler.
+*
+* @return	XST_SUCCESS, or the error of XScuGic_Connect().
+*
+* @note		Call before Xil_SmpStartCpu1(Xil_TaskPoolWorker).
+*
+******************************************************************************/
+s32 Xil_TaskPoolInit(XScuGic *GicPtr)
+{
+	u32 Cpu;
+	s32 Status;
+
+	Xil_AssertNonvoid(GicPtr != NULL);
+
+	for (Cpu = 0U; Cpu < XIL_SMP_NUM_CPUS; Cpu++) {
+		TaskDeques[Cpu].Top = 0U;
+		TaskDeques[Cpu].Bottom = 0U;
+		TaskIdle[Cpu] = 0U;
+	}
+	Xil_TaskPoolResetStats();
+	TaskGicPtr = GicPtr;
+
+	Status = XScuGic_Connect(GicPtr, XIL_TASKPOOL_SGI_ID,
+				 Xil_TaskWakeHandler, NULL);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	XScuGic_SetPriorityTriggerType(GicPtr, XIL_TASKPOOL_SGI_ID,
+				       XIL_TASKPOOL_SGI_PRIORITY,
+				       XIL_TASKPOOL_SGI_TRIGGER);
+	XScuGic_Enable(GicPtr, XIL_TASKPOOL_SGI_ID);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Worker loop of CPU1. Sets up the GIC CPU interface of CPU1 and runs tasks,
+* sleeping in WFI while there are none.
+*
+* @param	None.
+*
+* @return	Does not return.
+*
+* @note		Pass to Xil_SmpStartCpu1() after Xil_TaskPoolInit().
+*
+******************************************************************************/
+void Xil_TaskPoolWorker(void)
+{
+	u32 Cpu = Xil_SmpCpuId();
+	u32 Other = Xil_TaskOtherCpu(Cpu);
+
+	XScuGic_CpuInitialize(TaskGicPtr);
+	XScuGic_SetPriorityTriggerType(TaskGicPtr, XIL_TASKPOOL_SGI_ID,
+				       XIL_TASKPOOL_SGI_PRIORITY,
+				       XIL_TASKPOOL_SGI_TRIGGER);
+	XScuGic_Enable(TaskGicPtr, XIL_TASKPOOL_SGI_ID);
+	Xil_ExceptionEnable();
+
+	for (;;) {
+		if (Xil_TaskRunOne(Cpu) != 0) {
+			continue;
+		}
+
+		/*
+		 * Announce the idle state before the last look at the deques,
+		 * a task pushed after that look comes with a wakeup SGI.
+		 * IRQs stay masked from the look to the WFI, so that SGI
+		 * stays pending and ends the WFI instead of being taken
+		 * just before it.
+		 */
+		Xil_ExceptionDisable();
+		TaskIdle[Cpu] = 1U;
+		__sync_synchronize();
+		if ((TaskDeques[Cpu].Bottom == TaskDeques[Cpu].Top) &&
+		    (TaskDeques[Other].Bottom == TaskDeques[Other].Top)) {
+			__asm__ __volatile__ ("wfi");
+		}
+		TaskIdle[Cpu] = 0U;
+		Xil_ExceptionEnable();
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Queue a task on the deque of the calling CPU and wake the other CPU if it
+* is idle.
+*
+* @param	Group is the group the task belongs to, or NULL.
+* @param	Func is the task function.
+* @param	Arg is passed to Func.
+* @param	Index is passed to Func.
+*
+* @return	None.
+*
+* @note		When the deque is full the task runs before this function
+*		returns.
+*
+******************************************************************************/
+void Xil_TaskSubmit(Xil_TaskGroup *Group, Xil_TaskFunc Func, void *Arg,
+		    u32 Index)
+{
+	u32 Cpu = Xil_SmpCpuId();
+	u32 Other = Xil_TaskOtherCpu(Cpu);
+	Xil_TaskDeque *DequePtr = &TaskDeques[Cpu];
+	Xil_Task *SlotPtr;
+	Xil_Task Task;
+	u32 Bottom;
+
+	Xil_AssertVoid(Func != NULL);
+
+	Task.Func = Func;
+	Task.Arg = Arg;
+	Task.Index = Index;
+	Task.Group = Group;
+	if (Group != NULL) {
+		(void)__sync_fetch_and_add(&Group->Pending, 1U);
+	}
+
+	Bottom = DequePtr->Bottom;
+	if ((Bottom - DequePtr->Top) >= XIL_TASKPOOL_DEQUE_SIZE) {
+		TaskStats[Cpu].Inline++;
+		Xil_TaskRun(Cpu, &Task);
+		return;
+	}
+	SlotPtr = &DequePtr->Buf[Bottom & XIL_TASKPOOL_DEQUE_MASK];
+	*SlotPtr = Task;
+	__sync_synchronize();
+	DequePtr->Bottom = Bottom + 1U;
+	__sync_synchronize();
+
+	if (TaskIdle[Other] != 0U) {
+		TaskIdle[Other] = 0U;
+		TaskStats[Cpu].Wakeups++;
+		(void)XScuGic_SoftwareIntr(TaskGicPtr, XIL_TASKPOOL_SGI_ID,
+					   (u32)1U << Other);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Wait until all tasks of a group completed, running tasks of either deque
+* in the meantime.
+*
+* @param	Group is the task group.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_TaskGroupWait(Xil_TaskGroup *Group)
+{
+	u32 Cpu = Xil_SmpCpuId();
+
+	Xil_AssertVoid(Group != NULL);
+
+	while (Group->Pending != 0U) {
+		(void)Xil_TaskRunOne(Cpu);
+	}
+	__sync_synchronize();
+}
+
+/*****************************************************************************/
+/**
+*
+* Run Func(Arg, Index) for Index 0 to Count - 1 on both CPUs and wait for all
+* of them.
+*
+* @param	Func is the task function.
+* @param	Arg is passed to every call.
+* @param	Count is the number of calls.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_TaskParallelFor(Xil_TaskFunc Func, void *Arg, u32 Count)
+{
+	Xil_TaskGroup Group;
+	u32 Index;
+
+	Group.Pending = 0U;
+	for (Index = 0U; Index < Count; Index++) {
+		Xil_TaskSubmit(&Group, Func, Arg, Index);
+	}
+	Xil_TaskGroupWait(&Group);
+}
+
+/*****************************************************************************/
+/**
+*
+* Read the counters of one CPU.
+*
+* @param	Cpu is the CPU number, 0 or 1.
+* @param	StatsPtr receives the counters.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+void Xil_TaskPoolGetStats(u32 Cpu, Xil_TaskPoolStats *StatsPtr)
+{
+	Xil_AssertVoid(Cpu < XIL_SMP_NUM_CPUS);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = TaskStats[Cpu];
+}
+
+/*****************************************************************************/
+/**
+*
+* Clear the counters of both CPUs.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		Call while no tasks are running.
+*
+******************************************************************************/
+void Xil_TaskPoolResetStats(void)
+{
+	u32 Cpu;
+
+	for (Cpu = 0U; Cpu < XIL_SMP_NUM_CPUS; Cpu++) {
+		TaskStats[Cpu].Executed = 0U;
+		TaskStats[Cpu].Stolen = 0U;
+		TaskStats[Cpu].Inline = 0U;
+		TaskStats[Cpu].Wakeups = 0U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Take the newest task of the own deque.
+*
+* @param	DequePtr is the deque of the calling CPU.
+* @param	TaskPtr receives the task.
+*
+* @return	1 if a task was taken, 0 if the deque is empty.
+*
+* @note		None.
+*
+******************************************************************************/
+static s32 Xil_TaskPop(Xil_TaskDeque *DequePtr, Xil_Task *TaskPtr)
+{
+	u32 Bottom;
+	u32 Top;
+	s32 Taken = 1;
+
+	Bottom = DequePtr->Bottom - 1U;
+	DequePtr->Bottom = Bottom;
+	__sync_synchronize();
+	Top = DequePtr->Top;
+
+	if ((s32)(Bottom - Top) < 0) {
+		DequePtr->Bottom = Top;
+		return 0;
+	}
+
+	*TaskPtr = DequePtr->Buf[Bottom & XIL_TASKPOOL_DEQUE_MASK];
+	if (Bottom != Top) {
+		return 1;
+	}
+
+	/*
+	 * Last task, race the thief for it.
+	 */
+	if (__sync_bool_compare_and_swap(&DequePtr->Top, Top, Top + 1U) == 0) {
+		Taken = 0;
+	}
+	DequePtr->Bottom = Top + 1U;
+
+	return Taken;
+}
+
+/*****************************************************************************/
+/**
+*
+* Take the oldest task of the deque of the other CPU.
+*
+* @param	DequePtr is the deque of the other CPU.
+* @param	TaskPtr receives the task.
+*
+* @return	1 if a task was taken, 0 if the deque is empty or the task was
+*		taken by its owner first.
+*
+* @note		None.
+*
+******************************************************************************/
+static s32 Xil_TaskSteal(Xil_TaskDeque *DequePtr, Xil_Task *TaskPtr)
+{
+	u32 Bottom;
+	u32 Top;
+
+	Top = DequePtr->Top;
+	__sync_synchronize();
+	Bottom = DequePtr->Bottom;
+
+	if ((s32)(Bottom - Top) <= 0) {
+		return 0;
+	}
+
+	*TaskPtr = DequePtr->Buf[Top & XIL_TASKPOOL_DEQUE_MASK];
+	if (__sync_bool_compare_and_swap(&DequePtr->Top, Top, Top + 1U) == 0) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/*****************************************************************************/
+/**
+*
+* Run a task and complete it in its group.
+*
+* @param	Cpu is the calling CPU.
+* @param	TaskPtr is the task.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void Xil_TaskRun(u32 Cpu, const Xil_Task *TaskPtr)
+{
+	TaskPtr->Func(TaskPtr->Arg, TaskPtr->Index);
+	TaskStats[Cpu].Executed++;
+
+	if (TaskPtr->Group != NULL) {
+		/* Results of the task are visible before the completion */
+		(void)__sync_fetch_and_sub(&TaskPtr->Group->Pending, 1U);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Run one task of the own deque, or else one stolen from the other CPU.
+*
+* @param	Cpu is the calling CPU.
+*
+* @return	1 if a task was run, 0 if none was found.
+*
+* @note		None.
+*
+******************************************************************************/
+static s32 Xil_TaskRunOne(u32 Cpu)
+{
+	Xil_Task Task;
+
+	if (Xil_TaskPop(&TaskDeques[Cpu], &Task) != 0) {
+		Xil_TaskRun(Cpu, &Task);
+		return 1;
+	}
+	if (Xil_TaskSteal(&TaskDeques[Xil_TaskOtherCpu(Cpu)], &Task) != 0) {
+		TaskStats[Cpu].Stolen++;
+		Xil_TaskRun(Cpu, &Task);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Handler of the wakeup SGI. The interrupt only ends the WFI of the worker.
+*
+* @param	CallBackRef is unused.
+*
+* @return	None.
+*
+* @note		None.
+*
+******************************************************************************/
+static void Xil_TaskWakeHandler(void *CallBackRef)
+{
+	(void)CallBackRef;
+}
@@ -0,0 +1,130 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xil_taskpool.h
+*
+* This header file contains the interface of the work stealing task pool
+* that spreads data parallel work over CPU0 and CPU1.
+*
+* Each CPU owns a bounded deque of tasks. The owner pushes and pops at the
+* bottom without locking; the other CPU steals from the top with a compare
+* and swap, so a CPU that runs out of work takes the oldest, usually largest
+* remaining share of the other one. A task is a function called with an
+* argument and an index, and belongs to a task group whose pending count is
+* decremented when it completes.
+*
+* CPU1 runs Xil_TaskPoolWorker(), started with Xil_SmpStartCpu1(). When it
+* finds no work it sets its idle flag and waits in WFI; a CPU that submits a
+* task while the other one is idle wakes it with the software generated
+* interrupt XIL_TASKPOOL_SGI_ID. CPU0 executes tasks itself while it waits
+* for a group in Xil_TaskGroupWait().
+*
+* Tasks are submitted and waited for from thread context only. When the
+* deque of the submitting CPU is full the task runs immediately on that CPU.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XIL_TASKPOOL_H /* prevent circular inclusions */
+#define XIL_TASKPOOL_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+#include "xil_smp.h"
+#include "xscugic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+#define XIL_TASKPOOL_DEQUE_SIZE	256U	/* Tasks per CPU, power of 2 */
+#define XIL_TASKPOOL_SGI_ID	15U	/* Wakeup of an idle CPU */
+#define XIL_TASKPOOL_SGI_PRIORITY	0xE0U
+
+/**************************** Type Definitions ******************************/
+
+typedef void (*Xil_TaskFunc)(void *Arg, u32 Index);
+
+/*
+ * Group of tasks that can be waited for. Initialize Pending to 0.
+ */
+typedef struct {
+	volatile u32 Pending;	/* Submitted tasks not completed yet */
+} Xil_TaskGroup;
+
+typedef struct {
+	Xil_TaskFunc Func;
+	void *Arg;
+	u32 Index;
+	Xil_TaskGroup *Group;
+} Xil_Task;
+
+/*
+ * Per CPU counters, see Xil_TaskPoolGetStats().
+ */
+typedef struct {
+	u32 Executed;		/* Tasks run by the CPU */
+	u32 Stolen;		/* Of which taken from the other CPU */
+	u32 Inline;		/* Run at submission, deque full */
+	u32 Wakeups;		/* SGIs sent to the other CPU */
+} Xil_TaskPoolStats;
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+s32 Xil_TaskPoolInit(XScuGic *GicPtr);
+void Xil_TaskPoolWorker(void);
+void Xil_TaskSubmit(Xil_TaskGroup *Group, Xil_TaskFunc Func, void *Arg,
+		    u32 Index);
+void Xil_TaskGroupWait(Xil_TaskGroup *Group);
+void Xil_TaskParallelFor(Xil_TaskFunc Func, void *Arg, u32 Count);
+void Xil_TaskPoolGetStats(u32 Cpu, Xil_TaskPoolStats *StatsPtr);
+void Xil_TaskPoolResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XIL_TASKPOOL_H */
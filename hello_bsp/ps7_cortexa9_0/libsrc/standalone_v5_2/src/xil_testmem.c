@@ -42,6 +42,9 @@
 * Ver    Who    Date    Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a hbm  08/25/09 First release
+* 5.2   ag   10/18/26 Added Xil_TestMemFast, a faster engine for the 32-bit
+*		      test with fused passes, bursts and optional NEON and
+*		      fill offload, which Xil_TestMem32 now uses.
 * </pre>
 *
 *****************************************************************************/
@@ -50,10 +53,65 @@
 #include "xil_testmem.h"
 #include "xil_io.h"
 #include "xil_assert.h"
+#include "xil_cache.h"
+#include "xparameters.h"
+#include "xpm_counter.h"
+#include "xpseudo_asm.h"
+#include "xstatus.h"
+
+/*
+ * NEON intrinsics need -mfpu=neon with -mfloat-abi=softfp or hard, the
+ * default -mfloat-abi=soft of the BSP builds the scalar bursts
+ */
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define XIL_TESTMEM_NEON
+#endif
 
 /************************** Constant Definitions ****************************/
+
+#define XIL_TESTMEM_CPU_MHZ	(XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 1000000U)
+
+/* Words checked before they are written, and moved per burst */
+#define XIL_TESTMEM_BLOCK_WORDS	1024U
+#define XIL_TESTMEM_BURST	8U
+
+/**************************** Type Definitions ******************************/
+
+/*
+ * A pass of the fast engine, it checks a pattern and writes the next one
+ */
+typedef struct {
+	u8 Test;	/* Subtest the pass is counted for */
+	u8 Check;
+	u8 Write;
+	u32 CheckVal;
+	u32 CheckStep;
+	u32 WriteVal;
+	u32 WriteStep;
+} Xil_TestMemPass;
+
+typedef struct {
+	Xil_TestMemResult *Result;
+	u64 Cycles[XIL_TESTMEM_MAXTEST + 1U];
+	u64 Bytes[XIL_TESTMEM_MAXTEST + 1U];
+} Xil_TestMemState;
+
+/************************** Variable Definitions ****************************/
+
+static Xil_TestMemFillFunc TestMemFill;
+static void *TestMemFillRef;
+
 /************************** Function Prototypes *****************************/
 
+static s32 Xil_TestMemWalk32(u32 *Addr, u8 Test, Xil_TestMemState *State);
+static s32 Xil_TestMemRunPass(u32 *Addr, u32 Words,
+			      const Xil_TestMemPass *Pass,
+			      Xil_TestMemState *State);
+static u32 *Xil_TestMemCheckBlock(u32 *Ptr, u32 Count, u32 Val, u32 Step);
+static void Xil_TestMemWriteBlock(u32 *Ptr, u32 Count, u32 Val, u32 Step);
+static void Xil_TestMemFail(Xil_TestMemState *State, u8 Test, u32 *FailPtr,
+			    u32 Expect);
 static u32 RotateLeft(u32 Input, u8 Width);
 
 /* define ROTATE_RIGHT to give access to this functionality */
@@ -94,224 +152,176 @@ static u32 RotateRight(u32 Input, u8 Width);
 *****************************************************************************/
 s32 Xil_TestMem32(u32 *Addr, u32 Words, u32 Pattern, u8 Subtest)
 {
-	u32 I;
-	u32 j;
-	u32 Val;
-	u32 FirtVal;
-	u32 WordMem32;
+	return Xil_TestMemFast(Addr, Words, Pattern, Subtest, NULL);
+}
+
+/*****************************************************************************/
+/**
+*
+* Perform a destructive 32-bit wide memory test with the fast engine and
+* measure it.
+*
+* The walking ones and zeros subtests run on the first 32 words as in
+* Xil_TestMem32. The incrementing value, inverse address and fixed pattern
+* subtests run over the whole region in blocks of XIL_TESTMEM_BLOCK_WORDS
+* words. A block is first checked against the pattern of the previous
+* subtest and then written with the pattern of the next one, so that all
+* three take four passes over the region instead of six. The words are
+* moved in bursts of 8, with NEON when the library is built for it, and a
+* block is compared word by word only when it holds an error.
+*
+* With a fill function set by Xil_TestMemSetFill, the fixed pattern is
+* written by it, for example by the PL330, after the check of the previous
+* subtest.
+*
+* @param    Addr is a pointer to the region of memory to be tested.
+* @param    Words is the length of the block.
+* @param    Pattern is the constant used for the constant pattern test, if 0,
+*           0xDEADBEEF is used.
+* @param    Subtest is the test selected. See xil_testmem.h for possible
+*	    values.
+* @param    Result is filled in with the bandwidth of each subtest and the
+*	    first error, or NULL.
+*
+* @return
+*
+* - 0 is returned for a pass
+* - -1 is returned for a failure
+*
+* @note
+*
+* The bandwidth of a subtest counts the bytes read and written by the passes
+* that check it, with the first write pass going to the first subtest.
+*
+*****************************************************************************/
+s32 Xil_TestMemFast(u32 *Addr, u32 Words, u32 Pattern, u8 Subtest,
+		    Xil_TestMemResult *Result)
+{
+	Xil_TestMemPass Passes[4];
+	u32 NumPasses = 0U;
+	u32 Index;
+	u32 FixedVal;
+	u32 InvVal;
+	u8 Test;
+	u8 Prev = 0U;
 	s32 Status = 0;
+	Xil_TestMemState State;
 
 	Xil_AssertNonvoid(Words != (u32)0);
 	Xil_AssertNonvoid(Subtest <= (u8)XIL_TESTMEM_MAXTEST);
 	Xil_AssertNonvoid(Addr != NULL);
 
-	/*
-	 * variable initialization
-	 */
-	Val = XIL_TESTMEM_INIT_VALUE;
-	FirtVal = XIL_TESTMEM_INIT_VALUE;
-
-
-	if((Subtest == XIL_TESTMEM_ALLMEMTESTS) || (Subtest == XIL_TESTMEM_INCREMENT)) {
-		/*
-		 * Fill the memory with incrementing
-		 * values starting from 'FirtVal'
-		 */
-		for (I = 0U; I < Words; I++) {
-			*(Addr+I) = Val;
-			Val++;
-		}
-
-		/*
-		 * Restore the reference 'Val' to the
-		 * initial value
-		 */
-		Val = FirtVal;
-
-		/*
-		 * Check every word within the words
-		 * of tested memory and compare it
-		 * with the incrementing reference
-		 * Val
-		 */
-
-		for (I = 0U; I < Words; I++) {
-			WordMem32 = *(Addr+I);
-
-			if (WordMem32 != Val) {
-				Status = -1;
-				goto End_Label;
-			}
-
-			Val++;
-		}
-	}
-
-	if((Subtest == XIL_TESTMEM_ALLMEMTESTS) || (Subtest == XIL_TESTMEM_WALKONES)) {
-		/*
-		 * set up to cycle through all possible initial
-		 * test Patterns for walking ones test
-		 */
-
-		for (j = 0U; j < (u32)32; j++) {
-			/*
-			 * Generate an initial value for walking ones test
-			 * to test for bad data bits
-			 */
-
-			Val = (1U << j);
-
-			/*
-			 * START walking ones test
-			 * Write a one to each data bit indifferent locations
-			 */
-
-			for (I = 0U; I < (u32)32; I++) {
-				/* write memory location */
-				*(Addr+I) = Val;
-				Val = (u32) RotateLeft(Val, 32U);
-			}
-
-			/*
-			 * Restore the reference 'val' to the
-			 * initial value
-			 */
-			Val = 1U << j;
-
-			/* Read the values from each location that was
-			 * written */
-			for (I = 0U; I < (u32)32; I++) {
-				/* read memory location */
-
-				WordMem32 = *(Addr+I);
-
-				if (WordMem32 != Val) {
-					Status = -1;
-					goto End_Label;
-				}
-
-				Val = (u32)RotateLeft(Val, 32U);
-			}
-		}
+	State.Result = Result;
+	for (Index = 0U; Index <= XIL_TESTMEM_MAXTEST; Index++) {
+		State.Cycles[Index] = 0U;
+		State.Bytes[Index] = 0U;
 	}
-
-	if((Subtest == XIL_TESTMEM_ALLMEMTESTS) || (Subtest == XIL_TESTMEM_WALKZEROS)) {
-		/*
-		 * set up to cycle through all possible
-		 * initial test Patterns for walking zeros test
-		 */
-
-		for (j = 0U; j < (u32)32; j++) {
-
-			/*
-			 * Generate an initial value for walking ones test
-			 * to test for bad data bits
-			 */
-
-			Val = ~(1U << j);
-
-			/*
-			 * START walking zeros test
-			 * Write a one to each data bit indifferent locations
-			 */
-
-			for (I = 0U; I < (u32)32; I++) {
-				/* write memory location */
-				*(Addr+I) = Val;
-				Val = ~((u32)RotateLeft(~Val, 32U));
-			}
-
-			/*
-			 * Restore the reference 'Val' to the
-			 * initial value
-			 */
-
-			Val = ~(1U << j);
-
-			/* Read the values from each location that was
-			 * written */
-			for (I = 0U; I < (u32)32; I++) {
-				/* read memory location */
-				WordMem32 = *(Addr+I);
-				if (WordMem32 != Val) {
-					Status = -1;
-					goto End_Label;
-				}
-				Val = ~((u32)RotateLeft(~Val, 32U));
-			}
-
-		}
+	if (Result != NULL) {
+		Result->FailAddr = NULL;
+		Result->Expected = 0U;
+		Result->Actual = 0U;
+		Result->FailTest = 0U;
+		Xpm_StartCycleCounter();
 	}
 
-	if((Subtest == XIL_TESTMEM_ALLMEMTESTS) || (Subtest == XIL_TESTMEM_INVERSEADDR)) {
-		/* Fill the memory with inverse of address */
-		for (I = 0U; I < Words; I++) {
-			/* write memory location */
-			Val = (u32) (~((INTPTR) (&Addr[I])));
-			*(Addr+I) = Val;
-		}
-
-		/*
-		 * Check every word within the words
-		 * of tested memory
-		 */
-
-		for (I = 0U; I < Words; I++) {
-			/* Read the location */
-			WordMem32 = *(Addr+I);
-			Val = (u32) (~((INTPTR) (&Addr[I])));
-
-			if ((WordMem32 ^ Val) != 0x00000000U) {
-				Status = -1;
+	for (Test = XIL_TESTMEM_WALKONES; Test <= XIL_TESTMEM_WALKZEROS;
+	     Test++) {
+		if ((Subtest == XIL_TESTMEM_ALLMEMTESTS) || (Subtest == Test)) {
+			Status = Xil_TestMemWalk32(Addr, Test, &State);
+			if (Status != 0) {
 				goto End_Label;
 			}
 		}
 	}
 
-	if((Subtest == XIL_TESTMEM_ALLMEMTESTS) || (Subtest == XIL_TESTMEM_FIXEDPATTERN)) {
-		/*
-		 * Generate an initial value for
-		 * memory testing
-		 */
+	FixedVal = (Pattern == (u32)0) ? 0xDEADBEEFU : Pattern;
+	InvVal = ~((u32)(INTPTR)Addr);
 
-		if (Pattern == (u32)0) {
-			Val = 0xDEADBEEFU;
+	/*
+	 * Chain the selected subtests, each pass checks the pattern of one and
+	 * writes that of the next
+	 */
+	for (Test = XIL_TESTMEM_INCREMENT; Test <= XIL_TESTMEM_FIXEDPATTERN;
+	     Test++) {
+		if ((Test == XIL_TESTMEM_WALKONES) ||
+		    (Test == XIL_TESTMEM_WALKZEROS) ||
+		    ((Subtest != XIL_TESTMEM_ALLMEMTESTS) && (Subtest != Test))) {
+			continue;
 		}
-		else {
-			Val = Pattern;
+		Passes[NumPasses].Test = (NumPasses == 0U) ? Test : Prev;
+		Passes[NumPasses].Check = (NumPasses == 0U) ? 0U : 1U;
+		if (NumPasses != 0U) {
+			Passes[NumPasses].CheckVal = Passes[NumPasses - 1U].WriteVal;
+			Passes[NumPasses].CheckStep =
+				Passes[NumPasses - 1U].WriteStep;
 		}
-
-		/*
-		 * Fill the memory with fixed Pattern
-		 */
-
-		for (I = 0U; I < Words; I++) {
-			/* write memory location */
-			*(Addr+I) = Val;
+		Passes[NumPasses].Write = 1U;
+		if (Test == XIL_TESTMEM_INCREMENT) {
+			Passes[NumPasses].WriteVal = XIL_TESTMEM_INIT_VALUE;
+			Passes[NumPasses].WriteStep = 1U;
+		} else if (Test == XIL_TESTMEM_INVERSEADDR) {
+			Passes[NumPasses].WriteVal = InvVal;
+			Passes[NumPasses].WriteStep = (u32)0U - 4U;
+		} else {
+			Passes[NumPasses].WriteVal = FixedVal;
+			Passes[NumPasses].WriteStep = 0U;
 		}
+		Prev = Test;
+		NumPasses++;
+	}
+	if (NumPasses != 0U) {
+		Passes[NumPasses].Test = Prev;
+		Passes[NumPasses].Check = 1U;
+		Passes[NumPasses].CheckVal = Passes[NumPasses - 1U].WriteVal;
+		Passes[NumPasses].CheckStep = Passes[NumPasses - 1U].WriteStep;
+		Passes[NumPasses].Write = 0U;
+		NumPasses++;
+	}
 
-		/*
-		 * Check every word within the words
-		 * of tested memory and compare it
-		 * with the fixed Pattern
-		 */
-
-		for (I = 0U; I < Words; I++) {
-
-			/* read memory location */
-
-			WordMem32 = *(Addr+I);
-			if (WordMem32 != Val) {
-				Status = -1;
-				goto End_Label;
-			}
+	for (Index = 0U; Index < NumPasses; Index++) {
+		Status = Xil_TestMemRunPass(Addr, Words, &Passes[Index], &State);
+		if (Status != 0) {
+			break;
 		}
 	}
 
 End_Label:
+	if (Result != NULL) {
+		for (Index = 0U; Index <= XIL_TESTMEM_MAXTEST; Index++) {
+			Result->MBps[Index] = (State.Cycles[Index] == 0U) ? 0U :
+				(u32)((State.Bytes[Index] * XIL_TESTMEM_CPU_MHZ) /
+				      State.Cycles[Index]);
+		}
+	}
+
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+*
+* Set a function that writes the fixed pattern of Xil_TestMemFast, for
+* example with the PL330.
+*
+* @param    Fill is the function, or NULL to write with the CPU. It returns
+*	    XST_SUCCESS once the words are in memory, or an error to let the
+*	    CPU write them.
+* @param    CallBackRef is passed to the function.
+*
+* @return   None.
+*
+* @note
+*
+* The region is flushed from the caches before the function is called and
+* invalidated after it.
+*
+*****************************************************************************/
+void Xil_TestMemSetFill(Xil_TestMemFillFunc Fill, void *CallBackRef)
+{
+	TestMemFill = Fill;
+	TestMemFillRef = CallBackRef;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -774,6 +784,345 @@ End_Label:
 }
 
 
+/*****************************************************************************/
+/**
+*
+* Perform the destructive walking ones or walking zeros subtest of
+* Xil_TestMemFast on the first 32 words of the region.
+*
+* For each of the 32 bit positions a single one (or, for walking zeros, a
+* single zero) is written to every word, rotated by one bit from word to
+* word, and the 32 words are then read back and compared.
+*
+* @param    Addr is a pointer to the region of memory to be tested, which
+*           must be at least 32 words long.
+* @param    Test is XIL_TESTMEM_WALKONES or XIL_TESTMEM_WALKZEROS.
+* @param    State is the state of the running test. When it has a result,
+*           the first mismatch is recorded in it, and the cycles and bytes
+*           of the subtest are added to its totals.
+*
+* @return
+*
+* - 0 is returned for a pass
+* - -1 is returned for a failure
+*
+* @note
+*
+* The test stops at the first mismatch.
+*
+*****************************************************************************/
+static s32 Xil_TestMemWalk32(u32 *Addr, u8 Test, Xil_TestMemState *State)
+{
+	u32 I;
+	u32 j;
+	u32 Val;
+	u32 Expect;
+	u32 Invert = (Test == XIL_TESTMEM_WALKZEROS) ? 0xFFFFFFFFU : 0U;
+	u32 Start = 0U;
+	s32 Status = 0;
+
+	if (State->Result != NULL) {
+		Start = Xpm_GetCycleCounter();
+	}
+
+	for (j = 0U; j < (u32)32; j++) {
+		/*
+		 * Write a one, or a zero, to each data bit in different
+		 * locations
+		 */
+		Val = 1U << j;
+		for (I = 0U; I < (u32)32; I++) {
+			*(Addr+I) = Val ^ Invert;
+			Val = (u32)RotateLeft(Val, 32U);
+		}
+
+		/* Read the values from each location that was written */
+		Val = 1U << j;
+		for (I = 0U; I < (u32)32; I++) {
+			Expect = Val ^ Invert;
+			if (*(Addr+I) != Expect) {
+				Xil_TestMemFail(State, Test, Addr + I, Expect);
+				Status = -1;
+				goto End_Label;
+			}
+			Val = (u32)RotateLeft(Val, 32U);
+		}
+	}
+
+End_Label:
+	if (State->Result != NULL) {
+		State->Cycles[Test] += (u64)(Xpm_GetCycleCounter() - Start);
+		State->Bytes[Test] += (u64)j * 2U * 32U * 4U;
+	}
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* Run one pass of the fast engine over the region, block by block.
+*
+* @param    Addr is a pointer to the region of memory to be tested.
+* @param    Words is the length of the region.
+* @param    Pass is the pass, with the patterns to check and to write.
+* @param    State collects the timing and the error.
+*
+* @return
+*
+* - 0 is returned for a pass
+* - -1 is returned for a failure
+*
+* @note
+*
+* None.
+*
+*****************************************************************************/
+static s32 Xil_TestMemRunPass(u32 *Addr, u32 Words,
+			      const Xil_TestMemPass *Pass,
+			      Xil_TestMemState *State)
+{
+	u32 I;
+	u32 Count;
+	u32 Start = 0U;
+	u32 *FailPtr;
+	u32 Write = Pass->Write;
+	u32 Bytes = 0U;
+
+	/* The fixed pattern goes to the fill function after the check */
+	if ((Write != 0U) && (Pass->WriteStep == 0U) && (TestMemFill != NULL)) {
+		Write = 0U;
+	}
+
+	for (I = 0U; I < Words; I += Count) {
+		Count = Words - I;
+		if (Count > XIL_TESTMEM_BLOCK_WORDS) {
+			Count = XIL_TESTMEM_BLOCK_WORDS;
+		}
+		if (State->Result != NULL) {
+			Start = Xpm_GetCycleCounter();
+		}
+
+		if (Pass->Check != 0U) {
+			FailPtr = Xil_TestMemCheckBlock(&Addr[I], Count,
+					Pass->CheckVal + (I * Pass->CheckStep),
+					Pass->CheckStep);
+			if (FailPtr != NULL) {
+				Xil_TestMemFail(State, Pass->Test, FailPtr,
+					Pass->CheckVal +
+					((u32)(FailPtr - Addr) * Pass->CheckStep));
+				return -1;
+			}
+			Bytes = Count * 4U;
+		}
+		if (Write != 0U) {
+			Xil_TestMemWriteBlock(&Addr[I], Count,
+					      Pass->WriteVal + (I * Pass->WriteStep),
+					      Pass->WriteStep);
+			Bytes += Count * 4U;
+		}
+
+		if (State->Result != NULL) {
+			State->Cycles[Pass->Test] +=
+				(u64)(Xpm_GetCycleCounter() - Start);
+			State->Bytes[Pass->Test] += Bytes;
+		}
+		Bytes = 0U;
+	}
+
+	if ((Pass->Write != 0U) && (Write == 0U)) {
+		if (State->Result != NULL) {
+			Start = Xpm_GetCycleCounter();
+		}
+		Xil_DCacheFlushRange((INTPTR)Addr, Words * 4U);
+		if (TestMemFill(TestMemFillRef, Addr, Words, Pass->WriteVal) !=
+		    XST_SUCCESS) {
+			Xil_TestMemWriteBlock(Addr, Words, Pass->WriteVal, 0U);
+		}
+		Xil_DCacheInvalidateRange((INTPTR)Addr, Words * 4U);
+		if (State->Result != NULL) {
+			State->Cycles[Pass->Test] +=
+				(u64)(Xpm_GetCycleCounter() - Start);
+			State->Bytes[Pass->Test] += (u64)Words * 4U;
+		}
+	}
+
+	/* Complete the writes before the next pass reads them back */
+	dsb();
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* Compare a block with an arithmetic pattern, Val + Index * Step.
+*
+* @param    Ptr is the start of the block.
+* @param    Count is the number of words.
+* @param    Val is the expected value of the first word.
+* @param    Step is the difference between the words.
+*
+* @return   The first word that differs, or NULL.
+*
+* @note
+*
+* The block is compared in bursts with the differences ORed together and
+* only searched word by word if they are not zero. An error that does not
+* show again when searched is reported at the start of the block.
+*
+*****************************************************************************/
+static u32 *Xil_TestMemCheckBlock(u32 *Ptr, u32 Count, u32 Val, u32 Step)
+{
+	u32 I = 0U;
+	u32 Diff = 0U;
+	u32 Expect = Val;
+#ifdef XIL_TESTMEM_NEON
+	u32 Init[4];
+	uint32x4_t Exp0;
+	uint32x4_t Exp1;
+	uint32x4_t Inc;
+	uint32x4_t Acc;
+
+	Init[0] = Val;
+	Init[1] = Val + Step;
+	Init[2] = Val + (2U * Step);
+	Init[3] = Val + (3U * Step);
+	Exp0 = vld1q_u32(Init);
+	Exp1 = vaddq_u32(Exp0, vdupq_n_u32(4U * Step));
+	Inc = vdupq_n_u32(8U * Step);
+	Acc = vdupq_n_u32(0U);
+
+	for (; (I + XIL_TESTMEM_BURST) <= Count; I += XIL_TESTMEM_BURST) {
+		Acc = vorrq_u32(Acc, veorq_u32(vld1q_u32(&Ptr[I]), Exp0));
+		Acc = vorrq_u32(Acc, veorq_u32(vld1q_u32(&Ptr[I + 4U]), Exp1));
+		Exp0 = vaddq_u32(Exp0, Inc);
+		Exp1 = vaddq_u32(Exp1, Inc);
+	}
+	Diff = vgetq_lane_u32(Acc, 0) | vgetq_lane_u32(Acc, 1) |
+	       vgetq_lane_u32(Acc, 2) | vgetq_lane_u32(Acc, 3);
+	Expect = Val + (I * Step);
+#else
+	for (; (I + XIL_TESTMEM_BURST) <= Count; I += XIL_TESTMEM_BURST) {
+		Diff |= (Ptr[I] ^ Expect) |
+			(Ptr[I + 1U] ^ (Expect + Step)) |
+			(Ptr[I + 2U] ^ (Expect + (2U * Step))) |
+			(Ptr[I + 3U] ^ (Expect + (3U * Step))) |
+			(Ptr[I + 4U] ^ (Expect + (4U * Step))) |
+			(Ptr[I + 5U] ^ (Expect + (5U * Step))) |
+			(Ptr[I + 6U] ^ (Expect + (6U * Step))) |
+			(Ptr[I + 7U] ^ (Expect + (7U * Step)));
+		Expect += XIL_TESTMEM_BURST * Step;
+	}
+#endif
+	for (; I < Count; I++) {
+		Diff |= Ptr[I] ^ Expect;
+		Expect += Step;
+	}
+
+	if (Diff == 0U) {
+		return NULL;
+	}
+
+	Expect = Val;
+	for (I = 0U; I < Count; I++) {
+		if (Ptr[I] != Expect) {
+			return &Ptr[I];
+		}
+		Expect += Step;
+	}
+
+	return Ptr;
+}
+
+/*****************************************************************************/
+/**
+*
+* Write an arithmetic pattern, Val + Index * Step, to a block.
+*
+* @param    Ptr is the start of the block.
+* @param    Count is the number of words.
+* @param    Val is the value of the first word.
+* @param    Step is the difference between the words.
+*
+* @return   None.
+*
+* @note
+*
+* None.
+*
+*****************************************************************************/
+static void Xil_TestMemWriteBlock(u32 *Ptr, u32 Count, u32 Val, u32 Step)
+{
+	u32 I = 0U;
+	u32 Value = Val;
+#ifdef XIL_TESTMEM_NEON
+	u32 Init[4];
+	uint32x4_t Val0;
+	uint32x4_t Val1;
+	uint32x4_t Inc;
+
+	Init[0] = Val;
+	Init[1] = Val + Step;
+	Init[2] = Val + (2U * Step);
+	Init[3] = Val + (3U * Step);
+	Val0 = vld1q_u32(Init);
+	Val1 = vaddq_u32(Val0, vdupq_n_u32(4U * Step));
+	Inc = vdupq_n_u32(8U * Step);
+
+	for (; (I + XIL_TESTMEM_BURST) <= Count; I += XIL_TESTMEM_BURST) {
+		vst1q_u32(&Ptr[I], Val0);
+		vst1q_u32(&Ptr[I + 4U], Val1);
+		Val0 = vaddq_u32(Val0, Inc);
+		Val1 = vaddq_u32(Val1, Inc);
+	}
+	Value = Val + (I * Step);
+#else
+	for (; (I + XIL_TESTMEM_BURST) <= Count; I += XIL_TESTMEM_BURST) {
+		Ptr[I] = Value;
+		Ptr[I + 1U] = Value + Step;
+		Ptr[I + 2U] = Value + (2U * Step);
+		Ptr[I + 3U] = Value + (3U * Step);
+		Ptr[I + 4U] = Value + (4U * Step);
+		Ptr[I + 5U] = Value + (5U * Step);
+		Ptr[I + 6U] = Value + (6U * Step);
+		Ptr[I + 7U] = Value + (7U * Step);
+		Value += XIL_TESTMEM_BURST * Step;
+	}
+#endif
+	for (; I < Count; I++) {
+		Ptr[I] = Value;
+		Value += Step;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Record the first error of a test run.
+*
+* @param    State collects the error.
+* @param    Test is the failing subtest.
+* @param    FailPtr is the failing word.
+* @param    Expect is the value expected in it.
+*
+* @return   None.
+*
+* @note
+*
+* None.
+*
+*****************************************************************************/
+static void Xil_TestMemFail(Xil_TestMemState *State, u8 Test, u32 *FailPtr,
+			    u32 Expect)
+{
+	if (State->Result != NULL) {
+		State->Result->FailAddr = FailPtr;
+		State->Result->Expected = Expect;
+		State->Result->Actual = *FailPtr;
+		State->Result->FailTest = Test;
+	}
+}
+
 /*****************************************************************************/
 /**
 *
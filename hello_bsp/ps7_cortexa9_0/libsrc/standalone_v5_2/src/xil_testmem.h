@@ -79,6 +79,18 @@
 *       If zero is provided as the pattern the test uses '0xDEADBEEF".
 * </pre>
 *
+* <b>Fast engine</b>
+*
+* Xil_TestMemFast, which Xil_TestMem32 uses, checks each block of a subtest
+* just before writing the pattern of the next one, so that the incrementing
+* value, inverse address and fixed pattern tests take four passes over the
+* memory instead of six. It moves the data in bursts of 8 words, can report
+* the bandwidth of each subtest and the first error, and can have the fixed
+* pattern written by a DMA through Xil_TestMemSetFill. The bursts use NEON
+* only when the library is built with -mfpu=neon and -mfloat-abi=softfp or
+* hard; the default BSP flags select -mfloat-abi=soft, which leaves NEON
+* intrinsics unavailable, so the scalar burst loop is used.
+*
 * <i>WARNING</i>
 *
 * The tests are <b>DESTRUCTIVE</b>. Run before any initialized memory spaces
@@ -106,6 +118,7 @@
 * Ver    Who    Date    Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a hbm  08/25/09 First release
+* 5.2   ag   10/18/26 Added Xil_TestMemFast and Xil_TestMemSetFill.
 * </pre>
 *
 ******************************************************************************/
@@ -144,6 +157,23 @@ extern "C" {
 #define XIL_TESTMEM_MAXTEST         XIL_TESTMEM_FIXEDPATTERN
 /* @} */
 
+/**
+ * Outcome of Xil_TestMemFast
+ */
+typedef struct {
+	u32 MBps[XIL_TESTMEM_MAXTEST + 1U];	/**< Bandwidth per subtest */
+	u32 *FailAddr;		/**< First failing word, NULL if none */
+	u32 Expected;		/**< Value expected there */
+	u32 Actual;		/**< Value read there */
+	u8 FailTest;		/**< Failing subtest */
+} Xil_TestMemResult;
+
+/**
+ * Writes Words words of Value from Addr, see Xil_TestMemSetFill
+ */
+typedef s32 (*Xil_TestMemFillFunc)(void *CallBackRef, u32 *Addr, u32 Words,
+				   u32 Value);
+
 /***************** Macros (Inline Functions) Definitions *********************/
 
 
@@ -154,6 +184,9 @@ extern "C" {
 extern s32 Xil_TestMem32(u32 *Addr, u32 Words, u32 Pattern, u8 Subtest);
 extern s32 Xil_TestMem16(u16 *Addr, u32 Words, u16 Pattern, u8 Subtest);
 extern s32 Xil_TestMem8(u8 *Addr, u32 Words, u8 Pattern, u8 Subtest);
+extern s32 Xil_TestMemFast(u32 *Addr, u32 Words, u32 Pattern, u8 Subtest,
+			   Xil_TestMemResult *Result);
+extern void Xil_TestMemSetFill(Xil_TestMemFillFunc Fill, void *CallBackRef);
 
 #ifdef __cplusplus
 }
@@ -44,6 +44,7 @@
 * 1.00a sdm  02/01/10 Initial version
 * 3.10a srt 04/18/13 Implemented ARM Erratas. Please refer to file
 *		      'xil_errata.h' for errata description
+* 5.2   ag   10/18/26 Added the prefetch control register
 * </pre>
 *
 * @note
@@ -114,6 +115,7 @@ extern "C" {
 #define XPS_L2CC_ADDR_FILTER_END_OFFSET		0x0C04U		/* Start of address filtering */
 
 #define XPS_L2CC_DEBUG_CTRL_OFFSET		0x0F40U		/* Debug Control Register */
+#define XPS_L2CC_PREFETCH_CTRL_OFFSET		0x0F60U		/* Prefetch Control Register */
 
 /* XPS_L2CC_CNTRL_OFFSET bit masks */
 #define XPS_L2CC_ENABLE_MASK		0x00000001U	/* enables the L2CC */
@@ -145,6 +147,15 @@ extern "C" {
 #define XPS_L2CC_TAG_RAM_DEFAULT_MASK	0x00000111U	/* latency for TAG RAM */
 #define XPS_L2CC_DATA_RAM_DEFAULT_MASK	0x00000121U	/* latency for DATA RAM */
 
+/* XPS_L2CC_PREFETCH_CTRL_OFFSET bit masks */
+#define XPS_L2CC_PREF_DLFE_MASK		0x40000000U	/* Double linefill enable */
+#define XPS_L2CC_PREF_IPFE_MASK		0x20000000U	/* Instruction prefetch enable */
+#define XPS_L2CC_PREF_DPFE_MASK		0x10000000U	/* Data prefetch enable */
+#define XPS_L2CC_PREF_DLWRAPD_MASK	0x08000000U	/* Double linefill on WRAP read disable */
+#define XPS_L2CC_PREF_PDE_MASK		0x01000000U	/* Prefetch drop enable */
+#define XPS_L2CC_PREF_INCRDLFE_MASK	0x00800000U	/* INCR double linefill enable */
+#define XPS_L2CC_PREF_OFFSET_MASK	0x0000001FU	/* Prefetch offset */
+
 /* Interrupt bit masks */
 #define XPS_L2CC_IXR_DECERR_MASK	0x00000100U	/* DECERR from L3 */
 #define XPS_L2CC_IXR_SLVERR_MASK	0x00000080U	/* SLVERR from L3 */
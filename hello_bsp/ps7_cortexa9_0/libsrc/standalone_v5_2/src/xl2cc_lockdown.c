@@ -0,0 +1,364 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xl2cc_lockdown.c
+*
+* This file contains APIs for locking code and data into ways of the PL310
+* L2 cache controller. For more information, see xl2cc_lockdown.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xparameters_ps.h"
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xil_assert.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xstatus.h"
+#include "xl2cc.h"
+#include "xl2cc_counter.h"
+#include "xl2cc_lockdown.h"
+
+/************************** Constant Definitions ****************************/
+
+#define XL2CC_LINE_SIZE		32U
+#define XL2CC_LOCKDOWN_STRIDE	8U
+
+#define IRQ_FIQ_MASK		0xC0U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions *****************************/
+
+/************************** Function Prototypes ******************************/
+
+static void XL2cc_SetLockdown(u32 WayMask);
+static void XL2cc_CleanInvalidateWays(u32 WayMask);
+
+/******************************************************************************/
+
+/****************************************************************************/
+/**
+*
+* This function returns the number of ways of the L2 cache.
+*
+* @param	None.
+*
+* @return	8 or 16, from the associativity bit of the auxiliary control
+*		register.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XL2cc_GetNumWays(void)
+{
+	u32 Aux = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET);
+
+	return ((Aux & XPS_L2CC_AUX_ASSOC_MASK) != 0U) ? 16U : 8U;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the size of one way of the L2 cache.
+*
+* @param	None.
+*
+* @return	Way size in bytes, from the way-size field of the auxiliary
+*		control register.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XL2cc_GetWaySize(void)
+{
+	u32 Aux = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_AUX_CNTRL_OFFSET);
+	u32 Field = (Aux & XPS_L2CC_AUX_WAY_SIZE_MASK) >> 17U;
+
+	if (Field == 0U) {
+		Field = 1U;
+	}
+
+	return (u32)0x2000U << Field;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the ways locked for the data accesses of master 0,
+* which the APIs of this file keep the same for all masters.
+*
+* @param	None.
+*
+* @return	Mask with a bit set for each locked way.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XL2cc_GetLockedWays(void)
+{
+	return Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET) &
+	       0x0000FFFFU;
+}
+
+/****************************************************************************/
+/**
+*
+* This function loads a range of code or data into the chosen ways of the L2
+* cache and locks the ways.
+*
+* The range is flushed and the ways are cleaned and invalidated, so that
+* every line of the range misses in L2. With all other ways locked the range
+* is then read line by line, which allocates it into the chosen ways only.
+* Finally the chosen ways are locked for all masters, next to the ways that
+* were locked before.
+*
+* @param	Addr is the start of the range.
+* @param	Len is the length of the range in bytes. It must fit into the
+*		chosen ways, XL2cc_GetWaySize() bytes per way.
+* @param	WayMask has a bit set for each way to use. The ways must not be
+*		locked already and at least one way must stay unlocked.
+*
+* @return	XST_SUCCESS, or XST_INVALID_PARAM if the ways or the length do
+*		not fit.
+*
+* @note		Interrupts are masked while the range is read in. Traffic of
+*		the other CPU or of DMA masters in that time can allocate into
+*		the chosen ways too, so lock before they are started. Whole
+*		cache flushes keep the locked lines, see Xil_L2CacheFlush.
+*
+*****************************************************************************/
+s32 XL2cc_LockRange(INTPTR Addr, u32 Len, u32 WayMask)
+{
+	u32 AllWays = ((u32)1U << XL2cc_GetNumWays()) - 1U;
+	u32 Locked = XL2cc_GetLockedWays();
+	u32 NumWays = 0U;
+	u32 Way;
+	u32 LocalAddr;
+	u32 End;
+	u32 CurrMask;
+
+	Xil_AssertNonvoid(WayMask != 0U);
+
+	if (((WayMask & ~AllWays) != 0U) || ((WayMask & Locked) != 0U) ||
+	    ((WayMask | Locked) == AllWays)) {
+		return XST_INVALID_PARAM;
+	}
+
+	for (Way = WayMask; Way != 0U; Way &= Way - 1U) {
+		NumWays++;
+	}
+	if (Len > (NumWays * XL2cc_GetWaySize())) {
+		return XST_INVALID_PARAM;
+	}
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	Xil_DCacheFlushRange(Addr, Len);
+	XL2cc_CleanInvalidateWays(WayMask);
+
+	/* Allocate only into the chosen ways while reading the range in */
+	XL2cc_SetLockdown(AllWays & ~WayMask);
+	dsb();
+
+	LocalAddr = (u32)Addr & ~(XL2CC_LINE_SIZE - 1U);
+	End = (u32)Addr + Len;
+	while (LocalAddr < End) {
+		(void)*(volatile u32 *)LocalAddr;
+		LocalAddr += XL2CC_LINE_SIZE;
+	}
+	dsb();
+
+	XL2cc_SetLockdown(Locked | WayMask);
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET, 0U);
+	dsb();
+
+	mtcpsr(CurrMask);
+
+	return XST_SUCCESS;
+}
+
+/****************************************************************************/
+/**
+*
+* This function unlocks ways of the L2 cache for all masters.
+*
+* @param	WayMask has a bit set for each way to unlock.
+*
+* @return	None.
+*
+* @note		The lines in the ways stay valid and are replaced normally
+*		from then on.
+*
+*****************************************************************************/
+void XL2cc_UnlockWays(u32 WayMask)
+{
+	u32 CurrMask;
+
+	CurrMask = mfcpsr();
+	mtcpsr(CurrMask | IRQ_FIQ_MASK);
+
+	XL2cc_SetLockdown(XL2cc_GetLockedWays() & ~WayMask);
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET, 0U);
+	dsb();
+
+	mtcpsr(CurrMask);
+}
+
+/****************************************************************************/
+/**
+*
+* This function starts counting the data read hits and requests of the L2
+* cache on the event counters.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		The event counters are shared with XL2cc_EventCtrInit users.
+*
+*****************************************************************************/
+void XL2cc_HitRateStart(void)
+{
+	XL2cc_EventCtrInit(XL2CC_DRHIT, XL2CC_DRREQ);
+	XL2cc_EventCtrStart();
+}
+
+/****************************************************************************/
+/**
+*
+* This function stops the event counters started by XL2cc_HitRateStart and
+* returns the data read hit rate.
+*
+* @param	Hits is an output parameter for the number of data read hits,
+*		or NULL.
+* @param	Requests is an output parameter for the number of data read
+*		requests, or NULL.
+*
+* @return	Hit rate in tenths of a percent, 0 if there was no request.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XL2cc_HitRateStop(u32 *Hits, u32 *Requests)
+{
+	u32 HitCount;
+	u32 ReqCount;
+
+	XL2cc_EventCtrStop(&HitCount, &ReqCount);
+
+	if (Hits != NULL) {
+		*Hits = HitCount;
+	}
+	if (Requests != NULL) {
+		*Requests = ReqCount;
+	}
+	if (ReqCount == 0U) {
+		return 0U;
+	}
+
+	return (u32)(((u64)HitCount * 1000U) / ReqCount);
+}
+
+/****************************************************************************/
+/**
+*
+* This function writes a way mask to the data and instruction lockdown
+* registers of all masters.
+*
+* @param	WayMask has a bit set for each way to lock.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XL2cc_SetLockdown(u32 WayMask)
+{
+	u32 Master;
+	u32 Offset;
+
+	for (Master = 0U; Master < XL2CC_LOCKDOWN_MASTERS; Master++) {
+		Offset = Master * XL2CC_LOCKDOWN_STRIDE;
+		Xil_Out32(XPS_L2CC_BASEADDR +
+			  XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET + Offset, WayMask);
+		Xil_Out32(XPS_L2CC_BASEADDR +
+			  XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET + Offset, WayMask);
+	}
+}
+
+/****************************************************************************/
+/**
+*
+* This function cleans and invalidates ways of the L2 cache and waits until
+* the background operation is done.
+*
+* @param	WayMask has a bit set for each way.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XL2cc_CleanInvalidateWays(u32 WayMask)
+{
+#if defined(CONFIG_PL310_ERRATA_588369) || defined(CONFIG_PL310_ERRATA_727915)
+	/* Disable Write-back and line fills */
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_DEBUG_CTRL_OFFSET, 0x3U);
+#endif
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_WAY_OFFSET,
+		  WayMask);
+	while ((Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_INV_CLN_WAY_OFFSET) &
+		WayMask) != 0U) {
+		;
+	}
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET, 0U);
+#if defined(CONFIG_PL310_ERRATA_588369) || defined(CONFIG_PL310_ERRATA_727915)
+	/* Enable Write-back and line fills */
+	Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_DEBUG_CTRL_OFFSET, 0x0U);
+#endif
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xl2cc_lockdown.h
+*
+* This header file contains APIs for locking code and data into ways of the
+* PL310 L2 cache controller.
+*
+* The PL310 has a data and an instruction lockdown register for each master.
+* A set bit keeps the master from allocating new lines into that way, but
+* lines already in the way still hit. XL2cc_LockRange() empties the chosen
+* ways, opens only them for allocation, reads the range in and then closes
+* them for every master, so that the range stays in L2 whatever traffic
+* follows. Code and data are locked the same way, the L2 is unified.
+*
+* The other ways keep serving all masters and get the whole traffic, so lock
+* no more than needed. XL2cc_UnlockWays() opens the ways again, their lines
+* then age out normally.
+*
+* XL2cc_HitRateStart() and XL2cc_HitRateStop() count the data read hits and
+* requests with the event counters of xl2cc_counter.h, to show the effect
+* of the lock on a piece of code.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 5.2   ag   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#ifndef XL2CC_LOCKDOWN_H /* prevent circular inclusions */
+#define XL2CC_LOCKDOWN_H /* by using protection macros */
+
+/***************************** Include Files ********************************/
+
+#include "xil_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/************************** Constant Definitions ****************************/
+
+/*
+ * Number of master lockdown register pairs of the PL310 in Zynq
+ */
+#define XL2CC_LOCKDOWN_MASTERS	8U
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Variable Definitions ****************************/
+
+/************************** Function Prototypes *****************************/
+
+u32 XL2cc_GetNumWays(void);
+u32 XL2cc_GetWaySize(void);
+u32 XL2cc_GetLockedWays(void);
+s32 XL2cc_LockRange(INTPTR Addr, u32 Len, u32 WayMask);
+void XL2cc_UnlockWays(u32 WayMask);
+void XL2cc_HitRateStart(void);
+u32 XL2cc_HitRateStop(u32 *Hits, u32 *Requests);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* XL2CC_LOCKDOWN_H */
@@ -46,6 +46,9 @@
 * 1.00a sdm  07/11/11 First release
 * 4.2	pkp	 07/21/14 Corrected reset value of event counter in function
 *					  Xpm_ResetEventCounters to fix CR#796275
+* 5.2   ag   10/18/26 Added Xpm_EnableCycleCounter and Xpm_GetCycleCounter.
+* 5.2   ag   10/18/26 Added Xpm_StartCycleCounter, which does not reset a
+*		      running cycle counter, for library code.
 * </pre>
 *
 ******************************************************************************/
@@ -56,6 +59,10 @@
 
 /************************** Constant Definitions ****************************/
 
+#define XPM_PMCR_ENABLE		0x00000001U	/* E: enable all counters */
+#define XPM_PMCR_CCNT_RESET	0x00000004U	/* C: reset cycle counter */
+#define XPM_CCNT_ENABLE		0x80000000U	/* Cycle counter enable bit */
+
 /**************************** Type Definitions ******************************/
 
 typedef const u32 PmcrEventCfg32[XPM_CTRCOUNT];
@@ -294,3 +301,104 @@ void Xpm_GetEventCounters(u32 *PmCtrValue)
 #endif
 	}
 }
+
+/****************************************************************************/
+/**
+*
+* This function resets the Cortex A9 cycle counter and starts it counting
+* every CPU clock cycle. The event counters are not affected.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void Xpm_EnableCycleCounter(void)
+{
+	u32 Reg;
+#ifdef __GNUC__
+	Reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+#elif defined (__ICCARM__)
+	mfcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+#else
+	{ register u32 C15Reg __asm(XREG_CP15_PERF_MONITOR_CTRL);
+	  Reg = C15Reg; }
+#endif
+	/* Count every cycle (D = 0), reset and enable */
+	Reg &= ~(1U << 3U);
+	Reg |= XPM_PMCR_ENABLE | XPM_PMCR_CCNT_RESET;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, XPM_CCNT_ENABLE);
+}
+
+/****************************************************************************/
+/**
+*
+* This function starts the Cortex A9 cycle counter counting every CPU clock
+* cycle if it is not running yet. A running counter is left alone, so that
+* measurements in progress elsewhere are not disturbed.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		Library code measuring differences of Xpm_GetCycleCounter
+*		readings calls this rather than Xpm_EnableCycleCounter, which
+*		resets the counter.
+*
+*****************************************************************************/
+void Xpm_StartCycleCounter(void)
+{
+	u32 Reg;
+	u32 Enabled;
+#ifdef __GNUC__
+	Reg = mfcp(XREG_CP15_PERF_MONITOR_CTRL);
+	Enabled = mfcp(XREG_CP15_COUNT_ENABLE_SET);
+#elif defined (__ICCARM__)
+	mfcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	mfcp(XREG_CP15_COUNT_ENABLE_SET, Enabled);
+#else
+	{ register u32 C15Reg __asm(XREG_CP15_PERF_MONITOR_CTRL);
+	  Reg = C15Reg; }
+	{ register u32 C15Reg __asm(XREG_CP15_COUNT_ENABLE_SET);
+	  Enabled = C15Reg; }
+#endif
+	if (((Reg & XPM_PMCR_ENABLE) != 0U) &&
+	    ((Enabled & XPM_CCNT_ENABLE) != 0U)) {
+		return;
+	}
+
+	/* Count every cycle (D = 0) and enable, without a reset */
+	Reg &= ~(1U << 3U);
+	Reg |= XPM_PMCR_ENABLE;
+	mtcp(XREG_CP15_PERF_MONITOR_CTRL, Reg);
+	mtcp(XREG_CP15_COUNT_ENABLE_SET, XPM_CCNT_ENABLE);
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the current value of the Cortex A9 cycle counter.
+*
+* @param	None.
+*
+* @return	Number of CPU cycles since Xpm_EnableCycleCounter, modulo 2^32.
+*
+* @note		Differences of two readings are valid across one wrap.
+*
+*****************************************************************************/
+u32 Xpm_GetCycleCounter(void)
+{
+	u32 Cycles;
+#ifdef __GNUC__
+	Cycles = mfcp(XREG_CP15_PERF_CYCLE_COUNTER);
+#elif defined (__ICCARM__)
+	mfcp(XREG_CP15_PERF_CYCLE_COUNTER, Cycles);
+#else
+	{ register u32 C15Reg __asm(XREG_CP15_PERF_CYCLE_COUNTER);
+	  Cycles = C15Reg; }
+#endif
+	return Cycles;
+}
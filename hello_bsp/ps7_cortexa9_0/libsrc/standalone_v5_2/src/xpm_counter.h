@@ -46,8 +46,11 @@
 *
 * @note
 *
-* This file doesn't handle the Cortex-A9 cycle counter, as the cycle counter is
-* being used for time keeping.
+* The cycle counter is handled separately from the event counters:
+* Xpm_EnableCycleCounter resets and starts it, Xpm_StartCycleCounter only
+* starts it if it is stopped, and Xpm_GetCycleCounter reads it. Time
+* keeping uses the global timer (xtime_l.h), so the cycle counter is free for
+* measurements. It counts CPU clock cycles and wraps after 2^32 cycles.
 *
 * <pre>
 * MODIFICATION HISTORY:
@@ -55,6 +58,8 @@
 * Ver   Who  Date     Changes
 * ----- ---- -------- -----------------------------------------------
 * 1.00a sdm  07/11/11 First release
+* 5.2   ag   10/18/26 Added Xpm_EnableCycleCounter and Xpm_GetCycleCounter.
+* 5.2   ag   10/18/26 Added Xpm_StartCycleCounter.
 * </pre>
 *
 ******************************************************************************/
@@ -563,6 +568,9 @@ extern "C" {
 /* Interface fuctions to access perfromance counters from abstraction layer */
 void Xpm_SetEvents(s32 PmcrCfg);
 void Xpm_GetEventCounters(u32 *PmCtrValue);
+void Xpm_EnableCycleCounter(void);
+void Xpm_StartCycleCounter(void);
+u32 Xpm_GetCycleCounter(void);
 
 #ifdef __cplusplus
 }
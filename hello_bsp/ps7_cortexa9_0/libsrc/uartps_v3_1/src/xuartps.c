@@ -154,6 +154,10 @@ s32 XUartPs_CfgInitialize(XUartPs *InstancePtr,
 	InstancePtr->ReceiveBuffer.RemainingBytes = 0U;
 	InstancePtr->ReceiveBuffer.RequestedBytes = 0U;
 
+	InstancePtr->MsgRing.Enabled = 0U;
+	InstancePtr->MsgRing.Head = 0U;
+	InstancePtr->MsgRing.Tail = 0U;
+
 	/* Initialize the platform data */
 	InstancePtr->Platform = XGetPlatform_Info();
 
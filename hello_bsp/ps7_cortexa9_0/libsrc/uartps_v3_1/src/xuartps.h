@@ -111,6 +111,16 @@
 * driver to allow data to be sent and received. They can be used in either
 * polled or interrupt mode.
 *
+* <b>Message Mode</b>
+*
+* For frame oriented protocols XUartPs_SetMsgMode() switches reception to
+* message mode. The interrupt handler then drains the RX FIFO in bursts into
+* an application supplied ring and closes a message when the delimiter byte
+* arrives or the line goes idle for the RX timeout. Each complete message is
+* reported to the handler with XUARTPS_EVENT_RECV_MSG and its length, and is
+* copied out with XUartPs_MsgRead(), either from the handler or later from
+* task context. XUartPs_Recv() must not be used while message mode is active.
+*
 * @note
 *
 * The default configuration for the UART after initialization is:
@@ -159,6 +169,9 @@
 *			Support for Zynq Ultrascale Mp added.
 * 3.1	kvn    04/10/15 Modified code for latest RTL changes. Also added
 *						platform variable in driver instance structure.
+* 3.1   ag     10/18/26 Added message (framed receive) mode which buffers
+*			received bytes in a ring and reports whole messages
+*			on RX timeout or delimiter, see xuartps_msg.c.
 *
 * </pre>
 *
@@ -267,6 +280,23 @@ extern "C" {
 #define XUARTPS_EVENT_PARE_FRAME_BRKE	6U /**< A receive parity, frame, break
 											 *	error detected */
 #define XUARTPS_EVENT_RECV_ORERR		7U /**< A receive overrun error detected */
+#define XUARTPS_EVENT_RECV_MSG			8U /**< A complete message is queued
+											 *	in message mode */
+/*@}*/
+
+/** @name Message Mode
+ *
+ * Constants used with XUartPs_SetMsgMode(). Each queued message occupies
+ * XUARTPS_MSG_HDR_SIZE bytes of length header plus its data in the ring.
+ *
+ * @{
+ */
+#define XUARTPS_MSG_NO_DELIMITER	0x100U	/**< Frame on RX timeout only */
+#define XUARTPS_MSG_HDR_SIZE		2U		/**< Length header per message */
+#define XUARTPS_MSG_MAX_LEN			0xFFFFU	/**< Longest single message */
+#define XUARTPS_MSG_FIFO_TRIGGER	32U		/**< RX FIFO trigger level used */
+#define XUARTPS_MSG_DEF_TIMEOUT		2U		/**< RX timeout used if none set,
+											 *	in units of 4 bit periods */
 /*@}*/
 
 
@@ -290,6 +320,23 @@ typedef struct {
 	u32 RemainingBytes;
 } XUartPsBuffer;
 
+/*
+ * Keep track of the receive ring used in message mode. Head and the message
+ * in progress are only updated by the interrupt handler, Tail only by
+ * XUartPs_MsgRead().
+ */
+typedef struct {
+	u8 *RingPtr;		/* Ring storage supplied by the application */
+	u32 RingMask;		/* Ring size - 1, size is a power of 2 */
+	volatile u32 Head;	/* End of the last complete message */
+	volatile u32 Tail;	/* Start of the oldest unread message */
+	u32 MsgLen;			/* Bytes of the message being received */
+	u32 Delimiter;		/* Delimiter byte or XUARTPS_MSG_NO_DELIMITER */
+	volatile u32 Dropped;	/* Messages dropped because the ring was full */
+	u8 Enabled;			/* Message mode is active */
+	u8 Discard;			/* Drop the remainder of the current message */
+} XUartPsMsgRing;
+
 /**
  * Keep track of data format setting of a device.
  */
@@ -332,6 +379,7 @@ typedef struct {
 
 	XUartPsBuffer SendBuffer;
 	XUartPsBuffer ReceiveBuffer;
+	XUartPsMsgRing MsgRing;		/* Message mode receive state */
 
 	XUartPs_Handler Handler;
 	void *CallBackRef;	/* Callback reference for event handler */
@@ -497,6 +545,18 @@ void XUartPs_InterruptHandler(XUartPs *InstancePtr);
 void XUartPs_SetHandler(XUartPs *InstancePtr, XUartPs_Handler FuncPtr,
 			 void *CallBackRef);
 
+/* message mode functions in xuartps_msg.c */
+s32 XUartPs_SetMsgMode(XUartPs *InstancePtr, u8 *RingPtr, u32 RingSize,
+			 u32 Delimiter);
+
+void XUartPs_DisableMsgMode(XUartPs *InstancePtr);
+
+u32 XUartPs_MsgRead(XUartPs *InstancePtr, u8 *BufferPtr, u32 NumBytes);
+
+u32 XUartPs_MsgPending(XUartPs *InstancePtr);
+
+void XUartPs_MsgReceive(XUartPs *InstancePtr, u32 IsrStatus);
+
 /* self-test functions in xuartps_selftest.c */
 s32 XUartPs_SelfTest(XUartPs *InstancePtr);
 
@@ -46,6 +46,8 @@
 * 1.00  drg/jz 01/13/10 First Release
 * 3.00  kvn    02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1	kvn    04/10/15 Modified code for latest RTL changes.
+* 3.1   ag     10/18/26 Route receive data and timeout interrupts to
+*			XUartPs_MsgReceive() when message mode is enabled.
 * </pre>
 *
 *****************************************************************************/
@@ -199,11 +201,21 @@ void XUartPs_InterruptHandler(XUartPs *InstancePtr)
 				   XUARTPS_ISR_OFFSET);
 
 	/* Dispatch an appropriate handler. */
-	if((IsrStatus & ((u32)XUARTPS_IXR_RXOVR | (u32)XUARTPS_IXR_RXEMPTY |
+	if (InstancePtr->MsgRing.Enabled != 0U) {
+		/* Message mode owns the receive data and timeout interrupts */
+		if((IsrStatus & ((u32)XUARTPS_IXR_RXOVR | (u32)XUARTPS_IXR_RXFULL |
+				(u32)XUARTPS_IXR_TOUT)) != (u32)0) {
+			XUartPs_MsgReceive(InstancePtr, IsrStatus);
+		}
+	}
+	else if((IsrStatus & ((u32)XUARTPS_IXR_RXOVR | (u32)XUARTPS_IXR_RXEMPTY |
 			(u32)XUARTPS_IXR_RXFULL)) != (u32)0) {
 		/* Received data interrupt */
 		ReceiveDataHandler(InstancePtr);
 	}
+	else {
+		/* No receive data */
+	}
 
 	if((IsrStatus & ((u32)XUARTPS_IXR_TXEMPTY | (u32)XUARTPS_IXR_TXFULL))
 									 != (u32)0) {
@@ -218,7 +230,8 @@ void XUartPs_InterruptHandler(XUartPs *InstancePtr)
 		ReceiveErrorHandler(InstancePtr);
 	}
 
-	if((IsrStatus & ((u32)XUARTPS_IXR_TOUT)) != (u32)0) {
+	if(((IsrStatus & ((u32)XUARTPS_IXR_TOUT)) != (u32)0) &&
+			(InstancePtr->MsgRing.Enabled == 0U)) {
 		/* Received Timeout interrupt */
 		ReceiveTimeoutHandler(InstancePtr);
 	}
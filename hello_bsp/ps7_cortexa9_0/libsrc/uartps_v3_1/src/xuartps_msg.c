@@ -0,0 +1,404 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file xuartps_msg.c
+* @addtogroup uartps_v3_1
+* @{
+*
+* This file contains the message (framed receive) mode of the XUartPs driver.
+*
+* In message mode the interrupt handler moves received bytes into a ring
+* supplied by the application and only involves the application once a
+* whole message is available. A message ends when the configured delimiter
+* byte is received (the delimiter is kept as the last byte of the message)
+* or when the receive line has been idle for the RX timeout. The RX FIFO
+* trigger is raised to XUARTPS_MSG_FIFO_TRIGGER and the FIFO is drained in
+* bursts of that size, so a typical command costs one or two interrupts
+* instead of one per byte or per small FIFO threshold.
+*
+* Each message is stored in the ring behind a XUARTPS_MSG_HDR_SIZE byte
+* little endian length header. If the ring cannot hold the remainder of a
+* message the whole message is dropped and MsgRing.Dropped is incremented;
+* messages that were already complete are never overwritten.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date	Changes
+* ----- ------ -------- -----------------------------------------------
+* 3.1   ag     10/18/26 First release
+* </pre>
+*
+*****************************************************************************/
+
+/***************************** Include Files ********************************/
+
+#include <string.h>
+#include "xuartps.h"
+
+/************************** Constant Definitions ****************************/
+
+/* Interrupts that make up the receive path in message mode */
+#define XUARTPS_MSG_RX_IXR	((u32)XUARTPS_IXR_RXOVR | (u32)XUARTPS_IXR_TOUT | \
+				 (u32)XUARTPS_IXR_OVER | (u32)XUARTPS_IXR_FRAMING | \
+				 (u32)XUARTPS_IXR_PARITY)
+
+/**************************** Type Definitions ******************************/
+
+/***************** Macros (Inline Functions) Definitions ********************/
+
+/************************** Function Prototypes *****************************/
+
+static void XUartPs_MsgPutByte(XUartPs *InstancePtr, u8 Data);
+static void XUartPs_MsgEnd(XUartPs *InstancePtr);
+
+/************************** Variable Definitions ****************************/
+
+/****************************************************************************/
+/**
+*
+* This function switches the receive path of the device to message mode.
+* The receive FIFO trigger level is set to XUARTPS_MSG_FIFO_TRIGGER, the RX
+* timeout is set to XUARTPS_MSG_DEF_TIMEOUT if it is currently disabled and
+* the receive interrupts needed for message mode are enabled. Complete
+* messages are reported to the handler set by XUartPs_SetHandler() with the
+* XUARTPS_EVENT_RECV_MSG event and the message length as event data.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	RingPtr is the ring storage for received messages. It must stay
+*		valid until message mode is disabled.
+* @param	RingSize is the size of the ring in bytes. It must be a power
+*		of 2 and larger than XUARTPS_MSG_HDR_SIZE.
+* @param	Delimiter is the byte that terminates a message, or
+*		XUARTPS_MSG_NO_DELIMITER to delimit messages only by the RX
+*		timeout.
+*
+* @return
+*		- XST_SUCCESS if message mode was enabled.
+*		- XST_INVALID_PARAM if RingSize is not a power of 2.
+*		- XST_DEVICE_BUSY if a XUartPs_Recv() request is in progress.
+*
+* @note		Use XUartPs_SetRecvTimeout() before this call to select a
+*		different idle time for the end of a message.
+*
+*****************************************************************************/
+s32 XUartPs_SetMsgMode(XUartPs *InstancePtr, u8 *RingPtr, u32 RingSize,
+			 u32 Delimiter)
+{
+	s32 Status;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(RingPtr != NULL);
+	Xil_AssertNonvoid(RingSize > XUARTPS_MSG_HDR_SIZE);
+	Xil_AssertNonvoid(Delimiter <= XUARTPS_MSG_NO_DELIMITER);
+	Xil_AssertNonvoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	if ((RingSize & (RingSize - 1U)) != 0U) {
+		Status = XST_INVALID_PARAM;
+	} else if (InstancePtr->ReceiveBuffer.RemainingBytes != 0U) {
+		Status = XST_DEVICE_BUSY;
+	} else {
+		/* Quiesce the receive interrupts while the ring is set up */
+		XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XUARTPS_IDR_OFFSET, XUARTPS_IXR_RXEMPTY |
+				 XUARTPS_IXR_RXFULL | XUARTPS_MSG_RX_IXR);
+
+		InstancePtr->MsgRing.RingPtr = RingPtr;
+		InstancePtr->MsgRing.RingMask = RingSize - 1U;
+		InstancePtr->MsgRing.Head = 0U;
+		InstancePtr->MsgRing.Tail = 0U;
+		InstancePtr->MsgRing.MsgLen = 0U;
+		InstancePtr->MsgRing.Delimiter = Delimiter;
+		InstancePtr->MsgRing.Dropped = 0U;
+		InstancePtr->MsgRing.Discard = 0U;
+		InstancePtr->MsgRing.Enabled = 1U;
+
+		XUartPs_SetFifoThreshold(InstancePtr,
+					 (u8)XUARTPS_MSG_FIFO_TRIGGER);
+		if (XUartPs_GetRecvTimeout(InstancePtr) ==
+					(u8)XUARTPS_RXTOUT_DISABLE) {
+			XUartPs_SetRecvTimeout(InstancePtr,
+					 (u8)XUARTPS_MSG_DEF_TIMEOUT);
+		}
+
+		/* Clear stale receive status and enable the receive path */
+		XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XUARTPS_ISR_OFFSET, XUARTPS_MSG_RX_IXR);
+		XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+				 XUARTPS_IER_OFFSET, XUARTPS_MSG_RX_IXR);
+
+		Status = XST_SUCCESS;
+	}
+
+	return Status;
+}
+
+/****************************************************************************/
+/**
+*
+* This function leaves message mode. The receive interrupts enabled by
+* XUartPs_SetMsgMode() are disabled, a partially received message is
+* discarded and complete messages still in the ring are no longer
+* accessible.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+void XUartPs_DisableMsgMode(XUartPs *InstancePtr)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	XUartPs_WriteReg(InstancePtr->Config.BaseAddress,
+			 XUARTPS_IDR_OFFSET, XUARTPS_MSG_RX_IXR);
+
+	InstancePtr->MsgRing.Enabled = 0U;
+	InstancePtr->MsgRing.Head = 0U;
+	InstancePtr->MsgRing.Tail = 0U;
+	InstancePtr->MsgRing.MsgLen = 0U;
+}
+
+/****************************************************************************/
+/**
+*
+* This function returns the length of the oldest complete message in the
+* ring without removing it.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	Length of the next message in bytes, 0 if none is queued.
+*
+* @note		None.
+*
+*****************************************************************************/
+u32 XUartPs_MsgPending(XUartPs *InstancePtr)
+{
+	XUartPsMsgRing *Ring;
+	u32 Tail;
+	u32 Length = 0U;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+
+	Ring = &InstancePtr->MsgRing;
+	Tail = Ring->Tail;
+	if (Ring->Head != Tail) {
+		Length = (u32)Ring->RingPtr[Tail & Ring->RingMask] |
+			 ((u32)Ring->RingPtr[(Tail + 1U) & Ring->RingMask] << 8U);
+	}
+
+	return Length;
+}
+
+/****************************************************************************/
+/**
+*
+* This function removes the oldest complete message from the ring and copies
+* it to the given buffer. It may be called from the XUARTPS_EVENT_RECV_MSG
+* callback or from task context.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	BufferPtr is the buffer the message is copied to.
+* @param	NumBytes is the size of the buffer. A longer message is
+*		truncated to NumBytes but still removed from the ring as a
+*		whole.
+*
+* @return	Length of the message in bytes, which is larger than NumBytes
+*		if it was truncated, or 0 if no message is queued.
+*
+* @note		Only one context may read messages from a given instance.
+*
+*****************************************************************************/
+u32 XUartPs_MsgRead(XUartPs *InstancePtr, u8 *BufferPtr, u32 NumBytes)
+{
+	XUartPsMsgRing *Ring;
+	u32 Length;
+	u32 Copy;
+	u32 Index;
+	u32 First;
+
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(BufferPtr != NULL);
+
+	Length = XUartPs_MsgPending(InstancePtr);
+	if (Length != 0U) {
+		Ring = &InstancePtr->MsgRing;
+		Copy = (Length < NumBytes) ? Length : NumBytes;
+		Index = (Ring->Tail + XUARTPS_MSG_HDR_SIZE) & Ring->RingMask;
+
+		/* Copy in at most two pieces when the message wraps */
+		First = (Ring->RingMask + 1U) - Index;
+		if (First > Copy) {
+			First = Copy;
+		}
+		(void)memcpy(BufferPtr, &Ring->RingPtr[Index], First);
+		(void)memcpy(&BufferPtr[First], Ring->RingPtr, Copy - First);
+
+		/* Data must be copied out before the space is released */
+		dmb();
+		Ring->Tail += XUARTPS_MSG_HDR_SIZE + Length;
+	}
+
+	return Length;
+}
+
+/****************************************************************************/
+/**
+*
+* This function is the receive part of XUartPs_InterruptHandler() while
+* message mode is enabled. It drains the RX FIFO into the ring, reading
+* XUARTPS_MSG_FIFO_TRIGGER bytes at a time without polling the status
+* register while the FIFO is above the trigger level, and ends the current
+* message on a receive timeout.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	IsrStatus is the pending and enabled interrupt status.
+*
+* @return	None.
+*
+* @note		This function is called by the driver interrupt handler and
+*		should not be called by the application.
+*
+*****************************************************************************/
+void XUartPs_MsgReceive(XUartPs *InstancePtr, u32 IsrStatus)
+{
+	u32 BaseAddress = InstancePtr->Config.BaseAddress;
+	u32 Burst;
+	u32 CrRegister;
+
+	/* The FIFO holds at least a full trigger level while SR_RXOVR is set */
+	while ((XUartPs_ReadReg(BaseAddress, XUARTPS_SR_OFFSET) &
+			(u32)XUARTPS_SR_RXOVR) != 0U) {
+		for (Burst = 0U; Burst < XUARTPS_MSG_FIFO_TRIGGER; Burst++) {
+			XUartPs_MsgPutByte(InstancePtr,
+				(u8)XUartPs_ReadReg(BaseAddress,
+						    XUARTPS_FIFO_OFFSET));
+		}
+	}
+
+	while (XUartPs_IsReceiveData(BaseAddress)) {
+		XUartPs_MsgPutByte(InstancePtr,
+			(u8)XUartPs_ReadReg(BaseAddress, XUARTPS_FIFO_OFFSET));
+	}
+
+	if ((IsrStatus & (u32)XUARTPS_IXR_TOUT) != 0U) {
+		/* The line went idle, whatever was received is a message */
+		XUartPs_MsgEnd(InstancePtr);
+
+		CrRegister = XUartPs_ReadReg(BaseAddress, XUARTPS_CR_OFFSET);
+		XUartPs_WriteReg(BaseAddress, XUARTPS_CR_OFFSET,
+				 CrRegister | (u32)XUARTPS_CR_TORST);
+	}
+}
+
+/****************************************************************************/
+/*
+*
+* This function appends one received byte to the message in progress and
+* ends the message when the byte is the delimiter.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+* @param	Data is the received byte.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XUartPs_MsgPutByte(XUartPs *InstancePtr, u8 Data)
+{
+	XUartPsMsgRing *Ring = &InstancePtr->MsgRing;
+	u32 Used;
+
+	if (Ring->Discard == 0U) {
+		Used = (Ring->Head - Ring->Tail) + XUARTPS_MSG_HDR_SIZE +
+			Ring->MsgLen;
+		if ((Used >= (Ring->RingMask + 1U)) ||
+				(Ring->MsgLen == XUARTPS_MSG_MAX_LEN)) {
+			/* No room, drop this message up to its end */
+			Ring->Discard = 1U;
+			Ring->MsgLen = 0U;
+			Ring->Dropped++;
+		} else {
+			Ring->RingPtr[(Ring->Head + XUARTPS_MSG_HDR_SIZE +
+					Ring->MsgLen) & Ring->RingMask] = Data;
+			Ring->MsgLen++;
+		}
+	}
+
+	if ((u32)Data == Ring->Delimiter) {
+		XUartPs_MsgEnd(InstancePtr);
+	}
+}
+
+/****************************************************************************/
+/*
+*
+* This function ends the message in progress. A non empty message gets its
+* length header, is published to the reader and reported to the handler.
+*
+* @param	InstancePtr is a pointer to the XUartPs instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*****************************************************************************/
+static void XUartPs_MsgEnd(XUartPs *InstancePtr)
+{
+	XUartPsMsgRing *Ring = &InstancePtr->MsgRing;
+	u32 Length = Ring->MsgLen;
+	u32 Head = Ring->Head;
+
+	if (Ring->Discard != 0U) {
+		Ring->Discard = 0U;
+	} else if (Length != 0U) {
+		Ring->RingPtr[Head & Ring->RingMask] = (u8)Length;
+		Ring->RingPtr[(Head + 1U) & Ring->RingMask] = (u8)(Length >> 8U);
+		Ring->MsgLen = 0U;
+
+		/* Message data and header must be visible before Head moves */
+		dmb();
+		Ring->Head = Head + XUARTPS_MSG_HDR_SIZE + Length;
+
+		InstancePtr->Handler(InstancePtr->CallBackRef,
+				     XUARTPS_EVENT_RECV_MSG, Length);
+	} else {
+		/* Nothing received since the last message */
+	}
+}
+/** @} */
@@ -51,6 +51,10 @@
  * 2.00a kpc 04/03/14 Fixed CR#777763. Updated the macro names 
  * 2.1   kpc 04/28/14 Added XUsbPs_EpBufferSendWithZLT api and merged common
  *		      code to XUsbPs_EpQueueRequest.
+ * 2.2   ag  10/18/26 XUsbPs_EpQueueRequest flushes the buffer and the
+ *		      descriptors with one Xil_DCacheMaintainList call.
+ * 2.2   ag  10/18/26 Buffers and descriptors in coherent regions are not
+ *		      flushed, see xil_coherent.h.
  * </pre>
  ******************************************************************************/
 
@@ -64,6 +68,9 @@
 
 /************************** Constant Definitions ******************************/
 
+#define XUSBPS_CACHE_LIST_LEN	8	/* Entries of the flush list of a
+					 * queued request */
+
 /**************************** Type Definitions ********************************/
 
 /************************** Variable Definitions ******************************/
@@ -77,6 +84,8 @@ static int  XUsbPs_dTDAttachBuffer(XUsbPs_dTD *dTDPtr,
 					const u8 *BufferPtr, u32 BufferLen);
 
 static void XUsbPs_dQHSetMaxPacketLenISO(XUsbPs_dQH *dQHPtr, u32 Len);
+static void XUsbPs_CacheListAdd(Xil_CacheListEntry *List, u32 *CountPtr,
+				const void *Addr, u32 Len);
 
 /* Functions to reconfigure endpoint upon host's set alternate interface
  * request.
@@ -269,6 +278,8 @@ static int XUsbPs_EpQueueRequest(XUsbPs *InstancePtr, u8 EpNum,
 	u32		RegValue;
 	u32		Temp;
 	u32 exit = 1;
+	Xil_CacheListEntry CacheList[XUSBPS_CACHE_LIST_LEN];
+	u32		CacheCount = 0;
 
 
 	/* Locate the next available buffer in the ring. A buffer is available
@@ -276,7 +287,11 @@ static int XUsbPs_EpQueueRequest(XUsbPs *InstancePtr, u8 EpNum,
 	 */
 	Ep = &InstancePtr->DeviceConfig.Ep[EpNum].In;
 
-	Xil_DCacheFlushRange((unsigned int)BufferPtr, BufferLen);
+	/* The buffer and the descriptors are flushed in one list, the first
+	 * descriptor last so that the controller cannot follow it to
+	 * descriptors which are not in memory yet.
+	 */
+	XUsbPs_CacheListAdd(CacheList, &CacheCount, BufferPtr, BufferLen);
 
 	if(Ep->dTDTail != Ep->dTDHead) {
 		PipeEmpty = 0;
@@ -307,7 +322,10 @@ static int XUsbPs_EpQueueRequest(XUsbPs *InstancePtr, u8 EpNum,
 			exit = 0;
 		}
 		XUsbPs_dTDClrTerminate(Ep->dTDHead);
-		XUsbPs_dTDFlushCache(Ep->dTDHead);
+		if (Ep->dTDHead != DescPtr) {
+			XUsbPs_CacheListAdd(CacheList, &CacheCount,
+					Ep->dTDHead, sizeof(XUsbPs_dTD));
+		}
 
 		/* Advance the head descriptor pointer to the next descriptor. */
 		Ep->dTDHead = XUsbPs_dTDGetNLP(Ep->dTDHead);
@@ -315,6 +333,8 @@ static int XUsbPs_EpQueueRequest(XUsbPs *InstancePtr, u8 EpNum,
 		XUsbPs_dTDInvalidateCache(Ep->dTDHead);
 		/* Tell the caller if we do not have any descriptors available. */
 		if (XUsbPs_dTDIsActive(Ep->dTDHead)) {
+			Xil_DCacheMaintainList(CacheList, CacheCount);
+			XUsbPs_dTDFlushCache(DescPtr);
 			return XST_USB_NO_DESC_AVAILABLE;
 		}
 
@@ -325,7 +345,10 @@ static int XUsbPs_EpQueueRequest(XUsbPs *InstancePtr, u8 EpNum,
 	} while(BufferLen || exit);
 
 	XUsbPs_dTDSetTerminate(Ep->dTDHead);
-	XUsbPs_dTDFlushCache(Ep->dTDHead);
+	XUsbPs_CacheListAdd(CacheList, &CacheCount, Ep->dTDHead,
+			sizeof(XUsbPs_dTD));
+	Xil_DCacheMaintainList(CacheList, CacheCount);
+	XUsbPs_dTDFlushCache(DescPtr);
 
 	if(!PipeEmpty) {
 		/* Read the endpoint prime register. */
@@ -1118,6 +1141,37 @@ static int XUsbPs_dTDAttachBuffer(XUsbPs_dTD *dTDPtr,
 }
 
 
+/*****************************************************************************/
+/**
+ * This function appends a range to be flushed to a cache maintenance list.
+ * A full list is processed and emptied. A range in a coherent region is not
+ * added.
+ *
+ * @param	List is the list of XUSBPS_CACHE_LIST_LEN entries.
+ * @param	CountPtr is the number of entries in use.
+ * @param	Addr is the start of the range.
+ * @param	Len is the length of the range in bytes.
+ *
+ ******************************************************************************/
+static void XUsbPs_CacheListAdd(Xil_CacheListEntry *List, u32 *CountPtr,
+				const void *Addr, u32 Len)
+{
+	if (Xil_IsCoherent((INTPTR)Addr, Len) != 0U) {
+		return;
+	}
+
+	List[*CountPtr].Addr = (INTPTR)Addr;
+	List[*CountPtr].Len = Len;
+	List[*CountPtr].Op = XIL_CACHE_OP_FLUSH;
+	(*CountPtr)++;
+
+	if (*CountPtr == XUSBPS_CACHE_LIST_LEN) {
+		Xil_DCacheMaintainList(List, *CountPtr);
+		*CountPtr = 0;
+	}
+}
+
+
 /*****************************************************************************/
 /**
  * This function set the Max PacketLen for the queue head for isochronous EP.
@@ -46,6 +46,7 @@
  * Ver   Who  Date     Changes
  * ----- ---- -------- --------------------------------------------------------
  * 1.00a wgr  10/10/10 First release
+ * 2.2   ag   10/18/26 The cache macros skip descriptors in coherent regions.
  * </pre>
  *
  ******************************************************************************/
@@ -59,6 +60,7 @@ extern "C" {
 /***************************** Include Files *********************************/
 
 #include "xil_cache.h"
+#include "xil_coherent.h"
 #include "xusbps.h"
 #include "xil_types.h"
 
@@ -133,16 +135,36 @@ extern "C" {
  *
  ******************************************************************************/
 #define XUsbPs_dTDInvalidateCache(dTDPtr) \
-		Xil_DCacheInvalidateRange((unsigned int)dTDPtr, sizeof(XUsbPs_dTD))
+	do { \
+		if (Xil_IsCoherent((INTPTR)(dTDPtr), sizeof(XUsbPs_dTD)) == 0U) { \
+			Xil_DCacheInvalidateRange((unsigned int)dTDPtr, \
+						  sizeof(XUsbPs_dTD)); \
+		} \
+	} while (0)
 
 #define XUsbPs_dTDFlushCache(dTDPtr) \
-		Xil_DCacheFlushRange((unsigned int)dTDPtr, sizeof(XUsbPs_dTD))
+	do { \
+		if (Xil_IsCoherent((INTPTR)(dTDPtr), sizeof(XUsbPs_dTD)) == 0U) { \
+			Xil_DCacheFlushRange((unsigned int)dTDPtr, \
+					     sizeof(XUsbPs_dTD)); \
+		} \
+	} while (0)
 
 #define XUsbPs_dQHInvalidateCache(dQHPtr) \
-		Xil_DCacheInvalidateRange((unsigned int)dQHPtr, sizeof(XUsbPs_dQH))
+	do { \
+		if (Xil_IsCoherent((INTPTR)(dQHPtr), sizeof(XUsbPs_dQH)) == 0U) { \
+			Xil_DCacheInvalidateRange((unsigned int)dQHPtr, \
+						  sizeof(XUsbPs_dQH)); \
+		} \
+	} while (0)
 
 #define XUsbPs_dQHFlushCache(dQHPtr) \
-		Xil_DCacheFlushRange((unsigned int)dQHPtr, sizeof(XUsbPs_dQH))
+	do { \
+		if (Xil_IsCoherent((INTPTR)(dQHPtr), sizeof(XUsbPs_dQH)) == 0U) { \
+			Xil_DCacheFlushRange((unsigned int)dQHPtr, \
+					     sizeof(XUsbPs_dQH)); \
+		} \
+	} while (0)
 
 /*****************************************************************************/
 /**
@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+###############################################################################
+#
+# Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# Use of the Software is limited solely to applications:
+# (a) running on a Xilinx device, or
+# (b) that interact with a Xilinx device through a bus or interconnect.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+# OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Except as contained in this notice, the name of the Xilinx shall not be used
+# in advertising or otherwise to promote the sale, use or other dealings in
+# this Software without prior written authorization from Xilinx.
+#
+###############################################################################
+"""Decode the binary trace log written by Xil_LogWrite() (xil_log.h).
+
+The format strings are read from the .xil_log_fmt section of the application
+ELF. The input is either a raw byte capture of Xil_LogDrain() output (UART or
+DCC), or a memory dump of the Xil_LogCtrl symbol, for example
+
+    xsdb% mrd -bin -file log.bin Xil_LogCtrl <sizeof(Xil_LogCtrl) / 4>
+
+Usage:
+    xil_logdecode.py app.elf --stream capture.bin
+    xil_logdecode.py app.elf --dump log.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+CTRL_MAGIC = 0x584C4F47
+HDR_MAGIC = 0xA5000000
+HDR_MAGIC_MASK = 0xFF000000
+HDR_NARGS_MASK = 0x000000FF
+HDR_WORDS = 3
+MAX_ARGS = 4
+FMT_DROPPED = 0xFFFFFFFF
+FMT_SECTION = ".xil_log_fmt"
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+# Global timer runs at half the CPU clock (xtime_l.h)
+DEFAULT_CLOCK_HZ = 666666687 // 2
+
+
+class Elf(object):
+    """Minimal little endian ELF32 reader: sections and their contents."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or \
+                self.data[5] != 1:
+            raise ValueError("%s: not a little endian ELF32 file" % path)
+        (shoff,) = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data,
+                                                        0x2E)
+        raw = []
+        for i in range(shnum):
+            raw.append(struct.unpack_from("<IIIIIIIIII", self.data,
+                                          shoff + i * shentsize))
+        names_off = raw[shstrndx][4]
+        self.sections = []
+        for (name, stype, flags, addr, off, size, _l, _i, _a, _e) in raw:
+            end = self.data.index(b"\0", names_off + name)
+            sname = self.data[names_off + name:end].decode("ascii")
+            self.sections.append((sname, stype, flags, addr, off, size))
+
+    def section(self, name):
+        for s in self.sections:
+            if s[0] == name:
+                return s
+        return None
+
+    def cstring(self, section, addr):
+        (_n, _t, _f, base, off, size) = section
+        if addr < base or addr >= base + size:
+            return None
+        start = off + (addr - base)
+        end = self.data.find(b"\0", start, off + size)
+        if end < 0:
+            return None
+        return self.data[start:end].decode("latin-1")
+
+    def string_at(self, addr):
+        """Resolve a %s argument that points into constant ELF data."""
+        for s in self.sections:
+            if (s[2] & SHF_ALLOC) and s[1] != SHT_NOBITS:
+                text = self.cstring(s, addr)
+                if text is not None:
+                    return text
+        return None
+
+
+SPEC = re.compile(r"%(-?)(0?)(\d*)(?:\.(\d+))?l?([dDiuxXpsc%])")
+
+
+def xil_format(elf, fmt, args):
+    """Format like xil_printf(): %d %i %u %x %X %p %s %c with - 0 width."""
+    args = list(args)
+
+    def repl(m):
+        left, zero, width, prec, conv = m.groups()
+        if conv == "%":
+            return "%"
+        value = args.pop(0) if args else 0
+        if conv in "dDi":
+            text = str(value - (1 << 32) if value & 0x80000000 else value)
+        elif conv == "u":
+            text = str(value)
+        elif conv in "xXp":
+            text = "%X" % value
+        elif conv == "c":
+            text = chr(value & 0xFF)
+        else:
+            text = elf.string_at(value)
+            if text is None:
+                text = "<0x%08X>" % value
+            if prec:
+                text = text[:int(prec)]
+        width = int(width) if width else 0
+        if left:
+            return text.ljust(width)
+        return text.rjust(width, "0" if zero else " ")
+
+    return SPEC.sub(repl, fmt)
+
+
+class Decoder(object):
+    def __init__(self, elf, clock_hz):
+        self.elf = elf
+        self.fmt = elf.section(FMT_SECTION)
+        if self.fmt is None:
+            raise ValueError("ELF has no %s section" % FMT_SECTION)
+        self.clock_hz = clock_hz
+        self.first = None
+        self.last = None
+
+    def seconds(self, stamp):
+        # The log keeps the lower 32 bits of the global timer; unwrap them.
+        # Records that preempt each other may land out of stamp order, so a
+        # step back of less than half the range is not a wrap.
+        if self.first is None:
+            self.first = stamp
+            self.last = stamp
+        else:
+            delta = (stamp - self.last) & 0xFFFFFFFF
+            if delta >= 1 << 31:
+                delta -= 1 << 32
+            self.last += delta
+        return float(self.last - self.first) / self.clock_hz
+
+    def record(self, fmt_id, stamp, args):
+        when = self.seconds(stamp)
+        if fmt_id == FMT_DROPPED:
+            text = "*** %u record(s) dropped ***" % args[0]
+        else:
+            fmt = self.elf.cstring(self.fmt, fmt_id)
+            if fmt is None:
+                text = "<unknown format 0x%08X> %s" % (
+                    fmt_id, " ".join("0x%08X" % a for a in args))
+            else:
+                text = xil_format(self.elf, fmt, args)
+        return "[%12.6f] %s" % (when, text.rstrip("\r\n"))
+
+    def words(self, words):
+        """Decode a sequence of words, resynchronising on bad headers."""
+        out = []
+        i = 0
+        skipped = 0
+        while i + HDR_WORDS <= len(words):
+            hdr = words[i]
+            nargs = hdr & HDR_NARGS_MASK
+            if (hdr & HDR_MAGIC_MASK) != HDR_MAGIC or nargs > MAX_ARGS or \
+                    i + HDR_WORDS + nargs > len(words):
+                i += 1
+                skipped += 1
+                continue
+            if skipped:
+                out.append("*** skipped %d word(s) ***" % skipped)
+                skipped = 0
+            out.append(self.record(words[i + 1], words[i + 2],
+                                   words[i + HDR_WORDS:i + HDR_WORDS + nargs]))
+            i += HDR_WORDS + nargs
+        return out
+
+
+def words_of(data):
+    n = len(data) // 4
+    return list(struct.unpack_from("<%dI" % n, data))
+
+
+def decode_dump(decoder, data):
+    magic, size, head, tail, dropped = struct.unpack_from("<5I", data)
+    if magic != CTRL_MAGIC:
+        raise ValueError("dump does not start with Xil_LogCtrl")
+    buf = words_of(data[20:20 + size * 4])
+    if len(buf) != size:
+        raise ValueError("dump is shorter than the ring (%d words)" % size)
+    pending = [buf[(tail + i) % size] for i in range((head - tail) & 0xFFFFFFFF)]
+    lines = decoder.words(pending)
+    if dropped:
+        lines.append("*** %u record(s) dropped ***" % dropped)
+    return lines
+
+
+def decode_stream(decoder, data):
+    # A capture may start in the middle of a word; use the byte alignment
+    # that yields the most records.
+    best = []
+    for align in range(4):
+        trial = Decoder(decoder.elf, decoder.clock_hz)
+        lines = trial.words(words_of(data[align:]))
+        if len([l for l in lines if not l.startswith("***")]) > \
+                len([l for l in best if not l.startswith("***")]):
+            best = lines
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="application ELF file")
+    group = parser.add_mutually_exclusive_group(required=True)
+    group.add_argument("--stream", help="raw capture of Xil_LogDrain output")
+    group.add_argument("--dump", help="memory dump of Xil_LogCtrl")
+    parser.add_argument("--clock", type=int, default=DEFAULT_CLOCK_HZ,
+                        help="global timer frequency in Hz (default %(default)s)")
+    opts = parser.parse_args()
+
+    decoder = Decoder(Elf(opts.elf), opts.clock)
+    with open(opts.stream or opts.dump, "rb") as f:
+        data = f.read()
+    if opts.dump:
+        lines = decode_dump(decoder, data)
+    else:
+        lines = decode_stream(decoder, data)
+    for line in lines:
+        print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
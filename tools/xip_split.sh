@@ -0,0 +1,71 @@
+#!/bin/sh
+###############################################################################
+#
+# Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# Use of the Software is limited solely to applications:
+# (a) running on a Xilinx device, or
+# (b) that interact with a Xilinx device through a bus or interconnect.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+# WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+# OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Except as contained in this notice, the name of the Xilinx shall not be used
+# in advertising or otherwise to promote the sale, use or other dealings in
+# this Software without prior written authorization from Xilinx.
+#
+#
+# Split an application ELF that uses execute in place (XQSPIPS_XIP_TEXT /
+# XQSPIPS_XIP_RODATA) into
+#
+#   <app>.boot.elf  the ELF without .xip_text, given to bootgen for the FSBL
+#                   load of the DDR part
+#   <app>.xip.bin   the raw .xip_text contents, programmed into the QSPI flash
+#                   at offset 0xC00000 (XQSPIPS_XIP_FLASH_OFFSET)
+#
+# Usage: xip_split.sh <app>.elf
+#
+# Program the image with, for example
+#
+#   program_flash -f <app>.xip.bin -offset 0xC00000 -flash_type qspi_single
+#
+# CROSS_COMPILE selects the toolchain prefix (default arm-none-eabi-).
+#
+###############################################################################
+
+set -e
+
+if [ $# -ne 1 ]; then
+	echo "usage: $0 <app>.elf" >&2
+	exit 1
+fi
+
+ELF=$1
+BASE=${ELF%.elf}
+CROSS_COMPILE=${CROSS_COMPILE:-arm-none-eabi-}
+
+if ! ${CROSS_COMPILE}objdump -h "$ELF" | grep -q '\.xip_text'; then
+	echo "$ELF: no .xip_text section" >&2
+	exit 1
+fi
+
+${CROSS_COMPILE}objcopy -O binary -j .xip_text "$ELF" "$BASE.xip.bin"
+${CROSS_COMPILE}objcopy -R .xip_text "$ELF" "$BASE.boot.elf"
+
+echo "$BASE.xip.bin: $(wc -c < "$BASE.xip.bin") bytes, flash offset 0xC00000"
+echo "$BASE.boot.elf: boot image ELF"
@@ -0,0 +1,548 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* XILINX  BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/*****************************************************************************/
+/**
+*
+* @file xqspips_log_sim.c
+*
+* Host harness for the QSPI log store (xqspips_log.c). The flash device
+* layer is replaced by an in-memory NOR flash model with page program and
+* erase times, so the unmodified log code runs on the build host.
+*
+* Two runs are made:
+*	- throughput: records are appended as fast as the model accepts
+*	  them. The sustained record rate (in simulated flash time), the
+*	  write amplification (bytes programmed per byte appended), erases,
+*	  the spread of the sector erase counts and the host CPU time per
+*	  append are printed, together with the write amplification of
+*	  rewriting a whole sector per record.
+*	- power fail: the model is cut at a random point, optionally in the
+*	  middle of a program or erase, the log is mounted again and all
+*	  records are read back and checked.
+*
+* Build and run from the repository root:
+*
+*	B=hello_bsp/ps7_cortexa9_0
+*	cc -O2 -I$B/libsrc/qspips_v3_2/src -I$B/libsrc/standalone_v5_2/src \
+*	   -I$B/include -o xqspips_log_sim tools/xqspips_log_sim.c \
+*	   $B/libsrc/qspips_v3_2/src/xqspips_log.c
+*	./xqspips_log_sim [sector size] [sectors] [flush interval]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 1.00  ag  10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "xqspips_log.h"
+
+/************************** Constant Definitions *****************************/
+
+#define REGION_BASE		0x00400000
+#define MAX_REGION_SIZE		(16 * 1024 * 1024)
+
+/*
+ * Flash timing in microseconds, typical values of a 128 Mbit device with a
+ * 50 MHz single line command interface
+ */
+#define PROGRAM_US		400
+#define PROGRAM_BYTE_NS		160
+#define ERASE_4K_US		45000
+#define ERASE_SECTOR_US		300000
+
+#define THROUGHPUT_RECORDS	200000
+#define POWER_FAIL_RUNS		500
+#define POWER_FAIL_RECORDS	4000
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u8 *Mem;		/* Region contents */
+	u32 Size;		/* Region size */
+	u32 SectorSize;		/* Erase sector size */
+	u32 *EraseCount;	/* Erases per sector */
+	u64 Now;		/* Simulated time in ns */
+	u64 OpStart;		/* Start of the operation at the queue tail */
+	u32 OpsLeft;		/* Operations until power is cut, 0 = never */
+	int PowerOff;		/* Power has been cut */
+} FlashModel;
+
+/************************** Function Prototypes ******************************/
+
+static void ModelInit(FlashModel *ModelPtr, u32 SectorSize, u32 Sectors);
+static u64 ModelOpTime(XQspiPs_FlashOp *OpPtr);
+static void ModelApply(FlashModel *ModelPtr, XQspiPs_FlashOp *OpPtr,
+		       int Torn);
+static void ModelAdvance(XQspiPs_Flash *FlashPtr, u64 Until);
+static int ModelNextEvent(XQspiPs_Flash *FlashPtr, u64 *EventPtr);
+static u32 RecordLength(u32 Record);
+static void RecordFill(u32 Record, u8 *BufPtr, u32 Length);
+static int Throughput(u32 SectorSize, u32 Sectors, u32 FlushEvery);
+static int PowerFail(u32 SectorSize, u32 Sectors, u32 Run);
+static u32 Random(void);
+
+/************************** Variable Definitions *****************************/
+
+u32 Xil_AssertStatus;
+
+static FlashModel Model;
+static u32 RandomState = 1;
+
+/*****************************************************************************/
+/*
+ * Replacements of the assert handler and of the flash device layer
+ */
+void Xil_Assert(const char8 *File, s32 Line)
+{
+	fprintf(stderr, "assert %s:%d\n", File, Line);
+	exit(2);
+}
+
+void XQspiPs_FlashSetHandler(XQspiPs_Flash *FlashPtr,
+			     XQspiPs_FlashHandler FuncPtr, void *CallBackRef)
+{
+	FlashPtr->Handler = FuncPtr;
+	FlashPtr->CallBackRef = CallBackRef;
+}
+
+int XQspiPs_FlashSubmit(XQspiPs_Flash *FlashPtr, XQspiPs_FlashOp *OpPtr)
+{
+	u8 *Copy;
+
+	if ((FlashPtr->Head - FlashPtr->Tail) >= XQSPIPS_FLASH_QUEUE_LEN) {
+		return XST_DEVICE_BUSY;
+	}
+	if ((OpPtr->Type == XQSPIPS_FLASH_OP_PROGRAM) &&
+	    ((OpPtr->Address % FlashPtr->PageSize) + OpPtr->ByteCount >
+	     FlashPtr->PageSize)) {
+		fprintf(stderr, "program crosses a page at 0x%x\n",
+			(unsigned)OpPtr->Address);
+		exit(2);
+	}
+	if (FlashPtr->Head == FlashPtr->Tail) {
+		Model.OpStart = Model.Now;
+	}
+
+	/*
+	 * The real layer copies the data when the operation starts; copying
+	 * it here finds a caller that reuses a buffer too early only if the
+	 * content differs, so check the buffer again when the op completes
+	 */
+	Copy = NULL;
+	if (OpPtr->Type == XQSPIPS_FLASH_OP_PROGRAM) {
+		Copy = malloc(OpPtr->ByteCount);
+		memcpy(Copy, OpPtr->BufPtr, OpPtr->ByteCount);
+	}
+	FlashPtr->Queue[FlashPtr->Head & (XQSPIPS_FLASH_QUEUE_LEN - 1)] =
+		*OpPtr;
+	FlashPtr->Queue[FlashPtr->Head & (XQSPIPS_FLASH_QUEUE_LEN - 1)].
+		UserRef = Copy;
+	FlashPtr->Head++;
+
+	return XST_SUCCESS;
+}
+
+int XQspiPs_FlashRead(XQspiPs_Flash *FlashPtr, u32 Address, u8 *BufPtr,
+		      unsigned ByteCount)
+{
+	(void)FlashPtr;
+
+	if ((Address < REGION_BASE) ||
+	    (Address - REGION_BASE + ByteCount > Model.Size)) {
+		fprintf(stderr, "read outside the region at 0x%x\n",
+			(unsigned)Address);
+		exit(2);
+	}
+	memcpy(BufPtr, &Model.Mem[Address - REGION_BASE], ByteCount);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/*
+ * Flash model
+ */
+static void ModelInit(FlashModel *ModelPtr, u32 SectorSize, u32 Sectors)
+{
+	free(ModelPtr->Mem);
+	free(ModelPtr->EraseCount);
+	memset(ModelPtr, 0, sizeof(*ModelPtr));
+	ModelPtr->Size = SectorSize * Sectors;
+	ModelPtr->SectorSize = SectorSize;
+	ModelPtr->Mem = malloc(ModelPtr->Size);
+	ModelPtr->EraseCount = calloc(Sectors, sizeof(u32));
+
+	/* A new part is not necessarily blank */
+	memset(ModelPtr->Mem, 0xA5, ModelPtr->Size);
+}
+
+static u64 ModelOpTime(XQspiPs_FlashOp *OpPtr)
+{
+	switch (OpPtr->Type) {
+	case XQSPIPS_FLASH_OP_PROGRAM:
+		return PROGRAM_US * 1000ULL +
+		       (u64)OpPtr->ByteCount * PROGRAM_BYTE_NS;
+	case XQSPIPS_FLASH_OP_ERASE_4K:
+		return ERASE_4K_US * 1000ULL;
+	default:
+		return ERASE_SECTOR_US * 1000ULL;
+	}
+}
+
+static void ModelApply(FlashModel *ModelPtr, XQspiPs_FlashOp *OpPtr,
+		       int Torn)
+{
+	u32 Offset = OpPtr->Address - REGION_BASE;
+	u32 Size;
+	u32 Index;
+	u8 *Data = (u8 *)OpPtr->UserRef;
+
+	if (OpPtr->Type == XQSPIPS_FLASH_OP_PROGRAM) {
+		if (memcmp(Data, OpPtr->BufPtr, OpPtr->ByteCount) != 0) {
+			fprintf(stderr, "buffer at 0x%x reused before its "
+				"program completed\n", (unsigned)OpPtr->Address);
+			exit(2);
+		}
+		/* Programming only clears bits; a torn program a prefix */
+		Size = Torn ? (Random() % OpPtr->ByteCount) : OpPtr->ByteCount;
+		for (Index = 0; Index < Size; Index++) {
+			ModelPtr->Mem[Offset + Index] &= Data[Index];
+		}
+		free(Data);
+		return;
+	}
+
+	Size = (OpPtr->Type == XQSPIPS_FLASH_OP_ERASE_4K) ? 4096 :
+	       ModelPtr->SectorSize;
+	Offset -= Offset % Size;
+	if (Torn) {
+		/* An interrupted erase leaves the cells undefined */
+		for (Index = 0; Index < Size; Index++) {
+			ModelPtr->Mem[Offset + Index] |= (u8)Random();
+		}
+		return;
+	}
+	memset(&ModelPtr->Mem[Offset], 0xFF, Size);
+	ModelPtr->EraseCount[Offset / ModelPtr->SectorSize]++;
+}
+
+static int ModelNextEvent(XQspiPs_Flash *FlashPtr, u64 *EventPtr)
+{
+	if (FlashPtr->Head == FlashPtr->Tail) {
+		return 0;
+	}
+	*EventPtr = Model.OpStart +
+		ModelOpTime(&FlashPtr->Queue[FlashPtr->Tail &
+					     (XQSPIPS_FLASH_QUEUE_LEN - 1)]);
+	return 1;
+}
+
+/*
+ * Completes the queued operations that end before Until and moves the
+ * simulated time there
+ */
+static void ModelAdvance(XQspiPs_Flash *FlashPtr, u64 Until)
+{
+	XQspiPs_FlashOp Op;
+	u64 End;
+
+	while (!Model.PowerOff && ModelNextEvent(FlashPtr, &End) &&
+	       (End <= Until)) {
+		Op = FlashPtr->Queue[FlashPtr->Tail &
+				     (XQSPIPS_FLASH_QUEUE_LEN - 1)];
+		if ((Model.OpsLeft != 0) && (--Model.OpsLeft == 0)) {
+			/* Power fails while this operation runs */
+			ModelApply(&Model, &Op, Random() & 1);
+			Model.PowerOff = 1;
+			return;
+		}
+		ModelApply(&Model, &Op, 0);
+		Model.Now = End;
+		Model.OpStart = End;
+		FlashPtr->Tail++;
+		FlashPtr->Handler(FlashPtr->CallBackRef, &Op, XST_SUCCESS);
+	}
+	if (Until > Model.Now) {
+		Model.Now = Until;
+	}
+}
+
+/*****************************************************************************/
+/*
+ * Record contents are derived from the record number, so a reader can check
+ * every record it gets back
+ */
+static u32 RecordLength(u32 Record)
+{
+	return 16 + ((Record * 37) % 113);
+}
+
+static void RecordFill(u32 Record, u8 *BufPtr, u32 Length)
+{
+	u32 Index;
+
+	for (Index = 0; Index < Length; Index++) {
+		BufPtr[Index] = (u8)(Record * 131 + Index);
+	}
+	memcpy(BufPtr, &Record, sizeof(Record));
+}
+
+static u32 Random(void)
+{
+	RandomState = RandomState * 1103515245U + 12345U;
+	return RandomState >> 8;
+}
+
+/*****************************************************************************/
+/*
+ * Appends records as fast as the flash accepts them
+ */
+static int Throughput(u32 SectorSize, u32 Sectors, u32 FlushEvery)
+{
+	static XQspiPs_Flash Flash;
+	static XQspiPs_Log Log;
+	u8 Buf[256];
+	u32 Record;
+	u32 Length;
+	u32 MinErase = 0xFFFFFFFFU;
+	u32 MaxErase = 0;
+	u32 Index;
+	u64 Event;
+	u64 Start;
+	struct timespec T0, T1;
+	double HostNs = 0;
+	int Status;
+
+	ModelInit(&Model, SectorSize, Sectors);
+	memset(&Flash, 0, sizeof(Flash));
+	Flash.PageSize = XQSPIPS_FLASH_PAGE_SIZE;
+
+	if (XQspiPs_LogMount(&Log, &Flash, REGION_BASE, SectorSize,
+			     Sectors) != XST_SUCCESS) {
+		return 1;
+	}
+	Start = Model.Now;
+
+	for (Record = 0; Record < THROUGHPUT_RECORDS; ) {
+		Length = RecordLength(Record);
+		RecordFill(Record, Buf, Length);
+
+		clock_gettime(CLOCK_MONOTONIC, &T0);
+		Status = XQspiPs_LogAppend(&Log, Buf, Length);
+		if ((Status == XST_SUCCESS) && (FlushEvery != 0) &&
+		    ((Record + 1) % FlushEvery) == 0) {
+			(void)XQspiPs_LogFlush(&Log);
+		}
+		clock_gettime(CLOCK_MONOTONIC, &T1);
+		HostNs += (T1.tv_sec - T0.tv_sec) * 1e9 +
+			  (T1.tv_nsec - T0.tv_nsec);
+
+		if (Status == XST_SUCCESS) {
+			Record++;
+		} else if (Status == XST_DEVICE_BUSY) {
+			if (!ModelNextEvent(&Flash, &Event)) {
+				fprintf(stderr, "busy with an idle flash\n");
+				return 1;
+			}
+			ModelAdvance(&Flash, Event);
+		} else {
+			fprintf(stderr, "append failed %d\n", Status);
+			return 1;
+		}
+	}
+
+	for (Index = 0; Index < Sectors; Index++) {
+		if (Model.EraseCount[Index] < MinErase) {
+			MinErase = Model.EraseCount[Index];
+		}
+		if (Model.EraseCount[Index] > MaxErase) {
+			MaxErase = Model.EraseCount[Index];
+		}
+	}
+
+	printf("sector %6u x %3u, flush every %3u: %8.0f rec/s "
+	       "%7.1f KB/s  WA %5.2f  erases %6u (%u..%u)  %5.0f ns/append\n",
+	       (unsigned)SectorSize, (unsigned)Sectors, (unsigned)FlushEvery,
+	       THROUGHPUT_RECORDS / ((Model.Now - Start) / 1e9),
+	       Log.UserBytes / 1024.0 / ((Model.Now - Start) / 1e9),
+	       (double)Log.ProgramBytes / Log.UserBytes,
+	       (unsigned)Log.Erases, (unsigned)MinErase, (unsigned)MaxErase,
+	       HostNs / THROUGHPUT_RECORDS);
+	printf("  sector rewrite per record: WA %.0f, %.1f rec/s\n",
+	       (double)SectorSize * THROUGHPUT_RECORDS / Log.UserBytes,
+	       1e9 / (ModelOpTime(&(XQspiPs_FlashOp){
+			.Type = (SectorSize == 4096) ?
+				XQSPIPS_FLASH_OP_ERASE_4K :
+				XQSPIPS_FLASH_OP_ERASE_SECTOR }) +
+		      (SectorSize / XQSPIPS_FLASH_PAGE_SIZE) *
+		      ModelOpTime(&(XQspiPs_FlashOp){
+			.Type = XQSPIPS_FLASH_OP_PROGRAM,
+			.ByteCount = XQSPIPS_FLASH_PAGE_SIZE })));
+
+	return 0;
+}
+
+/*****************************************************************************/
+/*
+ * Cuts the power at a random operation, mounts again and checks that every
+ * record read back is intact and in order
+ */
+static int PowerFail(u32 SectorSize, u32 Sectors, u32 Run)
+{
+	static XQspiPs_Flash Flash;
+	static XQspiPs_Log Log;
+	XQspiPs_LogCursor Cursor;
+	u8 Buf[256];
+	u8 Expect[256];
+	u32 Record;
+	u32 Length;
+	u32 Count = 0;
+	u32 Last = 0;
+	u64 Event;
+	int Status;
+
+	ModelInit(&Model, SectorSize, Sectors);
+	memset(&Flash, 0, sizeof(Flash));
+	Flash.PageSize = XQSPIPS_FLASH_PAGE_SIZE;
+
+	/* Mount a blank part and let the initial erases finish */
+	XQspiPs_LogMount(&Log, &Flash, REGION_BASE, SectorSize, Sectors);
+	while (Log.DirtyCount > 0 || Log.ErasingCount > 0) {
+		if (ModelNextEvent(&Flash, &Event)) {
+			ModelAdvance(&Flash, Event);
+		}
+		XQspiPs_LogService(&Log);
+	}
+
+	Model.OpsLeft = 1 + Random() % (POWER_FAIL_RECORDS / 4);
+	for (Record = 0; !Model.PowerOff && Record < POWER_FAIL_RECORDS; ) {
+		Length = RecordLength(Record);
+		RecordFill(Record, Buf, Length);
+		Status = XQspiPs_LogAppend(&Log, Buf, Length);
+		if (Status == XST_SUCCESS) {
+			Record++;
+			if ((Random() % 16) == 0) {
+				(void)XQspiPs_LogFlush(&Log);
+			}
+		} else if (ModelNextEvent(&Flash, &Event)) {
+			ModelAdvance(&Flash, Event);
+		}
+	}
+	if (!Model.PowerOff) {
+		return 0;
+	}
+
+	/* Power up: the queue is lost, the flash keeps what was written */
+	memset(&Flash, 0, sizeof(Flash));
+	Flash.PageSize = XQSPIPS_FLASH_PAGE_SIZE;
+	Model.PowerOff = 0;
+	Model.OpsLeft = 0;
+
+	if (XQspiPs_LogMount(&Log, &Flash, REGION_BASE, SectorSize,
+			     Sectors) != XST_SUCCESS) {
+		return 1;
+	}
+	XQspiPs_LogCursorInit(&Log, &Cursor);
+	while (XQspiPs_LogRead(&Log, &Cursor, Buf, sizeof(Buf),
+			       &Length) == XST_SUCCESS) {
+		Record = Cursor.Record - 1;
+		RecordFill(Record, Expect, RecordLength(Record));
+		if ((Length != RecordLength(Record)) ||
+		    (memcmp(Buf, Expect, Length) != 0) ||
+		    ((Count > 0) && (Record <= Last))) {
+			fprintf(stderr, "run %u: record %u corrupt\n",
+				(unsigned)Run, (unsigned)Record);
+			return 1;
+		}
+		Last = Record;
+		Count++;
+	}
+
+	/* The log must be writable again and continue the numbering */
+	Record = XQspiPs_LogNextRecord(&Log);
+	if ((Count > 0) && (Record != Last + 1)) {
+		fprintf(stderr, "run %u: next record %u after %u\n",
+			(unsigned)Run, (unsigned)Record, (unsigned)Last);
+		return 1;
+	}
+	for (;;) {
+		Length = RecordLength(Record);
+		RecordFill(Record, Buf, Length);
+		if (XQspiPs_LogAppend(&Log, Buf, Length) == XST_SUCCESS) {
+			break;
+		}
+		if (!ModelNextEvent(&Flash, &Event)) {
+			fprintf(stderr, "run %u: log stuck\n", (unsigned)Run);
+			return 1;
+		}
+		ModelAdvance(&Flash, Event);
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	u32 SectorSize = (argc > 1) ? strtoul(argv[1], NULL, 0) : 4096;
+	u32 Sectors = (argc > 2) ? strtoul(argv[2], NULL, 0) : 64;
+	u32 FlushEvery = (argc > 3) ? strtoul(argv[3], NULL, 0) : 0;
+	u32 Run;
+
+	if ((SectorSize * Sectors > MAX_REGION_SIZE) ||
+	    (Sectors > XQSPIPS_LOG_MAX_SECTORS)) {
+		fprintf(stderr, "region too large\n");
+		return 1;
+	}
+
+	if (Throughput(SectorSize, Sectors, FlushEvery) != 0) {
+		return 1;
+	}
+
+	for (Run = 0; Run < POWER_FAIL_RUNS; Run++) {
+		if (PowerFail(SectorSize, Sectors, Run) != 0) {
+			return 1;
+		}
+	}
+	printf("power fail: %u runs passed\n", (unsigned)POWER_FAIL_RUNS);
+
+	return 0;
+}